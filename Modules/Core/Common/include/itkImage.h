@@ -170,6 +170,23 @@ public:
    * already be set, e.g. by calling SetRegions(). */
   void Allocate();
 
+  /** Allocate the image memory without constructing the pixels. Their
+   * values are undefined until they are written, so this is only useful
+   * when every pixel is about to be overwritten. It saves the pass over
+   * the memory made by the default constructors of pixel types such as
+   * RGBAPixel or SymmetricSecondRankTensor. It must not be used with pixel
+   * types that own resources, such as VariableLengthVector.
+   * ImageSource::AllocateOutputs() uses it for the pixel types of
+   * PixelAllocationTraits, when the filter turns
+   * AllocateOutputsUninitialized on.
+   * \sa ImportImageContainer::ReserveUninitialized() */
+  virtual void AllocateUninitialized();
+
+  /** Allocate the image memory and set every pixel to value. This is
+   * equivalent to Allocate() followed by FillBuffer(value), but writes the
+   * buffer only once, and is safe for every pixel type. */
+  void AllocateAndFill(const TPixel & value);
+
   /** Convenience methods to set the LargestPossibleRegion,
    *  BufferedRegion and RequestedRegion. Allocate must still be called.
    */
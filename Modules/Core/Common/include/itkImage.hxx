@@ -57,6 +57,30 @@ Image< TPixel, VImageDimension >
   m_Buffer->Reserve(num);
 }
 
+template< class TPixel, unsigned int VImageDimension >
+void
+Image< TPixel, VImageDimension >
+::AllocateUninitialized()
+{
+  this->ComputeOffsetTable();
+  const SizeValueType num =
+    static_cast< SizeValueType >( this->GetOffsetTable()[VImageDimension] );
+
+  m_Buffer->ReserveUninitialized(num);
+}
+
+template< class TPixel, unsigned int VImageDimension >
+void
+Image< TPixel, VImageDimension >
+::AllocateAndFill(const TPixel & value)
+{
+  this->ComputeOffsetTable();
+  const SizeValueType num =
+    static_cast< SizeValueType >( this->GetOffsetTable()[VImageDimension] );
+
+  m_Buffer->ReserveAndFill(num, value);
+}
+
 template< class TPixel, unsigned int VImageDimension >
 void
 Image< TPixel, VImageDimension >
@@ -73,7 +97,10 @@ Image< TPixel, VImageDimension >
   // Replace the handle to the buffer. This is the safest thing to do,
   // since the same container can be shared by multiple images (e.g.
   // Grafted outputs and in place filters).
+  // The allocator of the image is kept.
+  ImageBufferAllocator::Pointer allocator = m_Buffer ? m_Buffer->GetAllocator() : 0;
   m_Buffer = PixelContainer::New();
+  m_Buffer->SetAllocator( allocator.GetPointer() );
 }
 
 template< class TPixel, unsigned int VImageDimension >
@@ -0,0 +1,174 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkImageBufferAllocator_h
+#define __itkImageBufferAllocator_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkIntTypes.h"
+
+#include <map>
+
+namespace itk
+{
+/** \class ImageBufferAllocator
+ * \brief Allocates the raw memory of image pixel buffers.
+ *
+ * ImportImageContainer asks its allocator, when it has one, for the memory
+ * of the pixel buffers it manages instead of using new[]. The default
+ * implementation provides:
+ *
+ * - Aligned blocks. Every block starts on a multiple of Alignment bytes
+ *   (64 by default, a cache line and the widest SIMD register).
+ * - A recycling pool. When Pooling is on, released blocks are kept, sorted
+ *   by size bucket, and handed back to the next allocation of the same
+ *   bucket. Pipelines that are re-executed (per slice, per time point,
+ *   ...) then reuse their buffers instead of going back to the operating
+ *   system. The pool never holds more than MaximumPoolSize bytes.
+ * - Huge pages. When HugePages is on, blocks of at least
+ *   GetHugePageSize() bytes are aligned on huge page boundaries and the
+ *   kernel is advised to back them with transparent huge pages. This is
+ *   only supported on Linux and is ignored elsewhere.
+ *
+ * The same allocator may be shared by any number of containers and
+ * threads. The allocator used by new containers is set with
+ * SetGlobalDefault(); there is none by default, so containers keep using
+ * new[] unless an allocator is installed.
+ *
+ * Subclasses may override AllocateBlock() and DeallocateBlock() to obtain
+ * the memory from elsewhere; the pool is managed by Allocate() and
+ * Deallocate().
+ *
+ * \sa ImportImageContainer
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocator:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageBufferAllocator       Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageBufferAllocator, Object);
+
+  /** Return a block of at least numberOfBytes bytes, aligned on Alignment
+   * bytes. Throws a MemoryAllocationError on failure. */
+  void * Allocate(SizeValueType numberOfBytes);
+
+  /** Release a block returned by Allocate(). numberOfBytes must be the size
+   * that was requested for it. */
+  void Deallocate(void *block, SizeValueType numberOfBytes);
+
+  /** Set/Get the alignment of the blocks, in bytes. It must be a power of
+   * two; other values are rounded up to one. The default is 64. */
+  void SetAlignment(SizeValueType alignment);
+  itkGetConstMacro(Alignment, SizeValueType);
+
+  /** Set/Get whether released blocks are kept for reuse. Off by default.
+   * Turning pooling off releases the pool. */
+  void SetPooling(bool pooling);
+  itkGetConstMacro(Pooling, bool);
+  itkBooleanMacro(Pooling);
+
+  /** Set/Get the largest number of bytes kept in the pool. Blocks that
+   * would not fit are released. The default is 1 GiB. */
+  itkSetMacro(MaximumPoolSize, SizeValueType);
+  itkGetConstMacro(MaximumPoolSize, SizeValueType);
+
+  /** Set/Get whether large blocks are backed by huge pages. Off by
+   * default. */
+  itkSetMacro(HugePages, bool);
+  itkGetConstMacro(HugePages, bool);
+  itkBooleanMacro(HugePages);
+
+  /** Size of a huge page; only blocks at least this large use them. */
+  static SizeValueType GetHugePageSize();
+
+  /** Give all the pooled blocks back to the operating system. */
+  void ReleasePool();
+
+  /** Number of bytes currently held by the pool. */
+  SizeValueType GetPoolSize() const;
+
+  /** Statistics: number of calls to Allocate(), number of them served from
+   * the pool, and number of calls to Deallocate(). */
+  SizeValueType GetNumberOfAllocations() const;
+  SizeValueType GetNumberOfPoolHits() const;
+  SizeValueType GetNumberOfDeallocations() const;
+
+  /** Reset the statistics above to zero. */
+  void ResetStatistics();
+
+  /** Set/Get the allocator given to new ImportImageContainers. It is NULL
+   * by default, in which case the containers use new[]. */
+  static void SetGlobalDefault(Self *allocator);
+
+  static Pointer GetGlobalDefault();
+
+protected:
+  ImageBufferAllocator();
+  ~ImageBufferAllocator();
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+  /** Obtain/release the memory of a block of exactly numberOfBytes bytes
+   * (a bucket size) from the system. AllocateBlock() returns NULL on
+   * failure. */
+  virtual void * AllocateBlock(SizeValueType numberOfBytes);
+
+  virtual void DeallocateBlock(void *block, SizeValueType numberOfBytes);
+
+  /** Size of the bucket holding blocks of numberOfBytes bytes. Buckets are
+   * spaced by an eighth of a power of two, so at most one eighth of a
+   * block is wasted. */
+  static SizeValueType ComputeBucketSize(SizeValueType numberOfBytes);
+
+private:
+  ImageBufferAllocator(const Self &); //purposely not implemented
+  void operator=(const Self &);       //purposely not implemented
+
+  typedef std::multimap< SizeValueType, void * > PoolType;
+
+  /** Guards the pool and the statistics. */
+  mutable SimpleFastMutexLock m_Mutex;
+
+  PoolType      m_Pool;
+  SizeValueType m_PoolSize;
+
+  SizeValueType m_Alignment;
+  bool          m_Pooling;
+  SizeValueType m_MaximumPoolSize;
+  bool          m_HugePages;
+
+  SizeValueType m_NumberOfAllocations;
+  SizeValueType m_NumberOfPoolHits;
+  SizeValueType m_NumberOfDeallocations;
+
+  static Pointer             m_GlobalDefault;
+  static SimpleFastMutexLock m_GlobalDefaultMutex;
+};
+} // end namespace itk
+
+#endif
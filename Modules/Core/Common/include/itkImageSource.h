@@ -30,9 +30,16 @@
 
 #include "itkProcessObject.h"
 #include "itkImage.h"
+#include "itkPixelTraits.h"
+#include "itkSimpleFastMutexLock.h"
+
+#include <vector>
 
 namespace itk
 {
+template< class TPixel, unsigned int VImageDimension >
+class VectorImage;
+
 /** \class ImageSource
  *  \brief Base class for all process objects that output image data.
  *
@@ -197,9 +204,56 @@ public:
    * an implementation of MakeOutput(). */
   virtual DataObjectPointer MakeOutput(unsigned int idx);
 
+  /** Get whether the default GenerateData() schedules the output
+   * regions dynamically. By default the requested region is split into
+   * one piece per thread, which is passed to ThreadedGenerateData(). When
+   * DynamicMultiThreading is on, it is split into NumberOfPiecesPerThread
+   * pieces per thread instead: each thread first processes its own
+   * contiguous share of the pieces, then steals pieces from the end of the
+   * largest share that is left, and every piece is passed to
+   * DynamicThreadedGenerateData(). This keeps all the threads busy when
+   * the cost per pixel varies across the image.
+   *
+   * The mode is turned on by the filters which implement
+   * DynamicThreadedGenerateData(). It is off by default. */
+  itkGetConstMacro(DynamicMultiThreading, bool);
+
+  /** Get whether AllocateOutputs() leaves the pixels of the outputs
+   * unconstructed when their type allows it (see PixelAllocationTraits).
+   * It is turned on by the filters which write every pixel of the
+   * requested regions of their outputs. It is off by default, so that the
+   * outputs are allocated with Allocate(). */
+  itkGetConstMacro(AllocateOutputsUninitialized, bool);
+
+  /** Set/Get the number of pieces requested per thread when
+   * DynamicMultiThreading is on. The default is 8. */
+  itkSetClampMacro(NumberOfPiecesPerThread, unsigned int, 1,
+                   NumericTraits< unsigned int >::max());
+  itkGetConstMacro(NumberOfPiecesPerThread, unsigned int);
+
+  /** Set/Get whether the default GenerateData() places the pages of the
+   * primary output buffer on the NUMA node of the thread that computes
+   * them. The buffer of a plain-old-data image is not touched when it is
+   * allocated, and the operating system places each page on the node of
+   * the thread that first writes to it. When NUMAAwareAllocation is on,
+   * every thread first writes one byte per page of its own
+   * SplitRequestedRegion() piece, right after AllocateOutputs(), and the
+   * MultiThreader of the filter binds its threads to processors
+   * (MultiThreader::UseThreadAffinityOn()) so that the thread which
+   * computes a piece runs on the node holding its pages. The
+   * UseThreadAffinity setting of the MultiThreader is restored once the
+   * output is generated.
+   *
+   * Only Image and VectorImage outputs are placed; the pixel values are
+   * left unchanged. It is off by default. */
+  itkSetMacro(NUMAAwareAllocation, bool);
+  itkGetConstMacro(NUMAAwareAllocation, bool);
+  itkBooleanMacro(NUMAAwareAllocation);
+
 protected:
   ImageSource();
   virtual ~ImageSource() {}
+  void PrintSelf(std::ostream & os, Indent indent) const;
 
   /** A version of GenerateData() specific for image processing
    * filters.  This implementation will split the processing across
@@ -244,13 +298,52 @@ protected:
   void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                             ThreadIdType threadId) ITK_NO_RETURN;
 
+  /** If an imaging filter can process any number of pieces of its output
+   * per thread, it can provide an implementation of
+   * DynamicThreadedGenerateData() and turn DynamicMultiThreading on. The
+   * default GenerateData() then calls it once per piece of the requested
+   * region instead of calling ThreadedGenerateData() once per thread. A
+   * thread processes several pieces, so the method is called several
+   * times with the same threadId: the per-thread results must be
+   * accumulated across calls, not overwritten.
+   *
+   * \sa GenerateData(), SetDynamicMultiThreading() */
+  virtual
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForPiece,
+                                   ThreadIdType threadId) ITK_NO_RETURN;
+
+  /** Set whether the default GenerateData() schedules the pieces of the
+   * output dynamically through DynamicThreadedGenerateData(). Only the
+   * filters which implement DynamicThreadedGenerateData() may turn it
+   * on. */
+  itkSetMacro(DynamicMultiThreading, bool);
+  itkBooleanMacro(DynamicMultiThreading);
+
+  /** Set whether AllocateOutputs() may leave the pixels of the outputs
+   * unconstructed. Only the filters whose ThreadedGenerateData() writes
+   * every pixel of the output region it is given may turn it on, since
+   * the pixels of types such as RGBAPixel or SymmetricSecondRankTensor
+   * are otherwise left with arbitrary values instead of zero. */
+  itkSetMacro(AllocateOutputsUninitialized, bool);
+  itkBooleanMacro(AllocateOutputsUninitialized);
+
   /** The GenerateData method normally allocates the buffers for all of the
    * outputs of a filter. Some filters may want to override this default
    * behavior. For example, a filter may have multiple outputs with
    * varying resolution. Or a filter may want to process data in place by
-   * grafting its input to its output. */
+   * grafting its input to its output. The pixels of the outputs are
+   * constructed, unless AllocateOutputsUninitialized is on and their type
+   * allows it (see PixelAllocationTraits). */
   virtual void AllocateOutputs();
 
+  /** Number of bytes of the pixel buffers of the image outputs, reported
+   * to the profiler after each execution. */
+  virtual SizeValueType GetOutputsBufferSize() const;
+
+  /** Number of bytes of the requested regions of the image outputs, used
+   * to estimate the memory needed by a streamed piece. */
+  virtual SizeValueType GetOutputsRequestedRegionSize() const;
+
   /** If an imaging filter needs to perform processing after the buffer
    * has been allocated but before threads are spawned, the filter can
    * can provide an implementation for BeforeThreadedGenerateData(). The
@@ -293,9 +386,99 @@ protected:
   struct ThreadStruct {
     Pointer Filter;
   };
+
+  /** Static function used as a "callback" by the MultiThreader when
+   * DynamicMultiThreading is on. Each thread repeatedly takes a piece of
+   * the requested region, from its own share first and then from the
+   * other threads' shares, and passes it to DynamicThreadedGenerateData(). */
+  static ITK_THREAD_RETURN_TYPE DynamicThreaderCallback(void *arg);
+
+  /** Internal structure used for passing image data and the shares of
+   * pieces left to each thread into the threading library. */
+  struct DynamicThreadStruct {
+    Pointer Filter;
+    unsigned int NumberOfRequestedPieces;
+    std::vector< unsigned int > PieceBegin;
+    std::vector< unsigned int > PieceEnd;
+    SimpleFastMutexLock PieceLock;
+  };
+
+  /** Static function used as a "callback" by the MultiThreader when
+   * NUMAAwareAllocation is on. Each thread writes to the pages of the
+   * piece of the output that ThreaderCallback() would give it. */
+  static ITK_THREAD_RETURN_TYPE FirstTouchThreaderCallback(void *arg);
+
 private:
   ImageSource(const Self &);    //purposely not implemented
   void operator=(const Self &); //purposely not implemented
+
+  typedef ImageBase< OutputImageDimension > OutputImageBaseType;
+
+  /** Run BeforeThreadedGenerateData(), the threads and
+   * AfterThreadedGenerateData() for the default GenerateData(). */
+  void ThreadedGenerateOutputs();
+
+  /** Rewrite one byte of every memory page spanned by region in the
+   * buffer of image, leaving the pixel values unchanged. */
+  static void FirstTouchRegion(const OutputImageBaseType *image, char *buffer,
+                               SizeValueType bytesPerPixel,
+                               const OutputImageRegionType & region);
+
+  /** Allocate an output without constructing its pixels; Image and
+   * VectorImage outputs whose pixel type can be left unconstructed (see
+   * PixelAllocationTraits) are allocated with AllocateUninitialized(). */
+  template< class TPixel >
+  static void AllocateOutput(Image< TPixel, OutputImageDimension > *image);
+
+  template< class TPixel >
+  static void AllocateOutput(VectorImage< TPixel, OutputImageDimension > *image);
+
+  static void AllocateOutput(OutputImageBaseType *image)
+  { image->Allocate(); }
+
+  /** Dispatch FirstTouchRegion() on the output image type. Outputs that do
+   * not own a pixel buffer (LabelMap, ImageAdaptor, ...) are left alone. */
+  template< class TPixel >
+  static void FirstTouchOutput(Image< TPixel, OutputImageDimension > *image,
+                               const OutputImageRegionType & region);
+
+  template< class TPixel >
+  static void FirstTouchOutput(VectorImage< TPixel, OutputImageDimension > *image,
+                               const OutputImageRegionType & region);
+
+  static void FirstTouchOutput(const void *, const OutputImageRegionType &) {}
+
+  /** Size in bytes of the pixel buffer of an output; 0 for the outputs
+   * that do not own one. */
+  template< class TPixel >
+  static SizeValueType GetBufferSize(const Image< TPixel, OutputImageDimension > *image)
+  { return image->GetPixelContainer()->Capacity() * sizeof( TPixel ); }
+
+  template< class TPixel >
+  static SizeValueType GetBufferSize(const VectorImage< TPixel, OutputImageDimension > *image)
+  { return image->GetPixelContainer()->Capacity() * sizeof( TPixel ); }
+
+  static SizeValueType GetBufferSize(const void *) { return 0; }
+
+  /** Size in bytes of the requested region of an output; 0 for the
+   * outputs that are not images. */
+  template< class TPixel >
+  static SizeValueType GetRequestedRegionSize(const Image< TPixel, OutputImageDimension > *image)
+  { return image->GetRequestedRegion().GetNumberOfPixels() * sizeof( TPixel ); }
+
+  template< class TPixel >
+  static SizeValueType GetRequestedRegionSize(const VectorImage< TPixel, OutputImageDimension > *image)
+  {
+    return image->GetRequestedRegion().GetNumberOfPixels()
+           * image->GetNumberOfComponentsPerPixel() * sizeof( TPixel );
+  }
+
+  static SizeValueType GetRequestedRegionSize(const void *) { return 0; }
+
+  bool         m_DynamicMultiThreading;
+  unsigned int m_NumberOfPiecesPerThread;
+  bool         m_NUMAAwareAllocation;
+  bool         m_AllocateOutputsUninitialized;
 };
 } // end namespace itk
 
@@ -51,6 +51,11 @@ ImageSource< TOutputImage >
   // output bulk data prior to GenerateData() in case that bulk data
   // can be reused (an thus avoid a costly deallocate/allocate cycle).
   this->ReleaseDataBeforeUpdateFlagOff();
+
+  m_DynamicMultiThreading = false;
+  m_NumberOfPiecesPerThread = 8;
+  m_NUMAAwareAllocation = false;
+  m_AllocateOutputsUninitialized = false;
 }
 
 /**
@@ -220,9 +225,93 @@ ImageSource< TOutputImage >
     if ( outputPtr )
       {
       outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
-      outputPtr->Allocate();
+
+      // A filter which writes every pixel of its outputs may leave them
+      // unconstructed.
+      TOutputImage *output = m_AllocateOutputsUninitialized
+                             ? dynamic_cast< TOutputImage * >( outputPtr.GetPointer() ) : NULL;
+      if ( output )
+        {
+        AllocateOutput(output);
+        }
+      else
+        {
+        outputPtr->Allocate();
+        }
+      }
+    }
+}
+
+template< class TOutputImage >
+template< class TPixel >
+void
+ImageSource< TOutputImage >
+::AllocateOutput(Image< TPixel, OutputImageDimension > *image)
+{
+  if ( PixelAllocationTraits< TPixel >::CanBeUninitialized )
+    {
+    image->AllocateUninitialized();
+    }
+  else
+    {
+    image->Allocate();
+    }
+}
+
+template< class TOutputImage >
+template< class TPixel >
+void
+ImageSource< TOutputImage >
+::AllocateOutput(VectorImage< TPixel, OutputImageDimension > *image)
+{
+  if ( PixelAllocationTraits< TPixel >::CanBeUninitialized )
+    {
+    image->AllocateUninitialized();
+    }
+  else
+    {
+    image->Allocate();
+    }
+}
+
+//----------------------------------------------------------------------------
+template< class TOutputImage >
+SizeValueType
+ImageSource< TOutputImage >
+::GetOutputsBufferSize() const
+{
+  SizeValueType size = 0;
+
+  for ( unsigned int idx = 0; idx < this->GetNumberOfOutputs(); ++idx )
+    {
+    const TOutputImage *output =
+      dynamic_cast< const TOutputImage * >( this->ProcessObject::GetOutput(idx) );
+    if ( output )
+      {
+      size += GetBufferSize(output);
       }
     }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+template< class TOutputImage >
+SizeValueType
+ImageSource< TOutputImage >
+::GetOutputsRequestedRegionSize() const
+{
+  SizeValueType size = 0;
+
+  for ( unsigned int idx = 0; idx < this->GetNumberOfOutputs(); ++idx )
+    {
+    const TOutputImage *output =
+      dynamic_cast< const TOutputImage * >( this->ProcessObject::GetOutput(idx) );
+    if ( output )
+      {
+      size += GetRequestedRegionSize(output);
+      }
+    }
+  return size;
 }
 
 //----------------------------------------------------------------------------
@@ -235,20 +324,93 @@ ImageSource< TOutputImage >
   // memory for the filter's outputs
   this->AllocateOutputs();
 
+  // Place the pages of the output on the nodes of the threads that will
+  // compute them, before anything else writes to the buffer. The threads
+  // stay bound to their processors until the output is generated; the
+  // setting of the threader is restored afterwards.
+  const bool useThreadAffinity = this->GetMultiThreader()->GetUseThreadAffinity();
+  if ( m_NUMAAwareAllocation )
+    {
+    ThreadStruct str;
+    str.Filter = this;
+
+    this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+    this->GetMultiThreader()->UseThreadAffinityOn();
+    this->GetMultiThreader()->SetSingleMethod(this->FirstTouchThreaderCallback, &str);
+    try
+      {
+      this->GetMultiThreader()->SingleMethodExecute();
+      }
+    catch ( ... )
+      {
+      this->GetMultiThreader()->SetUseThreadAffinity(useThreadAffinity);
+      throw;
+      }
+    }
+
+  try
+    {
+    this->ThreadedGenerateOutputs();
+    }
+  catch ( ... )
+    {
+    this->GetMultiThreader()->SetUseThreadAffinity(useThreadAffinity);
+    throw;
+    }
+  this->GetMultiThreader()->SetUseThreadAffinity(useThreadAffinity);
+}
+
+//----------------------------------------------------------------------------
+template< class TOutputImage >
+void
+ImageSource< TOutputImage >
+::ThreadedGenerateOutputs()
+{
   // Call a method that can be overridden by a subclass to perform
   // some calculations prior to splitting the main computations into
   // separate threads
   this->BeforeThreadedGenerateData();
 
   // Set up the multithreaded processing
-  ThreadStruct str;
-  str.Filter = this;
-
   this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
-  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
 
-  // multithread the execution
-  this->GetMultiThreader()->SingleMethodExecute();
+  if ( m_DynamicMultiThreading )
+    {
+    DynamicThreadStruct str;
+    str.Filter = this;
+
+    // Find out how many pieces the requested region can be split into,
+    // and give each thread an initial contiguous share of them
+    const ThreadIdType numberOfThreads = this->GetMultiThreader()->GetNumberOfThreads();
+    str.NumberOfRequestedPieces = numberOfThreads * m_NumberOfPiecesPerThread;
+
+    OutputImageRegionType splitRegion;
+    const unsigned int    numberOfPieces =
+      this->SplitRequestedRegion(0, str.NumberOfRequestedPieces, splitRegion);
+
+    str.PieceBegin.resize(numberOfThreads);
+    str.PieceEnd.resize(numberOfThreads);
+    for ( ThreadIdType t = 0; t < numberOfThreads; t++ )
+      {
+      str.PieceBegin[t] = ( t * numberOfPieces ) / numberOfThreads;
+      str.PieceEnd[t] = ( ( t + 1 ) * numberOfPieces ) / numberOfThreads;
+      }
+
+    this->GetMultiThreader()->SetSingleMethod(this->DynamicThreaderCallback, &str);
+
+    // multithread the execution
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+  else
+    {
+    ThreadStruct str;
+    str.Filter = this;
+
+    this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
+
+    // multithread the execution
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
 
   // Call a method that can be overridden by a subclass to perform
   // some calculations after all the threads have completed
@@ -277,6 +439,27 @@ ImageSource< TOutputImage >
   throw e_;
 }
 
+//----------------------------------------------------------------------------
+// The execute method created by the subclasses which schedule their pieces
+// dynamically.
+template< class TOutputImage >
+void
+ImageSource< TOutputImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType &,
+                              ThreadIdType)
+{
+// The ExceptionMacro is not used because gcc warns that a
+// 'noreturn' function does return
+  std::ostringstream message;
+
+  message << "itk::ERROR: " << this->GetNameOfClass()
+          << "(" << this << "): " << "Subclass should override this method!!!" << std::endl
+          << this->GetNameOfClass() << " turns DynamicMultiThreading on but does not "
+          << "implement DynamicThreadedGenerateData().";
+  ExceptionObject e_(__FILE__, __LINE__, message.str().c_str(), ITK_LOCATION);
+  throw e_;
+}
+
 // Callback routine used by the threading library. This routine just calls
 // the ThreadedGenerateData method after setting the correct region for this
 // thread.
@@ -301,7 +484,18 @@ ImageSource< TOutputImage >
 
   if ( threadId < total )
     {
-    str->Filter->ThreadedGenerateData(splitRegion, threadId);
+    const PipelineProfiler::Pointer profiler = str->Filter->GetActiveProfiler();
+    if ( profiler )
+      {
+      const PipelineProfiler::TimeStampType startTime = profiler->GetTime();
+      str->Filter->ThreadedGenerateData(splitRegion, threadId);
+      profiler->RecordThread( str->Filter, threadId, profiler->GetTime() - startTime,
+                              splitRegion.GetNumberOfPixels() );
+      }
+    else
+      {
+      str->Filter->ThreadedGenerateData(splitRegion, threadId);
+      }
     }
   // else
   //   {
@@ -312,6 +506,204 @@ ImageSource< TOutputImage >
 
   return ITK_THREAD_RETURN_VALUE;
 }
+
+// Callback routine used by the threading library when the pieces of the
+// output are scheduled dynamically. Every thread consumes its own share of
+// pieces from the front, then steals from the back of the largest share
+// left so that the pieces stolen are the ones furthest from their owner.
+template< class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+ImageSource< TOutputImage >
+::DynamicThreaderCallback(void *arg)
+{
+  const ThreadIdType threadId = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->ThreadID;
+
+  DynamicThreadStruct *str =
+    (DynamicThreadStruct *)( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
+
+  const ThreadIdType numberOfShares = static_cast< ThreadIdType >( str->PieceBegin.size() );
+
+  const PipelineProfiler::Pointer profiler = str->Filter->GetActiveProfiler();
+  PipelineProfiler::TimeStampType time = 0;
+  SizeValueType                   numberOfPixels = 0;
+
+  typename TOutputImage::RegionType splitRegion;
+  while ( true )
+    {
+    unsigned int piece;
+
+    str->PieceLock.Lock();
+    if ( threadId < numberOfShares && str->PieceBegin[threadId] < str->PieceEnd[threadId] )
+      {
+      piece = str->PieceBegin[threadId]++;
+      }
+    else
+      {
+      ThreadIdType victim = numberOfShares;
+      unsigned int largestShare = 0;
+      for ( ThreadIdType t = 0; t < numberOfShares; t++ )
+        {
+        const unsigned int share = str->PieceEnd[t] - str->PieceBegin[t];
+        if ( share > largestShare )
+          {
+          largestShare = share;
+          victim = t;
+          }
+        }
+      if ( victim == numberOfShares )
+        {
+        // all the pieces have been handed out
+        str->PieceLock.Unlock();
+        break;
+        }
+      piece = --str->PieceEnd[victim];
+      }
+    str->PieceLock.Unlock();
+
+    str->Filter->SplitRequestedRegion(piece, str->NumberOfRequestedPieces,
+                                      splitRegion);
+    if ( profiler )
+      {
+      const PipelineProfiler::TimeStampType startTime = profiler->GetTime();
+      str->Filter->DynamicThreadedGenerateData(splitRegion, threadId);
+      time += profiler->GetTime() - startTime;
+      numberOfPixels += splitRegion.GetNumberOfPixels();
+      }
+    else
+      {
+      str->Filter->DynamicThreadedGenerateData(splitRegion, threadId);
+      }
+    }
+
+  if ( profiler && numberOfPixels > 0 )
+    {
+    profiler->RecordThread(str->Filter, threadId, time, numberOfPixels);
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+// Callback routine used by the threading library to place the pages of
+// the output. Each thread touches the region ThreaderCallback() gives it.
+template< class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+ImageSource< TOutputImage >
+::FirstTouchThreaderCallback(void *arg)
+{
+  const ThreadIdType threadId = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->ThreadID;
+  const ThreadIdType threadCount = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->NumberOfThreads;
+
+  ThreadStruct *str = (ThreadStruct *)( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
+
+  typename TOutputImage::RegionType splitRegion;
+  const ThreadIdType total = str->Filter->SplitRequestedRegion(threadId, threadCount,
+                                                               splitRegion);
+
+  TOutputImage *output = str->Filter->GetOutput();
+  if ( threadId < total && splitRegion.Crop( output->GetBufferedRegion() ) )
+    {
+    FirstTouchOutput(output, splitRegion);
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< class TOutputImage >
+template< class TPixel >
+void
+ImageSource< TOutputImage >
+::FirstTouchOutput(Image< TPixel, OutputImageDimension > *image,
+                   const OutputImageRegionType & region)
+{
+  if ( image->GetBufferPointer() )
+    {
+    FirstTouchRegion( image, reinterpret_cast< char * >( image->GetBufferPointer() ),
+                      sizeof( TPixel ), region );
+    }
+}
+
+template< class TOutputImage >
+template< class TPixel >
+void
+ImageSource< TOutputImage >
+::FirstTouchOutput(VectorImage< TPixel, OutputImageDimension > *image,
+                   const OutputImageRegionType & region)
+{
+  if ( image->GetBufferPointer() )
+    {
+    FirstTouchRegion( image, reinterpret_cast< char * >( image->GetBufferPointer() ),
+                      image->GetVectorLength() * sizeof( TPixel ), region );
+    }
+}
+
+template< class TOutputImage >
+void
+ImageSource< TOutputImage >
+::FirstTouchRegion(const OutputImageBaseType *image, char *buffer,
+                   SizeValueType bytesPerPixel,
+                   const OutputImageRegionType & region)
+{
+  // Smallest page size of the supported platforms. Touching more often
+  // than needed is harmless.
+  const size_t pageSize = 4096;
+
+  if ( region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  // Lines along the first axis are contiguous in memory. The lines of two
+  // different regions never overlap, so no byte is written by two threads.
+  const size_t lineLength = region.GetSize(0) * bytesPerPixel;
+
+  typename OutputImageRegionType::IndexType index = region.GetIndex();
+  while ( true )
+    {
+    volatile char *line = buffer + image->ComputeOffset(index) * bytesPerPixel;
+
+    // rewrite the first byte of the line and of every page starting in it
+    line[0] = line[0];
+    for ( size_t offset = pageSize - reinterpret_cast< size_t >( line ) % pageSize;
+          offset < lineLength;
+          offset += pageSize )
+      {
+      line[offset] = line[offset];
+      }
+
+    // move to the next line
+    unsigned int dim = 1;
+    for (; dim < OutputImageDimension; dim++ )
+      {
+      if ( ++index[dim] < region.GetIndex(dim)
+           + static_cast< IndexValueType >( region.GetSize(dim) ) )
+        {
+        break;
+        }
+      index[dim] = region.GetIndex(dim);
+      }
+    if ( dim == OutputImageDimension )
+      {
+      break;
+      }
+    }
+}
+
+template< class TOutputImage >
+void
+ImageSource< TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "DynamicMultiThreading: "
+     << ( m_DynamicMultiThreading ? "On" : "Off" ) << std::endl;
+  os << indent << "NumberOfPiecesPerThread: "
+     << m_NumberOfPiecesPerThread << std::endl;
+  os << indent << "NUMAAwareAllocation: "
+     << ( m_NUMAAwareAllocation ? "On" : "Off" ) << std::endl;
+  os << indent << "AllocateOutputsUninitialized: "
+     << ( m_AllocateOutputsUninitialized ? "On" : "Off" ) << std::endl;
+}
 } // end namespace itk
 
 #endif
@@ -20,6 +20,7 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferAllocator.h"
 #include <utility>
 
 namespace itk
@@ -36,6 +37,10 @@ namespace itk
  *
  * \tparam TElement The element type stored in the container.
  *
+ * The memory managed by the container is obtained with new[], or from its
+ * ImageBufferAllocator when one is set (see SetAllocator()). New
+ * containers use ImageBufferAllocator::GetGlobalDefault().
+ *
  * \ingroup ImageObjects
  * \ingroup IOFilters
  * \ingroup ITKCommon
@@ -108,6 +113,24 @@ public:
    * \sa SetImportPointer() */
   void Reserve(ElementIdentifier num);
 
+  /** Same as Reserve(), except that the elements of a newly allocated
+   * buffer are not constructed: no constructor runs and their content is
+   * undefined until they are written. The destructors of such elements
+   * are not run either. This saves a pass over the memory for element
+   * types whose default constructor initializes them (RGBAPixel,
+   * SymmetricSecondRankTensor, ...) when every element is about to be
+   * overwritten. It must only be used with element types that do not own
+   * resources: it is not suitable for VariableLengthVector, std::vector
+   * and the like. */
+  void ReserveUninitialized(ElementIdentifier num);
+
+  /** Resize the container to num elements, all equal to value. The
+   * elements of a newly allocated buffer are copy constructed from value
+   * in raw memory, so each of them is written only once; a buffer that is
+   * large enough is reused and assigned. This is safe for every element
+   * type. The previous content is discarded. */
+  void ReserveAndFill(ElementIdentifier num, const TElement & value);
+
   /** Tell the container to try to minimize its memory usage for
    * storage of the current number of elements.  If new memory is
    * allocated, the contents of old buffer are copied to the new area.
@@ -131,6 +154,14 @@ public:
   itkSetMacro(ContainerManageMemory, bool);
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
+
+  /** Set/Get the allocator used for the memory allocated from now on by
+   * the container. When it is NULL, new[] is used. The current buffer is
+   * always released by the allocator it was obtained from. */
+  itkSetObjectMacro(Allocator, ImageBufferAllocator);
+  itkGetObjectMacro(Allocator, ImageBufferAllocator);
+  itkGetConstObjectMacro(Allocator, ImageBufferAllocator);
+
 protected:
   ImportImageContainer();
   virtual ~ImportImageContainer();
@@ -142,6 +173,11 @@ protected:
 
   virtual TElement * AllocateElements(ElementIdentifier size) const;
 
+  /** Allocate the memory of size elements without constructing them.
+   * Subclasses that override AllocateElements() and
+   * DeallocateManagedMemory() must override this method as well. */
+  virtual TElement * AllocateUninitializedElements(ElementIdentifier size) const;
+
   virtual void DeallocateManagedMemory();
 
   /* Set the m_Size member that represents the number of elements
@@ -169,10 +205,26 @@ private:
   ImportImageContainer(const Self &); //purposely not implemented
   void operator=(const Self &);       //purposely not implemented
 
+  /** Implementation of Reserve() and ReserveUninitialized(). */
+  void ReserveElements(ElementIdentifier size, bool constructElements);
+
   TElement *         m_ImportPointer;
   TElementIdentifier m_Size;
   TElementIdentifier m_Capacity;
   bool               m_ContainerManageMemory;
+
+  ImageBufferAllocator::Pointer m_Allocator;
+
+  /** Allocator the current buffer was obtained from, if any. */
+  ImageBufferAllocator::Pointer m_ImportPointerAllocator;
+
+  /** Whether the elements of the current buffer were constructed. */
+  bool m_ImportPointerConstructed;
+
+  /** Whether the current buffer comes from new[] and is released by
+   * delete[]. Otherwise its elements are destroyed one by one (if they
+   * were constructed) before the raw memory is released. */
+  bool m_ImportPointerFromNewArray;
 };
 } // end namespace itk
 
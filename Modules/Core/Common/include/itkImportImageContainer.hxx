@@ -29,7 +29,9 @@
 #define __itkImportImageContainer_hxx
 
 #include "itkImportImageContainer.h"
+#include <algorithm>
 #include <cstring>
+#include <new>
 #include <stdlib.h>
 #include <string.h>
 
@@ -43,6 +45,9 @@ ImportImageContainer< TElementIdentifier, TElement >
   m_ContainerManageMemory = true;
   m_Capacity = 0;
   m_Size = 0;
+  m_ImportPointerConstructed = true;
+  m_ImportPointerFromNewArray = true;
+  m_Allocator = ImageBufferAllocator::GetGlobalDefault();
 }
 
 template< typename TElementIdentifier, typename TElement >
@@ -60,6 +65,22 @@ template< typename TElementIdentifier, typename TElement >
 void
 ImportImageContainer< TElementIdentifier, TElement >
 ::Reserve(ElementIdentifier size)
+{
+  this->ReserveElements(size, true);
+}
+
+template< typename TElementIdentifier, typename TElement >
+void
+ImportImageContainer< TElementIdentifier, TElement >
+::ReserveUninitialized(ElementIdentifier size)
+{
+  this->ReserveElements(size, false);
+}
+
+template< typename TElementIdentifier, typename TElement >
+void
+ImportImageContainer< TElementIdentifier, TElement >
+::ReserveElements(ElementIdentifier size, bool constructElements)
 {
   // Reserve has a Resize semantics. We keep it that way for
   // backwards compatibility .
@@ -68,13 +89,17 @@ ImportImageContainer< TElementIdentifier, TElement >
     {
     if ( size > m_Capacity )
       {
-      TElement *temp = this->AllocateElements(size);
+      TElement *temp = constructElements ? this->AllocateElements(size)
+                       : this->AllocateUninitializedElements(size);
       // only copy the portion of the data used in the old buffer
       memcpy( temp, m_ImportPointer, m_Size * sizeof( TElement ) );
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerAllocator = m_Allocator;
+      m_ImportPointerConstructed = constructElements;
+      m_ImportPointerFromNewArray = constructElements && !m_Allocator;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -88,7 +113,11 @@ ImportImageContainer< TElementIdentifier, TElement >
     }
   else
     {
-    m_ImportPointer = this->AllocateElements(size);
+    m_ImportPointer = constructElements ? this->AllocateElements(size)
+                      : this->AllocateUninitializedElements(size);
+    m_ImportPointerAllocator = m_Allocator;
+    m_ImportPointerConstructed = constructElements;
+    m_ImportPointerFromNewArray = constructElements && !m_Allocator;
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -96,6 +125,62 @@ ImportImageContainer< TElementIdentifier, TElement >
     }
 }
 
+template< typename TElementIdentifier, typename TElement >
+void
+ImportImageContainer< TElementIdentifier, TElement >
+::ReserveAndFill(ElementIdentifier size, const TElement & value)
+{
+  if ( m_ImportPointer && size <= m_Capacity )
+    {
+    // the buffer is reused: its elements already exist
+    m_Size = size;
+    std::fill(m_ImportPointer, m_ImportPointer + size, value);
+    this->Modified();
+    return;
+    }
+
+  // The previous content is not needed, release it before allocating so
+  // that both buffers are never held at once.
+  DeallocateManagedMemory();
+
+  // The elements are copy constructed in raw memory, so that each of them
+  // is written once whatever its type.
+  TElement *        data = this->AllocateUninitializedElements(size);
+  ElementIdentifier i = 0;
+  try
+    {
+    for (; i < size; i++ )
+      {
+      new ( data + i ) TElement(value);
+      }
+    }
+  catch ( ... )
+    {
+    while ( i > 0 )
+      {
+      data[--i].~TElement();
+      }
+    if ( m_Allocator )
+      {
+      m_Allocator->Deallocate( data, size * sizeof( TElement ) );
+      }
+    else
+      {
+      ::operator delete(data);
+      }
+    throw;
+    }
+
+  m_ImportPointer = data;
+  m_ImportPointerAllocator = m_Allocator;
+  m_ImportPointerConstructed = true;
+  m_ImportPointerFromNewArray = false;
+  m_Capacity = size;
+  m_Size = size;
+  m_ContainerManageMemory = true;
+  this->Modified();
+}
+
 /**
  * Tell the container to try to minimize its memory usage for storage of
  * the current number of elements.
@@ -116,6 +201,9 @@ ImportImageContainer< TElementIdentifier, TElement >
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerAllocator = m_Allocator;
+      m_ImportPointerConstructed = true;
+      m_ImportPointerFromNewArray = !m_Allocator;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -176,6 +264,16 @@ TElement *ImportImageContainer< TElementIdentifier, TElement >
   // does not do this by default.
   TElement *data;
 
+  if ( m_Allocator )
+    {
+    data = this->AllocateUninitializedElements(size);
+    for ( ElementIdentifier i = 0; i < size; i++ )
+      {
+      new ( data + i ) TElement;
+      }
+    return data;
+    }
+
   try
     {
     data = new TElement[size];
@@ -195,6 +293,36 @@ TElement *ImportImageContainer< TElementIdentifier, TElement >
   return data;
 }
 
+template< typename TElementIdentifier, typename TElement >
+TElement *ImportImageContainer< TElementIdentifier, TElement >
+::AllocateUninitializedElements(ElementIdentifier size) const
+{
+  if ( m_Allocator )
+    {
+    // The allocator throws a MemoryAllocationError itself
+    return static_cast< TElement * >( m_Allocator->Allocate( size * sizeof( TElement ) ) );
+    }
+
+  void *data;
+  try
+    {
+    data = ::operator new( size * sizeof( TElement ) );
+    }
+  catch ( ... )
+    {
+    data = 0;
+    }
+  if ( !data )
+    {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__,
+                                "Failed to allocate memory for image.",
+                                ITK_LOCATION);
+    }
+  return static_cast< TElement * >( data );
+}
+
 template< typename TElementIdentifier, typename TElement >
 void ImportImageContainer< TElementIdentifier, TElement >
 ::DeallocateManagedMemory()
@@ -202,8 +330,32 @@ void ImportImageContainer< TElementIdentifier, TElement >
   // Encapsulate all image memory deallocation here
   if ( m_ImportPointer && m_ContainerManageMemory )
     {
-    delete[] m_ImportPointer;
+    if ( m_ImportPointerFromNewArray )
+      {
+      delete[] m_ImportPointer;
+      }
+    else
+      {
+      if ( m_ImportPointerConstructed )
+        {
+        for ( TElementIdentifier i = 0; i < m_Capacity; i++ )
+          {
+          m_ImportPointer[i].~TElement();
+          }
+        }
+      if ( m_ImportPointerAllocator )
+        {
+        m_ImportPointerAllocator->Deallocate( m_ImportPointer, m_Capacity * sizeof( TElement ) );
+        }
+      else
+        {
+        ::operator delete(m_ImportPointer);
+        }
+      }
     }
+  m_ImportPointerAllocator = 0;
+  m_ImportPointerConstructed = true;
+  m_ImportPointerFromNewArray = true;
   m_ImportPointer = 0;
   m_Capacity = 0;
   m_Size = 0;
@@ -221,6 +373,7 @@ ImportImageContainer< TElementIdentifier, TElement >
      << ( m_ContainerManageMemory ? "true" : "false" ) << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  os << indent << "Allocator: " << m_Allocator.GetPointer() << std::endl;
 }
 } // end namespace itk
 
@@ -30,8 +30,12 @@
 
 #include "itkMutexLock.h"
 #include "itkThreadSupport.h"
+#include "itkThreadPool.h"
 #include "itkIntTypes.h"
 
+#include <deque>
+#include <vector>
+
 namespace itk
 {
 /** \class MultiThreader
@@ -47,6 +51,20 @@ namespace itk
  * If ITK_USE_PTHREADS is defined, then
  * pthread_create() will be used to create multiple threads (on
  * a sun, for example).
+ *
+ * When UseThreadPool is on, SingleMethodExecute() runs the SingleMethod on
+ * the persistent workers of the process-wide ThreadPool instead of
+ * creating and joining new threads on every call. The default is taken
+ * from GetGlobalDefaultUseThreadPool(), which can be initialized with the
+ * ITK_USE_THREADPOOL environment variable.
+ *
+ * When UseThreadAffinity is on, every thread other than the calling one
+ * binds itself, for the duration of the SingleMethod, to one of the
+ * processors the process is allowed to run on, chosen from its ThreadID.
+ * A given ThreadID therefore always runs on the same core (and NUMA node),
+ * which lets memory first-touched by a thread stay local to it across
+ * executions. Thread affinity is only supported on Linux and Windows and
+ * is ignored elsewhere.
  * \ingroup ITKCommon
  */
 
@@ -73,10 +91,11 @@ public:
   itkGetConstMacro(NumberOfThreads, ThreadIdType);
 
   /** Set/Get the maximum number of threads to use when multithreading.  It
-   * will be clamped to the range [ 1, ITK_MAX_THREADS ] because several arrays
-   * are already statically allocated using the ITK_MAX_THREADS number.
-   * Therefore the caller of this method should check that the requested number
-   * of threads was accepted. */
+   * will be clamped to the range [ 1, ITK_MAX_THREADS ]. ITK_MAX_THREADS is
+   * only a sanity ceiling: the per-thread storage is allocated for the
+   * number of threads actually used by each execution. Therefore the caller
+   * of this method should check that the requested number of threads was
+   * accepted. */
   static void SetGlobalMaximumNumberOfThreads(ThreadIdType val);
 
   static ThreadIdType  GetGlobalMaximumNumberOfThreads();
@@ -89,6 +108,32 @@ public:
 
   static ThreadIdType  GetGlobalDefaultNumberOfThreads();
 
+  /** Set/Get whether SingleMethodExecute() dispatches onto the
+   * process-wide ThreadPool rather than spawning new threads. */
+  itkSetMacro(UseThreadPool, bool);
+  itkGetConstMacro(UseThreadPool, bool);
+  itkBooleanMacro(UseThreadPool);
+
+  /** Set/Get the value which is used to initialize UseThreadPool in the
+   * constructor. If it has not been set explicitly, it is initialized from
+   * the ITK_USE_THREADPOOL environment variable ("ON"/"1" enables the
+   * pool), and is off otherwise. */
+  static void SetGlobalDefaultUseThreadPool(bool useThreadPool);
+
+  static bool GetGlobalDefaultUseThreadPool();
+
+  /** Set/Get whether the threads run by SingleMethodExecute() are bound to
+   * a processor chosen from their ThreadID. */
+  itkSetMacro(UseThreadAffinity, bool);
+  itkGetConstMacro(UseThreadAffinity, bool);
+  itkBooleanMacro(UseThreadAffinity);
+
+  /** Set/Get the value which is used to initialize UseThreadAffinity in the
+   * constructor. Off by default. */
+  static void SetGlobalDefaultUseThreadAffinity(bool useThreadAffinity);
+
+  static bool GetGlobalDefaultUseThreadAffinity();
+
   /** Execute the SingleMethod (as define by SetSingleMethod) using
    * m_NumberOfThreads threads. As a side effect the m_NumberOfThreads will be
    * checked against the current m_GlobalMaximumNumberOfThreads and clamped if
@@ -113,7 +158,7 @@ public:
   void SetMultipleMethod(ThreadIdType index, ThreadFunctionType, void *data);
 
   /** Create a new thread for the given function. Return a thread id
-     * which is a number between 0 and ITK_MAX_THREADS - 1. This
+   * which is a number between 0 and ITK_MAX_THREADS - 1. This
    * id should be used to kill the thread at a later time. */
   // FIXME: Doesn't seem to be called anywhere...
   int SpawnThread(ThreadFunctionType, void *data);
@@ -154,24 +199,35 @@ private:
   void operator=(const Self &); //purposely not implemented
 
   /** An array of thread info containing a thread id
-   *  (0, 1, 2, .. ITK_MAX_THREADS-1), the thread count, and a pointer
-   *  to void so that user data can be passed to each thread. */
-  ThreadInfoStruct m_ThreadInfoArray[ITK_MAX_THREADS];
+   *  (0, 1, 2, .. NumberOfThreads-1), the thread count, and a pointer
+   *  to void so that user data can be passed to each thread. It is resized
+   *  to m_NumberOfThreads at the start of every execution. */
+  std::vector< ThreadInfoStruct > m_ThreadInfoArray;
 
   /** The methods to invoke. */
-  ThreadFunctionType m_SingleMethod;
-  ThreadFunctionType m_MultipleMethod[ITK_MAX_THREADS];
+  ThreadFunctionType                m_SingleMethod;
+  std::vector< ThreadFunctionType > m_MultipleMethod;
 
   /** Storage of MutexFunctions and ints used to control spawned
-   *  threads and the spawned thread ids. */
-  int                 m_SpawnedThreadActiveFlag[ITK_MAX_THREADS];
-  MutexLock::Pointer  m_SpawnedThreadActiveFlagLock[ITK_MAX_THREADS];
-  ThreadProcessIDType m_SpawnedThreadProcessID[ITK_MAX_THREADS];
-  ThreadInfoStruct    m_SpawnedThreadInfoArray[ITK_MAX_THREADS];
+   *  threads and the spawned thread ids. These grow by one entry whenever
+   *  all the existing ids are in use; a deque is used because the running
+   *  threads hold pointers to their entries. */
+  std::deque< int >                 m_SpawnedThreadActiveFlag;
+  std::deque< MutexLock::Pointer >  m_SpawnedThreadActiveFlagLock;
+  std::deque< ThreadProcessIDType > m_SpawnedThreadProcessID;
+  std::deque< ThreadInfoStruct >    m_SpawnedThreadInfoArray;
 
   /** Internal storage of the data. */
-  void *m_SingleData;
-  void *m_MultipleData[ITK_MAX_THREADS];
+  void *                m_SingleData;
+  std::vector< void * > m_MultipleData;
+
+  /** Resize m_ThreadInfoArray to m_NumberOfThreads and initialize the
+   *  thread ids of its entries. */
+  void InitializeThreadInfoArray();
+
+  /** Return the index of an unused entry of the spawned thread storage,
+   *  adding one if all of them are in use, and mark it as active. */
+  int AllocateSpawnedThreadId();
 
   /** Global variable defining the maximum number of threads that can be used.
    *  The m_GlobalMaximumNumberOfThreads must always be less than or equal to
@@ -186,6 +242,14 @@ private:
    */
   static ThreadIdType m_GlobalDefaultNumberOfThreads;
 
+  /** Global variable defining the default value of m_UseThreadPool, and
+   *  whether it has been initialized yet. */
+  static bool m_GlobalDefaultUseThreadPool;
+  static bool m_GlobalDefaultUseThreadPoolIsInitialized;
+
+  /** Global variable defining the default value of m_UseThreadAffinity. */
+  static bool m_GlobalDefaultUseThreadAffinity;
+
   /**  Platform specific number of threads */
   static ThreadIdType  GetGlobalDefaultNumberOfThreadsByPlatform();
 
@@ -200,6 +264,12 @@ private:
    */
   ThreadIdType m_NumberOfThreads;
 
+  /** Whether SingleMethodExecute() uses the process-wide ThreadPool. */
+  bool m_UseThreadPool;
+
+  /** Whether SingleMethodExecute() binds its threads to processors. */
+  bool m_UseThreadAffinity;
+
   /** Static function used as a "proxy callback" by the MultiThreader.  The
    * threading library will call this routine for each thread, which
    * will delegate the control to the prescribed SingleMethod. This
@@ -208,13 +278,21 @@ private:
    * exceptions thrown by the threads. */
   static ITK_THREAD_RETURN_TYPE SingleMethodProxy(void *arg);
 
+  /** Same as SingleMethodProxy, but binds the running thread to the
+   * processor assigned to its ThreadID while the SingleMethod runs, and
+   * restores the previous affinity afterwards so that pooled threads are
+   * not left bound. */
+  static ITK_THREAD_RETURN_TYPE SingleMethodProxyWithAffinity(void *arg);
+
   /** Spawn a thread for the prescribed SingleMethod.  This routine
    * spawns a thread to the SingleMethodProxy which runs the
-   * prescribed SingleMethod.  The SingleMethodProxy allows for
+   * prescribed SingleMethod (or to the given proxy, which must
+   * be one of the proxies above).  The SingleMethodProxy allows for
    * exceptions within a thread to be naively handled. A similar
    * abstraction needs to be added for MultipleMethod and
    * SpawnThread. */
-  ThreadProcessIDType DispatchSingleMethodThread(ThreadInfoStruct *);
+  ThreadProcessIDType DispatchSingleMethodThread(ThreadInfoStruct *,
+                                                 ThreadFunctionType proxy);
 
   /** Wait for a thread running the prescribed SingleMethod. A similar
    * abstraction needs to be added for MultipleMethod (SpawnThread
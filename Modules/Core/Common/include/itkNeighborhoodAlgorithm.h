@@ -19,9 +19,11 @@
 #define __itkNeighborhoodAlgorithm_h
 
 #include <list>
+#include <vector>
 #include "itkImage.h"
 #include "itkNeighborhoodOperator.h"
 #include "itkNeighborhoodIterator.h"
+#include "itkProgressReporter.h"
 
 namespace itk
 {
@@ -85,6 +87,116 @@ struct ITK_EXPORT CalculateOutputWrapOffsetModifiers {
   typedef Offset< ::itk::GetImageDimension< TImage >::ImageDimension > OffsetType;
   OffsetType operator()(TImage *, TImage *) const;
 };
+
+/** \class ConstInteriorNeighborhood
+ *  \brief Read-only neighborhood of a pixel whose whole neighborhood lies
+ *          in the buffered region of the image.
+ *
+ * The neighbors are read at fixed offsets from a pointer to the center
+ * pixel, without any bounds checking. ConstNeighborhoodIterator instead
+ * checks at each access whether the boundary condition is needed, and
+ * moves one pointer per neighbor at each step. ConstInteriorNeighborhood
+ * has the part of the ConstNeighborhoodIterator interface used to compute
+ * a value from a neighborhood (GetPixel(), GetCenterPixel(), Size(),
+ * GetStride()), so the same function template can be applied to both.
+ *
+ * It must only be moved to the locations of GetInteriorRegion(), the
+ * buffered region shrunk by the radius.
+ *
+ * \sa ApplyNeighborhoodKernel
+ * \ingroup ITKCommon
+ */
+template< class TImage >
+class ITK_EXPORT ConstInteriorNeighborhood
+{
+public:
+  typedef ConstInteriorNeighborhood                                       Self;
+  typedef TImage                                                          ImageType;
+  typedef typename TImage::PixelType                                      PixelType;
+  typedef typename TImage::InternalPixelType                              InternalPixelType;
+  typedef typename TImage::IndexType                                      IndexType;
+  typedef typename TImage::RegionType                                     RegionType;
+  typedef typename TImage::NeighborhoodAccessorFunctorType                NeighborhoodAccessorFunctorType;
+  typedef typename ConstNeighborhoodIterator< TImage >::RadiusType        RadiusType;
+  typedef typename ConstNeighborhoodIterator< TImage >::NeighborIndexType NeighborIndexType;
+  itkStaticConstMacro(Dimension, unsigned int, TImage::ImageDimension);
+
+  ConstInteriorNeighborhood(const ImageType *image, const RadiusType & radius);
+
+  /** Moves the center of the neighborhood to index. */
+  void SetLocation(const IndexType & index)
+  { m_Center = m_Buffer + m_Image->ComputeOffset(index); }
+
+  /** Moves the center of the neighborhood to the next pixel along the
+   * dimension 0. */
+  Self & operator++()
+  {
+    ++m_Center;
+    return *this;
+  }
+
+  PixelType GetPixel(NeighborIndexType i) const
+  { return m_NeighborhoodAccessorFunctor.Get(m_Center + m_Offsets[i]); }
+
+  PixelType GetCenterPixel() const
+  { return m_NeighborhoodAccessorFunctor.Get(m_Center); }
+
+  NeighborIndexType Size() const
+  { return static_cast< NeighborIndexType >( m_Offsets.size() ); }
+
+  /** Returns the step between two neighbors along axis, in the indices of
+   * the neighbors, as Neighborhood::GetStride() does. */
+  OffsetValueType GetStride(unsigned int axis) const
+  { return m_Strides[axis]; }
+
+  const RadiusType & GetRadius() const
+  { return m_Radius; }
+
+  /** Returns the region of the centers whose whole neighborhood lies in
+   * the buffered region. */
+  const RegionType & GetInteriorRegion() const
+  { return m_InteriorRegion; }
+
+private:
+  const ImageType *               m_Image;
+  const InternalPixelType *       m_Buffer;
+  const InternalPixelType *       m_Center;
+  RadiusType                      m_Radius;
+  RegionType                      m_InteriorRegion;
+  OffsetValueType                 m_Strides[Dimension];
+  std::vector< OffsetValueType >  m_Offsets;
+  NeighborhoodAccessorFunctorType m_NeighborhoodAccessorFunctor;
+};
+
+/**
+ * Applies a kernel to the neighborhood of each pixel of a region, and
+ * writes its result to the output image.
+ *
+ * The region is split by ImageBoundaryFacesCalculator. The kernel is
+ * given a ConstInteriorNeighborhood in the non-boundary region, and a
+ * ConstNeighborhoodIterator using boundaryCondition in the boundary faces,
+ * so its operator() must be a template which accepts both:
+ *
+ * \code
+ * struct Kernel
+ * {
+ *   template< class TNeighborhood >
+ *   OutputPixelType operator()(const TNeighborhood & neighborhood);
+ * };
+ * \endcode
+ *
+ * When boundaryCondition is null, the default boundary condition of
+ * ConstNeighborhoodIterator is used. The progress is reported for each
+ * pixel.
+ *
+ * \ingroup ITKCommon
+ */
+template< class TInputImage, class TOutputImage, class TKernel >
+void ApplyNeighborhoodKernel(const TInputImage *input, TOutputImage *output,
+                             const typename TOutputImage::RegionType & region,
+                             const typename ConstNeighborhoodIterator< TInputImage >::RadiusType & radius,
+                             ImageBoundaryCondition< TInputImage > *boundaryCondition,
+                             TKernel & kernel, ProgressReporter & progress);
 } // end namespace NeighborhoodAlgorithm
 } // end namespace itk
 
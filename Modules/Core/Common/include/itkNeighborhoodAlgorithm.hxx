@@ -19,6 +19,7 @@
 #define __itkNeighborhoodAlgorithm_hxx
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageLinearIteratorWithIndex.h"
 #include "itkImageRegion.h"
 #include "itkConstSliceIterator.h"
 
@@ -163,6 +164,101 @@ CalculateOutputWrapOffsetModifiers< TImage >
     }
   return ans;
 }
+
+template< class TImage >
+ConstInteriorNeighborhood< TImage >
+::ConstInteriorNeighborhood(const ImageType *image, const RadiusType & radius):
+  m_Image(image),
+  m_Buffer( image->GetBufferPointer() ),
+  m_Center( image->GetBufferPointer() ),
+  m_Radius(radius),
+  m_NeighborhoodAccessorFunctor( image->GetNeighborhoodAccessor() )
+{
+  m_NeighborhoodAccessorFunctor.SetBegin(m_Buffer);
+
+  const RegionType & bufferedRegion = image->GetBufferedRegion();
+  for ( unsigned int d = 0; d < Dimension; ++d )
+    {
+    const SizeValueType size = bufferedRegion.GetSize(d);
+    m_InteriorRegion.SetIndex( d, bufferedRegion.GetIndex(d) + static_cast< IndexValueType >( radius[d] ) );
+    m_InteriorRegion.SetSize( d, size > 2 * radius[d] ? size - 2 * radius[d] : 0 );
+    }
+
+  // The neighbors are in the same order as in a Neighborhood
+  Neighborhood< char, Dimension > neighborhood;
+  neighborhood.SetRadius(radius);
+  for ( unsigned int d = 0; d < Dimension; ++d )
+    {
+    m_Strides[d] = neighborhood.GetStride(d);
+    }
+
+  const OffsetValueType *offsetTable = image->GetOffsetTable();
+  m_Offsets.resize( neighborhood.Size() );
+  for ( NeighborIndexType i = 0; i < neighborhood.Size(); ++i )
+    {
+    const typename ImageType::OffsetType offset = neighborhood.GetOffset(i);
+    m_Offsets[i] = 0;
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      m_Offsets[i] += offset[d] * offsetTable[d];
+      }
+    }
+}
+
+template< class TInputImage, class TOutputImage, class TKernel >
+void
+ApplyNeighborhoodKernel(const TInputImage *input, TOutputImage *output,
+                        const typename TOutputImage::RegionType & region,
+                        const typename ConstNeighborhoodIterator< TInputImage >::RadiusType & radius,
+                        ImageBoundaryCondition< TInputImage > *boundaryCondition,
+                        TKernel & kernel, ProgressReporter & progress)
+{
+  typedef typename TOutputImage::PixelType            OutputPixelType;
+  typedef ImageBoundaryFacesCalculator< TInputImage > BFC;
+  typedef typename BFC::FaceListType                  FaceListType;
+
+  BFC                             faceCalculator;
+  FaceListType                    faceList = faceCalculator(input, region, radius);
+  typename FaceListType::iterator fit = faceList.begin();
+
+  // The first face is the non-boundary region, whose neighborhoods are
+  // read without bounds checking, one line of pixels at a time.
+  if ( fit != faceList.end() && fit->GetNumberOfPixels() > 0 )
+    {
+    ConstInteriorNeighborhood< TInputImage > neighborhood(input, radius);
+    if ( neighborhood.GetInteriorRegion().IsInside(*fit) )
+      {
+      ImageLinearIteratorWithIndex< TOutputImage > it(output, *fit);
+      it.SetDirection(0);
+      for ( it.GoToBegin(); !it.IsAtEnd(); it.NextLine() )
+        {
+        neighborhood.SetLocation( it.GetIndex() );
+        for ( ; !it.IsAtEndOfLine(); ++it, ++neighborhood )
+          {
+          it.Set( static_cast< OutputPixelType >( kernel(neighborhood) ) );
+          progress.CompletedPixel();
+          }
+        }
+      ++fit;
+      }
+    }
+
+  // The boundary faces
+  for ( ; fit != faceList.end(); ++fit )
+    {
+    ConstNeighborhoodIterator< TInputImage > bit(radius, input, *fit);
+    if ( boundaryCondition )
+      {
+      bit.OverrideBoundaryCondition(boundaryCondition);
+      }
+    ImageRegionIterator< TOutputImage > it(output, *fit);
+    for ( bit.GoToBegin(); !bit.IsAtEnd(); ++bit, ++it )
+      {
+      it.Set( static_cast< OutputPixelType >( kernel(bit) ) );
+      progress.CompletedPixel();
+      }
+    }
+}
 } // end namespace NeighborhoodAlgorithm
 } // end namespace itk
 
@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkPipelineProfiler_h
+#define __itkPipelineProfiler_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkRealTimeClock.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkIntTypes.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+class ProcessObject;
+
+/** \class PipelineProfiler
+ * \brief Records the executions of the filters of a pipeline.
+ *
+ * A ProcessObject reports every execution to its profiler: the wall time
+ * spent in GenerateData(), including the mini-pipelines it runs, and the
+ * number of bytes of the pixel buffers of its outputs. ImageSource also
+ * reports, for every thread, the time spent in ThreadedGenerateData() and
+ * the number of pixels it produced, which shows how well the work is
+ * balanced between the threads.
+ *
+ * Profiling is opt-in. A filter is profiled when it has a profiler
+ * (ProcessObject::SetProfiler()), or otherwise when a global default
+ * profiler is installed with SetGlobalDefault(); there is none by default
+ * and nothing is measured.
+ *
+ * Report() prints the statistics of all the filters, sorted by decreasing
+ * total time, as a table, as CSV or as JSON.
+ *
+ * The statistics of a filter are keyed by its address: Clear() the
+ * profiler before reusing it with filters that may have been allocated
+ * where destroyed ones lived.
+ *
+ * \sa TimeProbesCollectorBase
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineProfiler:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef PipelineProfiler           Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PipelineProfiler, Object);
+
+  typedef RealTimeClock::TimeStampType TimeStampType;
+
+  /** Formats of Report(). */
+  typedef enum { TEXT, CSV, JSON } ReportFormatType;
+
+  /** Statistics recorded for one filter. Times are in seconds; the thread
+   * vectors are indexed by thread id and accumulate over the
+   * executions. */
+  struct FilterStatistics {
+    std::string Name;
+    SizeValueType NumberOfExecutions;
+    TimeStampType TotalTime;
+    TimeStampType MinimumTime;
+    TimeStampType MaximumTime;
+    SizeValueType OutputBufferSize;
+    std::vector< TimeStampType > ThreadTime;
+    std::vector< SizeValueType > ThreadPixels;
+
+    FilterStatistics():NumberOfExecutions(0), TotalTime(0), MinimumTime(0),
+      MaximumTime(0), OutputBufferSize(0) {}
+
+    /** Largest thread time over the mean thread time, of the threads that
+     * produced pixels: 1 when the work is perfectly balanced, 0 when no
+     * thread time was recorded. */
+    double GetThreadImbalance() const;
+  };
+
+  /** Current time, in seconds, of the clock used for the measurements. */
+  TimeStampType GetTime() const
+  { return m_RealTimeClock->GetTimeInSeconds(); }
+
+  /** Record one execution of filter that took the given time and left
+   * outputBufferSize bytes of pixel buffers in its outputs. */
+  void RecordExecution(const ProcessObject *filter, TimeStampType time,
+                       SizeValueType outputBufferSize);
+
+  /** Record that thread threadId of filter produced numberOfPixels pixels
+   * in the given time. Thread safe. */
+  void RecordThread(const ProcessObject *filter, ThreadIdType threadId,
+                    TimeStampType time, SizeValueType numberOfPixels);
+
+  /** Number of filters recorded so far. */
+  SizeValueType GetNumberOfFilters() const;
+
+  /** Statistics of the i-th filter recorded, in the order of their first
+   * record. */
+  FilterStatistics GetFilterStatistics(SizeValueType i) const;
+
+  /** Statistics of filter; empty statistics if it was never recorded. */
+  FilterStatistics GetFilterStatistics(const ProcessObject *filter) const;
+
+  /** Forget all the statistics. */
+  void Clear();
+
+  /** Print the statistics of all the filters. */
+  void Report(std::ostream & os = std::cout, ReportFormatType format = TEXT) const;
+
+  /** Set/Get the profiler used by the filters that have none. It is NULL
+   * by default, in which case those filters are not profiled. */
+  static void SetGlobalDefault(Self *profiler);
+
+  static Pointer GetGlobalDefault();
+
+protected:
+  PipelineProfiler();
+  ~PipelineProfiler() {}
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+private:
+  PipelineProfiler(const Self &); //purposely not implemented
+  void operator=(const Self &);   //purposely not implemented
+
+  /** Statistics of filter, created on first use. m_Mutex must be held. */
+  FilterStatistics & GetRecord(const ProcessObject *filter);
+
+  typedef std::map< const ProcessObject *, SizeValueType > FilterMapType;
+
+  RealTimeClock::Pointer m_RealTimeClock;
+
+  /** Guards the statistics. */
+  mutable SimpleFastMutexLock m_Mutex;
+
+  FilterMapType                   m_FilterIndex;
+  std::vector< FilterStatistics > m_Statistics;
+
+  static Pointer             m_GlobalDefault;
+  static SimpleFastMutexLock m_GlobalDefaultMutex;
+};
+} // end namespace itk
+
+#endif
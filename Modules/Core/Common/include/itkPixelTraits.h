@@ -29,6 +29,7 @@
 #define __itkPixelTraits_h
 
 #include "itkMacro.h"
+#include <complex>
 
 namespace itk
 {
@@ -1082,6 +1083,157 @@ public:
 
 /** \endcond */
 
+/** \class PixelAllocationTraits
+ * \brief Whether the pixels of a new buffer may be left unconstructed.
+ *
+ * CanBeUninitialized is true for the pixel types that own no resource and
+ * whose content is fully defined by their bytes: the standard scalar
+ * types, std::complex and the fixed size ITK pixel types (Vector,
+ * RGBPixel, SymmetricSecondRankTensor, ...) of such components.
+ * ImageSource::AllocateOutputs() allocates the outputs with these pixel
+ * types without constructing their pixels for the filters which turn
+ * AllocateOutputsUninitialized on, since they write all of them. The
+ * default is false, which is safe for every pixel type.
+ * \sa Image::AllocateUninitialized()
+ * \ingroup ITKCommon
+ */
+template< class TPixelType >
+class PixelAllocationTraits
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool, false);
+};
+
+/** \cond HIDE_SPECIALIZATION_DOCUMENTATION */
+
+template< class TValueType, unsigned int VLength > class FixedArray;
+template< class T, unsigned int NVectorDimension > class Vector;
+template< class T, unsigned int NVectorDimension > class CovariantVector;
+template< class TCoordRep, unsigned int NPointDimension > class Point;
+template< class TComponent > class RGBPixel;
+template< class TComponent > class RGBAPixel;
+template< class TComponent, unsigned int NDimension > class SymmetricSecondRankTensor;
+template< class TComponent > class DiffusionTensor3D;
+template< unsigned int VOffsetDimension > class Offset;
+template< unsigned int VIndexDimension > class Index;
+
+#define itkPixelAllocationTraitsScalarMacro(T)    \
+  template< >                                     \
+  class PixelAllocationTraits< T >                \
+  {                                               \
+public:                                           \
+    itkStaticConstMacro(CanBeUninitialized, bool, true); \
+  }
+
+itkPixelAllocationTraitsScalarMacro(bool);
+itkPixelAllocationTraitsScalarMacro(char);
+itkPixelAllocationTraitsScalarMacro(signed char);
+itkPixelAllocationTraitsScalarMacro(unsigned char);
+itkPixelAllocationTraitsScalarMacro(short);
+itkPixelAllocationTraitsScalarMacro(unsigned short);
+itkPixelAllocationTraitsScalarMacro(int);
+itkPixelAllocationTraitsScalarMacro(unsigned int);
+itkPixelAllocationTraitsScalarMacro(long);
+itkPixelAllocationTraitsScalarMacro(unsigned long);
+itkPixelAllocationTraitsScalarMacro(long long);
+itkPixelAllocationTraitsScalarMacro(unsigned long long);
+itkPixelAllocationTraitsScalarMacro(float);
+itkPixelAllocationTraitsScalarMacro(double);
+itkPixelAllocationTraitsScalarMacro(long double);
+
+#undef itkPixelAllocationTraitsScalarMacro
+
+/** The composite pixel types follow their component type. */
+template< class T >
+class PixelAllocationTraits< std::complex< T > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< class T, unsigned int N >
+class PixelAllocationTraits< FixedArray< T, N > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< class T, unsigned int N >
+class PixelAllocationTraits< Vector< T, N > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< class T, unsigned int N >
+class PixelAllocationTraits< CovariantVector< T, N > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< class T, unsigned int N >
+class PixelAllocationTraits< Point< T, N > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< class T >
+class PixelAllocationTraits< RGBPixel< T > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< class T >
+class PixelAllocationTraits< RGBAPixel< T > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< class T, unsigned int N >
+class PixelAllocationTraits< SymmetricSecondRankTensor< T, N > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< class T >
+class PixelAllocationTraits< DiffusionTensor3D< T > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< T >::CanBeUninitialized);
+};
+
+template< unsigned int N >
+class PixelAllocationTraits< Offset< N > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< long >::CanBeUninitialized);
+};
+
+template< unsigned int N >
+class PixelAllocationTraits< Index< N > >
+{
+public:
+  itkStaticConstMacro(CanBeUninitialized, bool,
+                      PixelAllocationTraits< long >::CanBeUninitialized);
+};
+
+/** \endcond */
+
 } // end namespace itk
 
 #endif // __itkPixelTraits_h
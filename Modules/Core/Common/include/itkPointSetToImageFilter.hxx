@@ -238,8 +238,7 @@ PointSetToImageFilter< TInputPointSet, TOutputImage >
 
   OutputImage->SetOrigin(origin);         //   and origin
   OutputImage->SetDirection(m_Direction); //   and Direction
-  OutputImage->Allocate();                // allocate the image
-  OutputImage->FillBuffer(m_OutsideValue);
+  OutputImage->AllocateAndFill(m_OutsideValue);
 
   typedef typename InputPointSetType::PointsContainer::ConstIterator PointIterator;
   PointIterator pointItr = InputPointSet->GetPoints()->Begin();
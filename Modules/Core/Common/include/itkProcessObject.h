@@ -31,6 +31,7 @@
 #include "itkDataObject.h"
 #include "itkMultiThreader.h"
 #include "itkObjectFactory.h"
+#include "itkPipelineProfiler.h"
 #include <vector>
 
 namespace itk
@@ -286,6 +287,26 @@ public:
   MultiThreader * GetMultiThreader()
   { return m_Threader; }
 
+  /** Set/Get the profiler recording the executions of this filter. When
+   * it is not set, the global default profiler is used, if any; by
+   * default the filter is not profiled.
+   * \sa PipelineProfiler::SetGlobalDefault() */
+  itkSetObjectMacro(Profiler, PipelineProfiler);
+  itkGetObjectMacro(Profiler, PipelineProfiler);
+
+  /** Return the profiler this filter reports to: Profiler when it is set,
+   * the global default profiler otherwise. NULL when the filter is not
+   * profiled. */
+  PipelineProfiler::Pointer GetActiveProfiler() const;
+
+  /** Estimate the number of bytes of bulk data allocated upstream of this
+   * filter when its inputs are updated for the requested regions that
+   * have been propagated to them. Every filter upstream that needs to
+   * execute contributes the size of the requested regions of its outputs.
+   * All these outputs are counted as if they were alive at the same time,
+   * and the internal buffers of the filters are ignored. */
+  SizeValueType EstimateUpstreamMemorySize();
+
   /** An opportunity to deallocate a ProcessObject's bulk data
    *  storage. Some filters may wish to reuse existing bulk data
    *  storage to avoid unnecessary deallocation/allocation
@@ -419,6 +440,31 @@ protected:
   /** This method causes the filter to generate its output. */
   virtual void GenerateData() {}
 
+  /** Number of bytes of the bulk data of the outputs, reported to the
+   * profiler after each execution. ProcessObject does not know the type of
+   * its outputs and returns 0; ImageSource returns the size of the pixel
+   * buffers of its image outputs. */
+  virtual SizeValueType GetOutputsBufferSize() const { return 0; }
+
+  /** Number of bytes of bulk data needed by the requested regions of the
+   * outputs, used by EstimateUpstreamMemorySize(). ProcessObject returns
+   * 0; ImageSource returns the size of the requested regions of its image
+   * outputs. */
+  virtual SizeValueType GetOutputsRequestedRegionSize() const { return 0; }
+
+  /** Number of bytes of bulk data needed to produce the largest piece when
+   * the output is streamed in numberOfDivisions pieces. Overridden by the
+   * filters that stream their input; ProcessObject returns 0. */
+  virtual SizeValueType EstimateStreamedPieceMemorySize(unsigned int itkNotUsed(numberOfDivisions))
+  { return 0; }
+
+  /** Return the smallest number of stream divisions, up to
+   * maximumNumberOfDivisions, for which EstimateStreamedPieceMemorySize()
+   * does not exceed memoryBudget bytes; maximumNumberOfDivisions when no
+   * number of divisions fits in the budget. */
+  unsigned int PlanNumberOfStreamDivisions(SizeValueType memoryBudget,
+                                           unsigned int maximumNumberOfDivisions);
+
   /** Called to allocate the input array.  Copies old inputs. */
   /** Propagate a call to ResetPipeline() up the pipeline. Called only from
    * DataObject. */
@@ -488,6 +534,9 @@ private:
   /** Memory management ivars */
   bool m_ReleaseDataBeforeUpdateFlag;
 
+  /** Records the executions, when set. */
+  PipelineProfiler::Pointer m_Profiler;
+
   /** Friends of ProcessObject */
   friend class DataObject;
 };
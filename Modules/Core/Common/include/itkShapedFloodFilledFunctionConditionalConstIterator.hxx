@@ -96,8 +96,7 @@ ShapedFloodFilledFunctionConditionalConstIterator< TImage, TFunction >
   m_TempPtr->SetLargestPossibleRegion(tempRegion);
   m_TempPtr->SetBufferedRegion(tempRegion);
   m_TempPtr->SetRequestedRegion(tempRegion);
-  m_TempPtr->Allocate();
-  m_TempPtr->FillBuffer(NumericTraits< ITK_TYPENAME TTempImage::PixelType >::Zero);
+  m_TempPtr->AllocateAndFill(NumericTraits< ITK_TYPENAME TTempImage::PixelType >::Zero);
 
   // Initialize the queue by adding the start index assuming one of
   // the m_Seeds is "inside" This might not be true, in which
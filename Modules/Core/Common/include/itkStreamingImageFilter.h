@@ -36,6 +36,16 @@ namespace itk
  * This filter will produce the entire output as one image, but the upstream
  * filters will do their processing in pieces.
  *
+ * Instead of a number of stream divisions, a memory budget in bytes can be
+ * given with SetMemoryBudget(). The number of divisions is then chosen
+ * before each update as the smallest one for which the output of this
+ * filter, plus the requested regions of the outputs of the upstream
+ * filters for the largest piece, fit in the budget. The requested regions
+ * are those computed by the pipeline, so they include the enlargements
+ * made by the neighborhood filters. The shape of the pieces is the one
+ * produced by the RegionSplitter: an ImageRegionMultidimensionalSplitter
+ * gives pieces closer to cubes, which need smaller enlargements.
+ *
  * \ingroup ITKSystemObjects
  * \ingroup DataProcessing
  * \ingroup ITKCommon
@@ -87,6 +97,13 @@ public:
    * will be executed this many times. */
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the maximum number of bytes of image data that the output and
+   * the upstream pipeline may use for one piece. When it is not 0, the
+   * number of stream divisions is computed from it and
+   * NumberOfStreamDivisions is ignored. It is 0 by default. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
   /** Set the helper class for dividing the input into chunks. */
   itkSetObjectMacro(RegionSplitter, SplitterType);
 
@@ -119,6 +136,13 @@ protected:
   ~StreamingImageFilter();
   void PrintSelf(std::ostream & os, Indent indent) const;
 
+  /** Estimate the memory used upstream by the pieces when the output is
+   * split in numberOfDivisions. The pieces of the splitters differ by at
+   * most one pixel along each dimension, so the first one and the middle
+   * one, whose input requested regions are not cropped by the boundary,
+   * stand for all of them. */
+  virtual SizeValueType EstimateStreamedPieceMemorySize(unsigned int numberOfDivisions);
+
 private:
   StreamingImageFilter(const StreamingImageFilter &); //purposely not
                                                       // implemented
@@ -128,6 +152,7 @@ private:
 
   unsigned int          m_NumberOfStreamDivisions;
   RegionSplitterPointer m_RegionSplitter;
+  SizeValueType         m_MemoryBudget;
 };
 } // end namespace itk
 
@@ -22,6 +22,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkImageAlgorithm.h"
 
+#include <algorithm>
+
 namespace itk
 {
 /**
@@ -36,6 +38,9 @@ StreamingImageFilter< TInputImage, TOutputImage >
 
   // create default region splitter
   m_RegionSplitter = ImageRegionSplitter< InputImageDimension >::New();
+
+  // no memory budget by default
+  m_MemoryBudget = 0;
 }
 
 /**
@@ -58,6 +63,7 @@ StreamingImageFilter< TInputImage, TOutputImage >
 
   os << indent << "Number of stream divisions: " << m_NumberOfStreamDivisions
      << std::endl;
+  os << indent << "Memory budget: " << m_MemoryBudget << std::endl;
   if ( m_RegionSplitter )
     {
     os << indent << "Region splitter:" << m_RegionSplitter << std::endl;
@@ -109,6 +115,33 @@ StreamingImageFilter< TInputImage, TOutputImage >
   // because the pipeline managed later
 }
 
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+SizeValueType
+StreamingImageFilter< TInputImage, TOutputImage >
+::EstimateStreamedPieceMemorySize(unsigned int numberOfDivisions)
+{
+  const OutputImageRegionType outputRegion = this->GetOutput(0)->GetRequestedRegion();
+  InputImageType *            inputPtr = const_cast< InputImageType * >( this->GetInput(0) );
+
+  numberOfDivisions = m_RegionSplitter->GetNumberOfSplits(outputRegion, numberOfDivisions);
+
+  // the first piece is on the boundary of the region, where the
+  // enlargements of the requested regions are cropped, and the middle one
+  // is inside
+  SizeValueType      size = 0;
+  const unsigned int pieces[2] = { 0, numberOfDivisions / 2 };
+  for ( unsigned int i = 0; i < 2; i++ )
+    {
+    inputPtr->SetRequestedRegion( m_RegionSplitter->GetSplit(pieces[i], numberOfDivisions, outputRegion) );
+    inputPtr->PropagateRequestedRegion();
+    size = std::max( size, this->EstimateUpstreamMemorySize() );
+    }
+  return size;
+}
+
 /**
  *
  */
@@ -168,15 +201,29 @@ StreamingImageFilter< TInputImage, TOutputImage >
 
   /**
    * Determine of number of pieces to divide the input.  This will be the
-   * minimum of what the user specified via SetNumberOfStreamDivisions()
-   * and what the Splitter thinks is a reasonable value.
+   * minimum of what the user specified via SetNumberOfStreamDivisions(),
+   * or what fits in the memory budget, and what the Splitter thinks is a
+   * reasonable value.
    */
   unsigned int numDivisions, numDivisionsFromSplitter;
 
   numDivisions = m_NumberOfStreamDivisions;
+  if ( m_MemoryBudget > 0 )
+    {
+    // the splitters count the pieces in unsigned int: the largest request
+    // is kept low enough for them not to overflow
+    const SizeValueType outputSize = this->GetOutputsRequestedRegionSize();
+    const unsigned int  maximumNumberOfDivisions = m_RegionSplitter->GetNumberOfSplits(
+      outputRegion, static_cast< unsigned int >( NumericTraits< int >::max() ) );
+    numDivisions = this->PlanNumberOfStreamDivisions(
+      m_MemoryBudget > outputSize ? m_MemoryBudget - outputSize : 0,
+      maximumNumberOfDivisions);
+    itkDebugMacro(<< "Streaming in " << numDivisions << " pieces for a memory budget of "
+                  << m_MemoryBudget << " bytes");
+    }
   numDivisionsFromSplitter =
     m_RegionSplitter
-    ->GetNumberOfSplits(outputRegion, m_NumberOfStreamDivisions);
+    ->GetNumberOfSplits(outputRegion, numDivisions);
   if ( numDivisionsFromSplitter < numDivisions )
     {
     numDivisions = numDivisionsFromSplitter;
@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkThreadPool_h
+#define __itkThreadPool_h
+
+#include "itkObject.h"
+#include "itkConditionVariable.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkIntTypes.h"
+
+#include <deque>
+#include <set>
+#include <vector>
+
+namespace itk
+{
+/** \class ThreadPool
+ * \brief A process-wide pool of persistent worker threads.
+ *
+ * The ThreadPool keeps a set of worker threads alive between executions so
+ * that the MultiThreader does not have to create and join a system thread
+ * every time a filter runs. Work is submitted with AssignWork(), which
+ * returns a job identifier, and the caller blocks on WaitForJob() until
+ * that job has been executed by one of the workers.
+ *
+ * The pool is created lazily by the first call to GetInstance() and starts
+ * without any threads. A new worker is started whenever a job is assigned
+ * while no worker is idle, so the pool grows to the largest number of
+ * concurrently running jobs and never deadlocks when a job itself submits
+ * work (as happens with nested multithreaded filters).
+ *
+ * The functions run by the pool have the same ThreadFunctionType
+ * signature used by the MultiThreader, so the ThreadInfoStruct callback
+ * contract is unchanged.
+ *
+ * \sa MultiThreader
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ThreadPool:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ThreadPool                 Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ThreadPool, Object);
+
+  /** Identifier of a job submitted to the pool. */
+  typedef SizeValueType ThreadJobIdType;
+
+  /** Return the process-wide thread pool, creating it on first use. */
+  static Pointer GetInstance();
+
+  /** Queue the function f to be run with argument data by one of the
+   * workers. The returned identifier must be passed to WaitForJob(). */
+  ThreadJobIdType AssignWork(ThreadFunctionType f, void *data);
+
+  /** Block until the job with the given identifier has been executed. Each
+   * job must be waited for exactly once. */
+  void WaitForJob(ThreadJobIdType id);
+
+  /** Number of worker threads currently owned by the pool. */
+  ThreadIdType GetNumberOfThreads() const;
+
+  /** Number of worker threads currently not running a job. */
+  ThreadIdType GetNumberOfIdleThreads() const;
+
+protected:
+  ThreadPool();
+  ~ThreadPool();
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+private:
+  ThreadPool(const Self &);     //purposely not implemented
+  void operator=(const Self &); //purposely not implemented
+
+  struct ThreadJob {
+    ThreadJobIdType    m_Id;
+    ThreadFunctionType m_ThreadFunction;
+    void *             m_UserData;
+  };
+
+  /** Start one more worker thread. Must be called with m_Mutex held. */
+  void AddThread();
+
+  /** Loop run by every worker: pull jobs from the queue until the pool is
+   * destroyed. */
+  static ITK_THREAD_RETURN_TYPE ThreadExecute(void *arg);
+
+  /** Guards every member below. */
+  mutable SimpleMutexLock m_Mutex;
+
+  /** Signaled when a job is queued or the pool is being destroyed. */
+  ConditionVariable::Pointer m_WorkAvailable;
+
+  /** Broadcast every time a job completes. */
+  ConditionVariable::Pointer m_JobCompleted;
+
+  std::deque< ThreadJob >            m_PendingJobs;
+  std::set< ThreadJobIdType >        m_CompletedJobs;
+  std::vector< ThreadProcessIDType > m_Threads;
+
+  ThreadJobIdType m_NextJobId;
+  ThreadIdType    m_NumberOfBusyThreads;
+  bool            m_ScheduleForDestruction;
+
+  static Pointer             m_Instance;
+  static SimpleFastMutexLock m_InstanceMutex;
+};
+} // end namespace itk
+
+#endif
@@ -41,7 +41,7 @@ namespace itk
   /** Platform specific typedefs for simple types
    */
 #if defined(ITK_USE_PTHREADS)
-#define ITK_MAX_THREADS              128
+#define ITK_MAX_THREADS              1024
   typedef pthread_mutex_t MutexType;
   typedef pthread_mutex_t FastMutexType;
   typedef void *( * ThreadFunctionType )(void *);
@@ -51,7 +51,7 @@ namespace itk
 
 #elif defined(ITK_USE_WIN32_THREADS)
 
-#define ITK_MAX_THREADS              128
+#define ITK_MAX_THREADS              1024
   typedef HANDLE                 MutexType;
   typedef CRITICAL_SECTION       FastMutexType;
   typedef LPTHREAD_START_ROUTINE ThreadFunctionType;
@@ -33,6 +33,8 @@ UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
 {
   this->SetNumberOfRequiredInputs(1);
   this->InPlaceOff();
+  // Every output pixel is set from the functor
+  this->AllocateOutputsUninitializedOn();
 }
 
 /**
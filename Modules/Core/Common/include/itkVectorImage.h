@@ -172,6 +172,16 @@ public:
    * already be set, e.g. by calling SetRegions(). */
   void Allocate();
 
+  /** Allocate the image memory without initializing it. The components
+   * are undefined until they are written.
+   * \sa Image::AllocateUninitialized() */
+  virtual void AllocateUninitialized();
+
+  /** Allocate the image memory and set every pixel to value, which must
+   * have VectorLength components. This is equivalent to Allocate()
+   * followed by FillBuffer(value), but writes the buffer only once. */
+  void AllocateAndFill(const PixelType & value);
+
   /** Convenience methods to set the LargestPossibleRegion,
    *  BufferedRegion and RequestedRegion. Allocate must still be called.
    */
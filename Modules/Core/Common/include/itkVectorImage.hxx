@@ -61,6 +61,33 @@ VectorImage< TPixel, VImageDimension >
   m_Buffer->Reserve(num * m_VectorLength);
 }
 
+template< class TPixel, unsigned int VImageDimension >
+void
+VectorImage< TPixel, VImageDimension >
+::AllocateUninitialized()
+{
+  if ( m_VectorLength == 0 )
+    {
+    itkExceptionMacro(<< "Cannot allocate VectorImage with VectorLength = 0");
+    }
+
+  this->ComputeOffsetTable();
+  const SizeValueType num = this->GetOffsetTable()[VImageDimension];
+
+  m_Buffer->ReserveUninitialized(num * m_VectorLength);
+}
+
+template< class TPixel, unsigned int VImageDimension >
+void
+VectorImage< TPixel, VImageDimension >
+::AllocateAndFill(const PixelType & value)
+{
+  // The components are scalars: writing them once into the uninitialized
+  // buffer initializes it.
+  this->AllocateUninitialized();
+  this->FillBuffer(value);
+}
+
 template< class TPixel, unsigned int VImageDimension >
 void
 VectorImage< TPixel, VImageDimension >
@@ -77,7 +104,10 @@ VectorImage< TPixel, VImageDimension >
   // Replace the handle to the buffer. This is the safest thing to do,
   // since the same container can be shared by multiple images (e.g.
   // Grafted outputs and in place filters).
+  // The allocator of the image is kept.
+  ImageBufferAllocator::Pointer allocator = m_Buffer ? m_Buffer->GetAllocator() : 0;
   m_Buffer = PixelContainer::New();
+  m_Buffer->SetAllocator( allocator.GetPointer() );
 }
 
 template< class TPixel, unsigned int VImageDimension >
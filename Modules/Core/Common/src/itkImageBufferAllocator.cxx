@@ -0,0 +1,310 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#if defined( _WIN32 )
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace itk
+{
+ImageBufferAllocator::Pointer ImageBufferAllocator:: m_GlobalDefault;
+SimpleFastMutexLock           ImageBufferAllocator:: m_GlobalDefaultMutex;
+
+void
+ImageBufferAllocator
+::SetGlobalDefault(Self *allocator)
+{
+  m_GlobalDefaultMutex.Lock();
+  m_GlobalDefault = allocator;
+  m_GlobalDefaultMutex.Unlock();
+}
+
+ImageBufferAllocator::Pointer
+ImageBufferAllocator
+::GetGlobalDefault()
+{
+  m_GlobalDefaultMutex.Lock();
+  Pointer allocator = m_GlobalDefault;
+  m_GlobalDefaultMutex.Unlock();
+  return allocator;
+}
+
+ImageBufferAllocator
+::ImageBufferAllocator():
+  m_PoolSize(0),
+  m_Alignment(64),
+  m_Pooling(false),
+  m_MaximumPoolSize(static_cast< SizeValueType >( 1 ) << 30),
+  m_HugePages(false),
+  m_NumberOfAllocations(0),
+  m_NumberOfPoolHits(0),
+  m_NumberOfDeallocations(0)
+{}
+
+ImageBufferAllocator
+::~ImageBufferAllocator()
+{
+  this->ReleasePool();
+}
+
+SizeValueType
+ImageBufferAllocator
+::GetHugePageSize()
+{
+  return static_cast< SizeValueType >( 2 ) << 20;
+}
+
+SizeValueType
+ImageBufferAllocator
+::ComputeBucketSize(SizeValueType numberOfBytes)
+{
+  // Eight buckets per power of two, and never less than a cache line
+  numberOfBytes = std::max( numberOfBytes, static_cast< SizeValueType >( 1 ) );
+  SizeValueType powerOfTwo = 1;
+  while ( powerOfTwo <= numberOfBytes / 2 )
+    {
+    powerOfTwo *= 2;
+    }
+  const SizeValueType step = std::max( powerOfTwo / 8, static_cast< SizeValueType >( 64 ) );
+  return ( ( numberOfBytes + step - 1 ) / step ) * step;
+}
+
+void *
+ImageBufferAllocator
+::Allocate(SizeValueType numberOfBytes)
+{
+  const SizeValueType bucketSize = ComputeBucketSize(numberOfBytes);
+
+  void *block = 0;
+  m_Mutex.Lock();
+  ++m_NumberOfAllocations;
+  PoolType::iterator it = m_Pool.find(bucketSize);
+  if ( it != m_Pool.end() )
+    {
+    block = it->second;
+    m_Pool.erase(it);
+    m_PoolSize -= bucketSize;
+    ++m_NumberOfPoolHits;
+    }
+  m_Mutex.Unlock();
+
+  if ( !block )
+    {
+    block = this->AllocateBlock(bucketSize);
+    }
+  if ( !block )
+    {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__,
+                                "Failed to allocate memory for image.",
+                                ITK_LOCATION);
+    }
+  return block;
+}
+
+void
+ImageBufferAllocator
+::Deallocate(void *block, SizeValueType numberOfBytes)
+{
+  if ( !block )
+    {
+    return;
+    }
+
+  const SizeValueType bucketSize = ComputeBucketSize(numberOfBytes);
+
+  m_Mutex.Lock();
+  ++m_NumberOfDeallocations;
+  if ( m_Pooling && m_PoolSize + bucketSize <= m_MaximumPoolSize )
+    {
+    m_Pool.insert( PoolType::value_type(bucketSize, block) );
+    m_PoolSize += bucketSize;
+    block = 0;
+    }
+  m_Mutex.Unlock();
+
+  if ( block )
+    {
+    this->DeallocateBlock(block, bucketSize);
+    }
+}
+
+void *
+ImageBufferAllocator
+::AllocateBlock(SizeValueType numberOfBytes)
+{
+  SizeValueType alignment = m_Alignment;
+  const bool    useHugePages = m_HugePages && numberOfBytes >= GetHugePageSize();
+  if ( useHugePages )
+    {
+    alignment = std::max( alignment, GetHugePageSize() );
+    }
+
+  void *block = 0;
+#if defined( _WIN32 )
+  block = _aligned_malloc(numberOfBytes, alignment);
+#else
+  if ( posix_memalign(&block, alignment, numberOfBytes) != 0 )
+    {
+    block = 0;
+    }
+#if defined( __linux__ ) && defined( MADV_HUGEPAGE )
+  if ( block && useHugePages )
+    {
+    // Only a hint: the kernel may not have transparent huge pages enabled
+    madvise(block, numberOfBytes - numberOfBytes % GetHugePageSize(), MADV_HUGEPAGE);
+    }
+#endif
+#endif
+  return block;
+}
+
+void
+ImageBufferAllocator
+::DeallocateBlock(void *block, SizeValueType)
+{
+#if defined( _WIN32 )
+  _aligned_free(block);
+#else
+  free(block);
+#endif
+}
+
+void
+ImageBufferAllocator
+::SetAlignment(SizeValueType alignment)
+{
+  SizeValueType powerOfTwo = sizeof( void * );
+  while ( powerOfTwo < alignment )
+    {
+    powerOfTwo *= 2;
+    }
+  if ( m_Alignment != powerOfTwo )
+    {
+    // the pooled blocks may not satisfy the new alignment
+    this->ReleasePool();
+    m_Alignment = powerOfTwo;
+    this->Modified();
+    }
+}
+
+void
+ImageBufferAllocator
+::SetPooling(bool pooling)
+{
+  if ( m_Pooling != pooling )
+    {
+    m_Pooling = pooling;
+    if ( !pooling )
+      {
+      this->ReleasePool();
+      }
+    this->Modified();
+    }
+}
+
+void
+ImageBufferAllocator
+::ReleasePool()
+{
+  PoolType pool;
+
+  m_Mutex.Lock();
+  pool.swap(m_Pool);
+  m_PoolSize = 0;
+  m_Mutex.Unlock();
+
+  for ( PoolType::iterator it = pool.begin(); it != pool.end(); ++it )
+    {
+    this->DeallocateBlock(it->second, it->first);
+    }
+}
+
+SizeValueType
+ImageBufferAllocator
+::GetPoolSize() const
+{
+  m_Mutex.Lock();
+  const SizeValueType poolSize = m_PoolSize;
+  m_Mutex.Unlock();
+  return poolSize;
+}
+
+SizeValueType
+ImageBufferAllocator
+::GetNumberOfAllocations() const
+{
+  m_Mutex.Lock();
+  const SizeValueType numberOfAllocations = m_NumberOfAllocations;
+  m_Mutex.Unlock();
+  return numberOfAllocations;
+}
+
+SizeValueType
+ImageBufferAllocator
+::GetNumberOfPoolHits() const
+{
+  m_Mutex.Lock();
+  const SizeValueType numberOfPoolHits = m_NumberOfPoolHits;
+  m_Mutex.Unlock();
+  return numberOfPoolHits;
+}
+
+SizeValueType
+ImageBufferAllocator
+::GetNumberOfDeallocations() const
+{
+  m_Mutex.Lock();
+  const SizeValueType numberOfDeallocations = m_NumberOfDeallocations;
+  m_Mutex.Unlock();
+  return numberOfDeallocations;
+}
+
+void
+ImageBufferAllocator
+::ResetStatistics()
+{
+  m_Mutex.Lock();
+  m_NumberOfAllocations = 0;
+  m_NumberOfPoolHits = 0;
+  m_NumberOfDeallocations = 0;
+  m_Mutex.Unlock();
+}
+
+void
+ImageBufferAllocator
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Alignment: " << m_Alignment << std::endl;
+  os << indent << "Pooling: " << ( m_Pooling ? "On" : "Off" ) << std::endl;
+  os << indent << "MaximumPoolSize: " << m_MaximumPoolSize << std::endl;
+  os << indent << "HugePages: " << ( m_HugePages ? "On" : "Off" ) << std::endl;
+  os << indent << "PoolSize: " << this->GetPoolSize() << std::endl;
+  os << indent << "NumberOfAllocations: " << this->GetNumberOfAllocations() << std::endl;
+  os << indent << "NumberOfPoolHits: " << this->GetNumberOfPoolHits() << std::endl;
+  os << indent << "NumberOfDeallocations: " << this->GetNumberOfDeallocations() << std::endl;
+}
+} // end namespace itk
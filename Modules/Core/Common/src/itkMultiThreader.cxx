@@ -51,6 +51,48 @@ ThreadIdType MultiThreader:: m_GlobalMaximumNumberOfThreads = ITK_MAX_THREADS;
 // => Not initialized.
 ThreadIdType MultiThreader:: m_GlobalDefaultNumberOfThreads = 0;
 
+// Initialize static members that control the default use of the thread
+// pool : not initialized until first queried or set.
+bool MultiThreader:: m_GlobalDefaultUseThreadPool = false;
+bool MultiThreader:: m_GlobalDefaultUseThreadPoolIsInitialized = false;
+
+void MultiThreader::SetGlobalDefaultUseThreadPool(bool useThreadPool)
+{
+  m_GlobalDefaultUseThreadPool = useThreadPool;
+  m_GlobalDefaultUseThreadPoolIsInitialized = true;
+}
+
+bool MultiThreader::GetGlobalDefaultUseThreadPool()
+{
+  if ( !m_GlobalDefaultUseThreadPoolIsInitialized )
+    {
+    // check for environment variable
+    itksys_stl::string itkUseThreadPoolEnv;
+    if ( itksys::SystemTools::GetEnv("ITK_USE_THREADPOOL", itkUseThreadPoolEnv) )
+      {
+      itkUseThreadPoolEnv = itksys::SystemTools::UpperCase(itkUseThreadPoolEnv);
+      m_GlobalDefaultUseThreadPool = ( itkUseThreadPoolEnv == "ON"
+                                       || itkUseThreadPoolEnv == "1"
+                                       || itkUseThreadPoolEnv == "TRUE"
+                                       || itkUseThreadPoolEnv == "YES" );
+      }
+    m_GlobalDefaultUseThreadPoolIsInitialized = true;
+    }
+  return m_GlobalDefaultUseThreadPool;
+}
+
+bool MultiThreader:: m_GlobalDefaultUseThreadAffinity = false;
+
+void MultiThreader::SetGlobalDefaultUseThreadAffinity(bool useThreadAffinity)
+{
+  m_GlobalDefaultUseThreadAffinity = useThreadAffinity;
+}
+
+bool MultiThreader::GetGlobalDefaultUseThreadAffinity()
+{
+  return m_GlobalDefaultUseThreadAffinity;
+}
+
 void MultiThreader::SetGlobalMaximumNumberOfThreads(ThreadIdType val)
 {
   m_GlobalMaximumNumberOfThreads = val;
@@ -139,33 +181,81 @@ ThreadIdType MultiThreader::GetGlobalDefaultNumberOfThreads()
 }
 
 
-// Constructor. Default all the methods to NULL. Since the
-// ThreadInfoArray is static, the ThreadIDs can be initialized here
-// and will not change.
+// Constructor. Default all the methods to NULL. The per-thread storage
+// is allocated when the methods are set or executed, for the number of
+// threads actually used.
 MultiThreader::MultiThreader()
 {
-  for ( ThreadIdType i = 0; i < ITK_MAX_THREADS; i++ )
-    {
-    m_ThreadInfoArray[i].ThreadID           = i;
-    m_ThreadInfoArray[i].ActiveFlag         = 0;
-    m_ThreadInfoArray[i].ActiveFlagLock     = 0;
-
-    m_MultipleMethod[i]                     = 0;
-    m_MultipleData[i]                       = 0;
-
-    m_SpawnedThreadActiveFlag[i]            = 0;
-    m_SpawnedThreadActiveFlagLock[i]        = 0;
-    m_SpawnedThreadInfoArray[i].ThreadID    = i;
-    }
-
   m_SingleMethod = 0;
   m_SingleData = 0;
   m_NumberOfThreads = this->GetGlobalDefaultNumberOfThreads();
+  m_UseThreadPool = this->GetGlobalDefaultUseThreadPool();
+  m_UseThreadAffinity = this->GetGlobalDefaultUseThreadAffinity();
 }
 
 MultiThreader::~MultiThreader()
 {}
 
+void MultiThreader::InitializeThreadInfoArray()
+{
+  // Entries are only added here, between executions, so the pointers
+  // handed to the threads stay valid while they run.
+  const ThreadIdType previousSize = static_cast< ThreadIdType >( m_ThreadInfoArray.size() );
+  if ( previousSize < m_NumberOfThreads )
+    {
+    m_ThreadInfoArray.resize(m_NumberOfThreads);
+    for ( ThreadIdType i = previousSize; i < m_NumberOfThreads; i++ )
+      {
+      m_ThreadInfoArray[i].ThreadID       = i;
+      m_ThreadInfoArray[i].ActiveFlag     = 0;
+      m_ThreadInfoArray[i].ActiveFlagLock = 0;
+      }
+    }
+}
+
+int MultiThreader::AllocateSpawnedThreadId()
+{
+  int id = 0;
+  const int numberOfIds = static_cast< int >( m_SpawnedThreadActiveFlag.size() );
+
+  while ( id < numberOfIds )
+    {
+    if ( !m_SpawnedThreadActiveFlagLock[id]  )
+      {
+      m_SpawnedThreadActiveFlagLock[id] = MutexLock::New();
+      }
+    m_SpawnedThreadActiveFlagLock[id]->Lock();
+    if ( m_SpawnedThreadActiveFlag[id] == 0 )
+      {
+      // We've got a useable thread id, so grab it
+      m_SpawnedThreadActiveFlag[id] = 1;
+      m_SpawnedThreadActiveFlagLock[id]->Unlock();
+      return id;
+      }
+    m_SpawnedThreadActiveFlagLock[id]->Unlock();
+
+    id++;
+    }
+
+  if ( id >= ITK_MAX_THREADS )
+    {
+    itkExceptionMacro(<< "You have too many active threads!");
+    }
+
+  // All the existing ids are in use: add a new one
+  ThreadInfoStruct info;
+  info.ThreadID = id;
+  info.ActiveFlag = 0;
+  info.ActiveFlagLock = 0;
+
+  m_SpawnedThreadActiveFlag.push_back(1);
+  m_SpawnedThreadActiveFlagLock.push_back( MutexLock::New() );
+  m_SpawnedThreadProcessID.push_back( ThreadProcessIDType() );
+  m_SpawnedThreadInfoArray.push_back(info);
+
+  return id;
+}
+
 // Set the user defined method that will be run on NumberOfThreads threads
 // when SingleMethodExecute is called.
 void MultiThreader::SetSingleMethod(ThreadFunctionType f, void *data)
@@ -187,6 +277,11 @@ void MultiThreader::SetMultipleMethod(ThreadIdType index, ThreadFunctionType f,
     }
   else
     {
+    if ( m_MultipleMethod.size() < m_NumberOfThreads )
+      {
+      m_MultipleMethod.resize(m_NumberOfThreads, 0);
+      m_MultipleData.resize(m_NumberOfThreads, 0);
+      }
     m_MultipleMethod[index] = f;
     m_MultipleData[index]   = data;
     }
@@ -195,8 +290,7 @@ void MultiThreader::SetMultipleMethod(ThreadIdType index, ThreadFunctionType f,
 // Execute the method set as the SingleMethod on NumberOfThreads threads.
 void MultiThreader::SingleMethodExecute()
 {
-  ThreadIdType                 thread_loop = 0;
-  ThreadProcessIDType process_id[ITK_MAX_THREADS];
+  ThreadIdType thread_loop = 0;
 
   if ( !m_SingleMethod )
     {
@@ -207,6 +301,12 @@ void MultiThreader::SingleMethodExecute()
   // obey the global maximum number of threads limit
   m_NumberOfThreads = std::min( m_GlobalMaximumNumberOfThreads, m_NumberOfThreads );
 
+  this->InitializeThreadInfoArray();
+
+  std::vector< ThreadProcessIDType >         process_id(m_NumberOfThreads);
+  std::vector< ThreadPool::ThreadJobIdType > job_id(m_NumberOfThreads);
+  ThreadPool::Pointer                        threadPool;
+
   // Spawn a set of threads through the SingleMethodProxy. Exceptions
   // thrown from a thread will be caught by the SingleMethodProxy. A
   // naive mechanism is in place for determining whether a thread
@@ -214,8 +314,21 @@ void MultiThreader::SingleMethodExecute()
   //
   // Thanks to Hannu Helminen for suggestions on how to catch
   // exceptions thrown by threads.
-  bool        exceptionOccurred = false;
-  std::string exceptionDetails;
+  //
+  // When the thread pool is used, the same proxy is queued on the
+  // persistent workers of the pool instead of on newly created threads.
+  // Only the threads that were actually dispatched are waited for.
+  //
+  // The calling thread runs thread 0 and is never bound to a processor.
+  const ThreadFunctionType proxy =
+    m_UseThreadAffinity ? this->SingleMethodProxyWithAffinity : this->SingleMethodProxy;
+  bool         exceptionOccurred = false;
+  std::string  exceptionDetails;
+  ThreadIdType numberOfDispatchedThreads = 1;
+  if ( m_UseThreadPool && m_NumberOfThreads > 1 )
+    {
+    threadPool = ThreadPool::GetInstance();
+    }
   try
     {
     for ( thread_loop = 1; thread_loop < m_NumberOfThreads; thread_loop++ )
@@ -224,8 +337,17 @@ void MultiThreader::SingleMethodExecute()
       m_ThreadInfoArray[thread_loop].NumberOfThreads = m_NumberOfThreads;
       m_ThreadInfoArray[thread_loop].ThreadFunction = m_SingleMethod;
 
-      process_id[thread_loop] =
-        this->DispatchSingleMethodThread(&m_ThreadInfoArray[thread_loop]);
+      if ( threadPool )
+        {
+        job_id[thread_loop] =
+          threadPool->AssignWork( proxy, &m_ThreadInfoArray[thread_loop] );
+        }
+      else
+        {
+        process_id[thread_loop] =
+          this->DispatchSingleMethodThread(&m_ThreadInfoArray[thread_loop], proxy);
+        }
+      numberOfDispatchedThreads = thread_loop + 1;
       }
     }
   catch ( std::exception & e )
@@ -256,11 +378,18 @@ void MultiThreader::SingleMethodExecute()
     {
     // Need cleanup and rethrow ProcessAborted
     // close down other threads
-    for ( thread_loop = 1; thread_loop < m_NumberOfThreads; thread_loop++ )
+    for ( thread_loop = 1; thread_loop < numberOfDispatchedThreads; thread_loop++ )
       {
       try
         {
-        this->WaitForSingleMethodThread(process_id[thread_loop]);
+        if ( threadPool )
+          {
+          threadPool->WaitForJob(job_id[thread_loop]);
+          }
+        else
+          {
+          this->WaitForSingleMethodThread(process_id[thread_loop]);
+          }
         }
       catch ( ... )
               {}
@@ -285,11 +414,18 @@ void MultiThreader::SingleMethodExecute()
 
   // The parent thread has finished this->SingleMethod() - so now it
   // waits for each of the other processes to exit
-  for ( thread_loop = 1; thread_loop < m_NumberOfThreads; thread_loop++ )
+  for ( thread_loop = 1; thread_loop < numberOfDispatchedThreads; thread_loop++ )
     {
     try
       {
-      this->WaitForSingleMethodThread(process_id[thread_loop]);
+      if ( threadPool )
+        {
+        threadPool->WaitForJob(job_id[thread_loop]);
+        }
+      else
+        {
+        this->WaitForSingleMethodThread(process_id[thread_loop]);
+        }
       if ( m_ThreadInfoArray[thread_loop].ThreadExitCode
            != ThreadInfoStruct::SUCCESS )
         {
@@ -367,6 +503,12 @@ void MultiThreader::PrintSelf(std::ostream & os, Indent indent) const
      << m_GlobalMaximumNumberOfThreads << std::endl;
   os << indent << "Global Default Number Of Threads: "
      << m_GlobalDefaultNumberOfThreads << std::endl;
+  os << indent << "Use Thread Pool: " << m_UseThreadPool << std::endl;
+  os << indent << "Global Default Use Thread Pool: "
+     << m_GlobalDefaultUseThreadPool << std::endl;
+  os << indent << "Use Thread Affinity: " << m_UseThreadAffinity << std::endl;
+  os << indent << "Global Default Use Thread Affinity: "
+     << m_GlobalDefaultUseThreadAffinity << std::endl;
 }
 
 
@@ -53,13 +53,16 @@ void MultiThreader::MultipleMethodExecute()
 
   for ( thread_loop = 0; thread_loop < m_NumberOfThreads; thread_loop++ )
     {
-    if ( m_MultipleMethod[thread_loop] == (ThreadFunctionType)0 )
+    if ( thread_loop >= m_MultipleMethod.size()
+         || m_MultipleMethod[thread_loop] == (ThreadFunctionType)0 )
       {
       itkExceptionMacro(<< "No multiple method set for: " << thread_loop);
       return;
       }
     }
 
+  this->InitializeThreadInfoArray();
+
   // There is no multi threading, so there is only one thread.
   m_ThreadInfoArray[0].UserData    = m_MultipleData[0];
   m_ThreadInfoArray[0].NumberOfThreads = m_NumberOfThreads;
@@ -69,31 +72,7 @@ void MultiThreader::MultipleMethodExecute()
 // FIXME: Doesn't seem to be called anywhere...
 int MultiThreader::SpawnThread(ThreadFunctionType f, void *UserData)
 {
-  int id = 0;
-
-  while ( id < ITK_MAX_THREADS )
-    {
-    if ( !m_SpawnedThreadActiveFlagLock[id]  )
-      {
-      m_SpawnedThreadActiveFlagLock[id] = MutexLock::New();
-      }
-    m_SpawnedThreadActiveFlagLock[id]->Lock();
-    if ( m_SpawnedThreadActiveFlag[id] == 0 )
-      {
-      // We've got a useable thread id, so grab it
-      m_SpawnedThreadActiveFlag[id] = 1;
-      m_SpawnedThreadActiveFlagLock[id]->Unlock();
-      break;
-      }
-    m_SpawnedThreadActiveFlagLock[id]->Unlock();
-
-    id++;
-    }
-
-  if ( id >= ITK_MAX_THREADS )
-    {
-    itkExceptionMacro(<< "You have too many active threads!");
-    }
+  int id = this->AllocateSpawnedThreadId();
 
   m_SpawnedThreadInfoArray[id].UserData        = UserData;
   m_SpawnedThreadInfoArray[id].NumberOfThreads = 1;
@@ -110,7 +89,8 @@ int MultiThreader::SpawnThread(ThreadFunctionType f, void *UserData)
 
 void MultiThreader::TerminateThread(ThreadIdType ThreadID)
 {
-  if ( !m_SpawnedThreadActiveFlag[ThreadID] )
+  if ( ThreadID >= m_SpawnedThreadActiveFlag.size()
+       || !m_SpawnedThreadActiveFlag[ThreadID] )
     {
     return;
     }
@@ -137,9 +117,18 @@ MultiThreader
 
 ThreadProcessIDType
 MultiThreader
-::DispatchSingleMethodThread(MultiThreader::ThreadInfoStruct *threadInfo)
+::DispatchSingleMethodThread(MultiThreader::ThreadInfoStruct *threadInfo,
+                             ThreadFunctionType proxy)
 {
   // No threading library specified.  Do nothing.  The computation
   // will be run by the main execution thread.
 }
+
+ITK_THREAD_RETURN_TYPE
+MultiThreader
+::SingleMethodProxyWithAffinity(void *arg)
+{
+  // No threading library specified.  There is nothing to bind.
+  MultiThreader::SingleMethodProxy(arg);
+}
 } // end namespace itk
@@ -78,8 +78,6 @@ void MultiThreader::MultipleMethodExecute()
 {
   ThreadIdType thread_loop;
 
-  pthread_t process_id[ITK_MAX_THREADS];
-
   // obey the global maximum number of threads limit
   if ( m_NumberOfThreads > m_GlobalMaximumNumberOfThreads )
     {
@@ -88,13 +86,18 @@ void MultiThreader::MultipleMethodExecute()
 
   for ( thread_loop = 0; thread_loop < m_NumberOfThreads; thread_loop++ )
     {
-    if ( m_MultipleMethod[thread_loop] == (ThreadFunctionType)0 )
+    if ( thread_loop >= m_MultipleMethod.size()
+         || m_MultipleMethod[thread_loop] == (ThreadFunctionType)0 )
       {
       itkExceptionMacro(<< "No multiple method set for: " << thread_loop);
       return;
       }
     }
 
+  this->InitializeThreadInfoArray();
+
+  std::vector< pthread_t > process_id(m_NumberOfThreads);
+
   // Using POSIX threads
   //
   // We want to use pthread_create to start m_NumberOfThreads - 1
@@ -140,31 +143,7 @@ void MultiThreader::MultipleMethodExecute()
 
 int MultiThreader::SpawnThread(ThreadFunctionType f, void *UserData)
 {
-  int id = 0;
-
-  while ( id < ITK_MAX_THREADS )
-    {
-    if ( !m_SpawnedThreadActiveFlagLock[id]  )
-      {
-      m_SpawnedThreadActiveFlagLock[id] = MutexLock::New();
-      }
-    m_SpawnedThreadActiveFlagLock[id]->Lock();
-    if ( m_SpawnedThreadActiveFlag[id] == 0 )
-      {
-      // We've got a useable thread id, so grab it
-      m_SpawnedThreadActiveFlag[id] = 1;
-      m_SpawnedThreadActiveFlagLock[id]->Unlock();
-      break;
-      }
-    m_SpawnedThreadActiveFlagLock[id]->Unlock();
-
-    id++;
-    }
-
-  if ( id >= ITK_MAX_THREADS )
-    {
-    itkExceptionMacro(<< "You have too many active threads!");
-    }
+  int id = this->AllocateSpawnedThreadId();
 
   m_SpawnedThreadInfoArray[id].UserData        = UserData;
   m_SpawnedThreadInfoArray[id].NumberOfThreads = 1;
@@ -187,7 +166,8 @@ int MultiThreader::SpawnThread(ThreadFunctionType f, void *UserData)
 
 void MultiThreader::TerminateThread(ThreadIdType ThreadID)
 {
-  if ( !m_SpawnedThreadActiveFlag[ThreadID] )
+  if ( ThreadID >= m_SpawnedThreadActiveFlag.size()
+       || !m_SpawnedThreadActiveFlag[ThreadID] )
     {
     return;
     }
@@ -215,7 +195,8 @@ MultiThreader
 
 ThreadProcessIDType
 MultiThreader
-::DispatchSingleMethodThread(MultiThreader::ThreadInfoStruct *threadInfo)
+::DispatchSingleMethodThread(MultiThreader::ThreadInfoStruct *threadInfo,
+                             ThreadFunctionType proxy)
 {
   // Using POSIX threads
   pthread_attr_t attr;
@@ -228,7 +209,7 @@ MultiThreader
 
   int threadError;
   threadError =
-    pthread_create( &threadHandle, &attr, reinterpret_cast< c_void_cast >( this->SingleMethodProxy ),
+    pthread_create( &threadHandle, &attr, reinterpret_cast< c_void_cast >( proxy ),
                     reinterpret_cast< void * >( threadInfo ) );
   if ( threadError != 0 )
     {
@@ -237,4 +218,50 @@ MultiThreader
     }
   return threadHandle;
 }
+
+ITK_THREAD_RETURN_TYPE
+MultiThreader
+::SingleMethodProxyWithAffinity(void *arg)
+{
+#if defined( __linux__ ) && defined( CPU_SET ) && defined( CPU_COUNT )
+  MultiThreader::ThreadInfoStruct
+  * threadInfoStruct =
+    reinterpret_cast< MultiThreader::ThreadInfoStruct * >( arg );
+
+  // Bind to the n-th processor this thread may run on, so that cpusets
+  // and taskset restrictions are honored.
+  cpu_set_t allowed;
+  bool      bound = false;
+  if ( pthread_getaffinity_np(pthread_self(), sizeof( allowed ), &allowed) == 0 )
+    {
+    const int numberOfProcessors = CPU_COUNT(&allowed);
+    if ( numberOfProcessors > 0 )
+      {
+      int target = static_cast< int >( threadInfoStruct->ThreadID % numberOfProcessors );
+      for ( int cpu = 0; cpu < CPU_SETSIZE; cpu++ )
+        {
+        if ( CPU_ISSET(cpu, &allowed) && target-- == 0 )
+          {
+          cpu_set_t single;
+          CPU_ZERO(&single);
+          CPU_SET(cpu, &single);
+          bound = ( pthread_setaffinity_np(pthread_self(), sizeof( single ), &single) == 0 );
+          break;
+          }
+        }
+      }
+    }
+
+  MultiThreader::SingleMethodProxy(arg);
+
+  if ( bound )
+    {
+    pthread_setaffinity_np(pthread_self(), sizeof( allowed ), &allowed);
+    }
+  return ITK_THREAD_RETURN_VALUE;
+#else
+  // Thread affinity is not supported on this platform
+  return MultiThreader::SingleMethodProxy(arg);
+#endif
+}
 } // end namespace itk
@@ -48,8 +48,6 @@ void MultiThreader::MultipleMethodExecute()
   ThreadIdType thread_loop;
 
   DWORD  threadId;
-  HANDLE process_id[ITK_MAX_THREADS];
-
   // obey the global maximum number of threads limit
   if ( m_NumberOfThreads > m_GlobalMaximumNumberOfThreads )
     {
@@ -58,13 +56,18 @@ void MultiThreader::MultipleMethodExecute()
 
   for ( thread_loop = 0; thread_loop < m_NumberOfThreads; thread_loop++ )
     {
-    if ( m_MultipleMethod[thread_loop] == (ThreadFunctionType)0 )
+    if ( thread_loop >= m_MultipleMethod.size()
+         || m_MultipleMethod[thread_loop] == (ThreadFunctionType)0 )
       {
       itkExceptionMacro(<< "No multiple method set for: " << thread_loop);
       return;
       }
     }
 
+  this->InitializeThreadInfoArray();
+
+  std::vector< HANDLE > process_id(m_NumberOfThreads);
+
   // Using _beginthreadex on a PC
   //
   // We want to use _beginthreadex to start m_NumberOfThreads - 1
@@ -115,34 +118,10 @@ void MultiThreader::MultipleMethodExecute()
 
 int MultiThreader::SpawnThread(ThreadFunctionType f, void *UserData)
 {
-  ThreadIdType id = 0;
+  int id = this->AllocateSpawnedThreadId();
 
   DWORD threadId;
 
-  while ( id < ITK_MAX_THREADS )
-    {
-    if ( !m_SpawnedThreadActiveFlagLock[id]  )
-      {
-      m_SpawnedThreadActiveFlagLock[id] = MutexLock::New();
-      }
-    m_SpawnedThreadActiveFlagLock[id]->Lock();
-    if ( m_SpawnedThreadActiveFlag[id] == 0 )
-      {
-      // We've got a useable thread id, so grab it
-      m_SpawnedThreadActiveFlag[id] = 1;
-      m_SpawnedThreadActiveFlagLock[id]->Unlock();
-      break;
-      }
-    m_SpawnedThreadActiveFlagLock[id]->Unlock();
-
-    id++;
-    }
-
-  if ( id >= ITK_MAX_THREADS )
-    {
-    itkExceptionMacro(<< "You have too many active threads!");
-    }
-
   m_SpawnedThreadInfoArray[id].UserData        = UserData;
   m_SpawnedThreadInfoArray[id].NumberOfThreads = 1;
   m_SpawnedThreadInfoArray[id].ActiveFlag = &m_SpawnedThreadActiveFlag[id];
@@ -163,7 +142,8 @@ int MultiThreader::SpawnThread(ThreadFunctionType f, void *UserData)
 
 void MultiThreader::TerminateThread(ThreadIdType ThreadID)
 {
-  if ( !m_SpawnedThreadActiveFlag[ThreadID] )
+  if ( ThreadID >= m_SpawnedThreadActiveFlag.size()
+       || !m_SpawnedThreadActiveFlag[ThreadID] )
     {
     return;
     }
@@ -189,12 +169,13 @@ MultiThreader
 
 ThreadProcessIDType
 MultiThreader
-::DispatchSingleMethodThread(MultiThreader::ThreadInfoStruct *threadInfo)
+::DispatchSingleMethodThread(MultiThreader::ThreadInfoStruct *threadInfo,
+                             ThreadFunctionType proxy)
 {
   // Using _beginthreadex on a PC
   DWORD  threadId;
   HANDLE threadHandle =  (HANDLE)_beginthreadex(0, 0,
-                                                ( unsigned int (__stdcall *)(void *) ) this->SingleMethodProxy,
+                                                ( unsigned int (__stdcall *)(void *) ) proxy,
                                                 ( (void *)threadInfo ), 0, (unsigned int *)&threadId);
   if ( threadHandle == NULL )
     {
@@ -202,4 +183,44 @@ MultiThreader
     }
   return threadHandle;
 }
+
+ITK_THREAD_RETURN_TYPE
+MultiThreader
+::SingleMethodProxyWithAffinity(void *arg)
+{
+  MultiThreader::ThreadInfoStruct
+  * threadInfoStruct =
+    reinterpret_cast< MultiThreader::ThreadInfoStruct * >( arg );
+
+  // Bind to the n-th processor of the process affinity mask.
+  DWORD_PTR processMask;
+  DWORD_PTR systemMask;
+  DWORD_PTR previousMask = 0;
+  if ( GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask) && processMask )
+    {
+    unsigned int numberOfProcessors = 0;
+    for ( DWORD_PTR mask = processMask; mask; mask &= mask - 1 )
+      {
+      ++numberOfProcessors;
+      }
+    unsigned int target = threadInfoStruct->ThreadID % numberOfProcessors;
+    for ( unsigned int cpu = 0; cpu < 8 * sizeof( DWORD_PTR ); cpu++ )
+      {
+      const DWORD_PTR cpuMask = static_cast< DWORD_PTR >( 1 ) << cpu;
+      if ( ( processMask & cpuMask ) && target-- == 0 )
+        {
+        previousMask = SetThreadAffinityMask(GetCurrentThread(), cpuMask);
+        break;
+        }
+      }
+    }
+
+  MultiThreader::SingleMethodProxy(arg);
+
+  if ( previousMask )
+    {
+    SetThreadAffinityMask(GetCurrentThread(), previousMask);
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
 } // end namespace itk
@@ -0,0 +1,350 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineProfiler.h"
+#include "itkProcessObject.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace itk
+{
+PipelineProfiler::Pointer PipelineProfiler:: m_GlobalDefault;
+SimpleFastMutexLock       PipelineProfiler:: m_GlobalDefaultMutex;
+
+namespace
+{
+/** Orders the statistics by decreasing total time. */
+class TotalTimeGreater
+{
+public:
+  TotalTimeGreater(const std::vector< PipelineProfiler::FilterStatistics > & statistics):
+    m_Statistics(statistics) {}
+
+  bool operator()(SizeValueType a, SizeValueType b) const
+  {
+    return m_Statistics[a].TotalTime > m_Statistics[b].TotalTime;
+  }
+
+private:
+  const std::vector< PipelineProfiler::FilterStatistics > & m_Statistics;
+};
+}
+
+double
+PipelineProfiler::FilterStatistics
+::GetThreadImbalance() const
+{
+  TimeStampType sum = 0;
+  TimeStampType maximum = 0;
+  unsigned int  numberOfThreads = 0;
+
+  for ( size_t t = 0; t < ThreadTime.size(); t++ )
+    {
+    if ( ThreadPixels[t] > 0 )
+      {
+      sum += ThreadTime[t];
+      maximum = std::max(maximum, ThreadTime[t]);
+      ++numberOfThreads;
+      }
+    }
+  if ( sum <= 0 )
+    {
+    return 0;
+    }
+  return maximum * numberOfThreads / sum;
+}
+
+void
+PipelineProfiler
+::SetGlobalDefault(Self *profiler)
+{
+  m_GlobalDefaultMutex.Lock();
+  m_GlobalDefault = profiler;
+  m_GlobalDefaultMutex.Unlock();
+}
+
+PipelineProfiler::Pointer
+PipelineProfiler
+::GetGlobalDefault()
+{
+  m_GlobalDefaultMutex.Lock();
+  Pointer profiler = m_GlobalDefault;
+  m_GlobalDefaultMutex.Unlock();
+  return profiler;
+}
+
+PipelineProfiler
+::PipelineProfiler()
+{
+  m_RealTimeClock = RealTimeClock::New();
+}
+
+PipelineProfiler::FilterStatistics &
+PipelineProfiler
+::GetRecord(const ProcessObject *filter)
+{
+  FilterMapType::const_iterator it = m_FilterIndex.find(filter);
+  if ( it != m_FilterIndex.end() )
+    {
+    return m_Statistics[it->second];
+    }
+
+  // Filters of the same class are numbered in the order of their first
+  // record
+  const std::string className = filter->GetNameOfClass();
+  unsigned int      numberOfInstances = 0;
+  for ( size_t i = 0; i < m_Statistics.size(); i++ )
+    {
+    if ( m_Statistics[i].Name.compare(0, className.size(), className) == 0
+         && ( m_Statistics[i].Name.size() == className.size()
+              || m_Statistics[i].Name[className.size()] == '#' ) )
+      {
+      ++numberOfInstances;
+      }
+    }
+
+  FilterStatistics statistics;
+  std::ostringstream name;
+  name << className;
+  if ( numberOfInstances > 0 )
+    {
+    name << "#" << numberOfInstances + 1;
+    }
+  statistics.Name = name.str();
+
+  m_FilterIndex[filter] = m_Statistics.size();
+  m_Statistics.push_back(statistics);
+  return m_Statistics.back();
+}
+
+void
+PipelineProfiler
+::RecordExecution(const ProcessObject *filter, TimeStampType time,
+                  SizeValueType outputBufferSize)
+{
+  m_Mutex.Lock();
+  FilterStatistics & statistics = this->GetRecord(filter);
+  if ( statistics.NumberOfExecutions == 0 )
+    {
+    statistics.MinimumTime = time;
+    statistics.MaximumTime = time;
+    }
+  else
+    {
+    statistics.MinimumTime = std::min(statistics.MinimumTime, time);
+    statistics.MaximumTime = std::max(statistics.MaximumTime, time);
+    }
+  ++statistics.NumberOfExecutions;
+  statistics.TotalTime += time;
+  statistics.OutputBufferSize = std::max(statistics.OutputBufferSize, outputBufferSize);
+  m_Mutex.Unlock();
+}
+
+void
+PipelineProfiler
+::RecordThread(const ProcessObject *filter, ThreadIdType threadId,
+               TimeStampType time, SizeValueType numberOfPixels)
+{
+  m_Mutex.Lock();
+  FilterStatistics & statistics = this->GetRecord(filter);
+  if ( statistics.ThreadTime.size() <= threadId )
+    {
+    statistics.ThreadTime.resize(threadId + 1, 0);
+    statistics.ThreadPixels.resize(threadId + 1, 0);
+    }
+  statistics.ThreadTime[threadId] += time;
+  statistics.ThreadPixels[threadId] += numberOfPixels;
+  m_Mutex.Unlock();
+}
+
+SizeValueType
+PipelineProfiler
+::GetNumberOfFilters() const
+{
+  m_Mutex.Lock();
+  const SizeValueType numberOfFilters = m_Statistics.size();
+  m_Mutex.Unlock();
+  return numberOfFilters;
+}
+
+PipelineProfiler::FilterStatistics
+PipelineProfiler
+::GetFilterStatistics(SizeValueType i) const
+{
+  FilterStatistics statistics;
+
+  m_Mutex.Lock();
+  if ( i < m_Statistics.size() )
+    {
+    statistics = m_Statistics[i];
+    }
+  m_Mutex.Unlock();
+  return statistics;
+}
+
+PipelineProfiler::FilterStatistics
+PipelineProfiler
+::GetFilterStatistics(const ProcessObject *filter) const
+{
+  FilterStatistics statistics;
+
+  m_Mutex.Lock();
+  FilterMapType::const_iterator it = m_FilterIndex.find(filter);
+  if ( it != m_FilterIndex.end() )
+    {
+    statistics = m_Statistics[it->second];
+    }
+  m_Mutex.Unlock();
+  return statistics;
+}
+
+void
+PipelineProfiler
+::Clear()
+{
+  m_Mutex.Lock();
+  m_FilterIndex.clear();
+  m_Statistics.clear();
+  m_Mutex.Unlock();
+}
+
+void
+PipelineProfiler
+::Report(std::ostream & os, ReportFormatType format) const
+{
+  m_Mutex.Lock();
+  const std::vector< FilterStatistics > statistics = m_Statistics;
+  m_Mutex.Unlock();
+
+  std::vector< SizeValueType > order( statistics.size() );
+  TimeStampType                totalTime = 0;
+  for ( SizeValueType i = 0; i < statistics.size(); i++ )
+    {
+    order[i] = i;
+    totalTime += statistics[i].TotalTime;
+    }
+  std::stable_sort( order.begin(), order.end(), TotalTimeGreater(statistics) );
+
+  const std::ios_base::fmtflags flags = os.flags();
+  const std::streamsize         precision = os.precision();
+
+  if ( format == CSV )
+    {
+    os << "Filter,Executions,TotalTime,MeanTime,MinimumTime,MaximumTime,"
+       << "PercentOfTotalTime,OutputBufferSize,NumberOfThreads,ThreadImbalance,ThreadTimes"
+       << std::endl;
+    }
+  else if ( format == JSON )
+    {
+    os << "{" << std::endl << "  \"Filters\": [";
+    }
+  else
+    {
+    if ( statistics.empty() )
+      {
+      os << "No filter has been profiled" << std::endl;
+      return;
+      }
+    os << std::left << std::setw(40) << "Filter" << std::right
+       << std::setw(11) << "Executions"
+       << std::setw(13) << "Total (s)"
+       << std::setw(13) << "Mean (s)"
+       << std::setw(13) << "Max (s)"
+       << std::setw(9) << "Time %"
+       << std::setw(14) << "Output (MB)"
+       << std::setw(9) << "Threads"
+       << std::setw(11) << "Imbalance" << std::endl;
+    }
+
+  for ( SizeValueType k = 0; k < order.size(); k++ )
+    {
+    const FilterStatistics & s = statistics[order[k]];
+    const TimeStampType      meanTime =
+      s.NumberOfExecutions > 0 ? s.TotalTime / s.NumberOfExecutions : 0;
+    const double percent = totalTime > 0 ? 100.0 * s.TotalTime / totalTime : 0;
+
+    if ( format == CSV )
+      {
+      os << s.Name << "," << s.NumberOfExecutions << "," << s.TotalTime << ","
+         << meanTime << "," << s.MinimumTime << "," << s.MaximumTime << ","
+         << percent << "," << s.OutputBufferSize << "," << s.ThreadTime.size()
+         << "," << s.GetThreadImbalance() << ",";
+      for ( size_t t = 0; t < s.ThreadTime.size(); t++ )
+        {
+        os << ( t > 0 ? ";" : "" ) << s.ThreadTime[t];
+        }
+      os << std::endl;
+      }
+    else if ( format == JSON )
+      {
+      os << ( k > 0 ? "," : "" ) << std::endl
+         << "    {" << std::endl
+         << "      \"Name\": \"" << s.Name << "\"," << std::endl
+         << "      \"Executions\": " << s.NumberOfExecutions << "," << std::endl
+         << "      \"TotalTime\": " << s.TotalTime << "," << std::endl
+         << "      \"MeanTime\": " << meanTime << "," << std::endl
+         << "      \"MinimumTime\": " << s.MinimumTime << "," << std::endl
+         << "      \"MaximumTime\": " << s.MaximumTime << "," << std::endl
+         << "      \"PercentOfTotalTime\": " << percent << "," << std::endl
+         << "      \"OutputBufferSize\": " << s.OutputBufferSize << "," << std::endl
+         << "      \"ThreadImbalance\": " << s.GetThreadImbalance() << "," << std::endl
+         << "      \"Threads\": [";
+      for ( size_t t = 0; t < s.ThreadTime.size(); t++ )
+        {
+        os << ( t > 0 ? ", " : "" ) << "{ \"Id\": " << t << ", \"Time\": "
+           << s.ThreadTime[t] << ", \"Pixels\": " << s.ThreadPixels[t] << " }";
+        }
+      os << "]" << std::endl << "    }";
+      }
+    else
+      {
+      os << std::left << std::setw(40) << s.Name << std::right
+         << std::setw(11) << s.NumberOfExecutions
+         << std::fixed << std::setprecision(6)
+         << std::setw(13) << s.TotalTime
+         << std::setw(13) << meanTime
+         << std::setw(13) << s.MaximumTime
+         << std::setprecision(1)
+         << std::setw(9) << percent
+         << std::setprecision(2)
+         << std::setw(14) << s.OutputBufferSize / ( 1024.0 * 1024.0 )
+         << std::setw(9) << s.ThreadTime.size()
+         << std::setw(11) << s.GetThreadImbalance() << std::endl;
+      os.flags(flags);
+      os.precision(precision);
+      }
+    }
+
+  if ( format == JSON )
+    {
+    os << std::endl << "  ]," << std::endl
+       << "  \"TotalTime\": " << totalTime << std::endl
+       << "}" << std::endl;
+    }
+}
+
+void
+PipelineProfiler
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfFilters: " << this->GetNumberOfFilters() << std::endl;
+}
+} // end namespace itk
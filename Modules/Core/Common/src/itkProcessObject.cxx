@@ -30,6 +30,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <set>
 
 namespace itk
 {
@@ -53,6 +54,100 @@ ProcessObject
   m_ReleaseDataBeforeUpdateFlag = true;
 }
 
+PipelineProfiler::Pointer
+ProcessObject
+::GetActiveProfiler() const
+{
+  if ( m_Profiler )
+    {
+    return m_Profiler;
+    }
+  return PipelineProfiler::GetGlobalDefault();
+}
+
+SizeValueType
+ProcessObject
+::EstimateUpstreamMemorySize()
+{
+  SizeValueType                     size = 0;
+  std::set< const ProcessObject * > visited;
+  std::vector< ProcessObject * >    filters(1, this);
+
+  while ( !filters.empty() )
+    {
+    ProcessObject *filter = filters.back();
+    filters.pop_back();
+
+    for ( DataObjectPointerArraySizeType idx = 0; idx < filter->m_Inputs.size(); ++idx )
+      {
+      DataObject *input = filter->m_Inputs[idx];
+      if ( !input )
+        {
+        continue;
+        }
+      ProcessObject *source = input->GetSource();
+
+      // Same test as DataObject::PropagateRequestedRegion(): the sources
+      // of the inputs that are up to date for their requested region do
+      // not execute
+      if ( !source || visited.count(source) > 0
+           || !( input->GetUpdateMTime() < input->GetPipelineMTime()
+                 || input->GetDataReleased()
+                 || input->RequestedRegionIsOutsideOfTheBufferedRegion() ) )
+        {
+        continue;
+        }
+      visited.insert(source);
+      size += source->GetOutputsRequestedRegionSize();
+      filters.push_back(source);
+      }
+    }
+  return size;
+}
+
+unsigned int
+ProcessObject
+::PlanNumberOfStreamDivisions(SizeValueType memoryBudget,
+                              unsigned int maximumNumberOfDivisions)
+{
+  if ( maximumNumberOfDivisions <= 1
+       || this->EstimateStreamedPieceMemorySize(1) <= memoryBudget )
+    {
+    return 1;
+    }
+
+  // Double the number of divisions until the pieces fit, then bisect
+  // between the last number that did not fit and the first that did
+  unsigned int tooFew = 1;
+  unsigned int enough = 2;
+  while ( enough < maximumNumberOfDivisions
+          && this->EstimateStreamedPieceMemorySize(enough) > memoryBudget )
+    {
+    tooFew = enough;
+    enough = ( enough > maximumNumberOfDivisions / 2 ) ? maximumNumberOfDivisions : 2 * enough;
+    }
+  if ( enough == maximumNumberOfDivisions
+       && this->EstimateStreamedPieceMemorySize(enough) > memoryBudget )
+    {
+    itkWarningMacro(<< "Even the smallest stream pieces need more than the memory budget of "
+                    << memoryBudget << " bytes");
+    return maximumNumberOfDivisions;
+    }
+  while ( enough - tooFew > 1 )
+    {
+    const unsigned int middle = tooFew + ( enough - tooFew ) / 2;
+    if ( this->EstimateStreamedPieceMemorySize(middle) > memoryBudget )
+      {
+      tooFew = middle;
+      }
+    else
+      {
+      enough = middle;
+      }
+    }
+  return enough;
+}
+
 /**
  * This is a default implementation to make sure we have something.
  * Once all the subclasses of ProcessObject provide an appopriate
@@ -588,6 +683,8 @@ ProcessObject
     os << indent << "No Output\n";
     }
 
+  os << indent << "Profiler: " << m_Profiler.GetPointer() << std::endl;
+
   os << indent << "AbortGenerateData: " << ( m_AbortGenerateData ? "On\n" : "Off\n" );
   os << indent << "Progress: " << m_Progress << "\n";
 
@@ -1012,6 +1109,9 @@ ProcessObject
   m_AbortGenerateData = false;
   m_Progress = 0.0f;
 
+  const PipelineProfiler::Pointer       profiler = this->GetActiveProfiler();
+  const PipelineProfiler::TimeStampType startTime = profiler ? profiler->GetTime() : 0;
+
   try
     {
     this->GenerateData();
@@ -1040,6 +1140,12 @@ ProcessObject
     this->UpdateProgress(1.0f);
     }
 
+  if ( profiler )
+    {
+    profiler->RecordExecution( this, profiler->GetTime() - startTime,
+                               this->GetOutputsBufferSize() );
+    }
+
   /**
    * Notify end event observers
    */
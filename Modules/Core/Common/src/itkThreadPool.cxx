@@ -0,0 +1,250 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkThreadPool.h"
+
+#if defined(ITK_USE_WIN32_THREADS)
+#include <process.h>
+#endif
+
+namespace itk
+{
+#if defined(ITK_USE_PTHREADS)
+extern "C"
+{
+typedef void *( *c_void_cast )(void *);
+}
+#endif
+
+ThreadPool::Pointer ThreadPool:: m_Instance;
+SimpleFastMutexLock ThreadPool:: m_InstanceMutex;
+
+ThreadPool::Pointer
+ThreadPool
+::GetInstance()
+{
+  m_InstanceMutex.Lock();
+  if ( m_Instance.IsNull() )
+    {
+    m_Instance = new ThreadPool;
+    // Remove the extra reference taken by the constructor, the static
+    // smart pointer now owns the pool.
+    m_Instance->UnRegister();
+    }
+  m_InstanceMutex.Unlock();
+  return m_Instance;
+}
+
+ThreadPool
+::ThreadPool():
+  m_NextJobId(0),
+  m_NumberOfBusyThreads(0),
+  m_ScheduleForDestruction(false)
+{
+  m_WorkAvailable = ConditionVariable::New();
+  m_JobCompleted = ConditionVariable::New();
+}
+
+ThreadPool
+::~ThreadPool()
+{
+  m_Mutex.Lock();
+  m_ScheduleForDestruction = true;
+  m_WorkAvailable->Broadcast();
+  m_Mutex.Unlock();
+
+  for ( std::vector< ThreadProcessIDType >::iterator it = m_Threads.begin();
+        it != m_Threads.end(); ++it )
+    {
+#if defined(ITK_USE_PTHREADS)
+    pthread_join(*it, 0);
+#elif defined(ITK_USE_WIN32_THREADS)
+    WaitForSingleObject(*it, INFINITE);
+    CloseHandle(*it);
+#endif
+    }
+}
+
+void
+ThreadPool
+::AddThread()
+{
+#if defined(ITK_USE_PTHREADS)
+  pthread_attr_t attr;
+  pthread_t      threadHandle;
+
+  pthread_attr_init(&attr);
+#if !defined( __CYGWIN__ )
+  pthread_attr_setscope(&attr, PTHREAD_SCOPE_SYSTEM);
+#endif
+
+  const int threadError =
+    pthread_create( &threadHandle, &attr, reinterpret_cast< c_void_cast >( ThreadPool::ThreadExecute ),
+                    reinterpret_cast< void * >( this ) );
+  pthread_attr_destroy(&attr);
+  if ( threadError != 0 )
+    {
+    itkExceptionMacro(<< "Unable to create a thread.  pthread_create() returned "
+                      << threadError);
+    }
+  m_Threads.push_back(threadHandle);
+#elif defined(ITK_USE_WIN32_THREADS)
+  DWORD  threadId;
+  HANDLE threadHandle = (HANDLE)_beginthreadex(0, 0,
+                                               ( unsigned int (__stdcall *)(void *) )ThreadPool::ThreadExecute,
+                                               ( (void *)this ), 0, (unsigned int *)&threadId);
+  if ( threadHandle == NULL )
+    {
+    itkExceptionMacro("Error in thread creation !!!");
+    }
+  m_Threads.push_back(threadHandle);
+#endif
+}
+
+ThreadPool::ThreadJobIdType
+ThreadPool
+::AssignWork(ThreadFunctionType f, void *data)
+{
+#if defined(ITK_USE_PTHREADS) || defined(ITK_USE_WIN32_THREADS)
+  m_Mutex.Lock();
+
+  ThreadJob job;
+  job.m_Id = m_NextJobId++;
+  job.m_ThreadFunction = f;
+  job.m_UserData = data;
+
+  // Grow the pool when every worker is already busy or has been promised
+  // an earlier job; this keeps nested submissions from deadlocking. A
+  // worker stops being busy as soon as its job is recorded as completed,
+  // so the workers of a finished execution are reused by the next one.
+  const ThreadIdType numberOfAvailableThreads =
+    static_cast< ThreadIdType >( m_Threads.size() ) - m_NumberOfBusyThreads;
+  if ( m_PendingJobs.size() >= numberOfAvailableThreads )
+    {
+    try
+      {
+      this->AddThread();
+      }
+    catch ( ... )
+      {
+      m_Mutex.Unlock();
+      throw;
+      }
+    }
+
+  m_PendingJobs.push_back(job);
+  m_WorkAvailable->Signal();
+  m_Mutex.Unlock();
+
+  return job.m_Id;
+#else
+  // Without a threading library the job is run by the calling thread.
+  const ThreadJobIdType id = m_NextJobId++;
+  ( *f )(data);
+  m_CompletedJobs.insert(id);
+  return id;
+#endif
+}
+
+void
+ThreadPool
+::WaitForJob(ThreadJobIdType id)
+{
+  m_Mutex.Lock();
+  while ( m_CompletedJobs.find(id) == m_CompletedJobs.end() )
+    {
+    m_JobCompleted->Wait(&m_Mutex);
+    }
+  m_CompletedJobs.erase(id);
+  m_Mutex.Unlock();
+}
+
+ThreadIdType
+ThreadPool
+::GetNumberOfThreads() const
+{
+  m_Mutex.Lock();
+  const ThreadIdType numberOfThreads = static_cast< ThreadIdType >( m_Threads.size() );
+  m_Mutex.Unlock();
+  return numberOfThreads;
+}
+
+ThreadIdType
+ThreadPool
+::GetNumberOfIdleThreads() const
+{
+  m_Mutex.Lock();
+  const ThreadIdType numberOfIdleThreads =
+    static_cast< ThreadIdType >( m_Threads.size() ) - m_NumberOfBusyThreads;
+  m_Mutex.Unlock();
+  return numberOfIdleThreads;
+}
+
+ITK_THREAD_RETURN_TYPE
+ThreadPool
+::ThreadExecute(void *arg)
+{
+  ThreadPool *pool = reinterpret_cast< ThreadPool * >( arg );
+
+  pool->m_Mutex.Lock();
+  while ( true )
+    {
+    while ( pool->m_PendingJobs.empty() && !pool->m_ScheduleForDestruction )
+      {
+      pool->m_WorkAvailable->Wait(&pool->m_Mutex);
+      }
+    if ( pool->m_PendingJobs.empty() )
+      {
+      // Only reached once the pool is being destroyed.
+      break;
+      }
+
+    const ThreadJob job = pool->m_PendingJobs.front();
+    pool->m_PendingJobs.pop_front();
+    ++pool->m_NumberOfBusyThreads;
+    pool->m_Mutex.Unlock();
+
+    // The MultiThreader submits SingleMethodProxy, which already catches
+    // exceptions; this guards the worker against any other callback.
+    try
+      {
+      ( *job.m_ThreadFunction )(job.m_UserData);
+      }
+    catch ( ... )
+      {
+      }
+
+    pool->m_Mutex.Lock();
+    pool->m_CompletedJobs.insert(job.m_Id);
+    --pool->m_NumberOfBusyThreads;
+    pool->m_JobCompleted->Broadcast();
+    }
+  pool->m_Mutex.Unlock();
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+void
+ThreadPool
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Threads: " << this->GetNumberOfThreads() << std::endl;
+  os << indent << "Number Of Idle Threads: " << this->GetNumberOfIdleThreads() << std::endl;
+}
+} // end namespace itk
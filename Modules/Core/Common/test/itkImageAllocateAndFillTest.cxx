@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkVectorImage.h"
+#include "itkSymmetricSecondRankTensor.h"
+#include "itkRGBAPixel.h"
+#include "itkPixelTraits.h"
+#include "itkImageRegionConstIterator.h"
+
+namespace
+{
+int numberOfConstructions = 0;
+int numberOfLiveElements = 0;
+int numberOfAssignments = 0;
+
+class ImageAllocateAndFillTestElement
+{
+public:
+  ImageAllocateAndFillTestElement():m_Value(0)
+  { ++numberOfConstructions; ++numberOfLiveElements; }
+  ImageAllocateAndFillTestElement(const ImageAllocateAndFillTestElement & other):m_Value(other.m_Value)
+  { ++numberOfConstructions; ++numberOfLiveElements; }
+  ~ImageAllocateAndFillTestElement() { --numberOfLiveElements; }
+  ImageAllocateAndFillTestElement & operator=(const ImageAllocateAndFillTestElement & other)
+  { ++numberOfAssignments; m_Value = other.m_Value; return *this; }
+  int m_Value;
+};
+
+template< class TImage >
+bool CheckAllPixels(const TImage *image, const typename TImage::PixelType & value)
+{
+  itk::ImageRegionConstIterator< TImage > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != value )
+      {
+      std::cerr << "Wrong value " << it.Get() << " instead of " << value << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+int CheckContainer(itk::ImageBufferAllocator *allocator)
+{
+  typedef itk::ImportImageContainer< itk::SizeValueType, ImageAllocateAndFillTestElement > ContainerType;
+
+  ContainerType::Pointer container = ContainerType::New();
+  container->SetAllocator(allocator);
+
+  // No element is constructed by ReserveUninitialized()
+  numberOfConstructions = 0;
+  container->ReserveUninitialized(100);
+  if ( numberOfConstructions != 0 || container->Size() != 100 )
+    {
+    std::cerr << "ReserveUninitialized() constructed " << numberOfConstructions << " elements" << std::endl;
+    return EXIT_FAILURE;
+    }
+  container->Initialize();
+
+  // Every element is copy constructed once by ReserveAndFill()
+  ImageAllocateAndFillTestElement value;
+  value.m_Value = 42;
+  numberOfConstructions = 0;
+  numberOfAssignments = 0;
+  numberOfLiveElements = 1;
+  container->ReserveAndFill(100, value);
+  if ( numberOfConstructions != 100 || numberOfAssignments != 0 || ( *container )[99].m_Value != 42 )
+    {
+    std::cerr << "ReserveAndFill() constructed " << numberOfConstructions
+              << " elements and assigned " << numberOfAssignments << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // A large enough buffer is reused and assigned
+  value.m_Value = 43;
+  container->ReserveAndFill(50, value);
+  if ( numberOfConstructions != 100 || ( *container )[49].m_Value != 43 || container->Capacity() != 100 )
+    {
+    std::cerr << "ReserveAndFill() did not reuse the buffer" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  container->Initialize();
+  if ( numberOfLiveElements != 1 )
+    {
+    std::cerr << numberOfLiveElements - 1 << " elements were not destroyed" << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int itkImageAllocateAndFillTest(int, char *[])
+{
+  typedef itk::SymmetricSecondRankTensor< float, 3 >           TensorType;
+  typedef itk::Image< TensorType, 3 >                          TensorImageType;
+  typedef itk::Image< itk::VariableLengthVector< double >, 2 > VariableLengthImageType;
+  typedef itk::VectorImage< short, 3 >                         VectorImageType;
+
+  TensorImageType::SizeType size;
+  size.Fill(17);
+
+  TensorType tensor;
+  tensor.Fill(2.5);
+
+  TensorImageType::Pointer tensorImage = TensorImageType::New();
+  tensorImage->SetRegions(size);
+  tensorImage->AllocateAndFill(tensor);
+  if ( !CheckAllPixels(tensorImage.GetPointer(), tensor) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // uninitialized pixels are written before being read
+  tensorImage->Initialize();
+  tensorImage->SetRegions(size);
+  tensorImage->AllocateUninitialized();
+  tensorImage->FillBuffer(tensor);
+  if ( !CheckAllPixels(tensorImage.GetPointer(), tensor) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // pixels that own memory are copy constructed
+  VariableLengthImageType::SizeType vlSize;
+  vlSize.Fill(9);
+  VariableLengthImageType::PixelType vlValue(4);
+  vlValue.Fill(-1.0);
+  VariableLengthImageType::Pointer vlImage = VariableLengthImageType::New();
+  vlImage->SetRegions(vlSize);
+  vlImage->AllocateAndFill(vlValue);
+  if ( !CheckAllPixels(vlImage.GetPointer(), vlValue) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(size);
+  vectorImage->SetVectorLength(3);
+  VectorImageType::PixelType vectorValue(3);
+  vectorValue[0] = 1;
+  vectorValue[1] = -2;
+  vectorValue[2] = 3;
+  vectorImage->AllocateAndFill(vectorValue);
+  if ( !CheckAllPixels(vectorImage.GetPointer(), vectorValue) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // ImageSource::AllocateOutputs() leaves only plain pixel types unconstructed
+  if ( !itk::PixelAllocationTraits< TensorType >::CanBeUninitialized
+       || !itk::PixelAllocationTraits< itk::RGBAPixel< unsigned char > >::CanBeUninitialized
+       || itk::PixelAllocationTraits< itk::VariableLengthVector< double > >::CanBeUninitialized
+       || itk::PixelAllocationTraits< ImageAllocateAndFillTestElement >::CanBeUninitialized )
+    {
+    std::cerr << "Wrong PixelAllocationTraits" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // with new[] and with an allocator
+  itk::ImageBufferAllocator::Pointer allocator = itk::ImageBufferAllocator::New();
+  if ( CheckContainer(NULL) != EXIT_SUCCESS || CheckContainer(allocator) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
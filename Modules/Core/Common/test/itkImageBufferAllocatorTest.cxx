@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferAllocator.h"
+#include "itkImage.h"
+#include "itkVectorImage.h"
+
+namespace
+{
+int numberOfLiveElements = 0;
+
+class ImageBufferAllocatorTestElement
+{
+public:
+  ImageBufferAllocatorTestElement():m_Value(7) { ++numberOfLiveElements; }
+  ~ImageBufferAllocatorTestElement() { --numberOfLiveElements; }
+  int m_Value;
+};
+
+bool IsAligned(const void *pointer, size_t alignment)
+{
+  return reinterpret_cast< size_t >( pointer ) % alignment == 0;
+}
+}
+
+int itkImageBufferAllocatorTest(int, char *[])
+{
+  typedef itk::Image< float, 3 >                ImageType;
+  typedef itk::VectorImage< unsigned char, 3 >  VectorImageType;
+
+  itk::ImageBufferAllocator::Pointer allocator = itk::ImageBufferAllocator::New();
+  allocator->PoolingOn();
+  allocator->Print(std::cout);
+
+  ImageType::RegionType region;
+  ImageType::SizeType   size;
+  size[0] = 101;
+  size[1] = 53;
+  size[2] = 7;
+  region.SetSize(size);
+
+  // Buffers are aligned and recycled across executions
+  ImageType::Pointer image = ImageType::New();
+  image->GetPixelContainer()->SetAllocator(allocator);
+  image->SetRegions(region);
+  for ( unsigned int i = 0; i < 5; i++ )
+    {
+    image->Allocate();
+    if ( !IsAligned(image->GetBufferPointer(), 64) )
+      {
+      std::cerr << "Buffer " << image->GetBufferPointer() << " is not 64-byte aligned" << std::endl;
+      return EXIT_FAILURE;
+      }
+    image->FillBuffer(i);
+    // releases the buffer and keeps the allocator, like ReleaseData()
+    image->Initialize();
+    image->SetRegions(region);
+    }
+  if ( image->GetPixelContainer()->GetAllocator() != allocator.GetPointer() )
+    {
+    std::cerr << "The allocator of the image was not kept by Initialize()" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( allocator->GetNumberOfAllocations() != 5 || allocator->GetNumberOfPoolHits() != 4
+       || allocator->GetNumberOfDeallocations() != 5 || allocator->GetPoolSize() == 0 )
+    {
+    allocator->Print(std::cerr);
+    std::cerr << "Unexpected pool statistics" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The pool never holds more than MaximumPoolSize bytes
+  allocator->ReleasePool();
+  allocator->ResetStatistics();
+  allocator->SetMaximumPoolSize(0);
+  image->Allocate();
+  image->Initialize();
+  if ( allocator->GetPoolSize() != 0 || allocator->GetNumberOfDeallocations() != 1 )
+    {
+    std::cerr << "Block kept beyond MaximumPoolSize" << std::endl;
+    return EXIT_FAILURE;
+    }
+  allocator->SetMaximumPoolSize(1 << 30);
+
+  // Large blocks are aligned on huge pages
+  allocator->HugePagesOn();
+  void *block = allocator->Allocate( 3 * itk::ImageBufferAllocator::GetHugePageSize() );
+  if ( !IsAligned(block, itk::ImageBufferAllocator::GetHugePageSize()) )
+    {
+    std::cerr << "Huge page block " << block << " is not aligned" << std::endl;
+    return EXIT_FAILURE;
+    }
+  allocator->Deallocate( block, 3 * itk::ImageBufferAllocator::GetHugePageSize() );
+  allocator->HugePagesOff();
+
+  // Elements of non trivial types are constructed and destroyed
+  typedef itk::ImportImageContainer< itk::SizeValueType, ImageBufferAllocatorTestElement > ContainerType;
+  ContainerType::Pointer container = ContainerType::New();
+  container->SetAllocator(allocator);
+  container->Reserve(1000);
+  if ( numberOfLiveElements != 1000 || ( *container )[999].m_Value != 7 )
+    {
+    std::cerr << numberOfLiveElements << " elements constructed instead of 1000" << std::endl;
+    return EXIT_FAILURE;
+    }
+  container->Reserve(2000);
+  container->Squeeze();
+  container->Initialize();
+  if ( numberOfLiveElements != 0 )
+    {
+    std::cerr << numberOfLiveElements << " elements were not destroyed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // New images use the global default allocator
+  itk::ImageBufferAllocator::SetGlobalDefault(allocator);
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  itk::ImageBufferAllocator::SetGlobalDefault(NULL);
+  if ( vectorImage->GetPixelContainer()->GetAllocator() != allocator.GetPointer()
+       || ImageType::New()->GetPixelContainer()->GetAllocator() != NULL )
+    {
+    std::cerr << "The global default allocator was not used" << std::endl;
+    return EXIT_FAILURE;
+    }
+  allocator->SetAlignment(256);
+  vectorImage->SetRegions(region);
+  vectorImage->SetVectorLength(3);
+  vectorImage->Allocate();
+  if ( !IsAligned(vectorImage->GetBufferPointer(), 256) )
+    {
+    std::cerr << "Buffer " << vectorImage->GetBufferPointer() << " is not 256-byte aligned" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  allocator->Print(std::cout);
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSource.h"
+#include "itkImageBufferAllocator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkRGBAPixel.h"
+#include "itkSymmetricSecondRankTensor.h"
+#include <cstring>
+
+namespace itk
+{
+/** \class ImageSourceAllocateOutputsTestAllocator
+ * Fills every new block with a non zero pattern, so that pixels which are
+ * not constructed can be told from zeroed ones.
+ */
+class ImageSourceAllocateOutputsTestAllocator:public ImageBufferAllocator
+{
+public:
+  typedef ImageSourceAllocateOutputsTestAllocator Self;
+  typedef ImageBufferAllocator                    Superclass;
+  typedef SmartPointer< Self >                    Pointer;
+  typedef SmartPointer< const Self >              ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(ImageSourceAllocateOutputsTestAllocator, ImageBufferAllocator);
+
+protected:
+  ImageSourceAllocateOutputsTestAllocator() {}
+
+  void * AllocateBlock(SizeValueType numberOfBytes)
+  {
+    void *block = Superclass::AllocateBlock(numberOfBytes);
+    if ( block )
+      {
+      std::memset(block, 0xcd, numberOfBytes);
+      }
+    return block;
+  }
+
+private:
+  ImageSourceAllocateOutputsTestAllocator(const Self &); //purposely not implemented
+  void operator=(const Self &);                          //purposely not implemented
+};
+
+/** \class ImageSourceAllocateOutputsTestSource
+ * Writes the pixels of even x index only, and relies on the others being
+ * constructed by AllocateOutputs(). The pixel types checked here are
+ * zeroed by their default constructor.
+ */
+template< class TOutputImage >
+class ImageSourceAllocateOutputsTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef ImageSourceAllocateOutputsTestSource Self;
+  typedef ImageSource< TOutputImage >          Superclass;
+  typedef SmartPointer< Self >                 Pointer;
+  typedef SmartPointer< const Self >           ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(ImageSourceAllocateOutputsTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+  typedef typename TOutputImage::PixelType           PixelType;
+
+  itkSetMacro(Value, PixelType);
+
+  /** Expose the protected setter */
+  void SetUninitialized(bool uninitialized)
+  {
+    this->SetAllocateOutputsUninitialized(uninitialized);
+  }
+
+protected:
+  ImageSourceAllocateOutputsTestSource() {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::SizeType size;
+    size.Fill(37);
+    typename TOutputImage::RegionType region(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType)
+  {
+    ImageRegionIteratorWithIndex< TOutputImage > it(this->GetOutput(), region);
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      if ( it.GetIndex()[0] % 2 == 0 )
+        {
+        it.Set(m_Value);
+        }
+      }
+  }
+
+private:
+  ImageSourceAllocateOutputsTestSource(const Self &); //purposely not implemented
+  void operator=(const Self &);                       //purposely not implemented
+
+  PixelType m_Value;
+};
+}
+
+namespace
+{
+template< class TPixel >
+int CheckAllocateOutputs(const char *name, const TPixel & value)
+{
+  typedef itk::Image< TPixel, 2 >                                ImageType;
+  typedef itk::ImageSourceAllocateOutputsTestSource< ImageType > SourceType;
+
+  typename SourceType::Pointer source = SourceType::New();
+  if ( source->GetAllocateOutputsUninitialized() )
+    {
+    std::cerr << name << ": AllocateOutputsUninitialized should be off by default" << std::endl;
+    return EXIT_FAILURE;
+    }
+  source->SetValue(value);
+  source->SetNumberOfThreads(3);
+  source->Update();
+
+  // The pixels which are not written keep the value of their default
+  // constructor
+  const TPixel zero = TPixel();
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( source->GetOutput(),
+                                                          source->GetOutput()->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const TPixel expected = ( it.GetIndex()[0] % 2 == 0 ) ? value : zero;
+    if ( it.Get() != expected )
+      {
+      std::cerr << name << ": the value at " << it.GetIndex() << " is " << it.Get()
+                << " instead of " << expected << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A filter which turns AllocateOutputsUninitialized on gets unconstructed
+  // pixels
+  typename SourceType::Pointer uninitializedSource = SourceType::New();
+  uninitializedSource->SetUninitialized(true);
+  uninitializedSource->SetValue(value);
+  uninitializedSource->Update();
+  const TPixel *buffer = uninitializedSource->GetOutput()->GetBufferPointer();
+  const unsigned char *firstOddPixel = reinterpret_cast< const unsigned char * >( buffer + 1 );
+  for ( unsigned int i = 0; i < sizeof( TPixel ); i++ )
+    {
+    if ( firstOddPixel[i] != 0xcd )
+      {
+      std::cerr << name << ": the pixels were constructed with AllocateOutputsUninitialized on" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+struct ImageSourceAllocateOutputsTestFunctor {
+  float operator()(float x) const { return x; }
+  bool operator!=(const ImageSourceAllocateOutputsTestFunctor &) const { return false; }
+};
+}
+
+int itkImageSourceAllocateOutputsTest(int, char *[])
+{
+  itk::ImageBufferAllocator::Pointer previousAllocator = itk::ImageBufferAllocator::GetGlobalDefault();
+  itk::ImageSourceAllocateOutputsTestAllocator::Pointer allocator =
+    itk::ImageSourceAllocateOutputsTestAllocator::New();
+  itk::ImageBufferAllocator::SetGlobalDefault(allocator);
+
+  typedef itk::RGBAPixel< unsigned char >            RGBAPixelType;
+  typedef itk::SymmetricSecondRankTensor< float, 3 > TensorType;
+
+  RGBAPixelType rgba;
+  rgba.Set(10, 20, 30, 40);
+  TensorType tensor;
+  tensor.Fill(2.5f);
+
+  int result = EXIT_SUCCESS;
+  if ( CheckAllocateOutputs< RGBAPixelType >("RGBAPixel", rgba) != EXIT_SUCCESS
+       || CheckAllocateOutputs< TensorType >("SymmetricSecondRankTensor", tensor) != EXIT_SUCCESS )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  // The filters which write their whole output turn it on
+  typedef itk::Image< float, 2 > FloatImageType;
+  typedef itk::UnaryFunctorImageFilter< FloatImageType, FloatImageType,
+                                        ImageSourceAllocateOutputsTestFunctor > FunctorFilterType;
+  FunctorFilterType::Pointer functorFilter = FunctorFilterType::New();
+  if ( !functorFilter->GetAllocateOutputsUninitialized() )
+    {
+    std::cerr << "UnaryFunctorImageFilter should turn AllocateOutputsUninitialized on" << std::endl;
+    result = EXIT_FAILURE;
+    }
+
+  itk::ImageBufferAllocator::SetGlobalDefault(previousAllocator);
+  if ( result == EXIT_SUCCESS )
+    {
+    std::cout << "Test PASSED !" << std::endl;
+    }
+  return result;
+}
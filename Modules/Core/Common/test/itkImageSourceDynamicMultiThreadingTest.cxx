@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSource.h"
+#include "itkImageRegionIterator.h"
+
+#include <algorithm>
+
+namespace itk
+{
+/** \class ImageSourceDynamicMultiThreadingTestSource
+ * Increments every pixel of the region it is given, and counts the
+ * number of calls to ThreadedGenerateData() and to
+ * DynamicThreadedGenerateData() made by each thread.
+ */
+template< class TOutputImage >
+class ImageSourceDynamicMultiThreadingTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef ImageSourceDynamicMultiThreadingTestSource Self;
+  typedef ImageSource< TOutputImage >                Superclass;
+  typedef SmartPointer< Self >                       Pointer;
+  typedef SmartPointer< const Self >                 ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(ImageSourceDynamicMultiThreadingTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  /** The filter can be scheduled both ways */
+  void SetScheduleDynamically(bool dynamic)
+  {
+    this->SetDynamicMultiThreading(dynamic);
+  }
+
+  unsigned int GetNumberOfCalls() const
+  {
+    return Sum(m_NumberOfCalls);
+  }
+
+  unsigned int GetNumberOfDynamicCalls() const
+  {
+    return Sum(m_NumberOfDynamicCalls);
+  }
+
+  /** Largest number of calls to ThreadedGenerateData() made by a thread */
+  unsigned int GetMaximumNumberOfCallsPerThread() const
+  {
+    unsigned int maximum = 0;
+    for ( unsigned int i = 0; i < m_NumberOfCalls.size(); i++ )
+      {
+      maximum = std::max(maximum, m_NumberOfCalls[i]);
+      }
+    return maximum;
+  }
+
+protected:
+  ImageSourceDynamicMultiThreadingTestSource() {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::RegionType region;
+    typename TOutputImage::SizeType   size;
+    size.Fill(16);
+    // the outermost axis is split; make it divisible by the number of pieces
+    size[TOutputImage::ImageDimension - 1] = 120;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void BeforeThreadedGenerateData()
+  {
+    this->GetOutput()->FillBuffer(0);
+    m_NumberOfCalls.assign(this->GetNumberOfThreads(), 0);
+    m_NumberOfDynamicCalls.assign(this->GetNumberOfThreads(), 0);
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType threadId)
+  {
+    m_NumberOfCalls[threadId]++;
+    this->IncrementRegion(region);
+  }
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType threadId)
+  {
+    m_NumberOfDynamicCalls[threadId]++;
+    this->IncrementRegion(region);
+  }
+
+  void IncrementRegion(const OutputImageRegionType & region)
+  {
+    ImageRegionIterator< TOutputImage > it(this->GetOutput(), region);
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      it.Set( it.Get() + 1 );
+      }
+  }
+
+  static unsigned int Sum(const std::vector< unsigned int > & calls)
+  {
+    unsigned int total = 0;
+    for ( unsigned int i = 0; i < calls.size(); i++ )
+      {
+      total += calls[i];
+      }
+    return total;
+  }
+
+private:
+  ImageSourceDynamicMultiThreadingTestSource(const Self &); //purposely not implemented
+  void operator=(const Self &);                             //purposely not implemented
+
+  std::vector< unsigned int > m_NumberOfCalls;
+  std::vector< unsigned int > m_NumberOfDynamicCalls;
+};
+}
+
+namespace
+{
+template< class TImage >
+bool CheckEveryPixelGeneratedOnce(const TImage *image)
+{
+  itk::ImageRegionConstIterator< TImage > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != 1 )
+      {
+      std::cerr << "Pixel " << it.GetIndex() << " was generated "
+                << it.Get() << " times" << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkImageSourceDynamicMultiThreadingTest(int, char *[])
+{
+  typedef itk::Image< unsigned int, 3 >                                 ImageType;
+  typedef itk::ImageSourceDynamicMultiThreadingTestSource< ImageType > SourceType;
+
+  SourceType::Pointer source = SourceType::New();
+  source->SetNumberOfThreads(4);
+
+  if ( source->GetDynamicMultiThreading() )
+    {
+    std::cerr << "DynamicMultiThreading should be off by default" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Static scheduling: ThreadedGenerateData() is called at most once per
+  // thread
+  source->Update();
+  if ( !CheckEveryPixelGeneratedOnce( source->GetOutput() ) )
+    {
+    return EXIT_FAILURE;
+    }
+  if ( source->GetMaximumNumberOfCallsPerThread() != 1 || source->GetNumberOfDynamicCalls() != 0 )
+    {
+    std::cerr << "With static scheduling, a thread called ThreadedGenerateData "
+              << source->GetMaximumNumberOfCallsPerThread() << " times and DynamicThreadedGenerateData "
+              << source->GetNumberOfDynamicCalls() << " times" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Dynamic scheduling: every piece goes to DynamicThreadedGenerateData()
+  source->SetScheduleDynamically(true);
+  source->SetNumberOfPiecesPerThread(5);
+  source->Update();
+  source->Print(std::cout);
+
+  if ( !source->GetDynamicMultiThreading() || !CheckEveryPixelGeneratedOnce( source->GetOutput() ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  const unsigned int expectedNumberOfCalls =
+    source->GetMultiThreader()->GetNumberOfThreads() * source->GetNumberOfPiecesPerThread();
+  if ( source->GetNumberOfDynamicCalls() != expectedNumberOfCalls || source->GetNumberOfCalls() != 0 )
+    {
+    std::cerr << "DynamicThreadedGenerateData was called " << source->GetNumberOfDynamicCalls()
+              << " times instead of " << expectedNumberOfCalls << ", and ThreadedGenerateData "
+              << source->GetNumberOfCalls() << " times instead of 0" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,203 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSource.h"
+#include "itkImageRegionIterator.h"
+#include "itkVectorImage.h"
+
+namespace itk
+{
+/** \class ImageSourceNUMAAwareAllocationTestSource
+ * Adds the linear index of every pixel to its current value, so that the
+ * result of a second execution tells whether the first touch of the
+ * buffer preserved its content.
+ */
+template< class TOutputImage >
+class ImageSourceNUMAAwareAllocationTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef ImageSourceNUMAAwareAllocationTestSource Self;
+  typedef ImageSource< TOutputImage >              Superclass;
+  typedef SmartPointer< Self >                     Pointer;
+  typedef SmartPointer< const Self >               ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(ImageSourceNUMAAwareAllocationTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  itkSetMacro(Clear, bool);
+
+  /** Whether the threads were bound to processors while the output was
+   * generated */
+  itkGetConstMacro(ThreadAffinityDuringGeneration, bool);
+
+protected:
+  ImageSourceNUMAAwareAllocationTestSource():m_Clear(true), m_ThreadAffinityDuringGeneration(false) {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::RegionType region;
+    typename TOutputImage::SizeType   size;
+    // lines of 4000 bytes or more, so that pages start in the middle of lines
+    size[0] = 1000;
+    size[1] = 37;
+    size[2] = 5;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+    this->GetOutput()->SetNumberOfComponentsPerPixel(2);
+  }
+
+  void BeforeThreadedGenerateData()
+  {
+    m_ThreadAffinityDuringGeneration = this->GetMultiThreader()->GetUseThreadAffinity();
+    if ( m_Clear )
+      {
+      typename TOutputImage::PixelType zero;
+      NumericTraits< typename TOutputImage::PixelType >::SetLength(
+        zero, this->GetOutput()->GetNumberOfComponentsPerPixel() );
+      zero.Fill(0);
+      this->GetOutput()->FillBuffer(zero);
+      }
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType)
+  {
+    TOutputImage *output = this->GetOutput();
+
+    ImageRegionIterator< TOutputImage > it(output, region);
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      typename TOutputImage::PixelType value = it.Get();
+      value[0] += output->ComputeOffset( it.GetIndex() );
+      value[1] += 1;
+      it.Set(value);
+      }
+  }
+
+private:
+  ImageSourceNUMAAwareAllocationTestSource(const Self &); //purposely not implemented
+  void operator=(const Self &);                           //purposely not implemented
+
+  bool m_Clear;
+  bool m_ThreadAffinityDuringGeneration;
+};
+}
+
+namespace
+{
+ITK_THREAD_RETURN_TYPE NUMAAwareAllocationTestCallback(void *arg)
+{
+  itk::MultiThreader::ThreadInfoStruct *info =
+    static_cast< itk::MultiThreader::ThreadInfoStruct * >( arg );
+  std::vector< unsigned int > *counter =
+    static_cast< std::vector< unsigned int > * >( info->UserData );
+
+  ( *counter )[info->ThreadID]++;
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< class TImage >
+int CheckNUMAAwareAllocation(const char *name, unsigned int numberOfExecutions)
+{
+  typedef itk::ImageSourceNUMAAwareAllocationTestSource< TImage > SourceType;
+
+  typename SourceType::Pointer source = SourceType::New();
+  source->SetNumberOfThreads(4);
+  if ( source->GetNUMAAwareAllocation() )
+    {
+    std::cerr << "NUMAAwareAllocation should be off by default" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const bool useThreadAffinity = source->GetMultiThreader()->GetUseThreadAffinity();
+  source->NUMAAwareAllocationOn();
+  source->Update();
+
+  // The buffer is reused: the values of the first execution must survive
+  // the first touch of the later ones
+  source->SetClear(false);
+  for ( unsigned int i = 1; i < numberOfExecutions; i++ )
+    {
+    source->Modified();
+    source->Update();
+    }
+
+  if ( !source->GetThreadAffinityDuringGeneration() )
+    {
+    std::cerr << name << ": thread affinity was not turned on" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( source->GetMultiThreader()->GetUseThreadAffinity() != useThreadAffinity )
+    {
+    std::cerr << name << ": the thread affinity of the threader was not restored" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  TImage *output = source->GetOutput();
+  itk::ImageRegionIterator< TImage > it( output, output->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const typename TImage::PixelType value = it.Get();
+    if ( value[0] != numberOfExecutions * output->ComputeOffset( it.GetIndex() )
+         || value[1] != numberOfExecutions )
+      {
+      std::cerr << name << ": wrong value " << value << " at " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int itkImageSourceNUMAAwareAllocationTest(int, char *[])
+{
+  typedef itk::Image< itk::Vector< unsigned int, 2 >, 3 > ImageType;
+  typedef itk::VectorImage< unsigned int, 3 >            VectorImageType;
+
+  if ( CheckNUMAAwareAllocation< ImageType >("Image", 3) != EXIT_SUCCESS
+       || CheckNUMAAwareAllocation< VectorImageType >("VectorImage", 3) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Every thread must run exactly once with thread affinity on, whether the
+  // threads are created or taken from the pool
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(8);
+  threader->UseThreadAffinityOn();
+  threader->Print(std::cout);
+
+  std::vector< unsigned int > counter(threader->GetNumberOfThreads(), 0);
+  threader->SetSingleMethod(NUMAAwareAllocationTestCallback, &counter);
+  for ( int useThreadPool = 0; useThreadPool < 2; useThreadPool++ )
+    {
+    threader->SetUseThreadPool(useThreadPool != 0);
+    threader->SingleMethodExecute();
+    }
+  for ( unsigned int t = 0; t < counter.size(); t++ )
+    {
+    if ( counter[t] != 2 )
+      {
+      std::cerr << "Thread " << t << " ran " << counter[t] << " times instead of 2" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 #include "itkConfigure.h"
 #include "itkMultiThreader.h"
 #include <stdlib.h>
+#include <vector>
 
 bool VerifyRange(int value, int min, int max, const char * msg)
 {
@@ -37,6 +38,16 @@ bool VerifyRange(int value, int min, int max, const char * msg)
 }
 
 
+ITK_THREAD_RETURN_TYPE CountThreadsCallback( void *ptr )
+{
+  itk::MultiThreader::ThreadInfoStruct * info =
+    static_cast< itk::MultiThreader::ThreadInfoStruct * >( ptr );
+  std::vector< unsigned int > * counter =
+    static_cast< std::vector< unsigned int > * >( info->UserData );
+  ( *counter )[info->ThreadID]++;
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 bool SetAndVerifyGlobalMaximumNumberOfThreads( int value )
 {
   itk::MultiThreader::SetGlobalMaximumNumberOfThreads( value );
@@ -127,6 +138,47 @@ int itkMultiThreaderTest(int argc, char* argv[])
 
   }
 
+  {
+  // The per-thread storage is allocated for each execution, so more
+  // threads than the former static limit of 128 can be used. The global
+  // maximum is restored afterwards, whatever the outcome.
+  const itk::ThreadIdType manyThreads = 200;
+  const itk::ThreadIdType previousGlobalMaximum = itk::MultiThreader::GetGlobalMaximumNumberOfThreads();
+  itk::MultiThreader::SetGlobalMaximumNumberOfThreads( manyThreads );
+  itk::MultiThreader::Pointer threader3 = itk::MultiThreader::New();
+  threader3->SetNumberOfThreads( manyThreads );
+  bool manyThreadsPassed = true;
+  if( threader3->GetNumberOfThreads() != manyThreads )
+    {
+    std::cerr << "Could not set " << manyThreads << " threads" << std::endl;
+    manyThreadsPassed = false;
+    }
+  else
+    {
+    std::vector< unsigned int > counter( manyThreads, 0 );
+    threader3->SetSingleMethod( CountThreadsCallback, &counter );
+    threader3->SingleMethodExecute();
+    for( itk::ThreadIdType t = 0; t < manyThreads; t++ )
+      {
+      if( counter[t] != 1 )
+        {
+        std::cerr << "Thread " << t << " ran " << counter[t] << " times" << std::endl;
+        manyThreadsPassed = false;
+        }
+      }
+    }
+  itk::MultiThreader::SetGlobalMaximumNumberOfThreads( previousGlobalMaximum );
+  if( itk::MultiThreader::GetGlobalMaximumNumberOfThreads() != previousGlobalMaximum )
+    {
+    std::cerr << "Could not restore the global maximum number of threads" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if( !manyThreadsPassed )
+    {
+    return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
 
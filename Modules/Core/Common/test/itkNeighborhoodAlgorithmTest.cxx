@@ -18,8 +18,10 @@
 
 
 #include "itkImage.h"
+#include "itkVectorImage.h"
 #include "itkImageRegionIterator.h"
 #include "itkNeighborhoodAlgorithm.h"
+#include "itkConstantBoundaryCondition.h"
 
 template<class TImage>
 bool ImageBoundaryFaceCalculatorTest(TImage * image, const typename TImage::RegionType & region, const typename TImage::SizeType & radius)
@@ -95,6 +97,140 @@ bool NeighborhoodAlgorithmTest()
   return true;
 }
 
+// Owner of the ProgressReporter given to ApplyNeighborhoodKernel
+class KernelTestProcessObject : public itk::ProcessObject
+{
+public:
+  typedef KernelTestProcessObject       Self;
+  typedef itk::ProcessObject            Superclass;
+  typedef itk::SmartPointer< Self >     Pointer;
+  itkNewMacro(Self);
+};
+
+// Weights each neighbor by its position, and each component of the
+// vector pixels by its rank.
+struct WeightedSumKernel
+{
+  template< class TNeighborhood >
+  double operator()(const TNeighborhood & neighborhood) const
+  {
+    double sum = 0.0;
+    for ( unsigned int i = 0; i < neighborhood.Size(); ++i )
+      {
+      sum += ( i + 1 ) * PixelValue( neighborhood.GetPixel(i) );
+      }
+    for ( unsigned int d = 0; d < TNeighborhood::Dimension; ++d )
+      {
+      sum += 1000.0 * neighborhood.GetStride(d) * ( d + 1 );
+      }
+    return sum;
+  }
+
+  static double PixelValue(float p) { return p; }
+  static double PixelValue(const itk::VariableLengthVector< float > & p)
+  { return p[0] + 0.5 * p[1]; }
+};
+
+// Compares ApplyNeighborhoodKernel with a ConstNeighborhoodIterator
+// swept over the whole region.
+template< class TImage >
+bool ApplyNeighborhoodKernelTest(const TImage *image, const typename TImage::RegionType & region,
+                                 const typename TImage::SizeType & radius)
+{
+  typedef itk::Image< double, TImage::ImageDimension > OutputImageType;
+
+  typename OutputImageType::Pointer output = OutputImageType::New();
+  output->SetRegions( image->GetLargestPossibleRegion() );
+  output->Allocate();
+  output->FillBuffer(-1.0);
+
+  itk::ConstantBoundaryCondition< TImage > boundaryCondition;
+  typename TImage::PixelType constant = image->GetPixel( image->GetLargestPossibleRegion().GetIndex() );
+  constant.Fill(3);
+  boundaryCondition.SetConstant(constant);
+
+  KernelTestProcessObject::Pointer process = KernelTestProcessObject::New();
+  {
+  itk::ProgressReporter progress( process, 0, region.GetNumberOfPixels() );
+  WeightedSumKernel     kernel;
+  itk::NeighborhoodAlgorithm::ApplyNeighborhoodKernel(image, output.GetPointer(), region, radius,
+                                                      &boundaryCondition, kernel, progress);
+  }
+
+  WeightedSumKernel                       kernel;
+  itk::ConstNeighborhoodIterator< TImage > bit(radius, image, region);
+  bit.OverrideBoundaryCondition(&boundaryCondition);
+  for ( bit.GoToBegin(); !bit.IsAtEnd(); ++bit )
+    {
+    if ( output->GetPixel( bit.GetIndex() ) != kernel(bit) )
+      {
+      std::cerr << "ApplyNeighborhoodKernel gives " << output->GetPixel( bit.GetIndex() ) << " at "
+                << bit.GetIndex() << " instead of " << kernel(bit) << std::endl;
+      return false;
+      }
+    }
+  if ( process->GetProgress() != 1.0f )
+    {
+    std::cerr << "The progress is " << process->GetProgress() << " instead of 1" << std::endl;
+    return false;
+    }
+  return true;
+}
+
+template< unsigned int VDimension >
+bool ApplyNeighborhoodKernelTest()
+{
+  typedef itk::VectorImage< float, VDimension > ImageType;
+  typedef typename ImageType::RegionType        RegionType;
+  typedef typename ImageType::IndexType         IndexType;
+  typedef typename ImageType::SizeType          SizeType;
+
+  IndexType start;
+  SizeType  size;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    start[d] = static_cast< itk::IndexValueType >( d ) - 2;
+    size[d] = 9 - d;
+    }
+  const RegionType region(start, size);
+
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetVectorLength(2);
+  image->Allocate();
+
+  unsigned int                          seed = 1;
+  itk::ImageRegionIterator< ImageType > it(image, region);
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    typename ImageType::PixelType value = it.Get();
+    seed = seed * 1103515245 + 12345;
+    value[0] = ( seed / 65536 ) % 100;
+    value[1] = ( seed / 65536 ) % 7;
+    it.Set(value);
+    }
+
+  SizeType radius;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    radius[d] = ( d % 2 ) + 1;
+    }
+
+  // a region inside the image, and a radius larger than the image
+  RegionType subRegion = region;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    subRegion.SetIndex(d, start[d] + 1);
+    subRegion.SetSize(d, size[d] - 2);
+    }
+  SizeType largeRadius;
+  largeRadius.Fill(4);
+
+  return ApplyNeighborhoodKernelTest< ImageType >(image, region, radius)
+         && ApplyNeighborhoodKernelTest< ImageType >(image, subRegion, radius)
+         && ApplyNeighborhoodKernelTest< ImageType >(image, subRegion, largeRadius);
+}
+
 int itkNeighborhoodAlgorithmTest(int, char * [] )
 {
   if( !NeighborhoodAlgorithmTest<int, 1>( ) )
@@ -109,5 +245,8 @@ int itkNeighborhoodAlgorithmTest(int, char * [] )
   if( !NeighborhoodAlgorithmTest<int, 4>( ) )
       return EXIT_FAILURE;
 
+  if( !ApplyNeighborhoodKernelTest< 2 >() || !ApplyNeighborhoodKernelTest< 3 >() )
+      return EXIT_FAILURE;
+
   return EXIT_SUCCESS;
 }
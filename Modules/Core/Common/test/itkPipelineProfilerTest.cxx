@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSource.h"
+#include "itkImageRegionIterator.h"
+#include "itkPipelineProfiler.h"
+
+#include <sstream>
+
+namespace itk
+{
+/** \class PipelineProfilerTestSource
+ * Fills its output with a constant.
+ */
+template< class TOutputImage >
+class PipelineProfilerTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef PipelineProfilerTestSource  Self;
+  typedef ImageSource< TOutputImage > Superclass;
+  typedef SmartPointer< Self >        Pointer;
+  typedef SmartPointer< const Self >  ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(PipelineProfilerTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  /** The filter can be scheduled both ways */
+  void SetScheduleDynamically(bool dynamic)
+  {
+    this->SetDynamicMultiThreading(dynamic);
+  }
+
+protected:
+  PipelineProfilerTestSource() {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::SizeType size;
+    size.Fill(64);
+    typename TOutputImage::RegionType region;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType)
+  {
+    ImageRegionIterator< TOutputImage > it(this->GetOutput(), region);
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      it.Set(3);
+      }
+  }
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType threadId)
+  {
+    this->ThreadedGenerateData(region, threadId);
+  }
+
+private:
+  PipelineProfilerTestSource(const Self &); //purposely not implemented
+  void operator=(const Self &);             //purposely not implemented
+};
+}
+
+int itkPipelineProfilerTest(int, char *[])
+{
+  typedef itk::Image< float, 3 >                          ImageType;
+  typedef itk::PipelineProfilerTestSource< ImageType >    SourceType;
+  typedef itk::PipelineProfiler::FilterStatistics         StatisticsType;
+
+  const itk::SizeValueType numberOfPixels = 64 * 64 * 64;
+
+  itk::PipelineProfiler::Pointer profiler = itk::PipelineProfiler::New();
+
+  // Filters are not profiled by default
+  SourceType::Pointer source = SourceType::New();
+  source->SetNumberOfThreads(3);
+  if ( source->GetActiveProfiler() )
+    {
+    std::cerr << "A filter should not be profiled by default" << std::endl;
+    return EXIT_FAILURE;
+    }
+  source->SetProfiler(profiler);
+  for ( unsigned int i = 0; i < 3; i++ )
+    {
+    source->Modified();
+    source->Update();
+    }
+
+  StatisticsType statistics = profiler->GetFilterStatistics(source);
+  if ( statistics.Name != "PipelineProfilerTestSource" || statistics.NumberOfExecutions != 3
+       || statistics.OutputBufferSize != numberOfPixels * sizeof( float ) )
+    {
+    std::cerr << "Wrong statistics: " << statistics.Name << " executed "
+              << statistics.NumberOfExecutions << " times with "
+              << statistics.OutputBufferSize << " bytes" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( statistics.MinimumTime > statistics.MaximumTime
+       || statistics.TotalTime < 3 * statistics.MinimumTime )
+    {
+    std::cerr << "Inconsistent times" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Every pixel is produced once per execution, by one of the threads
+  itk::SizeValueType pixels = 0;
+  for ( size_t t = 0; t < statistics.ThreadPixels.size(); t++ )
+    {
+    pixels += statistics.ThreadPixels[t];
+    }
+  if ( statistics.ThreadTime.size() != 3 || pixels != 3 * numberOfPixels
+       || statistics.GetThreadImbalance() < 1.0 )
+    {
+    std::cerr << "Wrong thread statistics: " << statistics.ThreadTime.size()
+              << " threads produced " << pixels << " pixels" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The global default profiler is used by the filters that have none,
+  // and the pieces of the dynamic scheduling are accumulated per thread
+  itk::PipelineProfiler::SetGlobalDefault(profiler);
+  SourceType::Pointer dynamicSource = SourceType::New();
+  dynamicSource->SetNumberOfThreads(2);
+  dynamicSource->SetScheduleDynamically(true);
+  dynamicSource->Update();
+  itk::PipelineProfiler::SetGlobalDefault(NULL);
+
+  statistics = profiler->GetFilterStatistics(dynamicSource);
+  if ( profiler->GetNumberOfFilters() != 2 || statistics.Name != "PipelineProfilerTestSource#2"
+       || statistics.NumberOfExecutions != 1 || statistics.ThreadTime.size() > 2
+       || statistics.ThreadPixels[0] + ( statistics.ThreadPixels.size() > 1 ? statistics.ThreadPixels[1] : 0 )
+       != numberOfPixels )
+    {
+    std::cerr << "Wrong statistics with the global default profiler" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const char *formatNames[] = { "TEXT", "CSV", "JSON" };
+  for ( int format = itk::PipelineProfiler::TEXT; format <= itk::PipelineProfiler::JSON; format++ )
+    {
+    std::ostringstream report;
+    profiler->Report( report, static_cast< itk::PipelineProfiler::ReportFormatType >( format ) );
+    std::cout << formatNames[format] << " report:" << std::endl << report.str() << std::endl;
+    if ( report.str().find("PipelineProfilerTestSource#2") == std::string::npos )
+      {
+      std::cerr << "The " << formatNames[format] << " report is missing a filter" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  profiler->Clear();
+  if ( profiler->GetNumberOfFilters() != 0 )
+    {
+    std::cerr << "Clear() did not remove the statistics" << std::endl;
+    return EXIT_FAILURE;
+    }
+  profiler->Print(std::cout);
+
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
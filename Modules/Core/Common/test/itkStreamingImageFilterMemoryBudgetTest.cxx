@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkPipelineMonitorImageFilter.h"
+
+namespace itk
+{
+/** \class StreamingMemoryBudgetTestFilter
+ * Copies its input, which it requests with a margin of two pixels like a
+ * neighborhood filter.
+ */
+template< class TImage >
+class StreamingMemoryBudgetTestFilter:public ImageToImageFilter< TImage, TImage >
+{
+public:
+  typedef StreamingMemoryBudgetTestFilter      Self;
+  typedef ImageToImageFilter< TImage, TImage > Superclass;
+  typedef SmartPointer< Self >                 Pointer;
+  typedef SmartPointer< const Self >           ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(StreamingMemoryBudgetTestFilter, ImageToImageFilter);
+
+protected:
+  StreamingMemoryBudgetTestFilter() {}
+
+  void GenerateInputRequestedRegion()
+  {
+    Superclass::GenerateInputRequestedRegion();
+    TImage *input = const_cast< TImage * >( this->GetInput() );
+    typename TImage::RegionType region = this->GetOutput()->GetRequestedRegion();
+    region.PadByRadius(2);
+    region.Crop( input->GetLargestPossibleRegion() );
+    input->SetRequestedRegion(region);
+  }
+
+  void GenerateData()
+  {
+    this->AllocateOutputs();
+    const typename TImage::RegionType region = this->GetOutput()->GetRequestedRegion();
+    ImageRegionConstIterator< TImage > inputIt(this->GetInput(), region);
+    ImageRegionIterator< TImage >      outputIt(this->GetOutput(), region);
+    for ( ; !outputIt.IsAtEnd(); ++inputIt, ++outputIt )
+      {
+      outputIt.Set( inputIt.Get() );
+      }
+  }
+
+private:
+  StreamingMemoryBudgetTestFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);                  //purposely not implemented
+};
+}
+
+int itkStreamingImageFilterMemoryBudgetTest(int, char *[])
+{
+  typedef itk::Image< short, 2 >                            ImageType;
+  typedef itk::PipelineMonitorImageFilter< ImageType >      MonitorType;
+  typedef itk::StreamingMemoryBudgetTestFilter< ImageType > FilterType;
+  typedef itk::StreamingImageFilter< ImageType, ImageType > StreamerType;
+
+  ImageType::RegionType region;
+  ImageType::SizeType   size = { { 100, 200 } };
+  region.SetSize(size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  itk::ImageRegionIterator< ImageType > it(image, region);
+  short value = 0;
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set(value++);
+    }
+
+  FilterType::Pointer first = FilterType::New();
+  first->SetInput(image);
+  FilterType::Pointer second = FilterType::New();
+  second->SetInput( first->GetOutput() );
+  MonitorType::Pointer monitor = MonitorType::New();
+  monitor->SetInput( second->GetOutput() );
+  StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetInput( monitor->GetOutput() );
+  streamer->SetNumberOfStreamDivisions(3);
+
+  // The output takes 40000 bytes. A piece of r rows inside the image
+  // needs r rows of the monitor and second filter outputs, and r + 4 rows
+  // of the first filter output: 200 * ( 3 * r + 4 ) bytes. The pieces of
+  // 20 rows are the largest that fit in the budget.
+  const itk::SizeValueType outputSize = region.GetNumberOfPixels() * sizeof( short );
+  const itk::SizeValueType budget = outputSize + 200 * ( 3 * 20 + 4 );
+  streamer->SetMemoryBudget(budget);
+  streamer->Update();
+
+  if ( monitor->GetNumberOfUpdates() != 10 )
+    {
+    std::cerr << "Expected 10 pieces for a budget of " << budget << " bytes, got "
+              << monitor->GetNumberOfUpdates() << std::endl;
+    return EXIT_FAILURE;
+    }
+  const MonitorType::RegionVectorType requestedRegions = monitor->GetUpdatedRequestedRegions();
+  for ( size_t i = 0; i < requestedRegions.size(); i++ )
+    {
+    const itk::SizeValueType pieceRows = requestedRegions[i].GetSize(1);
+    if ( pieceRows != 20 )
+      {
+      std::cerr << "Piece " << i << " has " << pieceRows << " rows" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  value = 0;
+  itk::ImageRegionIterator< ImageType > outputIt(streamer->GetOutput(), region);
+  for ( ; !outputIt.IsAtEnd(); ++outputIt )
+    {
+    if ( outputIt.Get() != value++ )
+      {
+      std::cerr << "Wrong output at " << outputIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A budget too small for any number of divisions streams one row at a
+  // time
+  monitor->ClearPipelineSavedInformation();
+  streamer->SetMemoryBudget(1000);
+  streamer->Update();
+  if ( monitor->GetNumberOfUpdates() != 200 )
+    {
+    std::cerr << "Expected 200 pieces for a budget smaller than the output, got "
+              << monitor->GetNumberOfUpdates() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Without a budget, NumberOfStreamDivisions is used again
+  monitor->ClearPipelineSavedInformation();
+  streamer->SetMemoryBudget(0);
+  streamer->Update();
+  if ( monitor->GetNumberOfUpdates() != 3 )
+    {
+    std::cerr << "Expected 3 pieces without a budget, got "
+              << monitor->GetNumberOfUpdates() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
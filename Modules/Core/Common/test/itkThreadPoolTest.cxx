@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMultiThreader.h"
+#include "itkThreadPool.h"
+#include <stdlib.h>
+#include <vector>
+
+
+class ThreadPoolTestUserData
+{
+public:
+  std::vector< unsigned int > m_Counter;
+};
+
+ITK_THREAD_RETURN_TYPE ThreadPoolTestCallback( void *ptr )
+{
+  itk::MultiThreader::ThreadInfoStruct * info =
+    static_cast< itk::MultiThreader::ThreadInfoStruct * >( ptr );
+  ThreadPoolTestUserData *data =
+    static_cast< ThreadPoolTestUserData * >( info->UserData );
+
+  // each thread only writes its own slot
+  data->m_Counter[info->ThreadID]++;
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+ITK_THREAD_RETURN_TYPE ThreadPoolTestThrowingCallback( void *ptr )
+{
+  itk::MultiThreader::ThreadInfoStruct * info =
+    static_cast< itk::MultiThreader::ThreadInfoStruct * >( ptr );
+  if( info->ThreadID == info->NumberOfThreads - 1 )
+    {
+    throw std::exception();
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+int itkThreadPoolTest(int argc, char* argv[])
+{
+  itk::ThreadIdType numberOfThreads = 4;
+  if( argc > 1 )
+    {
+    const int nt = atoi( argv[1] );
+    if( nt > 1 )
+      {
+      numberOfThreads = nt;
+      }
+    }
+
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->UseThreadPoolOn();
+  threader->SetNumberOfThreads( numberOfThreads );
+  numberOfThreads = threader->GetNumberOfThreads();
+
+  if( !threader->GetUseThreadPool() )
+    {
+    std::cerr << "UseThreadPool was not set" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ThreadPoolTestUserData data;
+  data.m_Counter.resize( numberOfThreads, 0 );
+  threader->SetSingleMethod( ThreadPoolTestCallback, &data );
+
+  const unsigned int numberOfExecutions = 100;
+  for( unsigned int i = 0; i < numberOfExecutions; i++ )
+    {
+    threader->SingleMethodExecute();
+    }
+
+  for( itk::ThreadIdType t = 0; t < numberOfThreads; t++ )
+    {
+    if( data.m_Counter[t] != numberOfExecutions )
+      {
+      std::cerr << "Thread " << t << " ran " << data.m_Counter[t]
+                << " times instead of " << numberOfExecutions << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // The workers are reused between executions: the calling thread runs
+  // thread 0 itself, so at most numberOfThreads - 1 workers are needed.
+  itk::ThreadPool::Pointer pool = itk::ThreadPool::GetInstance();
+  std::cout << pool << std::endl;
+  if( pool->GetNumberOfThreads() > numberOfThreads - 1 )
+    {
+    std::cerr << "Thread pool grew to " << pool->GetNumberOfThreads()
+              << " threads for " << numberOfThreads << " requested" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Exceptions thrown by a pooled thread must be reported to the caller
+  threader->SetSingleMethod( ThreadPoolTestThrowingCallback, NULL );
+  bool caught = false;
+  try
+    {
+    threader->SingleMethodExecute();
+    }
+  catch( itk::ExceptionObject & excp )
+    {
+    std::cout << "Caught expected exception: " << excp << std::endl;
+    caught = true;
+    }
+  if( !caught )
+    {
+    std::cerr << "Exception in pooled thread was not reported" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The pool must still be usable after a failed execution
+  threader->SetSingleMethod( ThreadPoolTestCallback, &data );
+  threader->SingleMethodExecute();
+  for( itk::ThreadIdType t = 0; t < numberOfThreads; t++ )
+    {
+    if( data.m_Counter[t] != numberOfExecutions + 1 )
+      {
+      std::cerr << "Thread pool unusable after exception" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -59,16 +59,20 @@ int itkTimeStampTest(int, char*[])
     multithreader->SetSingleMethod( modified_function, &helper);
 
     // Test that the number of threads has actually been clamped
-    const long int numberOfThreads =
-      static_cast<long int>( multithreader->GetNumberOfThreads() );
-
-    if( numberOfThreads > ITK_MAX_THREADS )
+    if( multithreader->GetNumberOfThreads() > ITK_MAX_THREADS )
       {
       std::cerr << "[TEST FAILED]" << std::endl;
       std::cerr << "numberOfThreads > ITK_MAX_THREADS" << std::endl;
       return EXIT_FAILURE;
       }
 
+    // ITK_MAX_THREADS is only a sanity ceiling; starting that many threads
+    // in every experiment would exhaust small machines, so the experiments
+    // use a small fixed number of threads
+    multithreader->SetNumberOfThreads( 16 );
+    const long int numberOfThreads =
+      static_cast<long int>( multithreader->GetNumberOfThreads() );
+
     // Set up the helper class
     helper.counters.resize( numberOfThreads );
     helper.timestamps.resize( numberOfThreads );
@@ -0,0 +1,99 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkBSplineCoefficientImageCache_h
+#define __itkBSplineCoefficientImageCache_h
+
+#include <vector>
+
+#include "itkBSplineDecompositionImageFilter.h"
+#include "itkSimpleFastMutexLock.h"
+
+namespace itk
+{
+/** \class BSplineCoefficientImageCache
+ * \brief Process-wide cache of the B-spline coefficients of images.
+ *
+ * Computing the B-spline coefficients of an image costs a pass of the
+ * BSplineDecompositionImageFilter over the whole image. The cache lets
+ * several BSplineInterpolateImageFunction, and the metrics and filters
+ * which use them, share the coefficients of the same image instead of
+ * computing them again.
+ *
+ * The coefficients are keyed by the address of the image, its modified
+ * time, its buffered region and the spline order. As for the pipeline,
+ * an image whose pixels are changed must be marked as Modified() so that
+ * its coefficients are computed again.
+ *
+ * The cache holds a reference to the coefficient images. The images which
+ * are only referenced by the cache are released when coefficients are
+ * added to the cache, or by Clear().
+ *
+ * \sa BSplineInterpolateImageFunction
+ *
+ * \ingroup ImageFunctions
+ * \ingroup ITKImageFunction
+ */
+template< class TImageType, class TCoefficientImageType >
+class BSplineCoefficientImageCache
+{
+public:
+  /** Standard class typedefs. */
+  typedef BSplineCoefficientImageCache Self;
+
+  typedef TImageType                                  ImageType;
+  typedef TCoefficientImageType                       CoefficientImageType;
+  typedef typename CoefficientImageType::ConstPointer CoefficientImageConstPointer;
+
+  /** Filter which computes the coefficients */
+  typedef BSplineDecompositionImageFilter< ImageType, CoefficientImageType > CoefficientFilterType;
+
+  /** Returns the coefficients of the image for the spline order of the
+   * filter. On a cache miss, they are computed by the filter, which is then
+   * disconnected from them. */
+  static CoefficientImageConstPointer GetCoefficients(const ImageType *image,
+                                                      CoefficientFilterType *filter);
+
+  /** Releases all the coefficient images held by the cache. */
+  static void Clear();
+
+  /** Number of coefficient images held by the cache. */
+  static SizeValueType GetNumberOfCoefficientImages();
+
+private:
+  BSplineCoefficientImageCache();                //purposely not implemented
+  BSplineCoefficientImageCache(const Self &);    //purposely not implemented
+  void operator=(const Self &);                  //purposely not implemented
+
+  struct EntryType {
+    const ImageType *              m_Image;
+    unsigned long                  m_ImageMTime;
+    typename ImageType::RegionType m_BufferedRegion;
+    unsigned int                   m_SplineOrder;
+    CoefficientImageConstPointer   m_Coefficients;
+  };
+
+  static SimpleFastMutexLock      m_Lock;
+  static std::vector< EntryType > m_Entries;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBSplineCoefficientImageCache.hxx"
+#endif
+
+#endif
@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkBSplineCoefficientImageCache_hxx
+#define __itkBSplineCoefficientImageCache_hxx
+
+#include "itkBSplineCoefficientImageCache.h"
+#include "itkMutexLockHolder.h"
+
+namespace itk
+{
+template< class TImageType, class TCoefficientImageType >
+SimpleFastMutexLock
+BSplineCoefficientImageCache< TImageType, TCoefficientImageType >
+::m_Lock;
+
+template< class TImageType, class TCoefficientImageType >
+std::vector< typename BSplineCoefficientImageCache< TImageType, TCoefficientImageType >::EntryType >
+BSplineCoefficientImageCache< TImageType, TCoefficientImageType >
+::m_Entries;
+
+template< class TImageType, class TCoefficientImageType >
+typename BSplineCoefficientImageCache< TImageType, TCoefficientImageType >
+::CoefficientImageConstPointer
+BSplineCoefficientImageCache< TImageType, TCoefficientImageType >
+::GetCoefficients(const ImageType *image, CoefficientFilterType *filter)
+{
+  const unsigned long                  imageMTime = image->GetMTime();
+  const typename ImageType::RegionType bufferedRegion = image->GetBufferedRegion();
+  const unsigned int                   splineOrder = filter->GetSplineOrder();
+
+  // The lock is held while the coefficients are computed, so that the
+  // coefficients of an image are computed only once when several threads
+  // ask for them.
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Lock);
+
+  for ( typename std::vector< EntryType >::const_iterator it = m_Entries.begin();
+        it != m_Entries.end(); ++it )
+    {
+    if ( it->m_Image == image && it->m_ImageMTime == imageMTime
+         && it->m_BufferedRegion == bufferedRegion && it->m_SplineOrder == splineOrder )
+      {
+      return it->m_Coefficients;
+      }
+    }
+
+  // Release the coefficients that nobody else uses
+  typename std::vector< EntryType >::iterator last = m_Entries.begin();
+  for ( typename std::vector< EntryType >::iterator it = m_Entries.begin();
+        it != m_Entries.end(); ++it )
+    {
+    if ( it->m_Coefficients->GetReferenceCount() > 1 )
+      {
+      *last++ = *it;
+      }
+    }
+  m_Entries.erase( last, m_Entries.end() );
+
+  filter->SetInput(image);
+  filter->Update();
+
+  // The coefficients must not be overwritten by a later update of the
+  // filter
+  typename CoefficientImageType::Pointer coefficients = filter->GetOutput();
+  coefficients->DisconnectPipeline();
+
+  EntryType entry;
+  entry.m_Image = image;
+  entry.m_ImageMTime = imageMTime;
+  entry.m_BufferedRegion = bufferedRegion;
+  entry.m_SplineOrder = splineOrder;
+  entry.m_Coefficients = coefficients.GetPointer();
+  m_Entries.push_back(entry);
+
+  return entry.m_Coefficients;
+}
+
+template< class TImageType, class TCoefficientImageType >
+void
+BSplineCoefficientImageCache< TImageType, TCoefficientImageType >
+::Clear()
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Lock);
+  m_Entries.clear();
+}
+
+template< class TImageType, class TCoefficientImageType >
+SizeValueType
+BSplineCoefficientImageCache< TImageType, TCoefficientImageType >
+::GetNumberOfCoefficientImages()
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Lock);
+  return m_Entries.size();
+}
+} // namespace itk
+
+#endif
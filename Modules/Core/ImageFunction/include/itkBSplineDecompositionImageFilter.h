@@ -62,6 +62,9 @@ namespace itk
  *               Requires the same order of Spline for each dimension.
  *               Can only process LargestPossibleRegion
  *
+ * The image is filtered one dimension after the other. The lines along
+ * a dimension are independent and are shared among the threads.
+ *
  * \sa itkBSplineInterpolateImageFunction
  *
  * \ingroup ImageFilters
@@ -132,9 +135,11 @@ protected:
   /** This filter must produce all of its output at once. */
   void EnlargeOutputRequestedRegion(DataObject *output);
 
+  /** Converts the share of the given thread of the lines of coefficients
+   * along m_IteratorDirection. */
+  void ThreadedDataToCoefficients(ThreadIdType threadId, ThreadIdType numberOfThreads);
+
   /** These are needed by the smoothing spline routine. */
-  std::vector< CoeffType >           m_Scratch;   // temp storage for processing
-                                                  // of Coefficients
   typename TInputImage::SizeType m_DataLength;    // Image size
 
   unsigned int m_SplineOrder;                // User specified spline order (3rd
@@ -145,8 +150,8 @@ protected:
 
   double m_Tolerance;                        // Tolerance used for determining
                                              // initial causal coefficient
-  unsigned int m_IteratorDirection;          // Direction for iterator
-                                             // incrementing
+  unsigned int m_IteratorDirection;          // Direction of the lines
+                                             // being converted
 private:
   BSplineDecompositionImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);                  //purposely not implemented
@@ -154,29 +159,26 @@ private:
   /** Determines the poles given the Spline Order. */
   virtual void SetPoles();
 
-  /** Converts a vector of data to a vector of Spline coefficients. */
-  virtual bool DataToCoefficients1D();
+  /** Converts a vector of data to a vector of Spline coefficients, in
+   *  place in the scratch vector. */
+  bool DataToCoefficients1D(CoeffType *scratch, SizeValueType dataLength) const;
 
   /** Converts an N-dimension image of data to an equivalent sized image
-   *    of spline coefficients. */
+   *    of spline coefficients. The lines along each dimension are
+   *    shared among the threads. */
   void DataToCoefficientsND();
 
   /** Determines the first coefficient for the causal filtering of the data. */
-  virtual void SetInitialCausalCoefficient(double z);
+  void SetInitialCausalCoefficient(double z, CoeffType *scratch, SizeValueType dataLength) const;
 
   /** Determines the first coefficient for the anti-causal filtering of the
     data. */
-  virtual void SetInitialAntiCausalCoefficient(double z);
+  void SetInitialAntiCausalCoefficient(double z, CoeffType *scratch, SizeValueType dataLength) const;
 
   /** Used to initialize the Coefficients image before calculation. */
   void CopyImageToImage();
 
-  /** Copies a vector of data from the Coefficients image to the m_Scratch
-    vector. */
-  void CopyCoefficientsToScratch(OutputLinearIterator &);
-
-  /** Copies a vector of data from m_Scratch to the Coefficients image. */
-  void CopyScratchToCoefficients(OutputLinearIterator &);
+  static ITK_THREAD_RETURN_TYPE DataToCoefficientsThreaderCallback(void *arg);
 };
 } // namespace itk
 
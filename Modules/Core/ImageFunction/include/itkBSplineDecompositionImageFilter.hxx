@@ -66,14 +66,14 @@ BSplineDecompositionImageFilter< TInputImage, TOutputImage >
 template< class TInputImage, class TOutputImage >
 bool
 BSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::DataToCoefficients1D()
+::DataToCoefficients1D(CoeffType *scratch, SizeValueType dataLength) const
 {
   // See Unser, 1993, Part II, Equation 2.5,
   //   or Unser, 1999, Box 2. for an explaination.
 
   double c0 = 1.0;
 
-  if ( m_DataLength[m_IteratorDirection] == 1 ) //Required by mirror boundaries
+  if ( dataLength == 1 ) //Required by mirror boundaries
     {
     return false;
     }
@@ -86,28 +86,28 @@ BSplineDecompositionImageFilter< TInputImage, TOutputImage >
     }
 
   // apply the gain
-  for ( unsigned int n = 0; n < m_DataLength[m_IteratorDirection]; n++ )
+  for ( unsigned int n = 0; n < dataLength; n++ )
     {
-    m_Scratch[n] *= c0;
+    scratch[n] *= c0;
     }
 
   // loop over all poles
   for ( int k = 0; k < m_NumberOfPoles; k++ )
     {
     // causal initialization
-    this->SetInitialCausalCoefficient(m_SplinePoles[k]);
+    this->SetInitialCausalCoefficient(m_SplinePoles[k], scratch, dataLength);
     // causal recursion
-    for ( unsigned int n = 1; n < m_DataLength[m_IteratorDirection]; n++ )
+    for ( unsigned int n = 1; n < dataLength; n++ )
       {
-      m_Scratch[n] += m_SplinePoles[k] * m_Scratch[n - 1];
+      scratch[n] += m_SplinePoles[k] * scratch[n - 1];
       }
 
     // anticausal initialization
-    this->SetInitialAntiCausalCoefficient(m_SplinePoles[k]);
+    this->SetInitialAntiCausalCoefficient(m_SplinePoles[k], scratch, dataLength);
     // anticausal recursion
-    for ( int n = m_DataLength[m_IteratorDirection] - 2; 0 <= n; n-- )
+    for ( int n = dataLength - 2; 0 <= n; n-- )
       {
-      m_Scratch[n] = m_SplinePoles[k] * ( m_Scratch[n + 1] - m_Scratch[n] );
+      scratch[n] = m_SplinePoles[k] * ( scratch[n + 1] - scratch[n] );
       }
     }
   return true;
@@ -177,7 +177,7 @@ BSplineDecompositionImageFilter< TInputImage, TOutputImage >
 template< class TInputImage, class TOutputImage >
 void
 BSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::SetInitialCausalCoefficient(double z)
+::SetInitialCausalCoefficient(double z, CoeffType *scratch, SizeValueType dataLength) const
 {
   /* begining InitialCausalCoefficient */
   /* See Unser, 1999, Box 2 for explaination */
@@ -186,52 +186,52 @@ BSplineDecompositionImageFilter< TInputImage, TOutputImage >
   typename TInputImage::SizeValueType horizon;
 
   /* this initialization corresponds to mirror boundaries */
-  horizon = m_DataLength[m_IteratorDirection];
+  horizon = dataLength;
   zn = z;
   if ( m_Tolerance > 0.0 )
     {
     horizon = (typename TInputImage::SizeValueType)
       vcl_ceil( vcl_log(m_Tolerance) / vcl_log( vcl_fabs(z) ) );
     }
-  if ( horizon < m_DataLength[m_IteratorDirection] )
+  if ( horizon < dataLength )
     {
     /* accelerated loop */
-    sum = m_Scratch[0];   // verify this
+    sum = scratch[0];   // verify this
     for ( unsigned int n = 1; n < horizon; n++ )
       {
-      sum += zn * m_Scratch[n];
+      sum += zn * scratch[n];
       zn *= z;
       }
-    m_Scratch[0] = sum;
+    scratch[0] = sum;
     }
   else
     {
     /* full loop */
     iz = 1.0 / z;
-    z2n = vcl_pow( z, (double)( m_DataLength[m_IteratorDirection] - 1L ) );
-    sum = m_Scratch[0] + z2n * m_Scratch[m_DataLength[m_IteratorDirection] - 1L];
+    z2n = vcl_pow( z, (double)( dataLength - 1L ) );
+    sum = scratch[0] + z2n * scratch[dataLength - 1L];
     z2n *= z2n * iz;
-    for ( unsigned int n = 1; n <= ( m_DataLength[m_IteratorDirection] - 2 ); n++ )
+    for ( unsigned int n = 1; n <= ( dataLength - 2 ); n++ )
       {
-      sum += ( zn + z2n ) * m_Scratch[n];
+      sum += ( zn + z2n ) * scratch[n];
       zn *= z;
       z2n *= iz;
       }
-    m_Scratch[0] = sum / ( 1.0 - zn * zn );
+    scratch[0] = sum / ( 1.0 - zn * zn );
     }
 }
 
 template< class TInputImage, class TOutputImage >
 void
 BSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::SetInitialAntiCausalCoefficient(double z)
+::SetInitialAntiCausalCoefficient(double z, CoeffType *scratch, SizeValueType dataLength) const
 {
   // this initialization corresponds to mirror boundaries
   /* See Unser, 1999, Box 2 for explaination */
   //  Also see erratum at http://bigwww.epfl.ch/publications/unser9902.html
-  m_Scratch[m_DataLength[m_IteratorDirection] - 1] =
+  scratch[dataLength - 1] =
     ( z / ( z * z - 1.0 ) )
-    * ( z * m_Scratch[m_DataLength[m_IteratorDirection] - 2] + m_Scratch[m_DataLength[m_IteratorDirection] - 1] );
+    * ( z * scratch[dataLength - 2] + scratch[dataLength - 1] );
 }
 
 template< class TInputImage, class TOutputImage >
@@ -239,40 +239,86 @@ void
 BSplineDecompositionImageFilter< TInputImage, TOutputImage >
 ::DataToCoefficientsND()
 {
-  OutputImagePointer output = this->GetOutput();
-
-  Size< ImageDimension > size = output->GetBufferedRegion().GetSize();
-
-  unsigned int count = output->GetBufferedRegion().GetNumberOfPixels() / size[0] * ImageDimension;
-
-  ProgressReporter progress(this, 0, count, 10);
+  ProgressReporter progress(this, 0, ImageDimension);
 
   // Initialize coeffient array
   this->CopyImageToImage();   // Coefficients are initialized to the input data
 
+  typename ImageSource< TOutputImage >::ThreadStruct str;
+  str.Filter = this;
+
+  MultiThreader *multithreader = this->GetMultiThreader();
+  multithreader->SetNumberOfThreads( this->GetNumberOfThreads() );
+  multithreader->SetSingleMethod(this->DataToCoefficientsThreaderCallback, &str);
+
+  // Loop through each dimension. The lines along a dimension are
+  // independent, and the dimensions are converted one after the other.
   for ( unsigned int n = 0; n < ImageDimension; n++ )
     {
     m_IteratorDirection = n;
-    // Loop through each dimension
+    multithreader->SingleMethodExecute();
+    progress.CompletedPixel();
+    }
+}
+
+template< class TInputImage, class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+BSplineDecompositionImageFilter< TInputImage, TOutputImage >
+::DataToCoefficientsThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  typedef typename ImageSource< TOutputImage >::ThreadStruct ThreadStruct;
+  ThreadStruct *str = static_cast< ThreadStruct * >( info->UserData );
+
+  Self *filter = static_cast< Self * >( str->Filter.GetPointer() );
+  filter->ThreadedDataToCoefficients( info->ThreadID, info->NumberOfThreads );
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< class TInputImage, class TOutputImage >
+void
+BSplineDecompositionImageFilter< TInputImage, TOutputImage >
+::ThreadedDataToCoefficients(ThreadIdType threadId, ThreadIdType numberOfThreads)
+{
+  typedef typename TOutputImage::PixelType OutputPixelType;
+
+  TOutputImage *output = this->GetOutput();
+
+  // The lines along the dimension d start at the pixels whose index is 0
+  // along d, and their pixels are stride apart in the buffer
+  const unsigned int  d = m_IteratorDirection;
+  const SizeValueType dataLength = output->GetBufferedRegion().GetSize()[d];
+  const SizeValueType numberOfLines = output->GetBufferedRegion().GetNumberOfPixels() / dataLength;
+  const SizeValueType stride = output->GetOffsetTable()[d];
+
+  if ( dataLength == 1 ) // Required by mirror boundaries
+    {
+    return;
+    }
+
+  const SizeValueType firstLine = numberOfLines * threadId / numberOfThreads;
+  const SizeValueType lastLine = numberOfLines * ( threadId + 1 ) / numberOfThreads;
+
+  OutputPixelType *        coefficients = output->GetBufferPointer();
+  std::vector< CoeffType > scratch(dataLength);
+  for ( SizeValueType line = firstLine; line < lastLine; line++ )
+    {
+    OutputPixelType *lineStart = coefficients + line % stride + ( line / stride ) * stride * dataLength;
+
+    // Copy coefficients to scratch
+    for ( SizeValueType j = 0; j < dataLength; j++ )
+      {
+      scratch[j] = static_cast< CoeffType >( lineStart[j * stride] );
+      }
+
+    // Perform 1D BSpline calculations
+    this->DataToCoefficients1D(&scratch[0], dataLength);
 
-    // Initialize iterators
-    OutputLinearIterator CIterator( output, output->GetBufferedRegion() );
-    CIterator.SetDirection(m_IteratorDirection);
-    // For each data vector
-    while ( !CIterator.IsAtEnd() )
+    // Copy scratch back to coefficients.
+    for ( SizeValueType j = 0; j < dataLength; j++ )
       {
-      // Copy coefficients to scratch
-      this->CopyCoefficientsToScratch(CIterator);
-
-      // Perform 1D BSpline calculations
-      this->DataToCoefficients1D();
-
-      // Copy scratch back to coefficients.
-      // Brings us back to the end of the line we were working on.
-      CIterator.GoToBeginOfLine();
-      this->CopyScratchToCoefficients(CIterator);   // m_Scratch = m_Image;
-      CIterator.NextLine();
-      progress.CompletedPixel();
+      lineStart[j * stride] = static_cast< OutputPixelType >( scratch[j] );
       }
     }
 }
@@ -303,42 +349,6 @@ BSplineDecompositionImageFilter< TInputImage, TOutputImage >
     }
 }
 
-/**
- * Copy the scratch to one line of the output image
- */
-template< class TInputImage, class TOutputImage >
-void
-BSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::CopyScratchToCoefficients(OutputLinearIterator & Iter)
-{
-  typedef typename TOutputImage::PixelType OutputPixelType;
-  typename TOutputImage::SizeValueType j = 0;
-  while ( !Iter.IsAtEndOfLine() )
-    {
-    Iter.Set( static_cast< OutputPixelType >( m_Scratch[j] ) );
-    ++Iter;
-    ++j;
-    }
-}
-
-/**
- * Copy one line of the output image to the scratch
- */
-template< class TInputImage, class TOutputImage >
-void
-BSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::CopyCoefficientsToScratch(OutputLinearIterator & Iter)
-{
-  typename TOutputImage::SizeValueType j = 0;
-
-  while ( !Iter.IsAtEndOfLine() )
-    {
-    m_Scratch[j] = static_cast< CoeffType >( Iter.Get() );
-    ++Iter;
-    ++j;
-    }
-}
-
 /**
  * GenerateInputRequestedRegion method.
  */
@@ -385,21 +395,10 @@ void
 BSplineDecompositionImageFilter< TInputImage, TOutputImage >
 ::GenerateData()
 {
-  // Allocate scratch memory
   InputImageConstPointer inputPtr = this->GetInput();
 
   m_DataLength = inputPtr->GetBufferedRegion().GetSize();
 
-  typename TOutputImage::SizeValueType maxLength = 0;
-  for ( unsigned int n = 0; n < ImageDimension; n++ )
-    {
-    if ( m_DataLength[n] > maxLength )
-      {
-      maxLength = m_DataLength[n];
-      }
-    }
-  m_Scratch.resize(maxLength);
-
   // Allocate memory for output image
   OutputImagePointer outputPtr = this->GetOutput();
   outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
@@ -407,9 +406,6 @@ BSplineDecompositionImageFilter< TInputImage, TOutputImage >
 
   // Calculate actual output
   this->DataToCoefficientsND();
-
-  // Clean up
-  m_Scratch.clear();
 }
 } // namespace itk
 
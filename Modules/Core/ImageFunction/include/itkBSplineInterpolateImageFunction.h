@@ -34,6 +34,7 @@
 #include "vnl/vnl_matrix.h"
 
 #include "itkBSplineDecompositionImageFilter.h"
+#include "itkBSplineCoefficientImageCache.h"
 #include "itkConceptChecking.h"
 #include "itkCovariantVector.h"
 
@@ -128,6 +129,9 @@ public:
   typedef BSplineDecompositionImageFilter< TImageType, CoefficientImageType > CoefficientFilter;
   typedef typename CoefficientFilter::Pointer                                 CoefficientFilterPointer;
 
+  /** Cache of the coefficients shared among the interpolators */
+  typedef BSplineCoefficientImageCache< TImageType, CoefficientImageType > CoefficientImageCacheType;
+
   /** Derivative typedef support */
   typedef CovariantVector< OutputType,
                            itkGetStaticConstMacro(ImageDimension) >
@@ -180,6 +184,16 @@ public:
                                                index,
                                                ThreadIdType threadID) const;
 
+  /** Evaluate the function at an array of ContinuousIndex positions.
+   *
+   * The working space (evaluateIndex, weights) is allocated once by the
+   * calling thread for all the positions, so that the method is thread
+   * safe without the cost of an allocation per position. No bounds
+   * checking is done. */
+  virtual void EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                                           OutputType *values,
+                                           SizeValueType numberOfIndices) const;
+
   CovariantVectorType EvaluateDerivative(const PointType & point) const
   {
     ContinuousIndexType index;
@@ -311,6 +325,16 @@ public:
   itkSetMacro(UseImageDirection, bool);
   itkGetConstMacro(UseImageDirection, bool);
   itkBooleanMacro(UseImageDirection);
+
+  /** The UseCoefficientImageCache flag determines whether SetInputImage()
+   * takes the coefficients of the image from the process-wide
+   * BSplineCoefficientImageCache, so that the interpolators of the same
+   * image share them and compute them only once. The image must then be
+   * marked as Modified() when its pixels are changed. The default value
+   * of this flag is Off. */
+  itkSetMacro(UseCoefficientImageCache, bool);
+  itkGetConstMacro(UseCoefficientImageCache, bool);
+  itkBooleanMacro(UseCoefficientImageCache);
 protected:
 
   /** The following methods take working space (evaluateIndex, weights, weightsDerivative)
@@ -379,6 +403,25 @@ private:
                             vnl_matrix< double > & weights,
                             unsigned int splineOrder) const;
 
+  struct DispatchBase {};
+  template< unsigned int >
+  struct Dispatch: DispatchBase {};
+
+  /** Sums the coefficients in the region of support weighted by the
+   *  interpolation weights. The coefficients are read directly from their
+   *  buffer, one line at a time for images of dimension 2 and 3. */
+  double InterpolateCoefficients(const Dispatch< 2 > &,
+                                 const vnl_matrix< long > & evaluateIndex,
+                                 const vnl_matrix< double > & weights) const;
+
+  double InterpolateCoefficients(const Dispatch< 3 > &,
+                                 const vnl_matrix< long > & evaluateIndex,
+                                 const vnl_matrix< double > & weights) const;
+
+  double InterpolateCoefficients(const DispatchBase &,
+                                 const vnl_matrix< long > & evaluateIndex,
+                                 const vnl_matrix< double > & weights) const;
+
   /** Precomputation for converting the 1D index of the interpolation
    *  neighborhood to an N-dimensional index. */
   void GeneratePointsToIndex();
@@ -411,6 +454,9 @@ private:
   // derivatives.
   bool m_UseImageDirection;
 
+  // flag to share or not the coefficients through the cache.
+  bool m_UseCoefficientImageCache;
+
   ThreadIdType          m_NumberOfThreads;
   vnl_matrix< long > *  m_ThreadedEvaluateIndex;
   vnl_matrix< double > *m_ThreadedWeights;
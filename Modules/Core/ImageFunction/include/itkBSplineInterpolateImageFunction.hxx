@@ -58,6 +58,7 @@ BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
   unsigned int SplineOrder = 3;
   this->SetSplineOrder(SplineOrder);
   this->m_UseImageDirection = true;
+  this->m_UseCoefficientImageCache = false;
 }
 
 template< class TImageType, class TCoordRep, class TCoefficientType >
@@ -95,6 +96,8 @@ BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
   os << indent << "Spline Order: " << m_SplineOrder << std::endl;
   os << indent << "UseImageDirection = "
      << ( this->m_UseImageDirection ? "On" : "Off" ) << std::endl;
+  os << indent << "UseCoefficientImageCache = "
+     << ( this->m_UseCoefficientImageCache ? "On" : "Off" ) << std::endl;
   os << indent << "NumberOfThreads: " << m_NumberOfThreads  << std::endl;
 }
 
@@ -105,10 +108,17 @@ BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
 {
   if ( inputData )
     {
-    m_CoefficientFilter->SetInput(inputData);
+    if ( m_UseCoefficientImageCache )
+      {
+      m_Coefficients = CoefficientImageCacheType::GetCoefficients(inputData, m_CoefficientFilter);
+      }
+    else
+      {
+      m_CoefficientFilter->SetInput(inputData);
 
-    m_CoefficientFilter->Update();
-    m_Coefficients = m_CoefficientFilter->GetOutput();
+      m_CoefficientFilter->Update();
+      m_Coefficients = m_CoefficientFilter->GetOutput();
+      }
 
     // Call the Superclass implementation after, in case the filter
     // pulls in  more of the input image
@@ -775,22 +785,129 @@ BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
   this->ApplyMirrorBoundaryConditions( ( evaluateIndex ), m_SplineOrder );
 
   // perform interpolation
-  double    interpolated = 0.0;
-  IndexType coefficientIndex;
+  return this->InterpolateCoefficients(Dispatch< ImageDimension >(),
+                                       evaluateIndex, weights);
+}
+
+template< class TImageType, class TCoordRep, class TCoefficientType >
+void
+BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+::EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                              OutputType *values,
+                              SizeValueType numberOfIndices) const
+{
+  vnl_matrix< long >   evaluateIndex( ImageDimension, ( m_SplineOrder + 1 ) );
+  vnl_matrix< double > weights( ImageDimension, ( m_SplineOrder + 1 ) );
+
+  for ( SizeValueType i = 0; i < numberOfIndices; i++ )
+    {
+    values[i] = this->EvaluateAtContinuousIndexInternal(indices[i],
+                                                        evaluateIndex,
+                                                        weights);
+    }
+}
+
+template< class TImageType, class TCoordRep, class TCoefficientType >
+double
+BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+::InterpolateCoefficients(const Dispatch< 2 > &,
+                          const vnl_matrix< long > & evaluateIndex,
+                          const vnl_matrix< double > & weights) const
+{
+  const CoefficientDataType *coefficients = m_Coefficients->GetBufferPointer();
+  const IndexType            bufferStart = m_Coefficients->GetBufferedRegion().GetIndex();
+  const OffsetValueType      stride1 = m_Coefficients->GetOffsetTable()[1];
+
+  const long *  evaluateIndex0 = evaluateIndex[0];
+  const long *  evaluateIndex1 = evaluateIndex[1];
+  const double *weights0 = weights[0];
+  const double *weights1 = weights[1];
+
+  double interpolated = 0.0;
+  for ( unsigned int k1 = 0; k1 <= m_SplineOrder; k1++ )
+    {
+    const CoefficientDataType *line = coefficients
+                                      + ( evaluateIndex1[k1] - bufferStart[1] ) * stride1;
+    double lineValue = 0.0;
+    for ( unsigned int k0 = 0; k0 <= m_SplineOrder; k0++ )
+      {
+      lineValue += weights0[k0] * line[evaluateIndex0[k0] - bufferStart[0]];
+      }
+    interpolated += weights1[k1] * lineValue;
+    }
+
+  return interpolated;
+}
+
+template< class TImageType, class TCoordRep, class TCoefficientType >
+double
+BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+::InterpolateCoefficients(const Dispatch< 3 > &,
+                          const vnl_matrix< long > & evaluateIndex,
+                          const vnl_matrix< double > & weights) const
+{
+  const CoefficientDataType *coefficients = m_Coefficients->GetBufferPointer();
+  const IndexType            bufferStart = m_Coefficients->GetBufferedRegion().GetIndex();
+  const OffsetValueType      stride1 = m_Coefficients->GetOffsetTable()[1];
+  const OffsetValueType      stride2 = m_Coefficients->GetOffsetTable()[2];
+
+  const long *  evaluateIndex0 = evaluateIndex[0];
+  const long *  evaluateIndex1 = evaluateIndex[1];
+  const long *  evaluateIndex2 = evaluateIndex[2];
+  const double *weights0 = weights[0];
+  const double *weights1 = weights[1];
+  const double *weights2 = weights[2];
+
+  double interpolated = 0.0;
+  for ( unsigned int k2 = 0; k2 <= m_SplineOrder; k2++ )
+    {
+    const CoefficientDataType *slice = coefficients
+                                       + ( evaluateIndex2[k2] - bufferStart[2] ) * stride2;
+    double sliceValue = 0.0;
+    for ( unsigned int k1 = 0; k1 <= m_SplineOrder; k1++ )
+      {
+      const CoefficientDataType *line = slice
+                                        + ( evaluateIndex1[k1] - bufferStart[1] ) * stride1;
+      double lineValue = 0.0;
+      for ( unsigned int k0 = 0; k0 <= m_SplineOrder; k0++ )
+        {
+        lineValue += weights0[k0] * line[evaluateIndex0[k0] - bufferStart[0]];
+        }
+      sliceValue += weights1[k1] * lineValue;
+      }
+    interpolated += weights2[k2] * sliceValue;
+    }
+
+  return interpolated;
+}
+
+template< class TImageType, class TCoordRep, class TCoefficientType >
+double
+BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+::InterpolateCoefficients(const DispatchBase &,
+                          const vnl_matrix< long > & evaluateIndex,
+                          const vnl_matrix< double > & weights) const
+{
+  const CoefficientDataType *coefficients = m_Coefficients->GetBufferPointer();
+  const IndexType            bufferStart = m_Coefficients->GetBufferedRegion().GetIndex();
+  const OffsetValueType *    offsetTable = m_Coefficients->GetOffsetTable();
+
+  double interpolated = 0.0;
   // Step through eachpoint in the N-dimensional interpolation cube.
   for ( unsigned int p = 0; p < m_MaxNumberInterpolationPoints; p++ )
     {
-    double w = 1.0;
+    double          w = 1.0;
+    OffsetValueType offset = 0;
     for ( unsigned int n = 0; n < ImageDimension; n++ )
       {
       unsigned int indx = m_PointsToIndex[p][n];
       w *= ( weights )[n][indx];
-      coefficientIndex[n] = ( evaluateIndex )[n][indx];
+      offset += ( ( evaluateIndex )[n][indx] - bufferStart[n] ) * offsetTable[n];
       }
-    interpolated += w * m_Coefficients->GetPixel(coefficientIndex);
+    interpolated += w * coefficients[offset];
     }
 
-  return ( interpolated );
+  return interpolated;
 }
 
 template< class TImageType, class TCoordRep, class TCoefficientType >
@@ -176,6 +176,20 @@ public:
     return isInside;
   }
 
+  /** Compute the part [begin, end) of the points start + i * delta, for i
+   * in [0, numberOfPoints), which are inside the image buffer according to
+   * IsInsideBuffer(const ContinuousIndexType &). The default implementation
+   * bounds the part analytically with the start and end continuous
+   * indices, and only checks the points at its ends with IsInsideBuffer.
+   * \warning A subclass overriding IsInsideBuffer(const ContinuousIndexType &)
+   * must override this method as well, since ResampleImageFilter relies on
+   * it to find the pixels to interpolate. */
+  virtual void ComputeLinePartInsideBuffer(const ContinuousIndexType & start,
+                                           const typename ContinuousIndexType::VectorType & delta,
+                                           SizeValueType numberOfPoints,
+                                           SizeValueType & begin,
+                                           SizeValueType & end) const;
+
   /** Convert point to nearest index. */
   void ConvertPointToNearestIndex(const PointType & point,
                                   IndexType & index) const
@@ -19,6 +19,8 @@
 #define __itkImageFunction_hxx
 
 #include "itkImageFunction.h"
+#include "vnl/vnl_math.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -79,6 +81,139 @@ ImageFunction< TInputImage, TOutput, TCoordRep >
       }
     }
 }
+
+/**
+ * Find the part of a line of points inside the buffer
+ */
+template< class TInputImage, class TOutput, class TCoordRep >
+void
+ImageFunction< TInputImage, TOutput, TCoordRep >
+::ComputeLinePartInsideBuffer(const ContinuousIndexType & start,
+                              const typename ContinuousIndexType::VectorType & delta,
+                              SizeValueType numberOfPoints,
+                              SizeValueType & begin,
+                              SizeValueType & end) const
+{
+  // Bound the part of the line within the buffer analytically, to
+  // [lower, upper). The bounds are only accurate up to the rounding
+  // errors, which are estimated as well. A line almost parallel to a side
+  // of the buffer is checked point by point.
+  const ContinuousIndexType & startBound = m_StartContinuousIndex;
+  const ContinuousIndexType & endBound = m_EndContinuousIndex;
+  const double                length = static_cast< double >( numberOfPoints );
+  const double                epsilon = NumericTraits< TCoordRep >::epsilon();
+
+  double lower = 0.0;
+  double upper = length;
+  bool   accurate = true;
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    const double magnitude = vcl_abs( static_cast< double >( start[d] ) )
+                             + vcl_abs( static_cast< double >( startBound[d] ) )
+                             + vcl_abs( static_cast< double >( endBound[d] ) )
+                             + length * vcl_abs( static_cast< double >( delta[d] ) );
+    if ( 8.0 * epsilon * magnitude >= 0.5 * vcl_abs( static_cast< double >( delta[d] ) ) )
+      {
+      if ( delta[d] != 0 )
+        {
+        accurate = false;
+        }
+      else if ( !( start[d] >= startBound[d] && start[d] < endBound[d] ) )
+        {
+        // A constant coordinate outside of the buffer
+        begin = 0;
+        end = 0;
+        return;
+        }
+      continue;
+      }
+    double a = ( static_cast< double >( startBound[d] ) - start[d] ) / delta[d];
+    double b = ( static_cast< double >( endBound[d] ) - start[d] ) / delta[d];
+    if ( a > b )
+      {
+      std::swap(a, b);
+      }
+    lower = vnl_math_max(lower, a);
+    upper = vnl_math_min(upper, b);
+    }
+
+  // The points more than one step away from [lower, upper) are outside of
+  // the buffer, and those more than one step inside of it are inside.
+  // Only the points in between are checked with IsInsideBuffer, which
+  // gives the exact part of the line inside the buffer, since it has no
+  // hole.
+  SizeValueType checkBegin = 0;
+  SizeValueType checkEnd = numberOfPoints;
+  SizeValueType coreBegin = 0;
+  SizeValueType coreEnd = 0;
+  if ( accurate )
+    {
+    if ( lower >= upper + 2.0 )
+      {
+      begin = 0;
+      end = 0;
+      return;
+      }
+    checkBegin = static_cast< SizeValueType >( vnl_math_min(vnl_math_max(vcl_floor(lower) - 1.0, 0.0), length) );
+    checkEnd = static_cast< SizeValueType >( vnl_math_min(vnl_math_max(vcl_ceil(upper) + 1.0, 0.0), length) );
+    const double coreLower = vcl_ceil(lower) + 1.0;
+    const double coreUpper = vcl_floor(upper) - 1.0;
+    if ( coreLower < coreUpper )
+      {
+      coreBegin = static_cast< SizeValueType >( coreLower );
+      coreEnd = static_cast< SizeValueType >( coreUpper );
+      }
+    }
+
+  ContinuousIndexType index;
+  if ( coreBegin < coreEnd )
+    {
+    begin = coreBegin;
+    while ( begin > checkBegin )
+      {
+      for ( unsigned int d = 0; d < ImageDimension; d++ )
+        {
+        index[d] = start[d] + static_cast< TCoordRep >( begin - 1 ) * delta[d];
+        }
+      if ( !this->IsInsideBuffer(index) )
+        {
+        break;
+        }
+      --begin;
+      }
+    end = coreEnd;
+    }
+  else
+    {
+    begin = checkBegin;
+    while ( begin < checkEnd )
+      {
+      for ( unsigned int d = 0; d < ImageDimension; d++ )
+        {
+        index[d] = start[d] + static_cast< TCoordRep >( begin ) * delta[d];
+        }
+      if ( this->IsInsideBuffer(index) )
+        {
+        break;
+        }
+      ++begin;
+      }
+    end = begin;
+    }
+  while ( end < checkEnd )
+    {
+    for ( unsigned int d = 0; d < ImageDimension; d++ )
+      {
+      index[d] = start[d] + static_cast< TCoordRep >( end ) * delta[d];
+      }
+    if ( !this->IsInsideBuffer(index) )
+      {
+      break;
+      }
+    ++end;
+    }
+}
+
 } // end namespace itk
 
 #endif
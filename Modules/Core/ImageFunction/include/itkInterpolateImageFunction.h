@@ -110,6 +110,30 @@ public:
   virtual OutputType EvaluateAtContinuousIndex(
     const ContinuousIndexType & index) const = 0;
 
+  /** Interpolate the image at an array of continuous index positions
+   *
+   * Stores in values[i] the interpolated image intensity at
+   * indices[i], for the numberOfIndices first elements of the arrays.
+   * No bounds checking is done. The indices are assumed to lie within
+   * the image buffer.
+   *
+   * The default implementation calls EvaluateAtContinuousIndex() for each
+   * index. Subclasses can override it to interpolate a whole row of
+   * positions with less overhead per position. The method must be thread
+   * safe, as EvaluateAtContinuousIndex().
+   *
+   * ImageFunction::IsInsideBuffer() can be used to check bounds before
+   * calling the method. */
+  virtual void EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                                           OutputType *values,
+                                           SizeValueType numberOfIndices) const
+  {
+    for ( SizeValueType i = 0; i < numberOfIndices; i++ )
+      {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+      }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
@@ -19,6 +19,7 @@
 #define __itkLinearInterpolateImageFunction_h
 
 #include "itkInterpolateImageFunction.h"
+#include "itkImage.h"
 
 namespace itk
 {
@@ -97,6 +98,22 @@ public:
     return this->EvaluateOptimized(Dispatch< ImageDimension >(), index);
   }
 
+  /** Evaluate the function at an array of ContinuousIndex positions
+   *
+   * For images of dimension 2 and 3, the positions whose neighbors all
+   * lie inside the image buffer are interpolated by reading the buffer
+   * directly, with its precomputed strides, and without the special
+   * cases at the boundaries. The result is the same as the result of
+   * EvaluateAtContinuousIndex(), which interpolates the other positions.
+   * No bounds checking is done. */
+  virtual void EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                                           OutputType *values,
+                                           SizeValueType numberOfIndices) const
+  {
+    this->EvaluateAtContinuousIndicesOptimized(Dispatch< ImageDimension >(),
+                                               indices, values, numberOfIndices);
+  }
+
 protected:
   LinearInterpolateImageFunction();
   ~LinearInterpolateImageFunction();
@@ -499,6 +516,28 @@ private:
 
   virtual inline OutputType EvaluateUnoptimized(
     const ContinuousIndexType & index) const;
+
+  /** Image whose buffer can be read directly by the optimized
+   * EvaluateAtContinuousIndices() */
+  typedef Image< InputPixelType, ImageDimension > BufferImageType;
+
+  void EvaluateAtContinuousIndicesOptimized(const Dispatch< 2 > &,
+                                            const ContinuousIndexType *indices,
+                                            OutputType *values,
+                                            SizeValueType numberOfIndices) const;
+
+  void EvaluateAtContinuousIndicesOptimized(const Dispatch< 3 > &,
+                                            const ContinuousIndexType *indices,
+                                            OutputType *values,
+                                            SizeValueType numberOfIndices) const;
+
+  inline void EvaluateAtContinuousIndicesOptimized(const DispatchBase &,
+                                                   const ContinuousIndexType *indices,
+                                                   OutputType *values,
+                                                   SizeValueType numberOfIndices) const
+  {
+    this->Superclass::EvaluateAtContinuousIndices(indices, values, numberOfIndices);
+  }
 };
 } // end namespace itk
 
@@ -163,6 +163,140 @@ LinearInterpolateImageFunction< TInputImage, TCoordRep >
 
   return ( static_cast< OutputType >( value ) );
 }
+
+/**
+ * Evaluate at an array of continuous index positions of a 2D image
+ */
+template< class TInputImage, class TCoordRep >
+void
+LinearInterpolateImageFunction< TInputImage, TCoordRep >
+::EvaluateAtContinuousIndicesOptimized(const Dispatch< 2 > &,
+                                       const ContinuousIndexType *indices,
+                                       OutputType *values,
+                                       SizeValueType numberOfIndices) const
+{
+  // Only the buffer of an Image can be read directly
+  const BufferImageType *image =
+    dynamic_cast< const BufferImageType * >( this->GetInputImage() );
+
+  if ( image == NULL )
+    {
+    this->Superclass::EvaluateAtContinuousIndices(indices, values, numberOfIndices);
+    return;
+    }
+
+  const InputPixelType *buffer = image->GetBufferPointer();
+  const IndexType       bufferStart = image->GetBufferedRegion().GetIndex();
+  const OffsetValueType stride1 = image->GetOffsetTable()[1];
+
+  for ( SizeValueType i = 0; i < numberOfIndices; i++ )
+    {
+    const ContinuousIndexType & index = indices[i];
+
+    const IndexValueType base0 = Math::Floor< IndexValueType >(index[0]);
+    const IndexValueType base1 = Math::Floor< IndexValueType >(index[1]);
+
+    // The neighbors which fall outside of the buffer are handled by
+    // EvaluateAtContinuousIndex()
+    if ( base0 < this->m_StartIndex[0] || base0 >= this->m_EndIndex[0]
+         || base1 < this->m_StartIndex[1] || base1 >= this->m_EndIndex[1] )
+      {
+      values[i] = this->EvaluateAtContinuousIndex(index);
+      continue;
+      }
+
+    const double distance0 = index[0] - static_cast< double >( base0 );
+    const double distance1 = index[1] - static_cast< double >( base1 );
+
+    const InputPixelType *neighbors = buffer
+                                      + ( base0 - bufferStart[0] )
+                                      + ( base1 - bufferStart[1] ) * stride1;
+
+    const RealType val00 = neighbors[0];
+    const RealType val10 = neighbors[1];
+    const RealType val01 = neighbors[stride1];
+    const RealType val11 = neighbors[stride1 + 1];
+
+    const RealType valx0 = val00 + ( val10 - val00 ) * distance0;
+    const RealType valx1 = val01 + ( val11 - val01 ) * distance0;
+
+    values[i] = static_cast< OutputType >( valx0 + ( valx1 - valx0 ) * distance1 );
+    }
+}
+
+/**
+ * Evaluate at an array of continuous index positions of a 3D image
+ */
+template< class TInputImage, class TCoordRep >
+void
+LinearInterpolateImageFunction< TInputImage, TCoordRep >
+::EvaluateAtContinuousIndicesOptimized(const Dispatch< 3 > &,
+                                       const ContinuousIndexType *indices,
+                                       OutputType *values,
+                                       SizeValueType numberOfIndices) const
+{
+  // Only the buffer of an Image can be read directly
+  const BufferImageType *image =
+    dynamic_cast< const BufferImageType * >( this->GetInputImage() );
+
+  if ( image == NULL )
+    {
+    this->Superclass::EvaluateAtContinuousIndices(indices, values, numberOfIndices);
+    return;
+    }
+
+  const InputPixelType *buffer = image->GetBufferPointer();
+  const IndexType       bufferStart = image->GetBufferedRegion().GetIndex();
+  const OffsetValueType stride1 = image->GetOffsetTable()[1];
+  const OffsetValueType stride2 = image->GetOffsetTable()[2];
+
+  for ( SizeValueType i = 0; i < numberOfIndices; i++ )
+    {
+    const ContinuousIndexType & index = indices[i];
+
+    const IndexValueType base0 = Math::Floor< IndexValueType >(index[0]);
+    const IndexValueType base1 = Math::Floor< IndexValueType >(index[1]);
+    const IndexValueType base2 = Math::Floor< IndexValueType >(index[2]);
+
+    // The neighbors which fall outside of the buffer are handled by
+    // EvaluateAtContinuousIndex()
+    if ( base0 < this->m_StartIndex[0] || base0 >= this->m_EndIndex[0]
+         || base1 < this->m_StartIndex[1] || base1 >= this->m_EndIndex[1]
+         || base2 < this->m_StartIndex[2] || base2 >= this->m_EndIndex[2] )
+      {
+      values[i] = this->EvaluateAtContinuousIndex(index);
+      continue;
+      }
+
+    const double distance0 = index[0] - static_cast< double >( base0 );
+    const double distance1 = index[1] - static_cast< double >( base1 );
+    const double distance2 = index[2] - static_cast< double >( base2 );
+
+    const InputPixelType *neighbors = buffer
+                                      + ( base0 - bufferStart[0] )
+                                      + ( base1 - bufferStart[1] ) * stride1
+                                      + ( base2 - bufferStart[2] ) * stride2;
+
+    const RealType val000 = neighbors[0];
+    const RealType val100 = neighbors[1];
+    const RealType val010 = neighbors[stride1];
+    const RealType val110 = neighbors[stride1 + 1];
+    const RealType val001 = neighbors[stride2];
+    const RealType val101 = neighbors[stride2 + 1];
+    const RealType val011 = neighbors[stride2 + stride1];
+    const RealType val111 = neighbors[stride2 + stride1 + 1];
+
+    const RealType valx00 = val000 + ( val100 - val000 ) * distance0;
+    const RealType valx10 = val010 + ( val110 - val010 ) * distance0;
+    const RealType valx01 = val001 + ( val101 - val001 ) * distance0;
+    const RealType valx11 = val011 + ( val111 - val011 ) * distance0;
+
+    const RealType valxx0 = valx00 + ( valx10 - valx00 ) * distance1;
+    const RealType valxx1 = valx01 + ( valx11 - valx01 ) * distance1;
+
+    values[i] = static_cast< OutputType >( valxx0 + ( valxx1 - valxx0 ) * distance2 );
+    }
+}
 } // end namespace itk
 
 #endif
@@ -164,6 +164,18 @@ public:
     return true;
   }
 
+  /** Every point of a line is inside the buffer, since IsInsideBuffer()
+   * always answers true. */
+  void ComputeLinePartInsideBuffer(const ContinuousIndexType &,
+                                   const typename ContinuousIndexType::VectorType &,
+                                   SizeValueType numberOfPoints,
+                                   SizeValueType & begin,
+                                   SizeValueType & end) const
+  {
+    begin = 0;
+    end = numberOfPoints;
+  }
+
 protected:
 
   /// Constructor
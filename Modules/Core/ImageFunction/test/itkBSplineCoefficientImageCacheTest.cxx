@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+/**
+ * The B-spline interpolators which use the coefficient image cache share
+ * the coefficients of the same image, and compute them again when the
+ * image or the spline order change.
+ */
+namespace
+{
+typedef itk::Image< short, 3 >                                    ImageType;
+typedef itk::BSplineInterpolateImageFunction< ImageType, double > InterpolatorType;
+typedef InterpolatorType::CoefficientImageCacheType               CacheType;
+
+void
+FillImage(ImageType *image, unsigned int seed)
+{
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245 + 12345;
+    it.Set( static_cast< short >( ( seed / 65536 ) % 300 ) );
+    }
+  image->Modified();
+}
+
+InterpolatorType::Pointer
+CreateInterpolator(const ImageType *image, unsigned int splineOrder, bool useCache)
+{
+  InterpolatorType::Pointer interpolator = InterpolatorType::New();
+  interpolator->SetSplineOrder(splineOrder);
+  interpolator->SetUseCoefficientImageCache(useCache);
+  interpolator->SetInputImage(image);
+  return interpolator;
+}
+
+/** Compare the interpolator with one which computes its own coefficients */
+bool
+CompareWithUncached(const ImageType *image, InterpolatorType *interpolator, const char *name)
+{
+  InterpolatorType::Pointer uncached =
+    CreateInterpolator(image, interpolator->GetSplineOrder(), false);
+
+  const ImageType::RegionType region = image->GetBufferedRegion();
+
+  InterpolatorType::ContinuousIndexType index;
+  for ( unsigned int i = 0; i < 50; i++ )
+    {
+    for ( unsigned int d = 0; d < ImageType::ImageDimension; d++ )
+      {
+      index[d] = region.GetIndex()[d]
+                 + vcl_fmod( 0.37 * ( i + 1 ) * ( d + 1 ), region.GetSize()[d] - 1.0 );
+      }
+    const double expected = uncached->EvaluateAtContinuousIndex(index);
+    const double value = interpolator->EvaluateAtContinuousIndex(index);
+    if ( value != expected )
+      {
+      std::cerr << name << ": the value at " << index << " is " << value
+                << " instead of " << expected << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool
+CheckNumberOfCoefficientImages(itk::SizeValueType expected, const char *name)
+{
+  if ( CacheType::GetNumberOfCoefficientImages() != expected )
+    {
+    std::cerr << name << ": the cache holds " << CacheType::GetNumberOfCoefficientImages()
+              << " coefficient images instead of " << expected << std::endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int itkBSplineCoefficientImageCacheTest(int, char *[])
+{
+  ImageType::Pointer    image = ImageType::New();
+  ImageType::RegionType region;
+  ImageType::SizeType   size = { { 17, 12, 9 } };
+  ImageType::IndexType  start = { { -2, 0, 3 } };
+  region.SetSize(size);
+  region.SetIndex(start);
+  image->SetRegions(region);
+  image->Allocate();
+  FillImage(image, 1);
+
+  bool passed = true;
+
+  // The interpolators of the same image with the same spline order share
+  // one coefficient image
+  InterpolatorType::Pointer first = CreateInterpolator(image, 3, true);
+  InterpolatorType::Pointer second = CreateInterpolator(image, 3, true);
+  passed &= CheckNumberOfCoefficientImages(1, "same image");
+  passed &= CompareWithUncached(image, first, "first interpolator");
+  passed &= CompareWithUncached(image, second, "second interpolator");
+
+  // Setting the same image again doesn't compute the coefficients again
+  first->SetInputImage(image);
+  passed &= CheckNumberOfCoefficientImages(1, "same image again");
+
+  // Another spline order has other coefficients
+  InterpolatorType::Pointer quadratic = CreateInterpolator(image, 2, true);
+  passed &= CheckNumberOfCoefficientImages(2, "other spline order");
+  passed &= CompareWithUncached(image, quadratic, "other spline order");
+
+  // The interpolators which don't use the cache aren't counted
+  InterpolatorType::Pointer uncached = CreateInterpolator(image, 3, false);
+  passed &= CheckNumberOfCoefficientImages(2, "uncached interpolator");
+
+  // A modified image has new coefficients, and the interpolators which
+  // still use the old ones are unchanged
+  InterpolatorType::Pointer old = CreateInterpolator(image, 3, true);
+  ImageType::Pointer        copy = ImageType::New();
+  copy->SetRegions(region);
+  copy->Allocate();
+  FillImage(copy, 1);
+
+  FillImage(image, 2);
+  InterpolatorType::Pointer modified = CreateInterpolator(image, 3, true);
+  passed &= CheckNumberOfCoefficientImages(3, "modified image");
+  passed &= CompareWithUncached(image, modified, "modified image");
+  passed &= CompareWithUncached(copy, old, "coefficients of the image before it was modified");
+
+  // The coefficients computed for an image are kept when the interpolator
+  // which computed them is set to another image
+  InterpolatorType::Pointer reused = CreateInterpolator(image, 4, true);
+  reused->SetInputImage(copy);
+  InterpolatorType::Pointer shared = CreateInterpolator(image, 4, true);
+  passed &= CheckNumberOfCoefficientImages(5, "interpolator set to another image");
+  passed &= CompareWithUncached(image, shared, "coefficients of the previous image of an interpolator");
+  passed &= CompareWithUncached(copy, reused, "coefficients of the next image of an interpolator");
+
+  // The coefficients which aren't used anymore are released by the next
+  // cache miss
+  first = NULL;
+  second = NULL;
+  old = NULL;
+  quadratic = NULL;
+  reused = NULL;
+  shared = NULL;
+  InterpolatorType::Pointer linear = CreateInterpolator(image, 1, true);
+  passed &= CheckNumberOfCoefficientImages(2, "released coefficients");
+  passed &= CompareWithUncached(image, linear, "linear");
+
+  CacheType::Clear();
+  passed &= CheckNumberOfCoefficientImages(0, "cleared cache");
+  passed &= CompareWithUncached(image, modified, "modified image after clear");
+
+  if ( !passed )
+    {
+    std::cerr << "Test FAILED !" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -32,6 +32,7 @@
 #include "itkSize.h"
 #include "itkRandomImageSource.h"
 #include "itkFilterWatcher.h"
+#include "itkImageRegionConstIterator.h"
 
 #include "vnl/vnl_sample.h"
 
@@ -126,6 +127,37 @@ int itkBSplineDecompositionImageFilterTest(int, char* [] )
 
     }
 
+  /** The lines are shared among the threads: the coefficients don't depend
+   * on the number of threads. */
+  FilterType::Pointer singleThreadFilter = FilterType::New();
+  singleThreadFilter->SetSplineOrder( SplineOrder );
+  singleThreadFilter->SetInput( source->GetOutput() );
+  singleThreadFilter->SetNumberOfThreads( 1 );
+  singleThreadFilter->Update();
+
+  FilterType::Pointer multiThreadFilter = FilterType::New();
+  multiThreadFilter->SetSplineOrder( SplineOrder );
+  multiThreadFilter->SetInput( source->GetOutput() );
+  multiThreadFilter->SetNumberOfThreads( 3 );
+  multiThreadFilter->Update();
+
+  itk::ImageRegionConstIterator<ImageType> singleIt( singleThreadFilter->GetOutput(),
+                                                    singleThreadFilter->GetOutput()->GetBufferedRegion() );
+  itk::ImageRegionConstIterator<ImageType> multiIt( multiThreadFilter->GetOutput(),
+                                                   multiThreadFilter->GetOutput()->GetBufferedRegion() );
+  for ( ; !singleIt.IsAtEnd(); ++singleIt, ++multiIt )
+    {
+    if ( singleIt.Get() != multiIt.Get() )
+      {
+      std::cout << "The coefficients depend on the number of threads." << std::endl;
+      std::cout << " index: " << singleIt.GetIndex() << std::endl;
+      std::cout << " 1 thread: " << singleIt.Get() << std::endl;
+      std::cout << " 3 threads: " << multiIt.Get() << std::endl;
+      std::cout << " Test failed. " << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   /** Instanciation test with a std::complex pixel */
   typedef std::complex<float>                                                     ComplexPixelType;
   typedef itk::Image<ComplexPixelType,ImageDimension>                             ComplexImageType;
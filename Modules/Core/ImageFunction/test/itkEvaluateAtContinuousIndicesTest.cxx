@@ -0,0 +1,188 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+/**
+ * The interpolators evaluate an array of continuous indices at once with
+ * EvaluateAtContinuousIndices(). This test checks that each value is the
+ * one computed by EvaluateAtContinuousIndex() for the same index, for
+ * indices spread over the whole buffer, including its borders, the
+ * positions which fall exactly on pixels, and a buffer which doesn't
+ * start at the origin.
+ */
+namespace
+{
+template< class TImage >
+typename TImage::Pointer
+CreateImage()
+{
+  typedef typename TImage::RegionType RegionType;
+  typename TImage::IndexType start;
+  typename TImage::SizeType  size;
+  for ( unsigned int d = 0; d < TImage::ImageDimension; d++ )
+    {
+    start[d] = 3 - 2 * static_cast< int >( d );
+    size[d] = 7 + d;
+    }
+
+  typename TImage::Pointer image = TImage::New();
+  image->SetRegions( RegionType(start, size) );
+  image->Allocate();
+
+  unsigned int                                seed = 7;
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, image->GetBufferedRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245 + 12345;
+    it.Set( static_cast< typename TImage::PixelType >( ( seed / 65536 ) % 200 ) );
+    }
+  return image;
+}
+
+template< class TInterpolator >
+bool
+CompareWithSingleIndices(TInterpolator *interpolator, double tolerance, const char *name)
+{
+  typedef typename TInterpolator::ContinuousIndexType ContinuousIndexType;
+  typedef typename TInterpolator::OutputType          OutputType;
+
+  const unsigned int Dimension = TInterpolator::ImageDimension;
+
+  const typename TInterpolator::InputImageType::RegionType region =
+    interpolator->GetInputImage()->GetBufferedRegion();
+
+  // Random positions inside the buffer, and positions on its borders
+  std::vector< ContinuousIndexType > indices;
+  unsigned int                       seed = 11;
+  for ( unsigned int i = 0; i < 500; i++ )
+    {
+    ContinuousIndexType index;
+    for ( unsigned int d = 0; d < Dimension; d++ )
+      {
+      seed = seed * 1103515245 + 12345;
+      const double fraction = ( seed / 65536 ) % 1000 / 1000.0;
+      index[d] = region.GetIndex()[d] - 0.5 + fraction * region.GetSize()[d];
+      if ( i % 5 == 1 )
+        {
+        // on the pixels
+        index[d] = vcl_floor(index[d] + 0.5);
+        }
+      }
+    if ( i % 7 == 2 )
+      {
+      // on the first or last pixel, or past it, along one dimension
+      const unsigned int d = i % Dimension;
+      switch ( i % 4 )
+        {
+        case 0:
+          index[d] = region.GetIndex()[d];
+          break;
+        case 1:
+          index[d] = region.GetIndex()[d] - 0.25;
+          break;
+        case 2:
+          index[d] = region.GetIndex()[d] + region.GetSize()[d] - 1;
+          break;
+        default:
+          index[d] = region.GetIndex()[d] + region.GetSize()[d] - 0.75;
+        }
+      }
+    indices.push_back(index);
+    }
+
+  std::vector< OutputType > values( indices.size() );
+  interpolator->EvaluateAtContinuousIndices( &indices[0], &values[0], indices.size() );
+
+  for ( unsigned int i = 0; i < indices.size(); i++ )
+    {
+    const OutputType expected = interpolator->EvaluateAtContinuousIndex(indices[i]);
+    if ( vcl_abs(values[i] - expected) > tolerance )
+      {
+      std::cerr << name << ": the value at " << indices[i] << " is " << values[i]
+                << " instead of " << expected << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template< unsigned int VDimension >
+bool
+TestInterpolators()
+{
+  typedef itk::Image< short, VDimension > ImageType;
+  typedef itk::Image< float, VDimension > FloatImageType;
+
+  typename ImageType::Pointer      image = CreateImage< ImageType >();
+  typename FloatImageType::Pointer floatImage = CreateImage< FloatImageType >();
+
+  std::cout << "Testing dimension " << VDimension << std::endl;
+
+  bool passed = true;
+
+  // The linear interpolation of the whole array gives the same values
+  typedef itk::LinearInterpolateImageFunction< ImageType, double > LinearType;
+  typename LinearType::Pointer linear = LinearType::New();
+  linear->SetInputImage(image);
+  passed &= CompareWithSingleIndices(linear.GetPointer(), 0.0, "linear");
+
+  typedef itk::LinearInterpolateImageFunction< FloatImageType, float > FloatLinearType;
+  typename FloatLinearType::Pointer floatLinear = FloatLinearType::New();
+  floatLinear->SetInputImage(floatImage);
+  passed &= CompareWithSingleIndices(floatLinear.GetPointer(), 0.0, "float linear");
+
+  // The default implementation of the base class
+  typedef itk::NearestNeighborInterpolateImageFunction< ImageType, double > NearestType;
+  typename NearestType::Pointer nearest = NearestType::New();
+  nearest->SetInputImage(image);
+  passed &= CompareWithSingleIndices(nearest.GetPointer(), 0.0, "nearest neighbor");
+
+  typedef itk::BSplineInterpolateImageFunction< ImageType, double > BSplineType;
+  typename BSplineType::Pointer bspline = BSplineType::New();
+  for ( unsigned int order = 0; order <= 5; order++ )
+    {
+    bspline->SetSplineOrder(order);
+    bspline->SetInputImage(image);
+    passed &= CompareWithSingleIndices(bspline.GetPointer(), 0.0, "B-spline");
+    }
+
+  return passed;
+}
+}
+
+int itkEvaluateAtContinuousIndicesTest(int, char *[])
+{
+  bool passed = true;
+
+  passed &= TestInterpolators< 1 >();
+  passed &= TestInterpolators< 2 >();
+  passed &= TestInterpolators< 3 >();
+  passed &= TestInterpolators< 4 >();
+
+  if ( !passed )
+    {
+    std::cerr << "Test FAILED !" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
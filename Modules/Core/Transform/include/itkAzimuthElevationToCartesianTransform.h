@@ -135,6 +135,18 @@ public:
   /** Transform from azimuth-elevation to cartesian. */
   OutputPointType     TransformPoint(const InputPointType  & point) const;
 
+  /** Transform an array of points one at a time, since this transform
+   * isn't the affine transform of its superclass. */
+  virtual void TransformPoints(const InputPointType *inputPoints,
+                               OutputPointType *outputPoints,
+                               SizeValueType numberOfPoints) const
+  {
+    for ( SizeValueType k = 0; k < numberOfPoints; k++ )
+      {
+      outputPoints[k] = this->TransformPoint(inputPoints[k]);
+      }
+  }
+
   /** Back transform from cartesian to azimuth-elevation.  */
   inline InputPointType  BackTransform(const OutputPointType  & point) const
   {
@@ -329,6 +329,13 @@ public:
   virtual void TransformPoint( const InputPointType &, OutputPointType &, WeightsType &, ParameterIndexArrayType &,
                                bool & ) const;
 
+  /** Transform an array of points by a BSpline deformable transformation.
+   * The weights and the offsets of the support region are allocated once
+   * for the whole array, and the coefficients are read straight from the
+   * buffers of the coefficient images. */
+  virtual void TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+                                SizeValueType numberOfPoints ) const;
+
   /** Get number of weights. */
   unsigned long GetNumberOfWeights() const
   {
@@ -791,6 +791,92 @@ BSplineTransform<TScalarType, NDimensions, VSplineOrder>
   return outputPoint;
 }
 
+// Transform an array of points
+template <class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder>
+void
+BSplineTransform<TScalarType, NDimensions, VSplineOrder>
+::TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+                   SizeValueType numberOfPoints ) const
+{
+  if( !this->m_CoefficientImages[0]->GetBufferPointer() )
+    {
+    itkWarningMacro( "B-spline coefficients have not been set" );
+    for( SizeValueType k = 0; k < numberOfPoints; k++ )
+      {
+      outputPoints[k] = inputPoints[k];
+      }
+    return;
+    }
+
+  const unsigned long numberOfWeights = this->m_WeightsFunction->GetNumberOfWeights();
+  WeightsType         weights( numberOfWeights );
+
+  // Offsets of the coefficients of a support region from its first
+  // coefficient, in the order in which TransformPoint visits them
+  const ImageType *                         coefficientImage = this->m_CoefficientImages[0];
+  const typename ImageType::OffsetValueType *offsetTable = coefficientImage->GetOffsetTable();
+  std::vector<OffsetValueType>              supportOffsets( numberOfWeights );
+  for( unsigned long w = 0; w < numberOfWeights; w++ )
+    {
+    OffsetValueType offset = 0;
+    unsigned long   remainder = w;
+    for( unsigned int j = 0; j < SpaceDimension; j++ )
+      {
+      offset += static_cast<OffsetValueType>( remainder % ( SplineOrder + 1 ) ) * offsetTable[j];
+      remainder /= SplineOrder + 1;
+      }
+    supportOffsets[w] = offset;
+    }
+
+  const ParametersValueType *coefficients[SpaceDimension];
+  for( unsigned int j = 0; j < SpaceDimension; j++ )
+    {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+    }
+
+  for( SizeValueType k = 0; k < numberOfPoints; k++ )
+    {
+    const InputPointType point = inputPoints[k];
+    ContinuousIndexType  index;
+    coefficientImage->TransformPhysicalPointToContinuousIndex( point, index );
+
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    if( !this->InsideValidRegion( index ) )
+      {
+      outputPoints[k] = point;
+      continue;
+      }
+
+    IndexType supportIndex;
+    this->m_WeightsFunction->Evaluate( index, weights, supportIndex );
+    const ParametersValueType *supportStart[SpaceDimension];
+    const OffsetValueType      start = coefficientImage->ComputeOffset( supportIndex );
+    for( unsigned int j = 0; j < SpaceDimension; j++ )
+      {
+      supportStart[j] = coefficients[j] + start;
+      }
+
+    ScalarType displacement[SpaceDimension];
+    for( unsigned int j = 0; j < SpaceDimension; j++ )
+      {
+      displacement[j] = NumericTraits<ScalarType>::Zero;
+      }
+    for( unsigned long w = 0; w < numberOfWeights; w++ )
+      {
+      const OffsetValueType offset = supportOffsets[w];
+      for( unsigned int j = 0; j < SpaceDimension; j++ )
+        {
+        displacement[j] += static_cast<ScalarType>( weights[w] * supportStart[j][offset] );
+        }
+      }
+    for( unsigned int j = 0; j < SpaceDimension; j++ )
+      {
+      outputPoints[k][j] = displacement[j] + point[j];
+      }
+    }
+}
+
 // Compute the Jacobian in one position
 template <class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder>
 void
@@ -295,6 +295,13 @@ public:
   */
   virtual OutputPointType TransformPoint( const InputPointType & inputPoint ) const;
 
+  /** Compute the positions of an array of points in the new space, by
+   * applying each transform of the queue to the whole array in turn, in the
+   * same order as TransformPoint. */
+  virtual void TransformPoints( const InputPointType *inputPoints,
+                                OutputPointType *outputPoints,
+                                SizeValueType numberOfPoints ) const;
+
   /* Note: why was the 'isInsideTransformRegion' flag used below?
   {
     bool isInside = true;
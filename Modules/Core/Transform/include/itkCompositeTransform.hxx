@@ -20,6 +20,7 @@
 
 #include "itkCompositeTransform.h"
 #include <string.h> // for memcpy on some platforms
+#include <algorithm>
 
 namespace itk
 {
@@ -90,6 +91,31 @@ CompositeTransform<TScalar, NDimensions>
   return outputPoint;
 }
 
+/**
+ * Transform points
+ */
+template
+<class TScalar, unsigned int NDimensions>
+void
+CompositeTransform<TScalar, NDimensions>
+::TransformPoints( const InputPointType *inputPoints,
+                   OutputPointType *outputPoints,
+                   SizeValueType numberOfPoints ) const
+{
+  if( outputPoints != inputPoints )
+    {
+    std::copy( inputPoints, inputPoints + numberOfPoints, outputPoints );
+    }
+
+  /* Apply in reverse queue order, each transform mapping the whole array
+   * in place. */
+  typename TransformQueueType::const_reverse_iterator it;
+  for( it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it )
+    {
+    (*it)->TransformPoints( outputPoints, outputPoints, numberOfPoints );
+    }
+}
+
 /**
  * return an inverse transformation
  */
@@ -66,6 +66,10 @@ namespace itk
  * The last NOutputDimension parameters defines the translation
  * in each dimensions.
  *
+ * TransformPoints() maps arrays of points with the matrix and the offset
+ * directly. A subclass that overrides TransformPoint() with another
+ * mapping must also override TransformPoints().
+ *
  * \ingroup ITKTransform
  */
 
@@ -338,6 +342,14 @@ public:
 
   OutputPointType       TransformPoint(const InputPointType & point) const;
 
+  /** Transform an array of points by the matrix and the offset, one
+   * output coordinate at a time over the whole array. TransformPoint is
+   * not called: a subclass that overrides TransformPoint must override
+   * this method as well (see Transform::TransformPoints()). */
+  virtual void TransformPoints(const InputPointType *inputPoints,
+                               OutputPointType *outputPoints,
+                               SizeValueType numberOfPoints) const;
+
   using Superclass::TransformVector;
   OutputVectorType      TransformVector(const InputVectorType & vector) const;
 
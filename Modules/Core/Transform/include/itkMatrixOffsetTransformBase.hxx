@@ -185,6 +185,69 @@ MatrixOffsetTransformBase<TScalarType, NInputDimensions, NOutputDimensions>
   return m_Matrix * point + m_Offset;
 }
 
+// Transform an array of points
+template <class TScalarType, unsigned int NInputDimensions,
+          unsigned int NOutputDimensions>
+void
+MatrixOffsetTransformBase<TScalarType, NInputDimensions, NOutputDimensions>
+::TransformPoints(const InputPointType *inputPoints,
+                  OutputPointType *outputPoints,
+                  SizeValueType numberOfPoints) const
+{
+  // Local copies, which the compiler knows aren't aliased by the points
+  TScalarType matrix[NOutputDimensions][NInputDimensions];
+  TScalarType offset[NOutputDimensions];
+  for( unsigned int i = 0; i < NOutputDimensions; i++ )
+    {
+    for( unsigned int j = 0; j < NInputDimensions; j++ )
+      {
+      matrix[i][j] = m_Matrix[i][j];
+      }
+    offset[i] = m_Offset[i];
+    }
+
+  // The points are copied by blocks into arrays of coordinates, so that
+  // each output coordinate is computed for the whole block by the same
+  // vectorizable loop. The whole block is read before it is written,
+  // which lets the output array be the input array.
+  const SizeValueType blockSize = 32;
+  TScalarType         coordinates[NInputDimensions][blockSize];
+  TScalarType         results[blockSize];
+  for( SizeValueType start = 0; start < numberOfPoints; start += blockSize )
+    {
+    const SizeValueType count = vnl_math_min( blockSize, numberOfPoints - start );
+    const InputPointType *input = inputPoints + start;
+    OutputPointType *     output = outputPoints + start;
+    for( SizeValueType k = 0; k < count; k++ )
+      {
+      for( unsigned int j = 0; j < NInputDimensions; j++ )
+        {
+        coordinates[j][k] = input[k][j];
+        }
+      }
+    for( unsigned int i = 0; i < NOutputDimensions; i++ )
+      {
+      // Same order of operations as TransformPoint
+      for( SizeValueType k = 0; k < count; k++ )
+        {
+        results[k] = NumericTraits<TScalarType>::Zero;
+        }
+      for( unsigned int j = 0; j < NInputDimensions; j++ )
+        {
+        const TScalarType m = matrix[i][j];
+        for( SizeValueType k = 0; k < count; k++ )
+          {
+          results[k] += m * coordinates[j][k];
+          }
+        }
+      for( SizeValueType k = 0; k < count; k++ )
+        {
+        output[k][i] = results[k] + offset[i];
+        }
+      }
+    }
+}
+
 // Transform a vector
 template <class TScalarType, unsigned int NInputDimensions,
           unsigned int NOutputDimensions>
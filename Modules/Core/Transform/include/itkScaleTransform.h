@@ -157,6 +157,11 @@ public:
    * vector. */
   OutputPointType     TransformPoint(const InputPointType  & point) const;
 
+  /** Transform an array of points by the scale transformation. */
+  virtual void TransformPoints(const InputPointType *inputPoints,
+                               OutputPointType *outputPoints,
+                               SizeValueType numberOfPoints) const;
+
   using Superclass::TransformVector;
   OutputVectorType    TransformVector(const InputVectorType & vector) const;
 
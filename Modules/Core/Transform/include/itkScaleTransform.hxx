@@ -130,6 +130,24 @@ ScaleTransform<ScalarType, NDimensions>::TransformPoint(const InputPointType & p
   return result;
 }
 
+// Transform an array of points
+template <class ScalarType, unsigned int NDimensions>
+void
+ScaleTransform<ScalarType, NDimensions>::TransformPoints(const InputPointType *inputPoints,
+                                                         OutputPointType *outputPoints,
+                                                         SizeValueType numberOfPoints) const
+{
+  for( unsigned int i = 0; i < SpaceDimension; i++ )
+    {
+    const ScalarType center = m_Center[i];
+    const ScalarType scale = m_Scale[i];
+    for( SizeValueType k = 0; k < numberOfPoints; k++ )
+      {
+      outputPoints[k][i] = ( inputPoints[k][i] - center ) * scale + center;
+      }
+    }
+}
+
 // Transform a vector
 template <class ScalarType, unsigned int NDimensions>
 typename ScaleTransform<ScalarType, NDimensions>::OutputVectorType
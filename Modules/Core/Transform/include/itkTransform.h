@@ -19,6 +19,7 @@
 #define __itkTransform_h
 
 #include "itkTransformBase.h"
+#include "itkIntTypes.h"
 #include "itkVector.h"
 #include "itkSymmetricSecondRankTensor.h"
 #include "itkDiffusionTensor3D.h"
@@ -193,6 +194,25 @@ public:
    */
   virtual OutputPointType TransformPoint(const InputPointType  &) const = 0;
 
+  /** Method to transform a contiguous array of points, such as the points
+   * of a scan line, with a single virtual call. The default implementation
+   * calls TransformPoint for each point; subclasses override it with loops
+   * the compiler can unroll and vectorize. When the input and output point
+   * types are the same, \c outputPoints may be \c inputPoints.
+   *
+   * These overrides compute the points themselves and do not call
+   * TransformPoint. A subclass that overrides TransformPoint must
+   * therefore also override TransformPoints when one of its base classes
+   * does (MatrixOffsetTransformBase and all its subclasses, ScaleTransform,
+   * BSplineTransform, ...), for instance with the loop of
+   * Transform::TransformPoints. Otherwise TransformPoints, which
+   * ResampleImageFilter and ImageToImageMetric use, silently ignores its
+   * TransformPoint.
+   * \warning This method must be thread-safe. */
+  virtual void TransformPoints(const InputPointType *inputPoints,
+                               OutputPointType *outputPoints,
+                               SizeValueType numberOfPoints) const;
+
   /**  Method to transform a vector. */
   virtual OutputVectorType  TransformVector(const InputVectorType &) const = 0;
 
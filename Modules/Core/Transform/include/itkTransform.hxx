@@ -77,6 +77,24 @@ std::string Transform<TScalarType, NInputDimensions, NOutputDimensions>
   return n.str();
 }
 
+/**
+ * TransformPoints
+ */
+template <class TScalarType,
+          unsigned int NInputDimensions,
+          unsigned int NOutputDimensions>
+void
+Transform<TScalarType, NInputDimensions, NOutputDimensions>
+::TransformPoints( const InputPointType *inputPoints,
+                   OutputPointType *outputPoints,
+                   SizeValueType numberOfPoints ) const
+{
+  for( SizeValueType i = 0; i < numberOfPoints; i++ )
+    {
+    outputPoints[i] = this->TransformPoint( inputPoints[i] );
+    }
+}
+
 #if 0
 /**
  * SetDirectionChange
@@ -0,0 +1,236 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkAzimuthElevationToCartesianTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkEuler3DTransform.h"
+#include "itkScaleTransform.h"
+#include "itkTranslationTransform.h"
+
+/**
+ * TransformPoints maps a whole array of points with a single call. This
+ * test compares its output, into another array and in place, with the
+ * output of TransformPoint for each point.
+ */
+namespace
+{
+unsigned int seed = 1;
+
+double
+RandomValue(double minimum, double maximum)
+{
+  seed = seed * 1103515245 + 12345;
+  return minimum + ( maximum - minimum ) * ( ( seed / 65536 ) % 10000 ) / 9999.0;
+}
+
+template< class TTransform >
+bool
+CompareWithTransformPoint(const TTransform *transform, unsigned int numberOfPoints,
+                          double minimum, double maximum, double tolerance, const char *name)
+{
+  typedef typename TTransform::InputPointType  InputPointType;
+  typedef typename TTransform::OutputPointType OutputPointType;
+
+  std::vector< InputPointType > points(numberOfPoints);
+  for ( unsigned int i = 0; i < numberOfPoints; i++ )
+    {
+    for ( unsigned int j = 0; j < TTransform::InputSpaceDimension; j++ )
+      {
+      points[i][j] = RandomValue(minimum, maximum);
+      }
+    }
+
+  std::vector< OutputPointType > outputPoints(numberOfPoints);
+  transform->TransformPoints(&points[0], &outputPoints[0], numberOfPoints);
+  std::vector< InputPointType > inPlacePoints = points;
+  transform->TransformPoints(&inPlacePoints[0], &inPlacePoints[0], numberOfPoints);
+
+  for ( unsigned int i = 0; i < numberOfPoints; i++ )
+    {
+    const OutputPointType expected = transform->TransformPoint(points[i]);
+    for ( unsigned int j = 0; j < TTransform::OutputSpaceDimension; j++ )
+      {
+      const double scale = tolerance * ( 1.0 + vcl_abs(expected[j]) );
+      if ( vcl_abs(outputPoints[i][j] - expected[j]) > scale
+           || vcl_abs(inPlacePoints[i][j] - expected[j]) > scale )
+        {
+        std::cerr << name << ": point " << points[i] << " is mapped to " << outputPoints[i]
+                  << " and to " << inPlacePoints[i] << " in place instead of " << expected << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+/** A subclass of AffineTransform with a non-linear TransformPoint. As
+ * documented in Transform::TransformPoints, it must override
+ * TransformPoints as well; it uses the loop of Transform. */
+class QuadraticTransform:public itk::AffineTransform< double, 3 >
+{
+public:
+  typedef QuadraticTransform                  Self;
+  typedef itk::AffineTransform< double, 3 >   Superclass;
+  typedef itk::SmartPointer< Self >           Pointer;
+  typedef itk::SmartPointer< const Self >     ConstPointer;
+  typedef itk::Transform< double, 3, 3 >      TransformType;
+
+  itkNewMacro(Self);
+  itkTypeMacro(QuadraticTransform, AffineTransform);
+
+  OutputPointType TransformPoint(const InputPointType & point) const
+  {
+    OutputPointType result = Superclass::TransformPoint(point);
+    result[0] += 0.01 * point[1] * point[1];
+    return result;
+  }
+
+  void TransformPoints(const InputPointType *inputPoints, OutputPointType *outputPoints,
+                       itk::SizeValueType numberOfPoints) const
+  {
+    this->TransformType::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+  }
+
+protected:
+  QuadraticTransform() {}
+
+private:
+  QuadraticTransform(const Self &); //purposely not implemented
+  void operator=(const Self &);     //purposely not implemented
+};
+}
+
+int itkTransformPointsTest(int, char *[])
+{
+  // More points than the blocks of MatrixOffsetTransformBase
+  const unsigned int numberOfPoints = 77;
+
+  bool passed = true;
+
+  // Affine transforms
+  typedef itk::AffineTransform< double, 3 > AffineTransformType;
+  AffineTransformType::Pointer affine = AffineTransformType::New();
+  AffineTransformType::ParametersType affineParameters = affine->GetParameters();
+  for ( unsigned int i = 0; i < affineParameters.Size(); i++ )
+    {
+    affineParameters[i] = RandomValue(-2.0, 2.0);
+    }
+  affine->SetParameters(affineParameters);
+  AffineTransformType::InputPointType center;
+  center[0] = 3.0;
+  center[1] = -1.0;
+  center[2] = 0.5;
+  affine->SetCenter(center);
+  passed &= CompareWithTransformPoint(affine.GetPointer(), numberOfPoints, -50.0, 50.0, 1e-12, "affine");
+  passed &= CompareWithTransformPoint(affine.GetPointer(), 1, -50.0, 50.0, 1e-12, "affine of one point");
+  passed &= CompareWithTransformPoint(affine.GetPointer(), 64, -50.0, 50.0, 1e-12, "affine of two blocks");
+
+  typedef itk::AffineTransform< float, 2 > FloatAffineTransformType;
+  FloatAffineTransformType::Pointer floatAffine = FloatAffineTransformType::New();
+  floatAffine->Rotate2D(0.3);
+  floatAffine->Scale(1.5f);
+  FloatAffineTransformType::OutputVectorType translation;
+  translation[0] = 4.0f;
+  translation[1] = -2.5f;
+  floatAffine->Translate(translation);
+  passed &= CompareWithTransformPoint(floatAffine.GetPointer(), numberOfPoints, -50.0, 50.0, 1e-6, "float affine");
+
+  typedef itk::Euler3DTransform< double > EulerTransformType;
+  EulerTransformType::Pointer euler = EulerTransformType::New();
+  euler->SetRotation(0.1, -0.4, 0.7);
+  passed &= CompareWithTransformPoint(euler.GetPointer(), numberOfPoints, -50.0, 50.0, 1e-12, "Euler 3D");
+
+  // Subclasses of MatrixOffsetTransformBase which override TransformPoint
+  typedef itk::ScaleTransform< double, 3 > ScaleTransformType;
+  ScaleTransformType::Pointer    scale = ScaleTransformType::New();
+  ScaleTransformType::ScaleType  scaleFactors;
+  ScaleTransformType::InputPointType scaleCenter;
+  for ( unsigned int j = 0; j < 3; j++ )
+    {
+    scaleFactors[j] = 0.5 + j;
+    scaleCenter[j] = 2.0 * j - 1.0;
+    }
+  scale->SetScale(scaleFactors);
+  scale->SetCenter(scaleCenter);
+  passed &= CompareWithTransformPoint(scale.GetPointer(), numberOfPoints, -50.0, 50.0, 1e-12, "scale");
+
+  typedef itk::AzimuthElevationToCartesianTransform< double, 3 > AzimuthElevationTransformType;
+  AzimuthElevationTransformType::Pointer azimuthElevation = AzimuthElevationTransformType::New();
+  azimuthElevation->SetAzimuthElevationToCartesianParameters(1.0, 5.0, 45, 45);
+  passed &= CompareWithTransformPoint(azimuthElevation.GetPointer(), numberOfPoints, 0.0, 40.0, 1e-12,
+                                      "azimuth elevation");
+
+  QuadraticTransform::Pointer quadratic = QuadraticTransform::New();
+  quadratic->SetParameters(affineParameters);
+  passed &= CompareWithTransformPoint(quadratic.GetPointer(), numberOfPoints, -50.0, 50.0, 1e-12,
+                                      "subclass of affine");
+
+  // The default implementation
+  typedef itk::TranslationTransform< double, 3 > TranslationTransformType;
+  TranslationTransformType::Pointer translationTransform = TranslationTransformType::New();
+  TranslationTransformType::OutputVectorType offset;
+  offset[0] = 1.5;
+  offset[1] = -3.0;
+  offset[2] = 7.25;
+  translationTransform->Translate(offset);
+  passed &= CompareWithTransformPoint(translationTransform.GetPointer(), numberOfPoints, -50.0, 50.0, 1e-12,
+                                      "translation");
+
+  // A B-spline transform with an oblique grid. Some of the points are
+  // outside of its valid region.
+  typedef itk::BSplineTransform< double, 3, 3 > BSplineTransformType;
+  BSplineTransformType::Pointer bspline = BSplineTransformType::New();
+  BSplineTransformType::OriginType origin;
+  origin.Fill(-20.0);
+  BSplineTransformType::PhysicalDimensionsType dimensions;
+  dimensions[0] = 40.0;
+  dimensions[1] = 30.0;
+  dimensions[2] = 35.0;
+  BSplineTransformType::MeshSizeType meshSize;
+  meshSize[0] = 5;
+  meshSize[1] = 4;
+  meshSize[2] = 6;
+  bspline->SetTransformDomainOrigin(origin);
+  bspline->SetTransformDomainPhysicalDimensions(dimensions);
+  bspline->SetTransformDomainMeshSize(meshSize);
+  bspline->SetTransformDomainDirection( euler->GetMatrix() );
+  BSplineTransformType::ParametersType bsplineParameters( bspline->GetNumberOfParameters() );
+  for ( unsigned int i = 0; i < bsplineParameters.Size(); i++ )
+    {
+    bsplineParameters[i] = RandomValue(-3.0, 3.0);
+    }
+  bspline->SetParameters(bsplineParameters);
+  passed &= CompareWithTransformPoint(bspline.GetPointer(), numberOfPoints, -30.0, 30.0, 1e-12, "B-spline");
+
+  // A composite of transforms of each kind
+  typedef itk::CompositeTransform< double, 3 > CompositeTransformType;
+  CompositeTransformType::Pointer composite = CompositeTransformType::New();
+  composite->AddTransform(affine);
+  composite->AddTransform(bspline);
+  composite->AddTransform(translationTransform);
+  passed &= CompareWithTransformPoint(composite.GetPointer(), numberOfPoints, -30.0, 30.0, 1e-12, "composite");
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
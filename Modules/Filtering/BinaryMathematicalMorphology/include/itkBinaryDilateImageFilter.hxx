@@ -182,15 +182,18 @@ BinaryDilateImageFilter< TInputImage, TOutputImage, TKernel >
   ImageRegionIteratorWithIndex< TempImageType >
   tmpRegIndexIt(tmpImage, tmpRequestedRegion);
 
-  ConstNeighborhoodIterator< TempImageType >
-  oNeighbIt(radius, tmpImage, tmpRequestedRegion);
+  // Neighborhood of the pixels whose whole neighborhood lies in the tmp
+  // image, read without bounds checking. The other pixels have neighbours
+  // outside of the tmp image, which are background pixels.
+  NeighborhoodAlgorithm::ConstInteriorNeighborhood< TempImageType >
+  interiorNeighbIt(tmpImage, radius);
+  const typename TempImageType::RegionType interiorRegion = interiorNeighbIt.GetInteriorRegion();
 
   // Define boundaries conditions
   ConstantBoundaryCondition< TempImageType > cbc;
   cbc.SetConstant(backgroundTag);
-  oNeighbIt.OverrideBoundaryCondition(&cbc);
 
-  unsigned int neighborhoodSize = oNeighbIt.Size();
+  unsigned int neighborhoodSize = interiorNeighbIt.Size();
   unsigned int centerPixelCode = neighborhoodSize / 2;
 
   std::queue< IndexType > propagQueue;
@@ -209,14 +212,9 @@ BinaryDilateImageFilter< TInputImage, TOutputImage, TKernel >
   nit.OverrideBoundaryCondition(&cbc);
   nit.GoToBegin();
 
-  ConstNeighborhoodIterator< TempImageType >
-  nnit(radius, tmpImage, tmpRequestedRegion);
-  nnit.OverrideBoundaryCondition(&cbc);
-  nnit.GoToBegin();
-
-  for ( tmpRegIndexIt.GoToBegin(), oNeighbIt.GoToBegin();
+  for ( tmpRegIndexIt.GoToBegin();
         !tmpRegIndexIt.IsAtEnd();
-        ++tmpRegIndexIt, ++oNeighbIt )
+        ++tmpRegIndexIt )
     {
     // Test current pixel: it is active ( on ) or not?
     if ( tmpRegIndexIt.Get() == onTag )
@@ -226,16 +224,20 @@ BinaryDilateImageFilter< TInputImage, TOutputImage, TKernel >
       // border pixel.
 
       // Test current pixel: it is a border pixel or an inner pixel?
-      bool bIsOnContour = false;
+      bool bIsOnContour = !interiorRegion.IsInside( tmpRegIndexIt.GetIndex() );
 
-      for ( i = 0; i < neighborhoodSize; ++i )
+      if ( !bIsOnContour )
         {
-        // If at least one neighbour pixel is off the center pixel
-        // belongs to contour
-        if ( oNeighbIt.GetPixel(i) == backgroundTag )
+        interiorNeighbIt.SetLocation( tmpRegIndexIt.GetIndex() );
+        for ( i = 0; i < neighborhoodSize; ++i )
           {
-          bIsOnContour = true;
-          break;
+          // If at least one neighbour pixel is off the center pixel
+          // belongs to contour
+          if ( interiorNeighbIt.GetPixel(i) == backgroundTag )
+            {
+            bIsOnContour = true;
+            break;
+            }
           }
         }
 
@@ -294,19 +296,20 @@ BinaryDilateImageFilter< TInputImage, TOutputImage, TKernel >
               // Get index of current neighbour pixel
               IndexType neighbIndex = nit.GetIndex(i);
 
-              // Force location of neighbour iterator
-              nnit += neighbIndex - nnit.GetIndex();
+              bool bIsOnBorder = !interiorRegion.IsInside(neighbIndex);
 
-              bool bIsOnBorder = false;
-
-              for ( j = 0; j < neighborhoodSize; ++j )
+              if ( !bIsOnBorder )
                 {
-                // If at least one neighbour pixel is off the center
-                // pixel belongs to border
-                if ( nnit.GetPixel(j) == backgroundTag )
+                interiorNeighbIt.SetLocation(neighbIndex);
+                for ( j = 0; j < neighborhoodSize; ++j )
                   {
-                  bIsOnBorder = true;
-                  break;
+                  // If at least one neighbour pixel is off the center
+                  // pixel belongs to border
+                  if ( interiorNeighbIt.GetPixel(j) == backgroundTag )
+                    {
+                    bIsOnBorder = true;
+                    break;
+                    }
                   }
                 }
 
@@ -23,6 +23,8 @@
 #include "itkProgressAccumulator.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 
+#include <complex>
+
 namespace itk
 {
 /** \class ConvolutionImageFilter
@@ -42,6 +44,10 @@ namespace itk
  * The kernel can optionally be normalized to sum to 1 using
  * NormalizeOn(). Normalization is off by default.
  *
+ * The inner products can be computed directly in the spatial domain, or
+ * for all the output pixels at once by multiplying Fourier transforms,
+ * which is much faster for large kernels. See SetConvolutionMethod().
+ *
  * \warning This filter ignores the spacing, origin, and orientation
  * of the kernel image and treats them as identical to those in the
  * input image.
@@ -136,6 +142,49 @@ public:
   virtual void SetOutputRegionModeToSame();
   virtual void SetOutputRegionModeToValid();
 
+  typedef enum
+  {
+    AUTOMATIC = 0,
+    SPATIAL,
+    FFT
+  } ConvolutionMethodType;
+
+  /** Sets how the convolution is computed. SPATIAL computes the inner
+   * product of the kernel with the neighborhood of every output pixel,
+   * which takes O(N*K) operations for N output pixels and K kernel
+   * pixels. FFT pads the input with the boundary condition to the output
+   * requested region, or each block of it (see SetFFTBlockSize()),
+   * enlarged by the kernel, rounded up to a size whose factors are 2, 3
+   * and 5, and multiplies the Fourier transforms of the padded input and
+   * of the kernel; it takes O(M*log(M)) operations for M padded pixels. Both methods give the same output, up to rounding
+   * errors, except that integer output pixels are truncated by SPATIAL and
+   * rounded to the nearest integer by FFT. AUTOMATIC, the default, uses
+   * FFT when its estimated cost is lower and the output pixel type is not
+   * an integer type, and SPATIAL otherwise. The Fourier transforms are
+   * computed by the implementation selected by ForwardFFTImageFilter::New()
+   * and InverseFFTImageFilter::New(). */
+  itkSetEnumMacro(ConvolutionMethod, ConvolutionMethodType);
+  itkGetEnumMacro(ConvolutionMethod, ConvolutionMethodType);
+  virtual void SetConvolutionMethodToAutomatic();
+  virtual void SetConvolutionMethodToSpatial();
+  virtual void SetConvolutionMethodToFFT();
+
+  /** Sets the size of the blocks of the output requested region that the
+   * FFT method computes one at a time, each from the input block enlarged
+   * by the kernel. The memory used by the transforms is then bounded by
+   * the block size instead of the requested region size, which the
+   * StreamingImageFilter already bounds for the input and output images.
+   * A size of 0, the default, uses the size of the requested region in
+   * that dimension. The transform of the kernel is computed once for all
+   * the blocks, and kept for the next pieces of a streamed output. */
+  itkSetMacro(FFTBlockSize, OutputSizeType);
+  itkGetConstReferenceMacro(FFTBlockSize, OutputSizeType);
+
+  /** Types of the images transformed by the FFT method. */
+  typedef typename NumericTraits< InputPixelType >::RealType           FFTRealPixelType;
+  typedef Image< FFTRealPixelType, ImageDimension >                   FFTRealImageType;
+  typedef Image< std::complex< FFTRealPixelType >, ImageDimension >   FFTComplexImageType;
+
   /** ConvolutionImageFilter needs the entire image kernel, which in
    * general is going to be a different size then the output requested
    * region. As such, this filter needs to provide an implementation
@@ -172,6 +221,17 @@ protected:
   /** Get the valid region of the convolution. */
   OutputRegionType GetValidRegion() const;
 
+  /** Returns true if the output requested region is computed with Fourier
+   * transforms, according to the ConvolutionMethod. */
+  bool GetConvolutionUsesFFT();
+
+  /** Smallest size, not less than n, whose prime factors are 2, 3 and 5,
+   * which all the FFT implementations support. */
+  static SizeValueType GetFFTSize(SizeValueType n);
+
+  /** Size of the blocks of region computed by the FFT method. */
+  OutputSizeType GetFFTBlockSizeForRegion(const OutputRegionType & region) const;
+
   /** Default superclass implementation ensures that input images
    * occupy same physical space. This is not needed for this filter. */
   virtual void VerifyInputInformation() {};
@@ -184,12 +244,23 @@ private:
   void ComputeConvolution( const TImage *kernelImage,
                            ProgressAccumulator *progress );
 
+  template< class TImage >
+  void ComputeFFTConvolution( const TImage *kernelImage,
+                              ProgressAccumulator *progress );
+
   bool m_Normalize;
 
   DefaultBoundaryConditionType m_DefaultBoundaryCondition;
   BoundaryConditionPointerType m_BoundaryCondition;
 
   OutputRegionModeType m_OutputRegionMode;
+
+  ConvolutionMethodType m_ConvolutionMethod;
+
+  OutputSizeType m_FFTBlockSize;
+
+  typename FFTComplexImageType::Pointer m_KernelFFT;
+  TimeStamp                             m_KernelFFTTime;
 };
 }
 
@@ -23,11 +23,17 @@
 
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
+#include "itkForwardFFTImageFilter.h"
 #include "itkImageBase.h"
 #include "itkImageKernelOperator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkInverseFFTImageFilter.h"
 #include "itkNeighborhoodOperatorImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 
+#include "vcl_cmath.h"
+#include <algorithm>
+
 namespace itk
 {
 template< class TInputImage, class TKernelImage, class TOutputImage >
@@ -39,6 +45,8 @@ ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
   m_Normalize = false;
   m_BoundaryCondition = &m_DefaultBoundaryCondition;
   m_OutputRegionMode = Self::SAME;
+  m_ConvolutionMethod = Self::AUTOMATIC;
+  m_FFTBlockSize.Fill( 0 );
 }
 
 template< class TInputImage, class TKernelImage, class TOutputImage >
@@ -86,6 +94,12 @@ ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
 ::ComputeConvolution( const TImage * kernelImage,
                       ProgressAccumulator * progress )
 {
+  if ( this->GetConvolutionUsesFFT() )
+    {
+    this->ComputeFFTConvolution( kernelImage, progress );
+    return;
+    }
+
   typedef typename TImage::PixelType KernelImagePixelType;
   typedef ImageKernelOperator< KernelImagePixelType, ImageDimension > KernelOperatorType;
   KernelOperatorType kernelOperator;
@@ -186,6 +200,285 @@ ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
     }
 }
 
+template< class TInputImage, class TKernelImage, class TOutputImage >
+template< class TImage >
+void
+ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
+::ComputeFFTConvolution( const TImage * kernelImage,
+                         ProgressAccumulator * progress )
+{
+  typedef ForwardFFTImageFilter< FFTRealImageType, FFTComplexImageType > ForwardFFTFilterType;
+  typedef InverseFFTImageFilter< FFTComplexImageType, FFTRealImageType > InverseFFTFilterType;
+  typedef typename FFTRealImageType::RegionType                          FFTRegionType;
+  typedef typename FFTRealImageType::SizeType                            FFTSizeType;
+
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  // The output pixel at index x is the sum over the kernel indices j of
+  // kernel(j) * input(x + j - c), where c = (s - 1) / 2 for a kernel of
+  // size s is the center of the kernel. The requested region is computed
+  // by blocks (overlap-save): each block is computed from the input region
+  // that starts c pixels before it and is s - 1 pixels larger, which is
+  // padded with zeros up to a size that the FFT supports. The circular
+  // correlation of the padded input with the kernel then never wraps
+  // around for the pixels of the block.
+  const OutputRegionType requestedRegion = output->GetRequestedRegion();
+  if ( requestedRegion.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+  const KernelSizeType   kernelSize = kernelImage->GetLargestPossibleRegion().GetSize();
+  const OutputSizeType   blockSize = this->GetFFTBlockSizeForRegion( requestedRegion );
+  FFTSizeType            fftSize;
+  SizeValueType          numberOfBlocks = 1;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    fftSize[i] = GetFFTSize( blockSize[i] + kernelSize[i] - 1 );
+    numberOfBlocks *= ( requestedRegion.GetSize(i) + blockSize[i] - 1 ) / blockSize[i];
+    }
+
+  // The transform of the kernel is kept for the next blocks and the next
+  // executions, such as the other pieces of a streamed output, while the
+  // kernel and the filter are not modified. It is reused when its size is
+  // large enough for the blocks, and not too large.
+  const KernelImageType *kernelInput = this->GetImageKernelInput();
+  bool reuseKernelFFT = m_KernelFFT.IsNotNull()
+                        && m_KernelFFTTime.GetMTime() > this->GetMTime()
+                        && m_KernelFFTTime.GetMTime() > kernelInput->GetMTime();
+  if ( reuseKernelFFT )
+    {
+    const FFTSizeType cachedSize = m_KernelFFT->GetLargestPossibleRegion().GetSize();
+    double            sizeRatio = 1.0;
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      reuseKernelFFT &= cachedSize[i] >= fftSize[i];
+      sizeRatio *= static_cast< double >( cachedSize[i] ) / fftSize[i];
+      }
+    if ( reuseKernelFFT && sizeRatio <= 2.0 )
+      {
+      fftSize = cachedSize;
+      }
+    else
+      {
+      reuseKernelFFT = false;
+      }
+    }
+
+  // The transforms share the progress left after the normalization. Each
+  // transform is marked complete once updated, so that the run ends at 1.0
+  // even with an FFT implementation that reports no progress of its own.
+  const float fftWeight = m_Normalize ? 0.9f : 1.0f;
+  const float kernelFFTWeight = reuseKernelFFT ? 0.0f : 0.1f * fftWeight;
+  const float blockWeight = ( fftWeight - kernelFFTWeight ) / ( 2.0f * numberOfBlocks );
+
+  if ( !reuseKernelFFT )
+    {
+    // Pad the kernel, with its first pixel at the origin.
+    m_KernelFFT = NULL;
+    FFTRegionType paddedKernelRegion;
+    paddedKernelRegion.SetSize( fftSize );
+    typename FFTRealImageType::Pointer paddedKernel = FFTRealImageType::New();
+    paddedKernel->SetRegions( paddedKernelRegion );
+    paddedKernel->Allocate();
+    paddedKernel->FillBuffer( NumericTraits< FFTRealPixelType >::ZeroValue() );
+
+    FFTRegionType kernelPlacementRegion;
+    kernelPlacementRegion.SetSize( kernelSize );
+    ImageRegionConstIterator< TImage >      kernelIt( kernelImage, kernelImage->GetLargestPossibleRegion() );
+    ImageRegionIterator< FFTRealImageType > paddedKernelIt( paddedKernel, kernelPlacementRegion );
+    for ( ; !kernelIt.IsAtEnd(); ++kernelIt, ++paddedKernelIt )
+      {
+      paddedKernelIt.Set( static_cast< FFTRealPixelType >( kernelIt.Get() ) );
+      }
+
+    typename ForwardFFTFilterType::Pointer kernelFFTFilter = ForwardFFTFilterType::New();
+    kernelFFTFilter->SetInput( paddedKernel );
+    kernelFFTFilter->SetNumberOfThreads( this->GetNumberOfThreads() );
+    progress->RegisterInternalFilter( kernelFFTFilter, kernelFFTWeight );
+    kernelFFTFilter->Update();
+    kernelFFTFilter->UpdateProgress(1.0f);
+    m_KernelFFT = kernelFFTFilter->GetOutput();
+    m_KernelFFT->DisconnectPipeline();
+    m_KernelFFTTime.Modified();
+    }
+
+  typename ForwardFFTFilterType::Pointer inputFFTFilter = ForwardFFTFilterType::New();
+  inputFFTFilter->SetNumberOfThreads( this->GetNumberOfThreads() );
+  progress->RegisterInternalFilter( inputFFTFilter, blockWeight );
+
+  typename InverseFFTFilterType::Pointer inverseFFTFilter = InverseFFTFilterType::New();
+  inverseFFTFilter->SetActualXDimensionIsOdd( fftSize[0] % 2 == 1 );
+  inverseFFTFilter->SetNumberOfThreads( this->GetNumberOfThreads() );
+  progress->RegisterInternalFilter( inverseFFTFilter, blockWeight );
+
+  const InputRegionType inputRegion = input->GetLargestPossibleRegion();
+  OutputSizeType        blockOffset;
+  blockOffset.Fill( 0 );
+  for ( SizeValueType block = 0; block < numberOfBlocks; block++ )
+    {
+    OutputRegionType blockRegion;
+    InputRegionType  neededRegion;
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      blockRegion.SetIndex( i, requestedRegion.GetIndex(i) + blockOffset[i] );
+      blockRegion.SetSize( i, std::min( blockSize[i], requestedRegion.GetSize(i) - blockOffset[i] ) );
+      neededRegion.SetIndex( i, blockRegion.GetIndex(i)
+                             - static_cast< typename InputIndexType::IndexValueType >( ( kernelSize[i] - 1 ) / 2 ) );
+      neededRegion.SetSize( i, blockRegion.GetSize(i) + kernelSize[i] - 1 );
+      }
+
+    // Pad the input, with the boundary condition outside the input image.
+    typename FFTRealImageType::Pointer paddedInput = FFTRealImageType::New();
+    paddedInput->SetRegions( FFTRegionType( neededRegion.GetIndex(), fftSize ) );
+    paddedInput->Allocate();
+    paddedInput->FillBuffer( NumericTraits< FFTRealPixelType >::ZeroValue() );
+
+    ImageRegionIteratorWithIndex< FFTRealImageType > paddedIt( paddedInput, neededRegion );
+    for ( paddedIt.GoToBegin(); !paddedIt.IsAtEnd(); ++paddedIt )
+      {
+      const InputIndexType & index = paddedIt.GetIndex();
+      if ( inputRegion.IsInside( index ) )
+        {
+        paddedIt.Set( static_cast< FFTRealPixelType >( input->GetPixel( index ) ) );
+        }
+      else
+        {
+        paddedIt.Set( static_cast< FFTRealPixelType >( m_BoundaryCondition->GetPixel( index, input ) ) );
+        }
+      }
+
+    inputFFTFilter->SetInput( paddedInput );
+    inputFFTFilter->Update();
+    inputFFTFilter->UpdateProgress(1.0f);
+    typename FFTComplexImageType::Pointer product = inputFFTFilter->GetOutput();
+    product->DisconnectPipeline();
+    inputFFTFilter->SetInput( NULL );
+    paddedInput = NULL;
+
+    // The Fourier transform of the correlation is the product of the
+    // transform of the input with the conjugate of the transform of the
+    // real kernel.
+    ImageRegionIterator< FFTComplexImageType >      productIt( product, product->GetLargestPossibleRegion() );
+    ImageRegionConstIterator< FFTComplexImageType > kernelFFTIt( m_KernelFFT,
+                                                                 m_KernelFFT->GetLargestPossibleRegion() );
+    for ( ; !productIt.IsAtEnd(); ++productIt, ++kernelFFTIt )
+      {
+      productIt.Set( productIt.Get() * std::conj( kernelFFTIt.Get() ) );
+      }
+
+    inverseFFTFilter->SetInput( product );
+    inverseFFTFilter->Update();
+    inverseFFTFilter->UpdateProgress(1.0f);
+    inverseFFTFilter->SetInput( NULL );
+    product = NULL;
+
+    // The correlation for the first pixel of the block is at the first
+    // pixel of the inverse transform.
+    FFTRealImageType *resultImage = inverseFFTFilter->GetOutput();
+    FFTRegionType     resultRegion( resultImage->GetLargestPossibleRegion().GetIndex(),
+                                    blockRegion.GetSize() );
+    ImageRegionConstIterator< FFTRealImageType > resultIt( resultImage, resultRegion );
+    ImageRegionIterator< OutputImageType >       outputIt( output, blockRegion );
+    for ( ; !outputIt.IsAtEnd(); ++resultIt, ++outputIt )
+      {
+      FFTRealPixelType value = resultIt.Get();
+      if ( NumericTraits< OutputPixelType >::is_integer )
+        {
+        value = vcl_floor( value + 0.5 );
+        }
+      outputIt.Set( static_cast< OutputPixelType >( value ) );
+      }
+    resultImage->ReleaseData();
+
+    progress->ResetFilterProgressAndKeepAccumulatedProgress();
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      blockOffset[i] += blockSize[i];
+      if ( blockOffset[i] < requestedRegion.GetSize(i) )
+        {
+        break;
+        }
+      blockOffset[i] = 0;
+      }
+    }
+}
+
+template< class TInputImage, class TKernelImage, class TOutputImage >
+typename ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >::OutputSizeType
+ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
+::GetFFTBlockSizeForRegion(const OutputRegionType & region) const
+{
+  OutputSizeType blockSize = region.GetSize();
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    if ( m_FFTBlockSize[i] > 0 && m_FFTBlockSize[i] < blockSize[i] )
+      {
+      blockSize[i] = m_FFTBlockSize[i];
+      }
+    }
+  return blockSize;
+}
+
+template< class TInputImage, class TKernelImage, class TOutputImage >
+bool
+ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
+::GetConvolutionUsesFFT()
+{
+  if ( m_ConvolutionMethod != Self::AUTOMATIC )
+    {
+    return m_ConvolutionMethod == Self::FFT;
+    }
+  const OutputRegionType requestedRegion = this->GetOutput()->GetRequestedRegion();
+  if ( NumericTraits< OutputPixelType >::is_integer || requestedRegion.GetNumberOfPixels() == 0 )
+    {
+    return false;
+    }
+
+  // A direct inner product takes two operations per kernel pixel, and a
+  // Fourier transform about 5 M log2(M) operations for M pixels: each
+  // block needs two transforms, and the kernel one more.
+  const KernelSizeType   kernelSize = this->GetImageKernelInput()->GetLargestPossibleRegion().GetSize();
+  const OutputSizeType   blockSize = this->GetFFTBlockSizeForRegion( requestedRegion );
+  double                 numberOfKernelPixels = 1.0;
+  double                 numberOfFFTPixels = 1.0;
+  double                 numberOfBlocks = 1.0;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    numberOfKernelPixels *= kernelSize[i];
+    numberOfFFTPixels *= GetFFTSize( blockSize[i] + kernelSize[i] - 1 );
+    numberOfBlocks *= ( requestedRegion.GetSize(i) + blockSize[i] - 1 ) / blockSize[i];
+    }
+  const double spatialCost = 2.0 * requestedRegion.GetNumberOfPixels() * numberOfKernelPixels;
+  const double fftCost = ( 2.0 * numberOfBlocks + 1.0 ) * 5.0 * numberOfFFTPixels
+                         * vcl_log(numberOfFFTPixels) / vcl_log(2.0);
+
+  return fftCost < spatialCost;
+}
+
+template< class TInputImage, class TKernelImage, class TOutputImage >
+SizeValueType
+ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
+::GetFFTSize(SizeValueType n)
+{
+  for ( SizeValueType size = std::max( n, static_cast< SizeValueType >( 1 ) ); ; ++size )
+    {
+    SizeValueType remainder = size;
+    const SizeValueType factors[3] = { 2, 3, 5 };
+    for ( unsigned int f = 0; f < 3; f++ )
+      {
+      while ( remainder % factors[f] == 0 )
+        {
+        remainder /= factors[f];
+        }
+      }
+    if ( remainder == 1 )
+      {
+      return size;
+      }
+    }
+}
+
 template< class TInputImage, class TKernelImage, class TOutputImage >
 void
 ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
@@ -320,6 +613,30 @@ ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
   this->SetOutputRegionMode( Self::VALID );
 }
 
+template< class TInputImage, class TKernelImage, class TOutputImage >
+void
+ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
+::SetConvolutionMethodToAutomatic()
+{
+  this->SetConvolutionMethod( Self::AUTOMATIC );
+}
+
+template< class TInputImage, class TKernelImage, class TOutputImage >
+void
+ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
+::SetConvolutionMethodToSpatial()
+{
+  this->SetConvolutionMethod( Self::SPATIAL );
+}
+
+template< class TInputImage, class TKernelImage, class TOutputImage >
+void
+ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
+::SetConvolutionMethodToFFT()
+{
+  this->SetConvolutionMethod( Self::FFT );
+}
+
 template< class TInputImage, class TKernelImage, class TOutputImage >
 void
 ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
@@ -390,6 +707,28 @@ ConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage >
       break;
     }
   os << std::endl;
+  os << indent << "ConvolutionMethod: ";
+  switch ( m_ConvolutionMethod )
+    {
+    case AUTOMATIC:
+      os << "AUTOMATIC";
+      break;
+
+    case SPATIAL:
+      os << "SPATIAL";
+      break;
+
+    case FFT:
+      os << "FFT";
+      break;
+
+    default:
+      os << "unknown";
+      break;
+    }
+  os << std::endl;
+  os << indent << "FFTBlockSize: " << m_FFTBlockSize << std::endl;
+  os << indent << "KernelFFT: " << m_KernelFFT.GetPointer() << std::endl;
 }
 }
 #endif
@@ -0,0 +1,381 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConvolutionImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionIterator.h"
+#include "itkSimpleFilterWatcher.h"
+#include "itkStreamingImageFilter.h"
+#include "itkVnlThreadedInverseFFTImageFilter.h"
+#include "itkCommand.h"
+#include "itkVersion.h"
+
+namespace
+{
+template< class TImage >
+typename TImage::Pointer
+CreateConvolutionTestImage(const typename TImage::SizeType & size, unsigned int seed)
+{
+  typename TImage::Pointer image = TImage::New();
+  typename TImage::RegionType region;
+  region.SetSize(size);
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIterator< TImage > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245 + 12345;
+    it.Set( static_cast< typename TImage::PixelType >( ( seed / 65536 ) % 100 ) );
+    }
+  return image;
+}
+
+/** Compare the FFT and spatial convolutions of image with kernel over the
+ * given output requested region, or the largest possible region when it
+ * is empty. */
+template< class TImage >
+bool
+CompareConvolutionMethods(const TImage *image, const TImage *kernel, bool normalize,
+                          bool valid, itk::ImageBoundaryCondition< TImage > *boundaryCondition,
+                          const typename TImage::RegionType & requestedRegion,
+                          double tolerance)
+{
+  typedef itk::ConvolutionImageFilter< TImage > ConvolutionFilterType;
+  typename ConvolutionFilterType::Pointer filters[2];
+
+  for ( unsigned int i = 0; i < 2; i++ )
+    {
+    filters[i] = ConvolutionFilterType::New();
+    filters[i]->SetInput(image);
+    filters[i]->SetImageKernelInput(kernel);
+    filters[i]->SetNormalize(normalize);
+    if ( valid )
+      {
+      filters[i]->SetOutputRegionModeToValid();
+      }
+    if ( boundaryCondition )
+      {
+      filters[i]->SetBoundaryCondition(boundaryCondition);
+      }
+    if ( i == 0 )
+      {
+      filters[i]->SetConvolutionMethodToSpatial();
+      }
+    else
+      {
+      filters[i]->SetConvolutionMethodToFFT();
+      }
+    if ( requestedRegion.GetNumberOfPixels() > 0 )
+      {
+      filters[i]->GetOutput()->UpdateOutputInformation();
+      filters[i]->GetOutput()->SetRequestedRegion(requestedRegion);
+      filters[i]->GetOutput()->PropagateRequestedRegion();
+      filters[i]->GetOutput()->UpdateOutputData();
+      }
+    else
+      {
+      filters[i]->Update();
+      }
+    }
+
+  if ( filters[0]->GetOutput()->GetBufferedRegion() != filters[1]->GetOutput()->GetBufferedRegion() )
+    {
+    std::cerr << "The spatial and FFT convolutions produced different regions: "
+              << filters[0]->GetOutput()->GetBufferedRegion()
+              << filters[1]->GetOutput()->GetBufferedRegion() << std::endl;
+    return false;
+    }
+
+  const typename TImage::RegionType region = filters[0]->GetOutput()->GetBufferedRegion();
+  itk::ImageRegionConstIterator< TImage > spatialIt( filters[0]->GetOutput(), region );
+  itk::ImageRegionConstIterator< TImage > fftIt( filters[1]->GetOutput(), region );
+  for ( ; !spatialIt.IsAtEnd(); ++spatialIt, ++fftIt )
+    {
+    const double difference = static_cast< double >( spatialIt.Get() ) - static_cast< double >( fftIt.Get() );
+    if ( vcl_abs( difference ) > tolerance )
+      {
+      std::cerr << "The FFT convolution differs from the spatial convolution at "
+                << spatialIt.GetIndex() << ": " << static_cast< double >( fftIt.Get() )
+                << " instead of " << static_cast< double >( spatialIt.Get() )
+                << " (kernel " << kernel->GetLargestPossibleRegion().GetSize()
+                << ", normalize " << normalize << ", valid " << valid << ")" << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+/** Inverse FFT that reports no progress of its own, like some FFT
+ * implementations. */
+template< class TInputImage, class TOutputImage >
+class SilentInverseFFTImageFilter:
+  public itk::VnlThreadedInverseFFTImageFilter< TInputImage, TOutputImage >
+{
+public:
+  typedef SilentInverseFFTImageFilter                                       Self;
+  typedef itk::VnlThreadedInverseFFTImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef itk::SmartPointer< Self >                                         Pointer;
+  typedef itk::SmartPointer< const Self >                                   ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(SilentInverseFFTImageFilter, VnlThreadedInverseFFTImageFilter);
+
+protected:
+  SilentInverseFFTImageFilter() {}
+
+  void GenerateData()
+  {
+    // The work is done by an internal filter whose progress is not
+    // forwarded
+    typename Superclass::Pointer inverse = Superclass::New();
+    inverse->SetInput( this->GetInput() );
+    inverse->SetActualXDimensionIsOdd( this->ActualXDimensionIsOdd() );
+    inverse->GraftOutput( this->GetOutput() );
+    inverse->Update();
+    this->GraftOutput( inverse->GetOutput() );
+  }
+
+private:
+  SilentInverseFFTImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);              //purposely not implemented
+};
+
+template< class TInputImage, class TOutputImage >
+class SilentInverseFFTFactory:public itk::ObjectFactoryBase
+{
+public:
+  typedef SilentInverseFFTFactory       Self;
+  typedef itk::ObjectFactoryBase        Superclass;
+  typedef itk::SmartPointer< Self >     Pointer;
+  typedef itk::SmartPointer< const Self > ConstPointer;
+
+  const char * GetITKSourceVersion() const { return ITK_SOURCE_VERSION; }
+  const char * GetDescription() const { return "Inverse FFT without progress"; }
+
+  itkFactorylessNewMacro(Self);
+  itkTypeMacro(SilentInverseFFTFactory, itk::ObjectFactoryBase);
+
+protected:
+  SilentInverseFFTFactory()
+  {
+    typedef itk::InverseFFTImageFilter< TInputImage, TOutputImage > OverriddenType;
+    this->RegisterOverride( typeid( OverriddenType ).name(),
+                            typeid( SilentInverseFFTImageFilter< TInputImage, TOutputImage > ).name(),
+                            "Inverse FFT without progress", true,
+                            itk::CreateObjectFunction<
+                              SilentInverseFFTImageFilter< TInputImage, TOutputImage > >::New() );
+  }
+
+private:
+  SilentInverseFFTFactory(const Self &); //purposely not implemented
+  void operator=(const Self &);          //purposely not implemented
+};
+
+/** Records the last progress reported by a filter, and whether it ever
+ * went backwards. */
+class ProgressRecorder
+{
+public:
+  ProgressRecorder():m_LastProgress(0.0f), m_Decreased(false) {}
+  void Record(itk::Object *caller, const itk::EventObject &)
+  {
+    const float progress = static_cast< itk::ProcessObject * >( caller )->GetProgress();
+    m_Decreased |= progress < m_LastProgress;
+    m_LastProgress = progress;
+  }
+  float m_LastProgress;
+  bool  m_Decreased;
+};
+
+/** Check that an FFT convolution reports a progress that increases up to
+ * 1.0, with or without normalization and blocks. */
+template< class TImage >
+bool
+CheckFFTProgress(const TImage *image, const TImage *kernel)
+{
+  typedef itk::ConvolutionImageFilter< TImage > ConvolutionFilterType;
+  for ( unsigned int normalize = 0; normalize < 2; normalize++ )
+    {
+    for ( unsigned int blocks = 0; blocks < 2; blocks++ )
+      {
+      typename ConvolutionFilterType::Pointer filter = ConvolutionFilterType::New();
+      filter->SetInput(image);
+      filter->SetImageKernelInput(kernel);
+      filter->SetNormalize(normalize);
+      filter->SetConvolutionMethodToFFT();
+      if ( blocks )
+        {
+        typename TImage::SizeType blockSize;
+        blockSize.Fill(8);
+        filter->SetFFTBlockSize(blockSize);
+        }
+      ProgressRecorder recorder;
+      typedef itk::MemberCommand< ProgressRecorder > CommandType;
+      typename CommandType::Pointer command = CommandType::New();
+      command->SetCallbackFunction(&recorder, &ProgressRecorder::Record);
+      filter->AddObserver(itk::ProgressEvent(), command);
+      filter->Update();
+      if ( recorder.m_Decreased || vcl_abs( recorder.m_LastProgress - 1.0f ) > 1e-4 )
+        {
+        std::cerr << "The FFT convolution ended at progress " << recorder.m_LastProgress
+                  << " (normalize " << normalize << ", blocks " << blocks
+                  << ", decreased " << recorder.m_Decreased << ")" << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int itkConvolutionImageFilterFFTTest(int, char *[])
+{
+  typedef itk::Image< float, 2 >         FloatImageType;
+  typedef itk::Image< float, 3 >         Float3DImageType;
+  typedef itk::Image< unsigned char, 2 > UCharImageType;
+
+  FloatImageType::SizeType imageSize = { { 41, 30 } };
+  FloatImageType::Pointer  image = CreateConvolutionTestImage< FloatImageType >(imageSize, 1);
+
+  FloatImageType::SizeType kernelSizes[3] = { { { 7, 7 } }, { { 6, 5 } }, { { 1, 4 } } };
+
+  itk::ConstantBoundaryCondition< FloatImageType > constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(17.0f);
+
+  FloatImageType::RegionType wholeRegion;
+  FloatImageType::RegionType subRegion;
+  FloatImageType::IndexType  subRegionIndex = { { 3, 11 } };
+  FloatImageType::SizeType   subRegionSize = { { 20, 9 } };
+  subRegion.SetIndex(subRegionIndex);
+  subRegion.SetSize(subRegionSize);
+
+  bool passed = true;
+  for ( unsigned int k = 0; k < 3; k++ )
+    {
+    FloatImageType::Pointer kernel = CreateConvolutionTestImage< FloatImageType >(kernelSizes[k], k + 7);
+    for ( unsigned int normalize = 0; normalize < 2; normalize++ )
+      {
+      for ( unsigned int valid = 0; valid < 2; valid++ )
+        {
+        passed &= CompareConvolutionMethods< FloatImageType >(image, kernel, normalize, valid, NULL,
+                                                              wholeRegion, 1e-2);
+        }
+      }
+    passed &= CompareConvolutionMethods< FloatImageType >(image, kernel, false, false,
+                                                          &constantBoundaryCondition, wholeRegion, 1e-2);
+    passed &= CompareConvolutionMethods< FloatImageType >(image, kernel, true, false, NULL,
+                                                          subRegion, 1e-4);
+    }
+
+  // Stream the FFT convolution, computed by blocks in each piece
+  typedef itk::ConvolutionImageFilter< FloatImageType >              FloatConvolutionFilterType;
+  typedef itk::StreamingImageFilter< FloatImageType, FloatImageType > StreamerType;
+  FloatImageType::Pointer blockKernel = CreateConvolutionTestImage< FloatImageType >(kernelSizes[0], 9);
+
+  FloatConvolutionFilterType::Pointer spatialFilter = FloatConvolutionFilterType::New();
+  spatialFilter->SetInput(image);
+  spatialFilter->SetImageKernelInput(blockKernel);
+  spatialFilter->SetConvolutionMethodToSpatial();
+  spatialFilter->Update();
+
+  FloatConvolutionFilterType::Pointer blockFilter = FloatConvolutionFilterType::New();
+  blockFilter->SetInput(image);
+  blockFilter->SetImageKernelInput(blockKernel);
+  blockFilter->SetConvolutionMethodToFFT();
+  FloatImageType::SizeType blockSize = { { 16, 0 } };
+  blockFilter->SetFFTBlockSize(blockSize);
+  StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetInput( blockFilter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions(4);
+
+  for ( unsigned int run = 0; run < 2; run++ )
+    {
+    // The second run changes the kernel, which the filter must transform
+    // again
+    if ( run == 1 )
+      {
+      blockKernel->FillBuffer(0.5f);
+      blockKernel->Modified();
+      spatialFilter->Update();
+      }
+    streamer->Update();
+    itk::ImageRegionConstIterator< FloatImageType > spatialIt( spatialFilter->GetOutput(),
+                                                              spatialFilter->GetOutput()->GetBufferedRegion() );
+    itk::ImageRegionConstIterator< FloatImageType > streamedIt( streamer->GetOutput(),
+                                                               spatialFilter->GetOutput()->GetBufferedRegion() );
+    for ( ; !spatialIt.IsAtEnd(); ++spatialIt, ++streamedIt )
+      {
+      if ( vcl_abs( spatialIt.Get() - streamedIt.Get() ) > 1e-2 )
+        {
+        std::cerr << "The streamed FFT convolution differs from the spatial convolution at "
+                  << spatialIt.GetIndex() << ": " << streamedIt.Get()
+                  << " instead of " << spatialIt.Get() << " (run " << run << ")" << std::endl;
+        passed = false;
+        break;
+        }
+      }
+    }
+
+  // 3D, with a large kernel
+  Float3DImageType::SizeType image3DSize = { { 24, 20, 18 } };
+  Float3DImageType::SizeType kernel3DSize = { { 9, 8, 7 } };
+  Float3DImageType::Pointer  image3D = CreateConvolutionTestImage< Float3DImageType >(image3DSize, 3);
+  Float3DImageType::Pointer  kernel3D = CreateConvolutionTestImage< Float3DImageType >(kernel3DSize, 5);
+  passed &= CompareConvolutionMethods< Float3DImageType >(image3D, kernel3D, true, false, NULL,
+                                                          Float3DImageType::RegionType(), 1e-3);
+
+  // Integer outputs are rounded by the FFT method and truncated by the
+  // spatial one
+  UCharImageType::SizeType ucharKernelSize = { { 5, 5 } };
+  UCharImageType::Pointer  ucharImage = CreateConvolutionTestImage< UCharImageType >(imageSize, 11);
+  UCharImageType::Pointer  ucharKernel = CreateConvolutionTestImage< UCharImageType >(ucharKernelSize, 13);
+  passed &= CompareConvolutionMethods< UCharImageType >(ucharImage, ucharKernel, true, false, NULL,
+                                                        UCharImageType::RegionType(), 1.0);
+
+  // The FFT method is chosen by default for large kernels only; check that
+  // it reports its progress and prints its settings
+  typedef itk::ConvolutionImageFilter< Float3DImageType > ConvolutionFilterType;
+  ConvolutionFilterType::Pointer filter = ConvolutionFilterType::New();
+  itk::SimpleFilterWatcher watcher(filter, "filter");
+  filter->SetInput(image3D);
+  filter->SetImageKernelInput(kernel3D);
+  filter->Update();
+  filter->Print(std::cout);
+  if ( filter->GetConvolutionMethod() != ConvolutionFilterType::AUTOMATIC )
+    {
+    std::cerr << "The default convolution method should be AUTOMATIC" << std::endl;
+    passed = false;
+    }
+
+  // The progress reaches 1.0, also when the inverse FFT reports none
+  passed &= CheckFFTProgress< FloatImageType >(image, blockKernel);
+  typedef SilentInverseFFTFactory< FloatConvolutionFilterType::FFTComplexImageType,
+                                   FloatConvolutionFilterType::FFTRealImageType > SilentFactoryType;
+  SilentFactoryType::Pointer silentFactory = SilentFactoryType::New();
+  itk::ObjectFactoryBase::RegisterFactory(silentFactory);
+  passed &= CheckFFTProgress< FloatImageType >(image, blockKernel);
+  itk::ObjectFactoryBase::UnRegisterFactory(silentFactory);
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
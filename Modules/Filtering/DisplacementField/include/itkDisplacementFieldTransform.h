@@ -199,6 +199,12 @@ public:
   virtual OutputPointType TransformPoint( const InputPointType& thisPoint )
   const;
 
+  /** Method to transform an array of points, which checks the field and
+   * the interpolator once for the whole array. */
+  virtual void TransformPoints( const InputPointType *inputPoints,
+                                OutputPointType *outputPoints,
+                                SizeValueType numberOfPoints ) const;
+
   /**  Method to transform a vector. */
   virtual OutputVectorType TransformVector(const InputVectorType &) const
   {
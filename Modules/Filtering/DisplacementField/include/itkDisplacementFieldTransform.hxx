@@ -111,6 +111,44 @@ DisplacementFieldTransform<TScalar, NDimensions>
   return outputPoint;
 }
 
+/**
+ * Transform points
+ */
+template <class TScalar, unsigned int NDimensions>
+void
+DisplacementFieldTransform<TScalar, NDimensions>
+::TransformPoints( const InputPointType *inputPoints,
+                   OutputPointType *outputPoints,
+                   SizeValueType numberOfPoints ) const
+{
+  if( !this->m_DisplacementField )
+    {
+    itkExceptionMacro( "No displacement field is specified." );
+    }
+  if( !this->m_Interpolator )
+    {
+    itkExceptionMacro( "No interpolator is specified." );
+    }
+
+  const DisplacementFieldType *field = this->m_DisplacementField;
+  const InterpolatorType *     interpolator = this->m_Interpolator;
+
+  typename InterpolatorType::ContinuousIndexType cidx;
+  typename InterpolatorType::PointType point;
+  for( SizeValueType k = 0; k < numberOfPoints; k++ )
+    {
+    point.CastFrom( inputPoints[k] );
+    OutputPointType outputPoint;
+    outputPoint.CastFrom( inputPoints[k] );
+    if( interpolator->IsInsideBuffer( point ) )
+      {
+      field->TransformPhysicalPointToContinuousIndex( point, cidx );
+      outputPoint += interpolator->EvaluateAtContinuousIndex( cidx );
+      }
+    outputPoints[k] = outputPoint;
+    }
+}
+
 /**
  * Transform covariant vector
  */
@@ -223,7 +223,7 @@ InverseDisplacementFieldImageFilter< TInputImage, TOutputImage >
   OutputImageType *outputPtr = this->GetOutput();
 
   outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
-  outputPtr->Allocate();
+  outputPtr->AllocateUninitialized();
 
   // Create an iterator that will walk the output region for this thread.
   typedef ImageRegionIteratorWithIndex<
@@ -63,7 +63,7 @@ void IterativeInverseDisplacementFieldImageFilter< TInputImage, TOutputImage >
   negField->SetOrigin( inputPtr->GetOrigin() );
   negField->SetSpacing( inputPtr->GetSpacing() );
   negField->SetDirection( inputPtr->GetDirection() );
-  negField->Allocate();
+  negField->AllocateUninitialized();
 
   InputConstIterator InputIt = InputConstIterator( inputPtr, inputPtr->GetRequestedRegion() );
   InputIterator      negImageIt = InputIterator( negField, negField->GetRequestedRegion() );
@@ -78,7 +78,7 @@ void IterativeInverseDisplacementFieldImageFilter< TInputImage, TOutputImage >
   outputPtr->SetOrigin( inputPtr->GetOrigin() );
   outputPtr->SetSpacing( inputPtr->GetSpacing() );
   outputPtr->SetDirection( inputPtr->GetDirection() );
-  outputPtr->Allocate();
+  outputPtr->AllocateUninitialized();
 
   typename VectorWarperType::Pointer vectorWarper = VectorWarperType::New();
   typename FieldInterpolatorType::Pointer VectorInterpolator = FieldInterpolatorType::New();
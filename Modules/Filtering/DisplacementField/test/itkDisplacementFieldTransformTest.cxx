@@ -266,6 +266,28 @@ int itkDisplacementFieldTransformTest(int, char *[] )
     return EXIT_FAILURE;
     }
 
+  /* Test an array of points, inside and outside of the field, in place */
+  const unsigned int                         numberOfPoints = 5;
+  DisplacementTransformType::InputPointType  inputPoints[numberOfPoints];
+  DisplacementTransformType::OutputPointType outputPoints[numberOfPoints];
+  for( unsigned int i = 0; i < numberOfPoints; i++ )
+    {
+    inputPoints[i][0] = testPoint[0] + 3.7 * i - 4.0;
+    inputPoints[i][1] = testPoint[1] - 6.1 * i + 2.5;
+    outputPoints[i] = inputPoints[i];
+    }
+  displacementTransform->TransformPoints( outputPoints, outputPoints, numberOfPoints );
+  for( unsigned int i = 0; i < numberOfPoints; i++ )
+    {
+    deformTruth = displacementTransform->TransformPoint( inputPoints[i] );
+    if( !samePoint( outputPoints[i], deformTruth ) )
+      {
+      std::cout << "Failed transforming the points of an array. Point " << inputPoints[i]
+                << " is mapped to " << outputPoints[i] << " instead of " << deformTruth << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   DisplacementTransformType::InputVectorType  testVector;
   DisplacementTransformType::OutputVectorType deformVector, deformVectorTruth;
   testVector[0] = 0.5;
@@ -33,6 +33,30 @@ namespace itk
 {
 namespace fftw
 {
+/** Build the key of a plan in the plan cache of FFTWGlobalConfiguration.
+ * kind identifies the transform. FFTW can only execute a plan on new arrays
+ * with the same alignment and the same in-place or out-of-place layout as
+ * the arrays it was created with, so these are part of the key. */
+inline FFTWGlobalConfiguration::PlanKeyType
+MakePlanKey(int kind, int rank, const int *n, int inputAlignment, int outputAlignment,
+            bool inPlace, unsigned flags, int threads)
+{
+  FFTWGlobalConfiguration::PlanKeyType key;
+  key.reserve( rank + 7 );
+  key.push_back( kind );
+  key.push_back( static_cast< int >( flags ) );
+  key.push_back( threads );
+  key.push_back( inputAlignment );
+  key.push_back( outputAlignment );
+  key.push_back( inPlace );
+  key.push_back( rank );
+  key.insert( key.end(), n, n + rank );
+  return key;
+}
+
+/** The kinds of transforms in the plan keys. */
+enum { PlanKind_dft_c2r = 0, PlanKind_dft_r2c = 1 };
+
 /**
  * \class Interface
  * \brief Wrapper for FFTW API
@@ -344,6 +368,88 @@ public:
   }
 
 
+  /** Same as Plan_dft_c2r(), but the plan is kept in the plan cache of
+   * FFTWGlobalConfiguration and returned again, without running the
+   * planner, for the next arrays with the same sizes and alignment and
+   * the same flags and number of threads. The plan belongs to the cache:
+   * it must be executed with Execute_dft_c2r() and must not be destroyed.
+   * NULL is returned when the plan is not cached and the cache is full;
+   * the caller then creates its own plan with Plan_dft_c2r(). */
+  static PlanType GetCachedPlan_dft_c2r(int rank,
+                                        const int *n,
+                                        ComplexType *in,
+                                        PixelType *out,
+                                        unsigned flags,
+                                        int threads=1,
+                                        bool canDestroyInput=false)
+  {
+    const FFTWGlobalConfiguration::PlanKeyType key =
+      MakePlanKey( PlanKind_dft_c2r, rank, n, fftwf_alignment_of( (PixelType *)in ),
+                   fftwf_alignment_of( out ), (void *)in == (void *)out, flags, threads );
+    FFTWGlobalConfiguration::Lock();
+    PlanType plan = FFTWGlobalConfiguration::GetCachedPlanFloat( key );
+    FFTWGlobalConfiguration::Unlock();
+    if( plan == NULL
+        && FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+        < FFTWGlobalConfiguration::GetMaximumNumberOfCachedPlans() )
+      {
+      PlanType newPlan = Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+      FFTWGlobalConfiguration::Lock();
+      plan = FFTWGlobalConfiguration::AddCachedPlanFloat( key, newPlan );
+      if( plan == NULL )
+        {
+        // the cache was filled by another thread in the meantime
+        DestroyPlan( newPlan );
+        }
+      FFTWGlobalConfiguration::Unlock();
+      }
+    return plan;
+  }
+
+  /** Same as Plan_dft_r2c(), with the plan kept in the plan cache.
+   * \sa GetCachedPlan_dft_c2r() */
+  static PlanType GetCachedPlan_dft_r2c(int rank,
+                                        const int *n,
+                                        PixelType *in,
+                                        ComplexType *out,
+                                        unsigned flags,
+                                        int threads=1,
+                                        bool canDestroyInput=false)
+  {
+    const FFTWGlobalConfiguration::PlanKeyType key =
+      MakePlanKey( PlanKind_dft_r2c, rank, n, fftwf_alignment_of( in ),
+                   fftwf_alignment_of( (PixelType *)out ), (void *)in == (void *)out, flags, threads );
+    FFTWGlobalConfiguration::Lock();
+    PlanType plan = FFTWGlobalConfiguration::GetCachedPlanFloat( key );
+    FFTWGlobalConfiguration::Unlock();
+    if( plan == NULL
+        && FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+        < FFTWGlobalConfiguration::GetMaximumNumberOfCachedPlans() )
+      {
+      PlanType newPlan = Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+      FFTWGlobalConfiguration::Lock();
+      plan = FFTWGlobalConfiguration::AddCachedPlanFloat( key, newPlan );
+      if( plan == NULL )
+        {
+        // the cache was filled by another thread in the meantime
+        DestroyPlan( newPlan );
+        }
+      FFTWGlobalConfiguration::Unlock();
+      }
+    return plan;
+  }
+
+  /** Execute the plan on new arrays, which must have the sizes and the
+   * alignment of the arrays of the plan. */
+  static void Execute_dft_c2r(PlanType p, ComplexType *in, PixelType *out)
+  {
+    fftwf_execute_dft_c2r(p, in, out);
+  }
+  static void Execute_dft_r2c(PlanType p, PixelType *in, ComplexType *out)
+  {
+    fftwf_execute_dft_r2c(p, in, out);
+  }
+
   static void Execute(PlanType p)
   {
     fftwf_execute(p);
@@ -646,6 +752,88 @@ public:
   }
 
 
+  /** Same as Plan_dft_c2r(), but the plan is kept in the plan cache of
+   * FFTWGlobalConfiguration and returned again, without running the
+   * planner, for the next arrays with the same sizes and alignment and
+   * the same flags and number of threads. The plan belongs to the cache:
+   * it must be executed with Execute_dft_c2r() and must not be destroyed.
+   * NULL is returned when the plan is not cached and the cache is full;
+   * the caller then creates its own plan with Plan_dft_c2r(). */
+  static PlanType GetCachedPlan_dft_c2r(int rank,
+                                        const int *n,
+                                        ComplexType *in,
+                                        PixelType *out,
+                                        unsigned flags,
+                                        int threads=1,
+                                        bool canDestroyInput=false)
+  {
+    const FFTWGlobalConfiguration::PlanKeyType key =
+      MakePlanKey( PlanKind_dft_c2r, rank, n, fftw_alignment_of( (PixelType *)in ),
+                   fftw_alignment_of( out ), (void *)in == (void *)out, flags, threads );
+    FFTWGlobalConfiguration::Lock();
+    PlanType plan = FFTWGlobalConfiguration::GetCachedPlanDouble( key );
+    FFTWGlobalConfiguration::Unlock();
+    if( plan == NULL
+        && FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+        < FFTWGlobalConfiguration::GetMaximumNumberOfCachedPlans() )
+      {
+      PlanType newPlan = Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+      FFTWGlobalConfiguration::Lock();
+      plan = FFTWGlobalConfiguration::AddCachedPlanDouble( key, newPlan );
+      if( plan == NULL )
+        {
+        // the cache was filled by another thread in the meantime
+        DestroyPlan( newPlan );
+        }
+      FFTWGlobalConfiguration::Unlock();
+      }
+    return plan;
+  }
+
+  /** Same as Plan_dft_r2c(), with the plan kept in the plan cache.
+   * \sa GetCachedPlan_dft_c2r() */
+  static PlanType GetCachedPlan_dft_r2c(int rank,
+                                        const int *n,
+                                        PixelType *in,
+                                        ComplexType *out,
+                                        unsigned flags,
+                                        int threads=1,
+                                        bool canDestroyInput=false)
+  {
+    const FFTWGlobalConfiguration::PlanKeyType key =
+      MakePlanKey( PlanKind_dft_r2c, rank, n, fftw_alignment_of( in ),
+                   fftw_alignment_of( (PixelType *)out ), (void *)in == (void *)out, flags, threads );
+    FFTWGlobalConfiguration::Lock();
+    PlanType plan = FFTWGlobalConfiguration::GetCachedPlanDouble( key );
+    FFTWGlobalConfiguration::Unlock();
+    if( plan == NULL
+        && FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+        < FFTWGlobalConfiguration::GetMaximumNumberOfCachedPlans() )
+      {
+      PlanType newPlan = Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+      FFTWGlobalConfiguration::Lock();
+      plan = FFTWGlobalConfiguration::AddCachedPlanDouble( key, newPlan );
+      if( plan == NULL )
+        {
+        // the cache was filled by another thread in the meantime
+        DestroyPlan( newPlan );
+        }
+      FFTWGlobalConfiguration::Unlock();
+      }
+    return plan;
+  }
+
+  /** Execute the plan on new arrays, which must have the sizes and the
+   * alignment of the arrays of the plan. */
+  static void Execute_dft_c2r(PlanType p, ComplexType *in, PixelType *out)
+  {
+    fftw_execute_dft_c2r(p, in, out);
+  }
+  static void Execute_dft_r2c(PlanType p, PixelType *in, ComplexType *out)
+  {
+    fftw_execute_dft_r2c(p, in, out);
+  }
+
   static void Execute(PlanType p)
   {
     fftw_execute(p);
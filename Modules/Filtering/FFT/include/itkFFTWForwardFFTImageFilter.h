@@ -105,6 +105,16 @@ public:
   }
   itkGetConstReferenceMacro( PlanRigor, int );
 
+  /** Create the plan of the transform of the images of the given size,
+   * with the current plan rigor and number of threads, and keep it in the
+   * plan cache of FFTWGlobalConfiguration, so that the filters which
+   * transform images of that size don't run the FFTW planner. An
+   * application can call it at startup for the sizes it uses most.
+   *
+   * \sa FFTWGlobalConfiguration::SetUsePlanCache()
+   */
+  void PreparePlan(const InputSizeType & size);
+
 protected:
   FFTWForwardFFTImageFilter();
   ~FFTWForwardFFTImageFilter() {}
@@ -96,14 +96,63 @@ FFTWForwardFFTImageFilter< TInputImage, TOutputImage >
     sizes[(ImageDimension - 1) - i] = inputSize[i];
     }
 
-  plan = FFTWProxyType::Plan_dft_r2c(ImageDimension,sizes,
-                                    in,
-                                    out,
-                                    flags,
-                                    this->GetNumberOfThreads());
-  delete [] sizes;
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  plan = NULL;
+  if( FFTWGlobalConfiguration::GetUsePlanCache() )
+    {
+    // NULL if the plan is not cached and the cache is full
+    plan = FFTWProxyType::GetCachedPlan_dft_r2c(ImageDimension,sizes,
+                                               in,
+                                               out,
+                                               flags,
+                                               this->GetNumberOfThreads());
+    }
+  if( plan != NULL )
+    {
+    // the cached plan is executed on the arrays of this image
+    delete [] sizes;
+    FFTWProxyType::Execute_dft_r2c(plan, in, out);
+    }
+  else
+    {
+    plan = FFTWProxyType::Plan_dft_r2c(ImageDimension,sizes,
+                                      in,
+                                      out,
+                                      flags,
+                                      this->GetNumberOfThreads());
+    delete [] sizes;
+    FFTWProxyType::Execute(plan);
+    FFTWProxyType::DestroyPlan(plan);
+    }
+}
+
+template< class TInputImage, class TOutputImage >
+void
+FFTWForwardFFTImageFilter< TInputImage, TOutputImage >
+::PreparePlan(const InputSizeType & inputSize)
+{
+  SizeValueType totalInputSize = 1;
+  SizeValueType totalOutputSize = 1;
+  int sizes[ImageDimension];
+  for( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    sizes[(ImageDimension - 1) - i] = inputSize[i];
+    totalInputSize *= inputSize[i];
+    totalOutputSize *= ( i == 0 ) ? inputSize[i] / 2 + 1 : inputSize[i];
+    }
+
+  // The plan is created on temporary arrays, allocated like the buffers of
+  // the images to get the same alignment, with the flags used in
+  // GenerateData() for an input which is not released.
+  InputPixelType * in = new InputPixelType[totalInputSize];
+  typename FFTWProxyType::ComplexType * out = new typename FFTWProxyType::ComplexType[totalOutputSize];
+  FFTWProxyType::GetCachedPlan_dft_r2c(ImageDimension, sizes,
+                                      in,
+                                      out,
+                                      m_PlanRigor | FFTW_PRESERVE_INPUT,
+                                      this->GetNumberOfThreads(),
+                                      true);
+  delete [] in;
+  delete [] out;
 }
 
 template< class TInputImage, class TOutputImage >
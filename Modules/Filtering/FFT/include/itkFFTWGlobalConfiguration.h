@@ -23,6 +23,7 @@
 //       the next defines in order to have USE_FFTWF,USE_FFTWD defined
 #if defined(USE_FFTWF) || defined(USE_FFTWD)
 
+#include "itkIntTypes.h"
 #include "itkSimpleFastMutexLock.h"
 
 #include "itksys/SystemTools.hxx"
@@ -30,6 +31,8 @@
 #include "fftw3.h"
 #include <algorithm>
 #include <cctype>
+#include <map>
+#include <vector>
 
 //* The fftw utilities help control the various strategies
 //available for controlling optimizations for the FFTW library.
@@ -49,6 +52,9 @@
 //                             file to be generated.  If this is
 //                             set, then ITK_FFTW_WISDOM_CACHE_BASE
 //                             is ignored.
+//ITK_FFTW_USE_PLAN_CACHE    - Defines if the plans created by the
+//                             filters should be kept in memory and
+//                             reused (it is "On" by default)
 //
 // The above behaviors can also be controlled by the application.
 //
@@ -390,6 +396,81 @@ public:
    */
   static std::string GetWisdomFileDefaultBaseName();
 
+  /**
+   * \brief Set the behavior of plan caching
+   *
+   * When the plan cache is used, the FFTW filters keep the plans they
+   * create in a cache shared by the whole process, and execute them again
+   * on the new images of the same size instead of running the planner
+   * for each transform. With the FFTW_MEASURE rigor and above, the planner
+   * often costs more than the transform itself, which matters when many
+   * images of the same size are transformed, like in a registration.
+   * The cache holds at most MaximumNumberOfCachedPlans plans; once it is
+   * full, the plans for new sizes are created and destroyed by each
+   * transform, as without the cache. The plans of the cache live until
+   * ClearPlanCache() is called or the program exits.
+   *
+   * If the environmental variable "ITK_FFTW_USE_PLAN_CACHE", is set,
+   * then the environmental setting overides default settings.
+   * \param v true to keep and reuse the plans (the default)
+   */
+  static void SetUsePlanCache( const bool & v )
+  {
+    GetInstance()->m_UsePlanCache = v;
+  }
+
+  static bool GetUsePlanCache()
+  {
+    return GetInstance()->m_UsePlanCache;
+  }
+
+  /** Destroy all the plans of the plan cache. This method must not be
+   * called while an FFTW filter is running. */
+  static void ClearPlanCache();
+
+  /** Return the number of plans in the plan cache. */
+  static SizeValueType GetNumberOfCachedPlans();
+
+  /** Set/Get the maximum number of plans in the plan cache, 64 by
+   * default. Lowering it does not destroy the plans already cached: call
+   * ClearPlanCache() to release them. */
+  static void SetMaximumNumberOfCachedPlans( const SizeValueType & v )
+  {
+    GetInstance()->m_MaximumNumberOfCachedPlans = v;
+  }
+
+  static SizeValueType GetMaximumNumberOfCachedPlans()
+  {
+    return GetInstance()->m_MaximumNumberOfCachedPlans;
+  }
+
+  /** The key of a plan in the plan cache, made by fftw::Proxy from the kind
+   * of transform, the sizes, the alignment of the arrays, the planner
+   * flags and the number of threads. */
+  typedef std::vector< int > PlanKeyType;
+
+#if defined(USE_FFTWF)
+  /** Return the cached float plan for the given key, or NULL if there is
+   * none. Lock() must be held by the caller. */
+  static fftwf_plan GetCachedPlanFloat( const PlanKeyType & key );
+
+  /** Add a float plan to the cache, which then owns it, and return the
+   * cached plan for the key: if another thread has cached a plan for the
+   * same key in the meantime, plan is destroyed and the other plan is
+   * returned. If the cache is full, plan is not added and NULL is
+   * returned; the caller keeps the ownership of plan. Lock() must be held
+   * by the caller. */
+  static fftwf_plan AddCachedPlanFloat( const PlanKeyType & key, fftwf_plan plan );
+#endif
+
+#if defined(USE_FFTWD)
+  /** Same as GetCachedPlanFloat() for the double plans. */
+  static fftw_plan GetCachedPlanDouble( const PlanKeyType & key );
+
+  /** Same as AddCachedPlanFloat() for the double plans. */
+  static fftw_plan AddCachedPlanDouble( const PlanKeyType & key, fftw_plan plan );
+#endif
+
   /** Import or export some wisdom for the type double to/from a file */
   static bool ImportWisdomFileDouble( const std::string &fname );
   static bool ExportWisdomFileDouble( const std::string &fname );
@@ -413,6 +494,9 @@ private:
   /** Return the singleton instance with no reference counting. */
   static Pointer GetInstance();
 
+  /** Number of plans in the plan cache; m_Lock must be held. */
+  SizeValueType GetNumberOfCachedPlansNoLock() const;
+
   /** This is a singleton pattern New.  There will only be ONE
    * reference to a FFTWGlobalConfiguration object per process.
    * The single instance will be unreferenced when
@@ -431,6 +515,14 @@ private:
   bool                          m_WriteWisdomCache;
   bool                          m_ReadWisdomCache;
   std::string                   m_WisdomCacheBase;
+  bool                          m_UsePlanCache;
+  SizeValueType                 m_MaximumNumberOfCachedPlans;
+#if defined(USE_FFTWF)
+  std::map< PlanKeyType, fftwf_plan > m_FloatPlanCache;
+#endif
+#if defined(USE_FFTWD)
+  std::map< PlanKeyType, fftw_plan >  m_DoublePlanCache;
+#endif
   //m_WriteWisdomCache Controls the behavior of default
   //wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
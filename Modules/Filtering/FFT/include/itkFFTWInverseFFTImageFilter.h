@@ -108,6 +108,15 @@ public:
     this->SetPlanRigor( FFTWGlobalConfiguration::GetPlanRigorValue( name ) );
   }
 
+  /** Create the plan of the transform to real images of the given size,
+   * with the current plan rigor and number of threads, and keep it in the
+   * plan cache of FFTWGlobalConfiguration, so that the filters which
+   * produce images of that size don't run the FFTW planner.
+   *
+   * \sa FFTWForwardFFTImageFilter::PreparePlan()
+   */
+  void PreparePlan(const OutputSizeType & size);
+
 protected:
   FFTWInverseFFTImageFilter();
   virtual ~FFTWInverseFFTImageFilter() {}
@@ -95,28 +95,81 @@ FFTWInverseFFTImageFilter< TInputImage, TOutputImage >
     {
     sizes[(ImageDimension - 1) - i] = outputSize[i];
     }
-  plan = FFTWProxyType::Plan_dft_c2r( ImageDimension,sizes,
-                                      in,
-                                      out,
-                                      m_PlanRigor,
-                                      this->GetNumberOfThreads(),
-                                      !m_CanUseDestructiveAlgorithm );
+  plan = NULL;
+  if( FFTWGlobalConfiguration::GetUsePlanCache() )
+    {
+    // NULL if the plan is not cached and the cache is full
+    plan = FFTWProxyType::GetCachedPlan_dft_c2r( ImageDimension,sizes,
+                                                 in,
+                                                 out,
+                                                 m_PlanRigor,
+                                                 this->GetNumberOfThreads(),
+                                                 !m_CanUseDestructiveAlgorithm );
+    }
+  const bool usePlanCache = ( plan != NULL );
+  if( !usePlanCache )
+    {
+    plan = FFTWProxyType::Plan_dft_c2r( ImageDimension,sizes,
+                                        in,
+                                        out,
+                                        m_PlanRigor,
+                                        this->GetNumberOfThreads(),
+                                        !m_CanUseDestructiveAlgorithm );
+    }
   if( !m_CanUseDestructiveAlgorithm )
     {
     memcpy( in,
             inputPtr->GetBufferPointer(),
             totalInputSize * sizeof(typename FFTWProxyType::ComplexType) );
     }
-  FFTWProxyType::Execute( plan );
+
+  if( usePlanCache )
+    {
+    // The cached plan is executed on the arrays of this image.
+    FFTWProxyType::Execute_dft_c2r( plan, in, out );
+    }
+  else
+    {
+    FFTWProxyType::Execute( plan );
+    FFTWProxyType::DestroyPlan( plan );
+    }
 
   // Some cleanup.
-  FFTWProxyType::DestroyPlan( plan );
   if( !m_CanUseDestructiveAlgorithm )
     {
     delete [] in;
     }
 }
 
+template< class TInputImage, class TOutputImage >
+void
+FFTWInverseFFTImageFilter< TInputImage, TOutputImage >
+::PreparePlan(const OutputSizeType & outputSize)
+{
+  SizeValueType totalOutputSize = 1;
+  SizeValueType totalInputSize = 1;
+  int sizes[ImageDimension];
+  for( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    sizes[(ImageDimension - 1) - i] = outputSize[i];
+    totalOutputSize *= outputSize[i];
+    totalInputSize *= ( i == 0 ) ? outputSize[i] / 2 + 1 : outputSize[i];
+    }
+
+  // The plan is created on temporary arrays, allocated like the buffers
+  // used in BeforeThreadedGenerateData() to get the same alignment.
+  typename FFTWProxyType::ComplexType * in = new typename FFTWProxyType::ComplexType[totalInputSize];
+  OutputPixelType * out = new OutputPixelType[totalOutputSize];
+  FFTWProxyType::GetCachedPlan_dft_c2r( ImageDimension, sizes,
+                                        in,
+                                        out,
+                                        m_PlanRigor,
+                                        this->GetNumberOfThreads(),
+                                        true );
+  delete [] in;
+  delete [] out;
+}
+
 template <class TInputImage, class TOutputImage>
 void
 FFTWInverseFFTImageFilter< TInputImage, TOutputImage >
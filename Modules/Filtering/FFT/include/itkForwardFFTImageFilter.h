@@ -70,7 +70,7 @@ public:
   /** Customized object creation methods that support configuration-based
     * selection of FFT implementation.
     *
-    * Default implementation is VnlFFT. */
+    * Default implementation is VnlThreadedForwardFFTImageFilter. */
   static Pointer New(void);
 
 protected:
@@ -100,6 +100,8 @@ private:
 #ifndef ITK_MANUAL_INSTANTIATION
 #ifndef __itkVnlForwardFFTImageFilter_h
 #ifndef __itkVnlForwardFFTImageFilter_hxx
+#ifndef __itkVnlThreadedForwardFFTImageFilter_h
+#ifndef __itkVnlThreadedForwardFFTImageFilter_hxx
 #ifndef __itkFFTWForwardFFTImageFilter_h
 #ifndef __itkFFTWForwardFFTImageFilter_hxx
 #include "itkForwardFFTImageFilter.hxx"
@@ -108,5 +110,7 @@ private:
 #endif
 #endif
 #endif
+#endif
+#endif
 
 #endif
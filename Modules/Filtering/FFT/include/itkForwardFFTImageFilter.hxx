@@ -19,7 +19,7 @@
 #define __itkForwardFFTImageFilter_hxx
 #include "itkMetaDataObject.h"
 
-#include "itkVnlForwardFFTImageFilter.h"
+#include "itkVnlThreadedForwardFFTImageFilter.h"
 
 #if defined( USE_FFTWD ) || defined( USE_FFTWF )
 #include "itkFFTWForwardFFTImageFilter.h"
@@ -33,7 +33,7 @@ struct DispatchFFTW_R2C_New
 {
   static TSelfPointer Apply()
     {
-      return VnlForwardFFTImageFilter< TInputImage, TOutputImage >
+      return VnlThreadedForwardFFTImageFilter< TInputImage, TOutputImage >
         ::New().GetPointer();
     }
 };
@@ -73,7 +73,7 @@ public:
   /** Customized object creation methods that support configuration-based
   * selection of FFT implementation.
   *
-  * Default implementation is VnlFFT. */
+  * Default implementation is VnlThreadedInverseFFTImageFilter. */
   static Pointer New(void);
 
   /** The output may be a different size from the input if complex conjugate
@@ -126,6 +126,8 @@ private:
 #ifndef ITK_MANUAL_INSTANTIATION
 #ifndef __itkVnlInverseFFTImageFilter_h
 #ifndef __itkVnlInverseFFTImageFilter_hxx
+#ifndef __itkVnlThreadedInverseFFTImageFilter_h
+#ifndef __itkVnlThreadedInverseFFTImageFilter_hxx
 #ifndef __itkFFTWInverseFFTImageFilter_h
 #ifndef __itkFFTWInverseFFTImageFilter_hxx
 #include "itkInverseFFTImageFilter.hxx"
@@ -134,5 +136,7 @@ private:
 #endif
 #endif
 #endif
+#endif
+#endif
 
 #endif
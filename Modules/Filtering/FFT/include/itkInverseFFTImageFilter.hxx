@@ -19,7 +19,7 @@
 #define __itkInverseFFTImageFilter_hxx
 #include "itkMetaDataObject.h"
 
-#include "itkVnlInverseFFTImageFilter.h"
+#include "itkVnlThreadedInverseFFTImageFilter.h"
 
 #if defined( USE_FFTWD ) || defined( USE_FFTWF )
 #include "itkFFTWInverseFFTImageFilter.h"
@@ -34,7 +34,7 @@ struct Dispatch_C2R_New
 {
   static TSelfPointer Apply()
     {
-      return VnlInverseFFTImageFilter< TInputImage, TOutputImage >
+      return VnlThreadedInverseFFTImageFilter< TInputImage, TOutputImage >
         ::New().GetPointer();
     }
 };
@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkVnlFFT1DTransform_h
+#define __itkVnlFFT1DTransform_h
+
+#include "itkIntTypes.h"
+#include "vnl/algo/vnl_fft_1d.h"
+#include "vnl/vnl_math.h"
+
+#include <complex>
+#include <vector>
+
+namespace itk
+{
+/** \class VnlFFT1DTransform
+ * \brief In-place one dimensional complex Fourier transform of any size.
+ *
+ * Computes \f$ X_k = \sum_j x_j e^{s 2 \pi i j k / n} \f$ for a sign s of
+ * -1 (forward transform) or +1 (unnormalized inverse transform). Sizes
+ * whose prime factors are 2, 3 and 5 are transformed directly by
+ * vnl_fft_1d. Other sizes use Bluestein's algorithm, which writes the
+ * transform as a convolution computed with vnl_fft_1d transforms of the
+ * next power of two not less than 2n-1.
+ *
+ * The tables are computed by the constructor, so an object can transform
+ * many signals of the same size. An object must not be shared by several
+ * threads.
+ *
+ * \sa VnlThreadedForwardFFTImageFilter VnlThreadedInverseFFTImageFilter
+ * \ingroup ITKFFT
+ */
+template< class TReal >
+class VnlFFT1DTransform
+{
+public:
+  typedef std::complex< TReal > ComplexType;
+
+  VnlFFT1DTransform(SizeValueType size, int sign):
+    m_Size(size),
+    m_Sign(sign),
+    m_FFT( static_cast< int >( IsSizeFactorizable(size) ? size : GetBluesteinSize(size) ) )
+  {
+    if ( IsSizeFactorizable(size) )
+      {
+      return;
+      }
+
+    // The chirp c_m = exp(s i pi m^2 / n): the angle is reduced modulo
+    // 2 pi before the conversion to floating point.
+    const SizeValueType bluesteinSize = GetBluesteinSize(size);
+    m_Chirp.resize(size);
+    for ( SizeValueType m = 0; m < size; m++ )
+      {
+      const double angle = sign * vnl_math::pi * static_cast< double >( ( m * m ) % ( 2 * size ) ) / size;
+      m_Chirp[m] = ComplexType( static_cast< TReal >( vcl_cos(angle) ), static_cast< TReal >( vcl_sin(angle) ) );
+      }
+
+    // The transform of the conjugate chirp, extended circularly to
+    // negative indices, scaled by the normalization of the inverse
+    // transform of the convolution.
+    m_ChirpFilterFFT.assign( bluesteinSize, ComplexType(0) );
+    m_ChirpFilterFFT[0] = std::conj(m_Chirp[0]);
+    for ( SizeValueType m = 1; m < size; m++ )
+      {
+      m_ChirpFilterFFT[m] = std::conj(m_Chirp[m]);
+      m_ChirpFilterFFT[bluesteinSize - m] = std::conj(m_Chirp[m]);
+      }
+    m_FFT.vnl_fft_1d< TReal >::base::transform(&m_ChirpFilterFFT[0], -1);
+    for ( SizeValueType k = 0; k < bluesteinSize; k++ )
+      {
+      m_ChirpFilterFFT[k] /= static_cast< TReal >( bluesteinSize );
+      }
+    m_Buffer.resize(bluesteinSize);
+  }
+
+  SizeValueType GetSize() const { return m_Size; }
+
+  /** Transforms the GetSize() values pointed to by data. */
+  void Transform(ComplexType *data)
+  {
+    if ( m_Chirp.empty() )
+      {
+      m_FFT.vnl_fft_1d< TReal >::base::transform(data, m_Sign);
+      return;
+      }
+
+    // X_k = c_k sum_j ( x_j c_j ) conj( c_{k-j} )
+    const SizeValueType bluesteinSize = m_Buffer.size();
+    for ( SizeValueType j = 0; j < m_Size; j++ )
+      {
+      m_Buffer[j] = data[j] * m_Chirp[j];
+      }
+    std::fill(m_Buffer.begin() + m_Size, m_Buffer.end(), ComplexType(0));
+    m_FFT.vnl_fft_1d< TReal >::base::transform(&m_Buffer[0], -1);
+    for ( SizeValueType k = 0; k < bluesteinSize; k++ )
+      {
+      m_Buffer[k] *= m_ChirpFilterFFT[k];
+      }
+    m_FFT.vnl_fft_1d< TReal >::base::transform(&m_Buffer[0], +1);
+    for ( SizeValueType k = 0; k < m_Size; k++ )
+      {
+      data[k] = m_Buffer[k] * m_Chirp[k];
+      }
+  }
+
+  /** Returns true if the prime factors of n are 2, 3 and 5. */
+  static bool IsSizeFactorizable(SizeValueType n)
+  {
+    if ( n == 0 )
+      {
+      return false;
+      }
+    const SizeValueType factors[3] = { 2, 3, 5 };
+    for ( unsigned int f = 0; f < 3; f++ )
+      {
+      while ( n % factors[f] == 0 )
+        {
+        n /= factors[f];
+        }
+      }
+    return n == 1;
+  }
+
+private:
+  VnlFFT1DTransform(const VnlFFT1DTransform &); //purposely not implemented
+  void operator=(const VnlFFT1DTransform &);     //purposely not implemented
+
+  static SizeValueType GetBluesteinSize(SizeValueType n)
+  {
+    SizeValueType size = 1;
+    while ( size < 2 * n - 1 )
+      {
+      size *= 2;
+      }
+    return size;
+  }
+
+  SizeValueType              m_Size;
+  int                        m_Sign;
+  vnl_fft_1d< TReal >        m_FFT;
+  std::vector< ComplexType > m_Chirp;
+  std::vector< ComplexType > m_ChirpFilterFFT;
+  std::vector< ComplexType > m_Buffer;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkVnlThreadedForwardFFTImageFilter_h
+#define __itkVnlThreadedForwardFFTImageFilter_h
+
+#include "itkForwardFFTImageFilter.h"
+
+namespace itk
+{
+/** \class VnlThreadedForwardFFTImageFilter
+ *
+ * \brief Multithreaded forward Fast Fourier Transform of images of any
+ * size, built on VNL.
+ *
+ * The transform is computed one dimension at a time. The lines of the
+ * image along the current dimension are shared by the threads, which
+ * transform them with VnlFFT1DTransform: sizes that are not multiples of
+ * 2s, 3s and 5s are supported through Bluestein's algorithm.
+ *
+ * The output takes advantage of the complex conjugate symmetry of the
+ * transform of a real image: like the FFTW implementation, only the
+ * first N/2+1 values of the first dimension, of size N, are computed
+ * (FullMatrix() returns false). Two real lines of the first dimension are
+ * transformed at once as the real and imaginary parts of a complex line.
+ *
+ * This is the implementation returned by ForwardFFTImageFilter::New()
+ * when FFTW is not used.
+ *
+ * \ingroup FourierTransform
+ *
+ * \sa ForwardFFTImageFilter VnlThreadedInverseFFTImageFilter
+ * \ingroup ITKFFT
+ */
+template< class TInputImage, class TOutputImage=Image< std::complex<typename TInputImage::PixelType>, TInputImage::ImageDimension> >
+class VnlThreadedForwardFFTImageFilter:
+  public ForwardFFTImageFilter< TInputImage, TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef TInputImage                            InputImageType;
+  typedef typename InputImageType::PixelType     InputPixelType;
+  typedef typename InputImageType::SizeType      InputSizeType;
+  typedef typename InputImageType::SizeValueType InputSizeValueType;
+  typedef TOutputImage                           OutputImageType;
+  typedef typename OutputImageType::PixelType    OutputPixelType;
+  typedef typename OutputImageType::SizeType     OutputSizeType;
+
+  typedef VnlThreadedForwardFFTImageFilter                   Self;
+  typedef ForwardFFTImageFilter<  TInputImage, TOutputImage> Superclass;
+  typedef SmartPointer< Self >                               Pointer;
+  typedef SmartPointer< const Self >                         ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VnlThreadedForwardFFTImageFilter,
+               ForwardFFTImageFilter);
+
+  /** Extract the dimensionality of the images. They are assumed to be
+   * the same. */
+  itkStaticConstMacro(ImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+  itkStaticConstMacro(InputImageDimension, unsigned int,
+                      TInputImage::ImageDimension);
+  itkStaticConstMacro(OutputImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+
+  /** These should be defined in every FFT filter class. */
+  virtual void GenerateData();
+
+  virtual bool FullMatrix();
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro( ImageDimensionsMatchCheck,
+                   ( Concept::SameDimension< InputImageDimension, OutputImageDimension > ) );
+  /** End concept checking */
+#endif
+
+protected:
+  VnlThreadedForwardFFTImageFilter():m_CurrentDimension(0) {}
+  ~VnlThreadedForwardFFTImageFilter() {}
+
+  /** Transforms the share of the lines along m_CurrentDimension of the
+   * given thread. */
+  void ThreadedTransformLines(ThreadIdType threadId, ThreadIdType numberOfThreads);
+
+private:
+  typedef typename OutputPixelType::value_type RealType;
+
+  static ITK_THREAD_RETURN_TYPE TransformLinesThreaderCallback(void *arg);
+
+  VnlThreadedForwardFFTImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);                   //purposely not implemented
+
+  unsigned int m_CurrentDimension;
+};
+}
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkVnlThreadedForwardFFTImageFilter.hxx"
+#endif
+
+#endif
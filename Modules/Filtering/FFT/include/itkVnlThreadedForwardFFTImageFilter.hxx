@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkVnlThreadedForwardFFTImageFilter_hxx
+#define __itkVnlThreadedForwardFFTImageFilter_hxx
+
+#include "itkVnlThreadedForwardFFTImageFilter.h"
+#include "itkForwardFFTImageFilter.hxx"
+#include "itkProgressReporter.h"
+#include "itkVnlFFT1DTransform.h"
+
+namespace itk
+{
+template< class TInputImage, class TOutputImage >
+void
+VnlThreadedForwardFFTImageFilter< TInputImage, TOutputImage >
+::GenerateData()
+{
+  // Get pointers to the input and output.
+  typename InputImageType::ConstPointer inputPtr = this->GetInput();
+  typename OutputImageType::Pointer outputPtr = this->GetOutput();
+
+  if ( !inputPtr || !outputPtr )
+    {
+    return;
+    }
+
+  ProgressReporter progress( this, 0, ImageDimension );
+
+  outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
+  outputPtr->Allocate();
+
+  typename ImageSource< OutputImageType >::ThreadStruct str;
+  str.Filter = this;
+
+  MultiThreader *multithreader = this->GetMultiThreader();
+  multithreader->SetNumberOfThreads( this->GetNumberOfThreads() );
+  multithreader->SetSingleMethod( this->TransformLinesThreaderCallback, &str );
+
+  // The first dimension transforms the real input into the output, and
+  // the next ones transform the output in place.
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    m_CurrentDimension = d;
+    multithreader->SingleMethodExecute();
+    progress.CompletedPixel();
+    }
+}
+
+template< class TInputImage, class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+VnlThreadedForwardFFTImageFilter< TInputImage, TOutputImage >
+::TransformLinesThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  typedef typename ImageSource< OutputImageType >::ThreadStruct ThreadStruct;
+  ThreadStruct *str = static_cast< ThreadStruct * >( info->UserData );
+
+  Self *filter = static_cast< Self * >( str->Filter.GetPointer() );
+  filter->ThreadedTransformLines( info->ThreadID, info->NumberOfThreads );
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< class TInputImage, class TOutputImage >
+void
+VnlThreadedForwardFFTImageFilter< TInputImage, TOutputImage >
+::ThreadedTransformLines(ThreadIdType threadId, ThreadIdType numberOfThreads)
+{
+  typedef VnlFFT1DTransform< RealType >           LineTransformType;
+  typedef typename LineTransformType::ComplexType ComplexType;
+
+  const InputImageType *inputPtr = this->GetInput();
+  OutputImageType *     outputPtr = this->GetOutput();
+  const InputSizeType   inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  const OutputSizeType  outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
+  OutputPixelType *     out = outputPtr->GetBufferPointer();
+
+  const unsigned int d = m_CurrentDimension;
+  SizeValueType      numberOfLines = 1;
+  SizeValueType      stride = 1;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    if ( i != d )
+      {
+      numberOfLines *= outputSize[i];
+      }
+    if ( i < d )
+      {
+      stride *= outputSize[i];
+      }
+    }
+
+  if ( d == 0 )
+    {
+    // Transform the real lines two by two, as the real and imaginary
+    // parts z = x + i y of a complex line: since the transforms of x and
+    // y are conjugate symmetric, X_k = ( Z_k + conj(Z_{n-k}) ) / 2 and
+    // Y_k = ( Z_k - conj(Z_{n-k}) ) / 2i.
+    const SizeValueType   n = inputSize[0];
+    const SizeValueType   halfN = outputSize[0];
+    const SizeValueType   numberOfPairs = ( numberOfLines + 1 ) / 2;
+    const SizeValueType   firstPair = numberOfPairs * threadId / numberOfThreads;
+    const SizeValueType   lastPair = numberOfPairs * ( threadId + 1 ) / numberOfThreads;
+    const InputPixelType *in = inputPtr->GetBufferPointer();
+
+    LineTransformType          transform(n, -1);
+    std::vector< ComplexType > z(n);
+    for ( SizeValueType pair = firstPair; pair < lastPair; pair++ )
+      {
+      const SizeValueType   line = 2 * pair;
+      const bool            hasSecondLine = line + 1 < numberOfLines;
+      const InputPixelType *x = in + line * n;
+      for ( SizeValueType j = 0; j < n; j++ )
+        {
+        z[j] = ComplexType( x[j], hasSecondLine ? x[j + n] : 0 );
+        }
+      transform.Transform(&z[0]);
+
+      OutputPixelType *X = out + line * halfN;
+      for ( SizeValueType k = 0; k < halfN; k++ )
+        {
+        const ComplexType zk = z[k];
+        const ComplexType znk = std::conj( z[( n - k ) % n] );
+        X[k] = ( zk + znk ) * static_cast< RealType >( 0.5 );
+        if ( hasSecondLine )
+          {
+          X[k + halfN] = ( zk - znk ) * ComplexType( 0, -0.5 );
+          }
+        }
+      }
+    }
+  else
+    {
+    // Transform the complex lines along the dimension d in place.
+    const SizeValueType n = outputSize[d];
+    const SizeValueType firstLine = numberOfLines * threadId / numberOfThreads;
+    const SizeValueType lastLine = numberOfLines * ( threadId + 1 ) / numberOfThreads;
+
+    LineTransformType          transform(n, -1);
+    std::vector< ComplexType > z(n);
+    for ( SizeValueType line = firstLine; line < lastLine; line++ )
+      {
+      OutputPixelType *lineStart = out + line % stride + ( line / stride ) * stride * n;
+      for ( SizeValueType j = 0; j < n; j++ )
+        {
+        z[j] = lineStart[j * stride];
+        }
+      transform.Transform(&z[0]);
+      for ( SizeValueType j = 0; j < n; j++ )
+        {
+        lineStart[j * stride] = z[j];
+        }
+      }
+    }
+}
+
+template< class TInputImage, class TOutputImage >
+bool
+VnlThreadedForwardFFTImageFilter< TInputImage, TOutputImage >
+::FullMatrix()
+{
+  return false;
+}
+}
+
+#endif
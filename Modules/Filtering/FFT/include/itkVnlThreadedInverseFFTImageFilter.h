@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkVnlThreadedInverseFFTImageFilter_h
+#define __itkVnlThreadedInverseFFTImageFilter_h
+
+#include "itkInverseFFTImageFilter.h"
+
+#include "itkImage.h"
+
+namespace itk
+{
+/** \class VnlThreadedInverseFFTImageFilter
+ *
+ * \brief Multithreaded inverse Fast Fourier Transform of images of any
+ * size, built on VNL.
+ *
+ * The input is the first N/2+1 values of the first dimension of a
+ * complex conjugate symmetric image, such as the output of
+ * VnlThreadedForwardFFTImageFilter or FFTWForwardFFTImageFilter
+ * (FullMatrix() returns false). The size N is read from the
+ * "FFT_Actual_RealImage_Size" metadata of the input when present, and
+ * is given by SetActualXDimensionIsOdd() otherwise.
+ *
+ * The transform is computed one dimension at a time, the lines along the
+ * current dimension being shared by the threads. The last dimension
+ * computed is the first one, whose conjugate symmetric lines are
+ * transformed two by two into the real and imaginary parts of a complex
+ * line. As with FFTW, the imaginary parts of the values that must be real
+ * for the symmetry, such as the first value of each line, are ignored.
+ *
+ * This is the implementation returned by InverseFFTImageFilter::New()
+ * when FFTW is not used.
+ *
+ * \ingroup FourierTransform
+ *
+ * \sa InverseFFTImageFilter VnlThreadedForwardFFTImageFilter
+ * \ingroup ITKFFT
+ */
+template< class TInputImage, class TOutputImage=Image< typename TInputImage::PixelType::value_type, TInputImage::ImageDimension> >
+class VnlThreadedInverseFFTImageFilter:
+  public InverseFFTImageFilter< TInputImage, TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef TInputImage                            InputImageType;
+  typedef typename InputImageType::PixelType     InputPixelType;
+  typedef typename InputImageType::SizeType      InputSizeType;
+  typedef typename InputImageType::SizeValueType InputSizeValueType;
+  typedef TOutputImage                           OutputImageType;
+  typedef typename OutputImageType::PixelType    OutputPixelType;
+  typedef typename OutputImageType::SizeType     OutputSizeType;
+
+  typedef VnlThreadedInverseFFTImageFilter                   Self;
+  typedef InverseFFTImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                               Pointer;
+  typedef SmartPointer< const Self >                         ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VnlThreadedInverseFFTImageFilter,
+               InverseFFTImageFilter);
+
+  /** Extract the dimensionality of the images. They must be the
+   * same. */
+  itkStaticConstMacro(ImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+  itkStaticConstMacro(InputImageDimension, unsigned int,
+                      TInputImage::ImageDimension);
+  itkStaticConstMacro(OutputImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+
+  /** These should be defined in every FFT filter class. */
+  virtual void GenerateData();  // generates output from input
+
+  virtual bool FullMatrix();
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro( ImageDimensionsMatchCheck,
+                   ( Concept::SameDimension< InputImageDimension, OutputImageDimension > ) );
+  /** End concept checking */
+#endif
+
+protected:
+  VnlThreadedInverseFFTImageFilter():m_CurrentDimension(0) {}
+  virtual ~VnlThreadedInverseFFTImageFilter(){}
+
+  /** Transforms the share of the lines along m_CurrentDimension of the
+   * given thread. */
+  void ThreadedTransformLines(ThreadIdType threadId, ThreadIdType numberOfThreads);
+
+private:
+  typedef typename InputPixelType::value_type RealType;
+
+  static ITK_THREAD_RETURN_TYPE TransformLinesThreaderCallback(void *arg);
+
+  VnlThreadedInverseFFTImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);                   //purposely not implemented
+
+  unsigned int m_CurrentDimension;
+
+  /** Copy of the input, transformed in place along all the dimensions but
+   * the first one. */
+  typename InputImageType::Pointer m_WorkImage;
+};
+}
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkVnlThreadedInverseFFTImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,214 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkVnlThreadedInverseFFTImageFilter_hxx
+#define __itkVnlThreadedInverseFFTImageFilter_hxx
+
+#include "itkVnlThreadedInverseFFTImageFilter.h"
+#include "itkInverseFFTImageFilter.hxx"
+#include "itkProgressReporter.h"
+#include "itkVnlFFT1DTransform.h"
+
+namespace itk
+{
+template< class TInputImage, class TOutputImage >
+void
+VnlThreadedInverseFFTImageFilter< TInputImage, TOutputImage >
+::GenerateData()
+{
+  // Get pointers to the input and output.
+  typename InputImageType::ConstPointer inputPtr = this->GetInput();
+  typename OutputImageType::Pointer outputPtr = this->GetOutput();
+
+  if ( !inputPtr || !outputPtr )
+    {
+    return;
+    }
+
+  const InputSizeType  inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  const OutputSizeType outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
+  if ( inputSize[0] != outputSize[0] / 2 + 1 )
+    {
+    itkExceptionMacro(<< "Cannot compute the inverse FFT of an image of size "
+                      << inputSize << " into an image of size " << outputSize
+                      << ". The first dimension of the input must hold the first "
+                      << "N/2+1 values of a transform of size N.");
+    }
+
+  ProgressReporter progress( this, 0, ImageDimension );
+
+  outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
+  outputPtr->Allocate();
+
+  m_WorkImage = InputImageType::New();
+  m_WorkImage->SetRegions( inputPtr->GetLargestPossibleRegion() );
+  m_WorkImage->Allocate();
+  std::copy( inputPtr->GetBufferPointer(),
+             inputPtr->GetBufferPointer() + inputPtr->GetLargestPossibleRegion().GetNumberOfPixels(),
+             m_WorkImage->GetBufferPointer() );
+
+  typename ImageSource< OutputImageType >::ThreadStruct str;
+  str.Filter = this;
+
+  MultiThreader *multithreader = this->GetMultiThreader();
+  multithreader->SetNumberOfThreads( this->GetNumberOfThreads() );
+  multithreader->SetSingleMethod( this->TransformLinesThreaderCallback, &str );
+
+  // The last dimensions are transformed in place in the work image, and
+  // the first one from the work image into the real output.
+  for ( int d = ImageDimension - 1; d >= 0; d-- )
+    {
+    m_CurrentDimension = d;
+    multithreader->SingleMethodExecute();
+    progress.CompletedPixel();
+    }
+
+  m_WorkImage = NULL;
+}
+
+template< class TInputImage, class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+VnlThreadedInverseFFTImageFilter< TInputImage, TOutputImage >
+::TransformLinesThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  typedef typename ImageSource< OutputImageType >::ThreadStruct ThreadStruct;
+  ThreadStruct *str = static_cast< ThreadStruct * >( info->UserData );
+
+  Self *filter = static_cast< Self * >( str->Filter.GetPointer() );
+  filter->ThreadedTransformLines( info->ThreadID, info->NumberOfThreads );
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< class TInputImage, class TOutputImage >
+void
+VnlThreadedInverseFFTImageFilter< TInputImage, TOutputImage >
+::ThreadedTransformLines(ThreadIdType threadId, ThreadIdType numberOfThreads)
+{
+  typedef VnlFFT1DTransform< RealType >           LineTransformType;
+  typedef typename LineTransformType::ComplexType ComplexType;
+
+  OutputImageType *    outputPtr = this->GetOutput();
+  const InputSizeType  inputSize = m_WorkImage->GetLargestPossibleRegion().GetSize();
+  const OutputSizeType outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
+  InputPixelType *     work = m_WorkImage->GetBufferPointer();
+
+  const unsigned int d = m_CurrentDimension;
+  SizeValueType      numberOfLines = 1;
+  SizeValueType      stride = 1;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    if ( i != d )
+      {
+      numberOfLines *= inputSize[i];
+      }
+    if ( i < d )
+      {
+      stride *= inputSize[i];
+      }
+    }
+
+  if ( d == 0 )
+    {
+    // Transform the conjugate symmetric lines X and Y two by two, as the
+    // line Z = X + i Y whose inverse transform is x + i y.
+    const SizeValueType n = outputSize[0];
+    const SizeValueType halfN = inputSize[0];
+    const SizeValueType numberOfPairs = ( numberOfLines + 1 ) / 2;
+    const SizeValueType firstPair = numberOfPairs * threadId / numberOfThreads;
+    const SizeValueType lastPair = numberOfPairs * ( threadId + 1 ) / numberOfThreads;
+    const RealType      scale = static_cast< RealType >( 1.0 / outputPtr->GetLargestPossibleRegion().GetNumberOfPixels() );
+    OutputPixelType *   out = outputPtr->GetBufferPointer();
+
+    LineTransformType          transform(n, +1);
+    std::vector< ComplexType > z(n);
+    for ( SizeValueType pair = firstPair; pair < lastPair; pair++ )
+      {
+      const SizeValueType   line = 2 * pair;
+      const bool            hasSecondLine = line + 1 < numberOfLines;
+      const InputPixelType *X = work + line * halfN;
+      const InputPixelType *Y = X + halfN;
+      for ( SizeValueType k = 0; k < n; k++ )
+        {
+        ComplexType a;
+        ComplexType b;
+        if ( k == 0 || 2 * k == n )
+          {
+          a = X[k].real();
+          b = hasSecondLine ? Y[k].real() : 0;
+          }
+        else if ( k < halfN )
+          {
+          a = X[k];
+          b = hasSecondLine ? Y[k] : ComplexType(0);
+          }
+        else
+          {
+          a = std::conj( X[n - k] );
+          b = hasSecondLine ? std::conj( Y[n - k] ) : ComplexType(0);
+          }
+        z[k] = a + ComplexType(0, 1) * b;
+        }
+      transform.Transform(&z[0]);
+
+      OutputPixelType *x = out + line * n;
+      for ( SizeValueType j = 0; j < n; j++ )
+        {
+        x[j] = static_cast< OutputPixelType >( z[j].real() * scale );
+        if ( hasSecondLine )
+          {
+          x[j + n] = static_cast< OutputPixelType >( z[j].imag() * scale );
+          }
+        }
+      }
+    }
+  else
+    {
+    // Transform the complex lines along the dimension d in place.
+    const SizeValueType n = inputSize[d];
+    const SizeValueType firstLine = numberOfLines * threadId / numberOfThreads;
+    const SizeValueType lastLine = numberOfLines * ( threadId + 1 ) / numberOfThreads;
+
+    LineTransformType          transform(n, +1);
+    std::vector< ComplexType > z(n);
+    for ( SizeValueType line = firstLine; line < lastLine; line++ )
+      {
+      InputPixelType *lineStart = work + line % stride + ( line / stride ) * stride * n;
+      for ( SizeValueType j = 0; j < n; j++ )
+        {
+        z[j] = lineStart[j * stride];
+        }
+      transform.Transform(&z[0]);
+      for ( SizeValueType j = 0; j < n; j++ )
+        {
+        lineStart[j * stride] = z[j];
+        }
+      }
+    }
+}
+
+template< class TInputImage, class TOutputImage >
+bool
+VnlThreadedInverseFFTImageFilter< TInputImage, TOutputImage >
+::FullMatrix()
+{
+  return false;
+}
+}
+
+#endif
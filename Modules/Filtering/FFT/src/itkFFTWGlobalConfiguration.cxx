@@ -122,7 +122,9 @@ FFTWGlobalConfiguration
   m_PlanRigor(0),
   m_WriteWisdomCache(false),
   m_ReadWisdomCache(true),
-  m_WisdomCacheBase("")
+  m_WisdomCacheBase(""),
+  m_UsePlanCache(true),
+  m_MaximumNumberOfCachedPlans(64)
 {
     {//Configure default method for creating WISDOM_CACHE files
     std::string manualCacheFilename="";
@@ -224,6 +226,21 @@ FFTWGlobalConfiguration
       }
     }
 
+    {
+    //Default library behavior should be to keep the plans
+    std::string use_plan_cache_env;
+    const bool envITK_FFTW_USE_PLAN_CACHEfound=
+      itksys::SystemTools::GetEnv("ITK_FFTW_USE_PLAN_CACHE", use_plan_cache_env);
+    if( envITK_FFTW_USE_PLAN_CACHEfound && isDeclineString(use_plan_cache_env) )
+      {
+      this->m_UsePlanCache=false;
+      }
+    else
+      {
+      this->m_UsePlanCache=true;
+      }
+    }
+
   if( this->m_ReadWisdomCache )
     {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -262,6 +279,21 @@ FFTWGlobalConfiguration
       }
 #endif
     }
+  // the plans must be destroyed before the cleanup of fftw
+#if defined(USE_FFTWF)
+  for( std::map< PlanKeyType, fftwf_plan >::iterator it = this->m_FloatPlanCache.begin();
+       it != this->m_FloatPlanCache.end(); ++it )
+    {
+    fftwf_destroy_plan( it->second );
+    }
+#endif
+#if defined(USE_FFTWD)
+  for( std::map< PlanKeyType, fftw_plan >::iterator it = this->m_DoublePlanCache.begin();
+       it != this->m_DoublePlanCache.end(); ++it )
+    {
+    fftw_destroy_plan( it->second );
+    }
+#endif
 #if defined(USE_FFTWF)
   fftwf_cleanup_threads();
   fftwf_cleanup();
@@ -449,6 +481,124 @@ FFTWGlobalConfiguration
 }
 
 
+void
+FFTWGlobalConfiguration
+::ClearPlanCache()
+{
+  Pointer instance = GetInstance();
+  instance->m_Lock.Lock();
+#if defined(USE_FFTWF)
+  for( std::map< PlanKeyType, fftwf_plan >::iterator it = instance->m_FloatPlanCache.begin();
+       it != instance->m_FloatPlanCache.end(); ++it )
+    {
+    fftwf_destroy_plan( it->second );
+    }
+  instance->m_FloatPlanCache.clear();
+#endif
+#if defined(USE_FFTWD)
+  for( std::map< PlanKeyType, fftw_plan >::iterator it = instance->m_DoublePlanCache.begin();
+       it != instance->m_DoublePlanCache.end(); ++it )
+    {
+    fftw_destroy_plan( it->second );
+    }
+  instance->m_DoublePlanCache.clear();
+#endif
+  instance->m_Lock.Unlock();
+}
+
+SizeValueType
+FFTWGlobalConfiguration
+::GetNumberOfCachedPlans()
+{
+  Pointer instance = GetInstance();
+  instance->m_Lock.Lock();
+  const SizeValueType numberOfPlans = instance->GetNumberOfCachedPlansNoLock();
+  instance->m_Lock.Unlock();
+  return numberOfPlans;
+}
+
+SizeValueType
+FFTWGlobalConfiguration
+::GetNumberOfCachedPlansNoLock() const
+{
+  SizeValueType numberOfPlans = 0;
+#if defined(USE_FFTWF)
+  numberOfPlans += m_FloatPlanCache.size();
+#endif
+#if defined(USE_FFTWD)
+  numberOfPlans += m_DoublePlanCache.size();
+#endif
+  return numberOfPlans;
+}
+
+#if defined(USE_FFTWF)
+fftwf_plan
+FFTWGlobalConfiguration
+::GetCachedPlanFloat( const PlanKeyType & key )
+{
+  Pointer instance = GetInstance();
+  std::map< PlanKeyType, fftwf_plan >::const_iterator it = instance->m_FloatPlanCache.find( key );
+  if( it == instance->m_FloatPlanCache.end() )
+    {
+    return NULL;
+    }
+  return it->second;
+}
+
+fftwf_plan
+FFTWGlobalConfiguration
+::AddCachedPlanFloat( const PlanKeyType & key, fftwf_plan plan )
+{
+  Pointer instance = GetInstance();
+  if( instance->m_FloatPlanCache.find( key ) == instance->m_FloatPlanCache.end()
+      && instance->GetNumberOfCachedPlansNoLock() >= instance->m_MaximumNumberOfCachedPlans )
+    {
+    return NULL;
+    }
+  std::pair< std::map< PlanKeyType, fftwf_plan >::iterator, bool > inserted =
+    instance->m_FloatPlanCache.insert( std::make_pair( key, plan ) );
+  if( !inserted.second )
+    {
+    fftwf_destroy_plan( plan );
+    }
+  return inserted.first->second;
+}
+#endif
+
+#if defined(USE_FFTWD)
+fftw_plan
+FFTWGlobalConfiguration
+::GetCachedPlanDouble( const PlanKeyType & key )
+{
+  Pointer instance = GetInstance();
+  std::map< PlanKeyType, fftw_plan >::const_iterator it = instance->m_DoublePlanCache.find( key );
+  if( it == instance->m_DoublePlanCache.end() )
+    {
+    return NULL;
+    }
+  return it->second;
+}
+
+fftw_plan
+FFTWGlobalConfiguration
+::AddCachedPlanDouble( const PlanKeyType & key, fftw_plan plan )
+{
+  Pointer instance = GetInstance();
+  if( instance->m_DoublePlanCache.find( key ) == instance->m_DoublePlanCache.end()
+      && instance->GetNumberOfCachedPlansNoLock() >= instance->m_MaximumNumberOfCachedPlans )
+    {
+    return NULL;
+    }
+  std::pair< std::map< PlanKeyType, fftw_plan >::iterator, bool > inserted =
+    instance->m_DoublePlanCache.insert( std::make_pair( key, plan ) );
+  if( !inserted.second )
+    {
+    fftw_destroy_plan( plan );
+    }
+  return inserted.first->second;
+}
+#endif
+
 void
 FFTWGlobalConfiguration
 ::Lock()
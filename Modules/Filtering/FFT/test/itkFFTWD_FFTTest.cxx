@@ -69,6 +69,67 @@ int itkFFTWD_FFTTest(int, char *[])
       itk::FFTWForwardFFTImageFilter<ImageD3> ,
       itk::FFTWInverseFFTImageFilter<ImageCD3> >(SizeOfDimensions2)) != 0)
     rval++;
+
+  // The plans are kept in the plan cache: preparing the same plan twice
+  // must create it once, and the transforms must not depend on the cache
+  std::cout << "UsePlanCache  " << itk::FFTWGlobalConfiguration::GetUsePlanCache() << std::endl;
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(true);
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  if( itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans() != 0 )
+    {
+    std::cerr << "The plan cache is not empty after ClearPlanCache()" << std::endl;
+    rval++;
+    }
+  ImageD3::SizeType planSize = { { 6, 5, 4 } };
+  itk::FFTWForwardFFTImageFilter<ImageD3>::Pointer forward = itk::FFTWForwardFFTImageFilter<ImageD3>::New();
+  forward->PreparePlan( planSize );
+  forward->PreparePlan( planSize );
+  if( itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans() != 1 )
+    {
+    std::cerr << "Wrong number of cached plans: " << itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+              << " instead of 1" << std::endl;
+    rval++;
+    }
+  itk::FFTWInverseFFTImageFilter<ImageCD3>::Pointer inverse = itk::FFTWInverseFFTImageFilter<ImageCD3>::New();
+  inverse->PreparePlan( planSize );
+  if( itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans() != 2 )
+    {
+    std::cerr << "Wrong number of cached plans: " << itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+              << " instead of 2" << std::endl;
+    rval++;
+    }
+  unsigned int SizeOfDimensions3[] = { 6,5,4 };
+  for( unsigned int i = 0; i < 2; i++ )
+    {
+    std::cerr << "FFTWD:double,3 (6,5,4) with UsePlanCache " << ( i == 0 ) << std::endl;
+    itk::FFTWGlobalConfiguration::SetUsePlanCache( i == 0 );
+    if((test_fft<double,3,
+        itk::FFTWForwardFFTImageFilter<ImageD3> ,
+        itk::FFTWInverseFFTImageFilter<ImageCD3> >(SizeOfDimensions3)) != 0)
+      rval++;
+    }
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(true);
+
+  // A full cache keeps its plans, and the transforms of other sizes create
+  // their own
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  itk::FFTWGlobalConfiguration::SetMaximumNumberOfCachedPlans(1);
+  forward->PreparePlan( planSize );
+  inverse->PreparePlan( planSize );
+  std::cerr << "FFTWD:double,3 (6,5,4) with a full plan cache" << std::endl;
+  if((test_fft<double,3,
+      itk::FFTWForwardFFTImageFilter<ImageD3> ,
+      itk::FFTWInverseFFTImageFilter<ImageCD3> >(SizeOfDimensions3)) != 0)
+    rval++;
+  if( itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans() != 1 )
+    {
+    std::cerr << "Wrong number of cached plans: " << itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+              << " instead of 1" << std::endl;
+    rval++;
+    }
+  itk::FFTWGlobalConfiguration::SetMaximumNumberOfCachedPlans(64);
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+
   return (rval == 0) ? 0 : -1;
 }
 
@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkFFTTest.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include "itkVnlThreadedForwardFFTImageFilter.h"
+#include "itkVnlThreadedInverseFFTImageFilter.h"
+
+// Compare the transform of a 2D image of size (7,5), computed with
+// Bluestein's algorithm in the first dimension, with the discrete Fourier
+// transform computed directly.
+static int test_fft_direct()
+{
+  typedef itk::Image< double, 2 >                                ImageType;
+  typedef itk::VnlThreadedForwardFFTImageFilter< ImageType >     FFTType;
+  typedef FFTType::OutputImageType                               ComplexImageType;
+
+  ImageType::SizeType   size = { { 7, 5 } };
+  ImageType::RegionType region;
+  region.SetSize(size);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  itk::ImageRegionIterator< ImageType > it(image, region);
+  for ( unsigned int i = 0; !it.IsAtEnd(); ++it, ++i )
+    {
+    it.Set( ( i * 37 ) % 11 - 3.0 );
+    }
+
+  FFTType::Pointer fft = FFTType::New();
+  fft->SetInput(image);
+  fft->SetNumberOfThreads(3);
+  fft->Update();
+
+  const ComplexImageType *output = fft->GetOutput();
+  if ( output->GetLargestPossibleRegion().GetSize(0) != size[0] / 2 + 1
+       || output->GetLargestPossibleRegion().GetSize(1) != size[1] )
+    {
+    std::cerr << "Wrong output size " << output->GetLargestPossibleRegion().GetSize() << std::endl;
+    return -1;
+    }
+
+  itk::ImageRegionConstIteratorWithIndex< ComplexImageType > outputIt( output, output->GetLargestPossibleRegion() );
+  for ( ; !outputIt.IsAtEnd(); ++outputIt )
+    {
+    const ComplexImageType::IndexType k = outputIt.GetIndex();
+    std::complex< double > expected(0);
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      const ImageType::IndexType j = it.GetIndex();
+      const double angle = -2.0 * vnl_math::pi * ( static_cast< double >( j[0] * k[0] ) / size[0]
+                                                  + static_cast< double >( j[1] * k[1] ) / size[1] );
+      expected += it.Get() * std::complex< double >( vcl_cos(angle), vcl_sin(angle) );
+      }
+    if ( std::abs( expected - outputIt.Get() ) > 1e-9 * ( 1.0 + std::abs(expected) ) )
+      {
+      std::cerr << "Wrong transform at " << k << ": " << outputIt.Get()
+                << " instead of " << expected << std::endl;
+      return -1;
+      }
+    }
+  return 0;
+}
+
+// Test the multithreaded VNL FFT: the forward and inverse transforms of
+// images whose sizes are multiples of 2s, 3s and 5s or not must give back
+// the images, and the transforms must match the ones of
+// VnlForwardFFTImageFilter, which returns the full matrix.
+int itkVnlThreadedFFTTest(int, char *[])
+{
+  typedef itk::Image< float, 1>               ImageF1;
+  typedef itk::Image< std::complex<float>, 1> ImageCF1;
+  typedef itk::Image< float, 2>               ImageF2;
+  typedef itk::Image< std::complex<float>, 2> ImageCF2;
+  typedef itk::Image< float, 3>               ImageF3;
+  typedef itk::Image< std::complex<float>, 3> ImageCF3;
+
+  typedef itk::Image< double, 1>               ImageD1;
+  typedef itk::Image< std::complex<double>, 1> ImageCD1;
+  typedef itk::Image< double, 2>               ImageD2;
+  typedef itk::Image< std::complex<double>, 2> ImageCD2;
+  typedef itk::Image< double, 3>               ImageD3;
+  typedef itk::Image< std::complex<double>, 3> ImageCD3;
+
+  unsigned int SizeOfDimensions[5][3] = { { 4,4,4 }, { 3,5,4 }, { 7,6,4 }, { 13,11,9 }, { 1,17,2 } };
+  int rval = 0;
+  for ( unsigned int s = 0; s < 5; s++ )
+    {
+    std::cerr << "VnlThreaded (" << SizeOfDimensions[s][0] << "," << SizeOfDimensions[s][1]
+              << "," << SizeOfDimensions[s][2] << ")" << std::endl;
+    rval += test_fft<float,1,
+      itk::VnlThreadedForwardFFTImageFilter<ImageF1> ,
+      itk::VnlThreadedInverseFFTImageFilter<ImageCF1> >(SizeOfDimensions[s]) != 0;
+    rval += test_fft<float,2,
+      itk::VnlThreadedForwardFFTImageFilter<ImageF2> ,
+      itk::VnlThreadedInverseFFTImageFilter<ImageCF2> >(SizeOfDimensions[s]) != 0;
+    rval += test_fft<float,3,
+      itk::VnlThreadedForwardFFTImageFilter<ImageF3> ,
+      itk::VnlThreadedInverseFFTImageFilter<ImageCF3> >(SizeOfDimensions[s]) != 0;
+    rval += test_fft<double,1,
+      itk::VnlThreadedForwardFFTImageFilter<ImageD1> ,
+      itk::VnlThreadedInverseFFTImageFilter<ImageCD1> >(SizeOfDimensions[s]) != 0;
+    rval += test_fft<double,2,
+      itk::VnlThreadedForwardFFTImageFilter<ImageD2> ,
+      itk::VnlThreadedInverseFFTImageFilter<ImageCD2> >(SizeOfDimensions[s]) != 0;
+    rval += test_fft<double,3,
+      itk::VnlThreadedForwardFFTImageFilter<ImageD3> ,
+      itk::VnlThreadedInverseFFTImageFilter<ImageCD3> >(SizeOfDimensions[s]) != 0;
+    }
+
+  for ( unsigned int s = 0; s < 2; s++ )
+    {
+    std::cerr << "Vnl and VnlThreaded (" << SizeOfDimensions[s][0] << "," << SizeOfDimensions[s][1]
+              << "," << SizeOfDimensions[s][2] << ")" << std::endl;
+    rval += test_fft_rtc<float,3,
+      itk::VnlForwardFFTImageFilter<ImageF3> ,
+      itk::VnlThreadedForwardFFTImageFilter<ImageF3> >(SizeOfDimensions[s]) != 0;
+    rval += test_fft_rtc<double,2,
+      itk::VnlForwardFFTImageFilter<ImageD2> ,
+      itk::VnlThreadedForwardFFTImageFilter<ImageD2> >(SizeOfDimensions[s]) != 0;
+    }
+
+  rval += test_fft_direct() != 0;
+
+  if ( rval != 0 )
+    {
+    std::cerr << rval << " tests failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
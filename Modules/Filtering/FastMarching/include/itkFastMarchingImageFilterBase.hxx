@@ -498,8 +498,7 @@ InitializeOutput( OutputImageType* oImage )
   {
   // allocate memory for the output buffer
   oImage->SetBufferedRegion( oImage->GetRequestedRegion() );
-  oImage->Allocate();
-  oImage->FillBuffer( this->m_LargeValue );
+  oImage->AllocateAndFill( this->m_LargeValue );
 
   // cache some buffered region information
   m_BufferedRegion = oImage->GetBufferedRegion();
@@ -523,15 +522,13 @@ InitializeOutput( OutputImageType* oImage )
     m_ConnectedComponentImage->SetSpacing( m_OutputSpacing );
     m_ConnectedComponentImage->SetRegions( m_BufferedRegion );
     m_ConnectedComponentImage->SetDirection( m_OutputDirection );
-    m_ConnectedComponentImage->Allocate();
-    m_ConnectedComponentImage->FillBuffer( 0 );
+    m_ConnectedComponentImage->AllocateAndFill( 0 );
     }
 
   // allocate memory for the PointTypeImage
   m_LabelImage->CopyInformation(oImage);
   m_LabelImage->SetBufferedRegion( m_BufferedRegion );
-  m_LabelImage->Allocate();
-  m_LabelImage->FillBuffer( Traits::Far );
+  m_LabelImage->AllocateAndFill( Traits::Far );
 
   NodeType idx;
   OutputPixelType outputPixel = this->m_LargeValue;
@@ -32,6 +32,8 @@ ComposeImageFilter< TInputImage, TOutputImage >
   int nbOfComponents = NumericTraits<OutputPixelType>::GetLength(p);
   nbOfComponents = std::max( 1, nbOfComponents );  // require at least one input
   this->SetNumberOfRequiredInputs( nbOfComponents );
+  // Every output pixel is composed from the inputs
+  this->AllocateOutputsUninitializedOn();
 }
 
 //----------------------------------------------------------------------------
@@ -52,6 +52,13 @@ namespace itk
  * Manduchi (Bilateral Filtering for Gray and ColorImages. IEEE
  * ICCV. 1998.)
  *
+ * The filter is evaluated exactly by default, at a cost proportional to
+ * the size of the domain kernel for each pixel. The GRID method (see
+ * SetBilateralMethod()) computes an approximation on a downsampled
+ * bilateral grid, whose cost barely depends on the sigmas, as described
+ * by Paris and Durand (A Fast Approximation of the Bilateral Filter
+ * using a Signal Processing Approach. IJCV. 2009.)
+ *
  * \sa GaussianOperator
  * \sa RecursiveGaussianImageFilter
  * \sa DiscreteGaussianImageFilter
@@ -167,6 +174,39 @@ public:
   itkSetMacro(NumberOfRangeGaussianSamples, unsigned long);
   itkGetConstMacro(NumberOfRangeGaussianSamples, unsigned long);
 
+  typedef enum
+  {
+    EXACT = 0,
+    GRID
+  } BilateralMethodType;
+
+  /** Sets how the filter is computed. EXACT, the default, sums the
+   * products of the domain and range Gaussians over the neighborhood of
+   * each pixel. GRID splats the pixels of the input requested region into
+   * a bilateral grid, with one dimension per image dimension plus one for
+   * the intensity, whose cells are about DomainSigma / GridSamplingRate by
+   * RangeSigma / GridSamplingRate. The grid is blurred with separable
+   * Gaussians and the output is interpolated from it at the position and
+   * intensity of each pixel. The cost of GRID grows with the number of
+   * pixels and of cells, but not with the size of the domain kernel, so
+   * it is much faster for large DomainSigma. The results differ a little
+   * from EXACT, mostly at the boundaries of the image, where the grid
+   * ignores the pixels outside of the image instead of repeating the
+   * boundary pixels. Radius and NumberOfRangeGaussianSamples are only used
+   * by EXACT. */
+  itkSetEnumMacro(BilateralMethod, BilateralMethodType);
+  itkGetEnumMacro(BilateralMethod, BilateralMethodType);
+  virtual void SetBilateralMethodToExact();
+  virtual void SetBilateralMethodToGrid();
+
+  /** Set/Get the number of cells of the bilateral grid per domain and
+   * range sigma, which trades the accuracy of the GRID method against its
+   * speed and memory: the number of cells grows with the power
+   * ImageDimension + 1 of the rate. The cells are never smaller than a
+   * pixel. Default is 1. */
+  itkSetMacro(GridSamplingRate, double);
+  itkGetConstMacro(GridSamplingRate, double);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro( OutputHasNumericTraitsCheck,
@@ -189,6 +229,9 @@ protected:
     m_DomainMu = 2.5;  // keep small to keep kernels small
     m_RangeMu = 4.0;   // can be bigger then DomainMu since we only
                        // index into a single table
+    m_BilateralMethod = EXACT;
+    m_GridSamplingRate = 1.0;
+    m_GridRangeMinimum = 0.0;
   }
 
   virtual ~BilateralImageFilter() {}
@@ -202,6 +245,9 @@ protected:
   void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                             ThreadIdType threadId);
 
+  /** Releases the bilateral grid. */
+  void AfterThreadedGenerateData();
+
   /** BilateralImageFilter needs a larger input requested region than
    * the output requested region (larger by the size of the domain
    * Gaussian kernel).  As such, BilateralImageFilter needs to provide
@@ -215,6 +261,24 @@ private:
   BilateralImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);       //purposely not implemented
 
+  itkStaticConstMacro(GridDimension, unsigned int, ImageDimension + 1);
+
+  typedef FixedArray< double, itkGetStaticConstMacro(GridDimension) >        GridArrayType;
+  typedef FixedArray< SizeValueType, itkGetStaticConstMacro(GridDimension) > GridSizeType;
+  typedef typename TInputImage::IndexType                                    InputIndexType;
+
+  /** Computes the bilateral grid of the input requested region for the
+   * GRID method. */
+  void ComputeBilateralGrid();
+
+  /** Interpolates the output of the GRID method from the grid. */
+  void ThreadedGenerateDataWithGrid(const OutputImageRegionType & outputRegionForThread,
+                                    ThreadIdType threadId);
+
+  /** Returns the offset in the grid of the cell below the position of a
+   * pixel, and the fractions of the position past that cell. */
+  SizeValueType GetGridCell(const InputIndexType & index, double value, GridArrayType & fractions) const;
+
   /** The standard deviation of the gaussian blurring kernel in the image
       range. Units are intensity. */
   double m_RangeSigma;
@@ -241,6 +305,19 @@ private:
   double                m_DynamicRange;
   double                m_DynamicRangeUsed;
   std::vector< double > m_RangeGaussianTable;
+
+  /** The GRID method and its bilateral grid, which holds for each cell
+   * the sum of the weighted values followed by the sum of the weights.
+   * The grid spacing is in pixels for the image dimensions and in units
+   * of intensity for the last one. */
+  BilateralMethodType  m_BilateralMethod;
+  double               m_GridSamplingRate;
+  std::vector< float > m_Grid;
+  GridSizeType         m_GridSize;
+  GridSizeType         m_GridStride;
+  GridArrayType        m_GridSpacing;
+  InputIndexType       m_GridOrigin;
+  double               m_GridRangeMinimum;
 };
 } // end namespace itk
 
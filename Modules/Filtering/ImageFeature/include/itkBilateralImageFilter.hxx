@@ -20,6 +20,7 @@
 
 #include "itkBilateralImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkGaussianImageSource.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
@@ -59,7 +60,7 @@ throw( InvalidRequestedRegionError )
   typename TInputImage::SizeType radius;
   unsigned int i;
 
-  if ( m_AutomaticKernelSize )
+  if ( m_AutomaticKernelSize || m_BilateralMethod == Self::GRID )
     {
     for ( i = 0; i < ImageDimension; i++ )
       {
@@ -112,6 +113,12 @@ void
 BilateralImageFilter< TInputImage, TOutputImage >
 ::BeforeThreadedGenerateData()
 {
+  if ( m_BilateralMethod == Self::GRID )
+    {
+    this->ComputeBilateralGrid();
+    return;
+    }
+
   // Build a small image of the N-dimensional Gaussian used for domain filter
   //
   // Gaussian image size will be (2*vcl_ceil(2.5*sigma)+1) x
@@ -235,6 +242,12 @@ BilateralImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
+  if ( m_BilateralMethod == Self::GRID )
+    {
+    this->ThreadedGenerateDataWithGrid(outputRegionForThread, threadId);
+    return;
+    }
+
   typename TInputImage::ConstPointer input = this->GetInput();
   typename TOutputImage::Pointer output = this->GetOutput();
   typename TInputImage::IndexValueType i;
@@ -330,6 +343,234 @@ BilateralImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< class TInputImage, class TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::AfterThreadedGenerateData()
+{
+  std::vector< float >().swap(m_Grid);
+}
+
+template< class TInputImage, class TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::ComputeBilateralGrid()
+{
+  if ( m_GridSamplingRate <= 0.0 )
+    {
+    itkExceptionMacro(<< "GridSamplingRate must be positive, not " << m_GridSamplingRate);
+    }
+  if ( m_RangeSigma <= 0.0 )
+    {
+    itkExceptionMacro(<< "RangeSigma must be positive for the GRID method, not " << m_RangeSigma);
+    }
+
+  const InputImageType *                     inputImage = this->GetInput();
+  const typename InputImageType::RegionType  region = inputImage->GetRequestedRegion();
+  const typename InputImageType::SpacingType inputSpacing = inputImage->GetSpacing();
+
+  // Determine the intensity range of the grid
+  ImageRegionConstIteratorWithIndex< InputImageType > it(inputImage, region);
+  double minimum = 0.0;
+  double maximum = 0.0;
+  it.GoToBegin();
+  if ( !it.IsAtEnd() )
+    {
+    minimum = static_cast< double >( it.Get() );
+    maximum = minimum;
+    }
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    const double value = static_cast< double >( it.Get() );
+    minimum = vnl_math_min(minimum, value);
+    maximum = vnl_math_max(maximum, value);
+    }
+  m_DynamicRange = maximum - minimum;
+  m_DynamicRangeUsed = m_RangeMu * m_RangeSigma;
+
+  // Size the grid so that the positions of all the pixels, and the cells
+  // above them, are inside. The Gaussians that blur the grid are narrowed
+  // to account for the blurring of the linear splatting and interpolation,
+  // whose variance is 1/6 of a cell each.
+  GridArrayType sigmas;
+  GridArrayType mus;
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    const double sigmaInPixels = m_DomainSigma[d] / inputSpacing[d];
+    m_GridSpacing[d] = vnl_math_max(sigmaInPixels / m_GridSamplingRate, 1.0);
+    m_GridSize[d] = static_cast< SizeValueType >( ( region.GetSize(d) - 1 ) / m_GridSpacing[d] ) + 2;
+    sigmas[d] = sigmaInPixels / m_GridSpacing[d];
+    mus[d] = m_DomainMu;
+    }
+  m_GridSpacing[ImageDimension] = m_RangeSigma / m_GridSamplingRate;
+  m_GridSize[ImageDimension] = static_cast< SizeValueType >( m_DynamicRange / m_GridSpacing[ImageDimension] ) + 2;
+  sigmas[ImageDimension] = m_GridSamplingRate;
+  mus[ImageDimension] = m_RangeMu;
+  m_GridOrigin = region.GetIndex();
+  m_GridRangeMinimum = minimum;
+
+  SizeValueType numberOfCells = 1;
+  for ( unsigned int d = 0; d < GridDimension; d++ )
+    {
+    m_GridStride[d] = numberOfCells;
+    numberOfCells *= m_GridSize[d];
+    }
+  m_Grid.assign(2 * numberOfCells, 0.0f);
+
+  // Splat the pixels in the cells around their position
+  const unsigned int numberOfCorners = 1 << GridDimension;
+  GridArrayType      fractions;
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const double        value = static_cast< double >( it.Get() );
+    const SizeValueType cell = this->GetGridCell(it.GetIndex(), value, fractions);
+    for ( unsigned int corner = 0; corner < numberOfCorners; corner++ )
+      {
+      SizeValueType offset = cell;
+      double        weight = 1.0;
+      for ( unsigned int d = 0; d < GridDimension; d++ )
+        {
+        if ( corner & ( 1 << d ) )
+          {
+          offset += m_GridStride[d];
+          weight *= fractions[d];
+          }
+        else
+          {
+          weight *= 1.0 - fractions[d];
+          }
+        }
+      m_Grid[2 * offset] += static_cast< float >( weight * value );
+      m_Grid[2 * offset + 1] += static_cast< float >( weight );
+      }
+    }
+
+  // Blur the grid along each of its dimensions. The cells outside of the
+  // grid are empty.
+  for ( unsigned int d = 0; d < GridDimension; d++ )
+    {
+    const double sigma = vcl_sqrt( vnl_math_max(sigmas[d] * sigmas[d] - 1.0 / 3.0, 0.0) );
+    const int    radius = static_cast< int >( vcl_ceil(mus[d] * sigma) );
+    if ( radius == 0 )
+      {
+      continue;
+      }
+    std::vector< double > kernel(2 * radius + 1);
+    for ( int k = -radius; k <= radius; k++ )
+      {
+      kernel[k + radius] = vcl_exp(-0.5 * k * k / ( sigma * sigma ) );
+      }
+
+    const SizeValueType   size = m_GridSize[d];
+    const SizeValueType   stride = m_GridStride[d];
+    const SizeValueType   numberOfLines = numberOfCells / size;
+    std::vector< double > line(2 * size);
+    for ( SizeValueType l = 0; l < numberOfLines; l++ )
+      {
+      float *lineStart = &m_Grid[2 * ( l % stride + ( l / stride ) * stride * size )];
+      for ( SizeValueType j = 0; j < size; j++ )
+        {
+        line[2 * j] = lineStart[2 * j * stride];
+        line[2 * j + 1] = lineStart[2 * j * stride + 1];
+        }
+      for ( SizeValueType j = 0; j < size; j++ )
+        {
+        const int first = -static_cast< int >( vnl_math_min(j, static_cast< SizeValueType >( radius ) ) );
+        const int last = static_cast< int >( vnl_math_min(size - 1 - j, static_cast< SizeValueType >( radius ) ) );
+        double    sum = 0.0;
+        double    weight = 0.0;
+        for ( int k = first; k <= last; k++ )
+          {
+          sum += kernel[k + radius] * line[2 * ( j + k )];
+          weight += kernel[k + radius] * line[2 * ( j + k ) + 1];
+          }
+        lineStart[2 * j * stride] = static_cast< float >( sum );
+        lineStart[2 * j * stride + 1] = static_cast< float >( weight );
+        }
+      }
+    }
+}
+
+template< class TInputImage, class TOutputImage >
+typename BilateralImageFilter< TInputImage, TOutputImage >::SizeValueType
+BilateralImageFilter< TInputImage, TOutputImage >
+::GetGridCell(const InputIndexType & index, double value, GridArrayType & fractions) const
+{
+  SizeValueType cell = 0;
+  for ( unsigned int d = 0; d < GridDimension; d++ )
+    {
+    const double position = ( d < ImageDimension )
+                            ? ( index[d] - m_GridOrigin[d] ) / m_GridSpacing[d]
+                            : ( value - m_GridRangeMinimum ) / m_GridSpacing[d];
+    // the rounding errors must not move the position out of the grid
+    const SizeValueType below =
+      vnl_math_min(static_cast< SizeValueType >( vnl_math_max(position, 0.0) ), m_GridSize[d] - 2);
+    fractions[d] = vnl_math_min(vnl_math_max(position - below, 0.0), 1.0);
+    cell += below * m_GridStride[d];
+    }
+  return cell;
+}
+
+template< class TInputImage, class TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateDataWithGrid(const OutputImageRegionType & outputRegionForThread,
+                               ThreadIdType threadId)
+{
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+
+  ImageRegionConstIteratorWithIndex< InputImageType > inputIt(this->GetInput(), outputRegionForThread);
+  ImageRegionIterator< OutputImageType >              outputIt(this->GetOutput(), outputRegionForThread);
+
+  // Interpolate the blurred sums linearly at the position of each pixel
+  const unsigned int numberOfCorners = 1 << GridDimension;
+  GridArrayType      fractions;
+  for ( ; !inputIt.IsAtEnd(); ++inputIt, ++outputIt )
+    {
+    const double        value = static_cast< double >( inputIt.Get() );
+    const SizeValueType cell = this->GetGridCell(inputIt.GetIndex(), value, fractions);
+    double              sum = 0.0;
+    double              normFactor = 0.0;
+    for ( unsigned int corner = 0; corner < numberOfCorners; corner++ )
+      {
+      SizeValueType offset = cell;
+      double        weight = 1.0;
+      for ( unsigned int d = 0; d < GridDimension; d++ )
+        {
+        if ( corner & ( 1 << d ) )
+          {
+          offset += m_GridStride[d];
+          weight *= fractions[d];
+          }
+        else
+          {
+          weight *= 1.0 - fractions[d];
+          }
+        }
+      sum += weight * m_Grid[2 * offset];
+      normFactor += weight * m_Grid[2 * offset + 1];
+      }
+    outputIt.Set( static_cast< OutputPixelType >( sum / normFactor ) );
+    progress.CompletedPixel();
+    }
+}
+
+template< class TInputImage, class TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::SetBilateralMethodToExact()
+{
+  this->SetBilateralMethod( Self::EXACT );
+}
+
+template< class TInputImage, class TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::SetBilateralMethodToGrid()
+{
+  this->SetBilateralMethod( Self::GRID );
+}
+
 template< class TInputImage, class TOutputImage >
 void
 BilateralImageFilter< TInputImage, TOutputImage >
@@ -345,6 +586,23 @@ BilateralImageFilter< TInputImage, TOutputImage >
   os << indent << "Amount of dynamic range used: " << m_DynamicRangeUsed << std::endl;
   os << indent << "AutomaticKernelSize: " << m_AutomaticKernelSize << std::endl;
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "BilateralMethod: ";
+  switch ( m_BilateralMethod )
+    {
+    case EXACT:
+      os << "EXACT";
+      break;
+
+    case GRID:
+      os << "GRID";
+      break;
+
+    default:
+      os << "unknown";
+      break;
+    }
+  os << std::endl;
+  os << indent << "GridSamplingRate: " << m_GridSamplingRate << std::endl;
 }
 } // end namespace itk
 
@@ -170,8 +170,7 @@ HoughTransform2DLinesImageFilter< TInputPixelType, TOutputPixelType >
   m_SimplifyAccumulator->SetOrigin( inputImage->GetOrigin() );
   m_SimplifyAccumulator->SetSpacing( inputImage->GetSpacing() );
   m_SimplifyAccumulator->SetDirection( inputImage->GetDirection() );
-  m_SimplifyAccumulator->Allocate();
-  m_SimplifyAccumulator->FillBuffer(0);
+  m_SimplifyAccumulator->AllocateAndFill(0);
 
   Index< 2 > index;
   Index< 2 > maxIndex;
@@ -171,8 +171,7 @@ LaplacianRecursiveGaussianImageFilter< TInputImage, TOutputImage >
   CumulativeImagePointer cumulativeImage = CumulativeImageType::New();
   cumulativeImage->SetRegions( outputImage->GetRequestedRegion() );
   cumulativeImage->CopyInformation( inputImage );
-  cumulativeImage->Allocate();
-  cumulativeImage->FillBuffer(NumericTraits< InternalRealType >::Zero);
+  cumulativeImage->AllocateAndFill(NumericTraits< InternalRealType >::Zero);
 
   m_DerivativeFilter->SetInput(inputImage);
 
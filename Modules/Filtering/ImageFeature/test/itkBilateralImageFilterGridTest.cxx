@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBilateralImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkSimpleFilterWatcher.h"
+
+namespace
+{
+/** Creates a noisy image with a step edge between the intensities 50
+ * and 150 in the middle of the first dimension. */
+template< class TImage >
+typename TImage::Pointer
+CreateStepImage(const typename TImage::SizeType & size, const typename TImage::SpacingType & spacing)
+{
+  typename TImage::Pointer image = TImage::New();
+  typename TImage::RegionType region;
+  region.SetSize(size);
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  unsigned int seed = 1;
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245 + 12345;
+    const int noise = static_cast< int >( ( seed / 65536 ) % 21 ) - 10;
+    const int step = it.GetIndex()[0] < static_cast< long >( size[0] / 2 ) ? 50 : 150;
+    it.Set( static_cast< typename TImage::PixelType >( step + noise ) );
+    }
+  return image;
+}
+
+/** Returns the mean absolute difference between the EXACT and GRID
+ * methods over the given region, away from the image boundaries, where
+ * the GRID method handles the pixels outside of the image differently.
+ * Also checks that the GRID method preserves the step edge. */
+template< class TImage >
+double
+CompareBilateralMethods(const TImage *image, double domainSigma, double rangeSigma,
+                        double samplingRate, const typename TImage::RegionType & compareRegion)
+{
+  typedef itk::BilateralImageFilter< TImage, TImage > FilterType;
+
+  typename FilterType::Pointer exact = FilterType::New();
+  exact->SetInput(image);
+  exact->SetDomainSigma(domainSigma);
+  exact->SetRangeSigma(rangeSigma);
+  exact->Update();
+
+  typename FilterType::Pointer grid = FilterType::New();
+  grid->SetInput(image);
+  grid->SetDomainSigma(domainSigma);
+  grid->SetRangeSigma(rangeSigma);
+  grid->SetBilateralMethodToGrid();
+  grid->SetGridSamplingRate(samplingRate);
+  grid->GetOutput()->SetRequestedRegion(compareRegion);
+  grid->Update();
+
+  const typename TImage::SizeType size = image->GetLargestPossibleRegion().GetSize();
+
+  double                                           difference = 0.0;
+  itk::ImageRegionConstIteratorWithIndex< TImage > exactIt( exact->GetOutput(), compareRegion );
+  itk::ImageRegionConstIterator< TImage >          gridIt( grid->GetOutput(), compareRegion );
+  for ( ; !exactIt.IsAtEnd(); ++exactIt, ++gridIt )
+    {
+    difference += vcl_abs( static_cast< double >( exactIt.Get() ) - static_cast< double >( gridIt.Get() ) );
+
+    const bool   lowSide = exactIt.GetIndex()[0] < static_cast< long >( size[0] / 2 );
+    const double value = static_cast< double >( gridIt.Get() );
+    if ( ( lowSide && value > 60.0 ) || ( !lowSide && value < 140.0 ) )
+      {
+      std::cerr << "The GRID method blurs the edge at " << exactIt.GetIndex() << ": " << value << std::endl;
+      return itk::NumericTraits< double >::max();
+      }
+    }
+  difference /= compareRegion.GetNumberOfPixels();
+  std::cout << "Sampling rate " << samplingRate << ": mean absolute difference " << difference << std::endl;
+  return difference;
+}
+}
+
+int itkBilateralImageFilterGridTest(int, char *[])
+{
+  typedef itk::Image< float, 2 >          ImageType;
+  typedef itk::Image< unsigned short, 3 > Image3DType;
+
+  bool passed = true;
+
+  // 2D, with a noise of standard deviation 6
+  ImageType::SizeType    size = { { 80, 64 } };
+  ImageType::SpacingType spacing;
+  spacing.Fill(1.0);
+  ImageType::Pointer image = CreateStepImage< ImageType >(size, spacing);
+
+  ImageType::RegionType interior;
+  ImageType::IndexType  interiorIndex = { { 10, 10 } };
+  ImageType::SizeType   interiorSize = { { 60, 44 } };
+  interior.SetIndex(interiorIndex);
+  interior.SetSize(interiorSize);
+
+  const double difference1 = CompareBilateralMethods< ImageType >(image, 3.0, 20.0, 1.0, interior);
+  const double difference2 = CompareBilateralMethods< ImageType >(image, 3.0, 20.0, 2.0, interior);
+  if ( difference1 > 0.6 || difference2 > 0.15 || difference2 > difference1 )
+    {
+    std::cerr << "The GRID method is too far from the EXACT one" << std::endl;
+    passed = false;
+    }
+
+  // 3D, with an anisotropic spacing and a requested region which doesn't
+  // hold the whole image
+  Image3DType::SizeType    size3D = { { 30, 24, 16 } };
+  Image3DType::SpacingType spacing3D;
+  spacing3D[0] = 1.0;
+  spacing3D[1] = 1.0;
+  spacing3D[2] = 2.0;
+  Image3DType::Pointer image3D = CreateStepImage< Image3DType >(size3D, spacing3D);
+
+  Image3DType::RegionType interior3D;
+  Image3DType::IndexType  interior3DIndex = { { 6, 6, 4 } };
+  Image3DType::SizeType   interior3DSize = { { 18, 10, 6 } };
+  interior3D.SetIndex(interior3DIndex);
+  interior3D.SetSize(interior3DSize);
+
+  const double difference3D = CompareBilateralMethods< Image3DType >(image3D, 2.0, 25.0, 1.0, interior3D);
+  if ( difference3D > 0.6 )
+    {
+    std::cerr << "The GRID method is too far from the EXACT one in 3D" << std::endl;
+    passed = false;
+    }
+
+  // The sampling rate must be positive
+  typedef itk::BilateralImageFilter< ImageType, ImageType > FilterType;
+  FilterType::Pointer filter = FilterType::New();
+  itk::SimpleFilterWatcher watcher(filter, "filter");
+  filter->SetInput(image);
+  filter->SetBilateralMethodToGrid();
+  filter->SetGridSamplingRate(0.0);
+  bool caught = false;
+  try
+    {
+    filter->Update();
+    }
+  catch ( itk::ExceptionObject & err )
+    {
+    std::cout << "Caught the expected exception: " << err.GetDescription() << std::endl;
+    caught = true;
+    }
+  if ( !caught )
+    {
+    std::cerr << "A GridSamplingRate of 0 should throw an exception" << std::endl;
+    passed = false;
+    }
+  filter->Print(std::cout);
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
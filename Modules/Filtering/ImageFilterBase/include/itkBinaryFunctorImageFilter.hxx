@@ -34,6 +34,8 @@ BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
 {
   this->SetNumberOfRequiredInputs(2);
   this->InPlaceOff();
+  // Every output pixel is set from the functor
+  this->AllocateOutputsUninitializedOn();
 }
 
 /**
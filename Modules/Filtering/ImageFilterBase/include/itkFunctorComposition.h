@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkFunctorComposition_h
+#define __itkFunctorComposition_h
+
+namespace itk
+{
+namespace Functor
+{
+/** \class Composition
+ * \brief Applies a functor to the result of another one.
+ *
+ * Composition< TFirst, TSecond, TOutput > computes
+ * Second( First( A ) ), or Second( First( A, B ) ) when First is a binary
+ * functor, and casts the result to TOutput. The value passed from First
+ * to Second has the return type of First, so the composition gives the
+ * same result as the pipeline of the two corresponding functor filters
+ * whose intermediate image pixel type is that return type.
+ *
+ * A chain of pixel-wise filters (UnaryFunctorImageFilter,
+ * BinaryFunctorImageFilter, NaryFunctorImageFilter) can thus be replaced
+ * by a single filter whose functor is the composition of their functors.
+ * The whole chain is then evaluated for each pixel in one pass over the
+ * images, without intermediate images. For instance, a cast followed by a
+ * shift-scale and a threshold:
+ *
+ * \code
+ * typedef Functor::Cast< short, float >                         CastType;
+ * typedef Functor::IntensityLinearTransform< float, float >     ShiftScaleType;
+ * typedef Functor::BinaryThreshold< float, unsigned char >      ThresholdType;
+ * typedef Functor::Composition< CastType, ShiftScaleType, float >           FirstTwoType;
+ * typedef Functor::Composition< FirstTwoType, ThresholdType, unsigned char > ChainType;
+ *
+ * typedef UnaryFunctorImageFilter< ShortImageType, UCharImageType, ChainType > FilterType;
+ * FilterType::Pointer filter = FilterType::New();
+ * filter->GetFunctor().GetFirst().GetSecond().SetFactor(0.5);
+ * filter->GetFunctor().GetSecond().SetLowerThreshold(100);
+ * \endcode
+ *
+ * The functors composed are accessed with GetFirst() and GetSecond(). As
+ * with GetFunctor(), the filter must be marked as Modified() when they are
+ * changed after the filter has been executed.
+ *
+ * \sa FirstInputComposition
+ * \sa UnaryFunctorImageFilter BinaryFunctorImageFilter NaryFunctorImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+template< class TFirst, class TSecond, class TOutput >
+class Composition
+{
+public:
+  typedef TFirst  FirstFunctorType;
+  typedef TSecond SecondFunctorType;
+
+  Composition() {}
+  Composition(const TFirst & first, const TSecond & second):
+    m_First(first), m_Second(second) {}
+  ~Composition() {}
+
+  TFirst & GetFirst() { return m_First; }
+  const TFirst & GetFirst() const { return m_First; }
+  void SetFirst(const TFirst & first) { m_First = first; }
+
+  TSecond & GetSecond() { return m_Second; }
+  const TSecond & GetSecond() const { return m_Second; }
+  void SetSecond(const TSecond & second) { m_Second = second; }
+
+  bool operator!=(const Composition & other) const
+  {
+    return m_First != other.m_First || m_Second != other.m_Second;
+  }
+
+  bool operator==(const Composition & other) const
+  {
+    return !( *this != other );
+  }
+
+  template< class TInput >
+  inline TOutput operator()(const TInput & A) const
+  {
+    return static_cast< TOutput >( m_Second( m_First(A) ) );
+  }
+
+  template< class TInput1, class TInput2 >
+  inline TOutput operator()(const TInput1 & A, const TInput2 & B) const
+  {
+    return static_cast< TOutput >( m_Second( m_First(A, B) ) );
+  }
+
+private:
+  TFirst  m_First;
+  TSecond m_Second;
+};
+
+/** \class FirstInputComposition
+ * \brief Applies a unary functor to the first argument of a binary one.
+ *
+ * FirstInputComposition< TFirst, TBinary, TOutput > computes
+ * Binary( First( A ), B ) and casts the result to TOutput. It fuses a chain
+ * of pixel-wise filters that ends with a binary one, such as the masking of
+ * a processed image, into a single BinaryFunctorImageFilter:
+ *
+ * \code
+ * typedef Functor::MaskInput< unsigned char, unsigned char > MaskType;
+ * typedef Functor::FirstInputComposition< ChainType, MaskType, unsigned char > FusedType;
+ *
+ * typedef BinaryFunctorImageFilter< ShortImageType, UCharImageType,
+ *                                   UCharImageType, FusedType > FilterType;
+ * \endcode
+ *
+ * \sa Composition
+ * \ingroup ITKImageFilterBase
+ */
+template< class TFirst, class TBinary, class TOutput >
+class FirstInputComposition
+{
+public:
+  typedef TFirst  FirstFunctorType;
+  typedef TBinary BinaryFunctorType;
+
+  FirstInputComposition() {}
+  FirstInputComposition(const TFirst & first, const TBinary & binary):
+    m_First(first), m_Binary(binary) {}
+  ~FirstInputComposition() {}
+
+  TFirst & GetFirst() { return m_First; }
+  const TFirst & GetFirst() const { return m_First; }
+  void SetFirst(const TFirst & first) { m_First = first; }
+
+  TBinary & GetBinary() { return m_Binary; }
+  const TBinary & GetBinary() const { return m_Binary; }
+  void SetBinary(const TBinary & binary) { m_Binary = binary; }
+
+  bool operator!=(const FirstInputComposition & other) const
+  {
+    return m_First != other.m_First || m_Binary != other.m_Binary;
+  }
+
+  bool operator==(const FirstInputComposition & other) const
+  {
+    return !( *this != other );
+  }
+
+  template< class TInput1, class TInput2 >
+  inline TOutput operator()(const TInput1 & A, const TInput2 & B) const
+  {
+    return static_cast< TOutput >( m_Binary(m_First(A), B) );
+  }
+
+private:
+  TFirst  m_First;
+  TBinary m_Binary;
+};
+} // end namespace Functor
+} // end namespace itk
+
+#endif
@@ -108,6 +108,26 @@ MaskNeighborhoodOperatorImageFilter< TInputImage, TMaskImage, TOutputImage, TOpe
     return;
     }
 
+  // A one dimensional operator is applied to whole lines by the
+  // superclass, and the pixels outside of the mask are replaced afterward.
+  unsigned int direction;
+  if ( this->IsOperatorOneDimensional(direction)
+       && this->ThreadedGenerateDataOnLines(outputRegionForThread, threadId, direction) )
+    {
+    ImageRegionIterator< OutputImageType >     oit(output, outputRegionForThread);
+    ImageRegionConstIterator< InputImageType > iit(input, outputRegionForThread);
+    ImageRegionConstIterator< MaskImageType >  mit(mask, outputRegionForThread);
+    for ( ; !oit.IsAtEnd(); ++oit, ++iit, ++mit )
+      {
+      if ( !mit.Get() )
+        {
+        // Use the default value or the input value
+        oit.Value() = m_UseDefaultValue ? m_DefaultValue : iit.Get();
+        }
+      }
+    return;
+    }
+
   // Define the inner product algorithm
   NeighborhoodInnerProduct< InputImageType, OperatorValueType > smartInnerProduct;
   // Break the input into a series of regions.  The first region is free
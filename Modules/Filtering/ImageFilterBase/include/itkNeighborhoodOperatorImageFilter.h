@@ -23,6 +23,8 @@
 #include "itkImage.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 
+#include <vector>
+
 namespace itk
 {
 /** \class NeighborhoodOperatorImageFilter
@@ -35,6 +37,15 @@ namespace itk
  * with the image region.  Apply the mirror()'d operator for
  * non-symmetric NeighborhoodOperators.
  *
+ * When the operator extends along a single dimension, as the operators
+ * of the separable filters like DiscreteGaussianImageFilter do, the
+ * output is computed one line of pixels at a time: each line of the input
+ * is copied once into a contiguous buffer, padded by the boundary
+ * condition, and convolved with the coefficients of the operator in
+ * simple loops which the compiler can vectorize. The inner products are
+ * summed in the same order as in the general case, so both give the same
+ * output.
+ *
  * \ingroup ImageFilters
  *
  * \sa Image
@@ -169,6 +180,18 @@ protected:
   void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                             ThreadIdType threadId);
 
+  /** Returns true if the radius of the operator is zero in all the
+   * dimensions but at most one, which is then returned in direction. */
+  bool IsOperatorOneDimensional(unsigned int & direction) const;
+
+  /** Computes the output of a one dimensional operator along direction,
+   * one line of pixels at a time. Returns false without writing any
+   * output if the input buffered region doesn't hold the part of the
+   * lines inside the input largest possible region. Called by
+   * ThreadedGenerateData(). */
+  bool ThreadedGenerateDataOnLines(const OutputImageRegionType & outputRegionForThread,
+                                   ThreadIdType threadId, unsigned int direction);
+
   void PrintSelf(std::ostream & os, Indent indent) const
   {  Superclass::PrintSelf(os, indent); }
 private:
@@ -184,6 +207,30 @@ private:
 
   /** Default boundary condition */
   DefaultBoundaryCondition m_DefaultBoundaryCondition;
+
+  /** Computes the inner product of the operator with a neighborhood, like
+   * NeighborhoodInnerProduct. */
+  struct InnerProductKernel
+  {
+    typedef typename NumericTraits< InputPixelType >::RealType      InputRealType;
+    typedef typename NumericTraits< InputRealType >::AccumulateType AccumulateRealType;
+    typedef typename NumericTraits< ComputingPixelType >::ValueType CoefficientType;
+
+    template< class TNeighborhood >
+    ComputingPixelType operator()(const TNeighborhood & neighborhood) const
+    {
+      const unsigned int size = static_cast< unsigned int >( m_Coefficients.size() );
+      AccumulateRealType sum = NumericTraits< AccumulateRealType >::Zero;
+      for ( unsigned int i = 0; i < size; ++i )
+        {
+        sum += static_cast< AccumulateRealType >(
+          m_Coefficients[i] * static_cast< InputRealType >( neighborhood.GetPixel(i) ) );
+        }
+      return static_cast< ComputingPixelType >( sum );
+    }
+
+    std::vector< CoefficientType > m_Coefficients;
+  };
 };
 } // end namespace itk
 
@@ -23,6 +23,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkNeighborhoodInnerProduct.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageLinearIteratorWithIndex.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkProgressReporter.h"
 
@@ -84,53 +85,156 @@ NeighborhoodOperatorImageFilter< TInputImage, TOutputImage, TOperatorValueType >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  typedef NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >
-  BFC;
+  unsigned int direction;
+  if ( this->IsOperatorOneDimensional(direction)
+       && this->ThreadedGenerateDataOnLines(outputRegionForThread, threadId, direction) )
+    {
+    return;
+    }
+
+  InnerProductKernel kernel;
+  kernel.m_Coefficients.resize( m_Operator.Size() );
+  for ( unsigned int i = 0; i < m_Operator.Size(); ++i )
+    {
+    kernel.m_Coefficients[i] = static_cast< typename InnerProductKernel::CoefficientType >( m_Operator[i] );
+    }
+
+  // support progress methods/callbacks
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+
+  // The neighborhoods of the non-boundary region are read without bounds
+  // checking, and the boundary faces use the boundary condition. Note, we
+  // pass in the input image and the OUTPUT requested region. We are only
+  // concerned with centering the neighborhood operator at the pixels that
+  // correspond to output pixels.
+  NeighborhoodAlgorithm::ApplyNeighborhoodKernel(this->GetInput(), this->GetOutput(), outputRegionForThread,
+                                                 m_Operator.GetRadius(), m_BoundsCondition, kernel, progress);
+}
 
-  typedef typename BFC::FaceListType FaceListType;
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+bool
+NeighborhoodOperatorImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::IsOperatorOneDimensional(unsigned int & direction) const
+{
+  direction = 0;
+  unsigned int extendedDimensions = 0;
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    if ( m_Operator.GetRadius(i) > 0 )
+      {
+      direction = i;
+      ++extendedDimensions;
+      }
+    }
+  return extendedDimensions <= 1;
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+bool
+NeighborhoodOperatorImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::ThreadedGenerateDataOnLines(const OutputImageRegionType & outputRegionForThread,
+                              ThreadIdType threadId, unsigned int direction)
+{
+  // Same types as NeighborhoodInnerProduct
+  typedef typename NumericTraits< InputPixelType >::RealType           InputPixelRealType;
+  typedef typename NumericTraits< InputPixelRealType >::AccumulateType AccumulateRealType;
+  typedef typename NumericTraits< ComputingPixelType >::ValueType      OperatorRealType;
+  typedef typename InputImageType::RegionType                          InputRegionType;
+  typedef typename InputImageType::IndexType                           InputIndexType;
+
+  OutputImageType *     output = this->GetOutput();
+  const InputImageType *input = this->GetInput();
+
+  const unsigned int   radius = m_Operator.GetRadius(direction);
+  const IndexValueType outputStart = outputRegionForThread.GetIndex(direction);
+  const SizeValueType  lineLength = outputRegionForThread.GetSize(direction);
+  if ( lineLength == 0 || outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return true;
+    }
 
-  NeighborhoodInnerProduct< InputImageType, OperatorValueType, ComputingPixelType > smartInnerProduct;
-  BFC                                                           faceCalculator;
-  FaceListType                                                  faceList;
+  // The part of the lines, padded by the radius of the operator, which is
+  // read from the input buffer. The rest is given by the boundary
+  // condition, which can only be asked for the pixels outside the largest
+  // possible region.
+  InputRegionType inputLinesRegion = outputRegionForThread;
+  inputLinesRegion.SetIndex(direction, outputStart - static_cast< IndexValueType >( radius ));
+  inputLinesRegion.SetSize(direction, lineLength + 2 * radius);
+  InputRegionType largestLinesRegion = inputLinesRegion;
+  if ( !largestLinesRegion.Crop( input->GetLargestPossibleRegion() )
+       || !input->GetBufferedRegion().IsInside(largestLinesRegion) )
+    {
+    return false;
+    }
+  inputLinesRegion = largestLinesRegion;
 
-  // Allocate output
-  OutputImageType *output = this->GetOutput();
+  const SizeValueType before = static_cast< SizeValueType >(
+    inputLinesRegion.GetIndex(direction) - ( outputStart - static_cast< IndexValueType >( radius ) ) );
+  const SizeValueType inside = inputLinesRegion.GetSize(direction);
+  const SizeValueType bufferLength = lineLength + 2 * radius;
 
-  const InputImageType *input   = this->GetInput();
+  const unsigned int              operatorSize = 2 * radius + 1;
+  std::vector< OperatorRealType > coefficients(operatorSize);
+  for ( unsigned int c = 0; c < operatorSize; ++c )
+    {
+    coefficients[c] = static_cast< OperatorRealType >( m_Operator[c] );
+    }
 
-  // Break the input into a series of regions.  The first region is free
-  // of boundary conditions, the rest with boundary conditions. Note,
-  // we pass in the input image and the OUTPUT requested region. We are
-  // only concerned with centering the neighborhood operator at the
-  // pixels that correspond to output pixels.
-  faceList = faceCalculator( input, outputRegionForThread,
-                             m_Operator.GetRadius() );
+  std::vector< InputPixelRealType > line(bufferLength);
+  std::vector< AccumulateRealType > sums(lineLength);
 
-  typename FaceListType::iterator fit;
-  ImageRegionIterator< OutputImageType > it;
+  ImageLinearConstIteratorWithIndex< InputImageType > inputIt(input, inputLinesRegion);
+  ImageLinearIteratorWithIndex< OutputImageType >     outputIt(output, outputRegionForThread);
+  inputIt.SetDirection(direction);
+  outputIt.SetDirection(direction);
 
-  // support progress methods/callbacks
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  // Process non-boundary region and each of the boundary faces.
-  // These are N-d regions which border the edge of the buffer.
-  ConstNeighborhoodIterator< InputImageType > bit;
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
+  for ( inputIt.GoToBegin(), outputIt.GoToBegin(); !outputIt.IsAtEnd();
+        inputIt.NextLine(), outputIt.NextLine() )
     {
-    bit =
-      ConstNeighborhoodIterator< InputImageType >(m_Operator.GetRadius(),
-                                                  input, *fit);
-    bit.OverrideBoundaryCondition(m_BoundsCondition);
-    it = ImageRegionIterator< OutputImageType >(output, *fit);
-    bit.GoToBegin();
-    while ( !bit.IsAtEnd() )
+    // Copy the line, and its neighbors outside of the input buffer
+    InputIndexType index = outputIt.GetIndex();
+    index[direction] = outputStart - static_cast< IndexValueType >( radius );
+    SizeValueType k = 0;
+    for ( ; k < before; ++k, ++index[direction] )
+      {
+      line[k] = static_cast< InputPixelRealType >( m_BoundsCondition->GetPixel(index, input) );
+      }
+    for ( ; k < before + inside; ++k, ++inputIt )
+      {
+      line[k] = static_cast< InputPixelRealType >( inputIt.Get() );
+      }
+    index[direction] = outputStart - static_cast< IndexValueType >( radius )
+                       + static_cast< IndexValueType >( k );
+    for ( ; k < bufferLength; ++k, ++index[direction] )
+      {
+      line[k] = static_cast< InputPixelRealType >( m_BoundsCondition->GetPixel(index, input) );
+      }
+
+    // Add the contributions of each coefficient to the whole line, in the
+    // order of the coefficients
+    for ( k = 0; k < lineLength; ++k )
+      {
+      sums[k] = NumericTraits< AccumulateRealType >::Zero;
+      }
+    for ( unsigned int c = 0; c < operatorSize; ++c )
+      {
+      const OperatorRealType     coefficient = coefficients[c];
+      const InputPixelRealType * source = &line[c];
+      for ( k = 0; k < lineLength; ++k )
+        {
+        sums[k] += static_cast< AccumulateRealType >( coefficient * source[k] );
+        }
+      }
+
+    for ( k = 0; !outputIt.IsAtEndOfLine(); ++outputIt, ++k )
       {
-      it.Value() = static_cast< typename OutputImageType::PixelType >( smartInnerProduct(bit, m_Operator) );
-      ++bit;
-      ++it;
+      outputIt.Set( static_cast< OutputPixelType >( static_cast< ComputingPixelType >( sums[k] ) ) );
       progress.CompletedPixel();
       }
     }
+  return true;
 }
 } // end namespace itk
 
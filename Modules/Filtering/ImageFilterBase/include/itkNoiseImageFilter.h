@@ -106,6 +106,29 @@ protected:
 private:
   NoiseImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);   //purposely not implemented
+
+  /** Computes the standard deviation of a neighborhood. */
+  struct NoiseKernel
+  {
+    template< class TNeighborhood >
+    OutputPixelType operator()(const TNeighborhood & neighborhood) const
+    {
+      const unsigned int  neighborhoodSize = neighborhood.Size();
+      const InputRealType num = static_cast< InputRealType >( neighborhoodSize );
+      InputRealType       sum = NumericTraits< InputRealType >::Zero;
+      InputRealType       sumOfSquares = NumericTraits< InputRealType >::Zero;
+      for ( unsigned int i = 0; i < neighborhoodSize; ++i )
+        {
+        const InputRealType value = static_cast< InputRealType >( neighborhood.GetPixel(i) );
+        sum += value;
+        sumOfSquares += ( value * value );
+        }
+
+      // calculate the standard deviation value
+      const InputRealType var = ( sumOfSquares - ( sum * sum / num ) ) / ( num - 1.0 );
+      return static_cast< OutputPixelType >( vcl_sqrt(var) );
+    }
+  };
 };
 } // end namespace itk
 
@@ -39,66 +39,16 @@ NoiseImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  unsigned int i;
-
   ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
 
-  ConstNeighborhoodIterator< InputImageType > bit;
-  ImageRegionIterator< OutputImageType >      it;
-
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename  InputImageType::ConstPointer input  = this->GetInput();
-
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  faceList = bC( input, outputRegionForThread, this->GetRadius() );
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator fit;
-
   // support progress methods/callbacks
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  InputRealType value;
-  InputRealType sum;
-  InputRealType sumOfSquares;
-  InputRealType var;
-  InputRealType num;
-
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
-    {
-    bit = ConstNeighborhoodIterator< InputImageType >(this->GetRadius(),
-                                                      input, *fit);
-    unsigned int neighborhoodSize = bit.Size();
-    num = static_cast< InputRealType >( bit.Size() );
-
-    it = ImageRegionIterator< OutputImageType >(output, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
-
-    while ( !bit.IsAtEnd() )
-      {
-      sum = NumericTraits< InputRealType >::Zero;
-      sumOfSquares = NumericTraits< InputRealType >::Zero;
-      for ( i = 0; i < neighborhoodSize; ++i )
-        {
-        value = static_cast< InputRealType >( bit.GetPixel(i) );
-        sum += value;
-        sumOfSquares += ( value * value );
-        }
-
-      // calculate the standard deviation value
-      var = ( sumOfSquares - ( sum * sum / num ) ) / ( num - 1.0 );
-      it.Set( static_cast< OutputPixelType >( vcl_sqrt(var) ) );
-
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
-      }
-    }
+  // The neighborhoods of the non-boundary region are read without bounds
+  // checking, and the boundary faces use the boundary condition.
+  NoiseKernel kernel;
+  NeighborhoodAlgorithm::ApplyNeighborhoodKernel(this->GetInput(), this->GetOutput(), outputRegionForThread,
+                                                 this->GetRadius(), &nbc, kernel, progress);
 }
 } // end namespace itk
 
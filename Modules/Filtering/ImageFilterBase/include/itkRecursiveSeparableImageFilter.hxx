@@ -21,8 +21,10 @@
 #include "itkRecursiveSeparableImageFilter.h"
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include <new>
+#include <vector>
 
 namespace itk
 {
@@ -152,6 +154,129 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
     }
 }
 
+/**
+ * Apply Recursive Filter to a block of lines
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::FilterDataArrays(RealType *outs, const RealType *data,
+                   RealType *scratch, unsigned int ln)
+{
+  const unsigned int B = NumberOfLinesPerBlock;
+
+  // local copies of the coefficients, which the compiler can't otherwise
+  // keep in registers since the arrays could alias them
+  const ScalarRealType n0 = m_N0;
+  const ScalarRealType n1 = m_N1;
+  const ScalarRealType n2 = m_N2;
+  const ScalarRealType n3 = m_N3;
+  const ScalarRealType d1 = m_D1;
+  const ScalarRealType d2 = m_D2;
+  const ScalarRealType d3 = m_D3;
+  const ScalarRealType d4 = m_D4;
+  const ScalarRealType m1 = m_M1;
+  const ScalarRealType m2 = m_M2;
+  const ScalarRealType m3 = m_M3;
+  const ScalarRealType m4 = m_M4;
+
+  /**
+   * Causal direction pass, see FilterDataArray()
+   */
+  for ( unsigned int l = 0; l < B; l++ )
+    {
+    const RealType  outV1 = data[l];
+    const RealType *d1st = data + B + l;
+    const RealType *d2nd = d1st + B;
+    const RealType *d3rd = d2nd + B;
+    RealType *      s0th = scratch + l;
+    RealType *      s1st = s0th + B;
+    RealType *      s2nd = s1st + B;
+    RealType *      s3rd = s2nd + B;
+
+    *s0th = RealType(outV1 * n0 + outV1 * n1 + outV1 * n2 + outV1 * n3);
+    *s1st = RealType(*d1st * n0 + outV1 * n1 + outV1 * n2 + outV1 * n3);
+    *s2nd = RealType(*d2nd * n0 + *d1st * n1 + outV1 * n2 + outV1 * n3);
+    *s3rd = RealType(*d3rd * n0 + *d2nd * n1 + *d1st * n2 + outV1 * n3);
+
+    *s0th -= RealType(outV1 * m_BN1 + outV1 * m_BN2 + outV1 * m_BN3 + outV1 * m_BN4);
+    *s1st -= RealType(*s0th * d1    + outV1 * m_BN2 + outV1 * m_BN3 + outV1 * m_BN4);
+    *s2nd -= RealType(*s1st * d1    + *s0th * d2    + outV1 * m_BN3 + outV1 * m_BN4);
+    *s3rd -= RealType(*s2nd * d1    + *s1st * d2    + *s0th * d3    + outV1 * m_BN4);
+    }
+
+  for ( unsigned int i = 4; i < ln; i++ )
+    {
+    const RealType *data0 = data + i * B;
+    const RealType *data1 = data0 - B;
+    const RealType *data2 = data1 - B;
+    const RealType *data3 = data2 - B;
+    RealType *      scratch0 = scratch + i * B;
+    const RealType *scratch1 = scratch0 - B;
+    const RealType *scratch2 = scratch1 - B;
+    const RealType *scratch3 = scratch2 - B;
+    const RealType *scratch4 = scratch3 - B;
+    for ( unsigned int l = 0; l < B; l++ )
+      {
+      scratch0[l]  = RealType(data0[l] * n0 + data1[l] * n1 + data2[l] * n2 + data3[l] * n3);
+      scratch0[l] -= RealType(scratch1[l] * d1 + scratch2[l] * d2 + scratch3[l] * d3 + scratch4[l] * d4);
+      }
+    }
+
+  for ( unsigned int i = 0; i < ln * B; i++ )
+    {
+    outs[i] = scratch[i];
+    }
+
+  /**
+   * AntiCausal direction pass
+   */
+  for ( unsigned int l = 0; l < B; l++ )
+    {
+    const RealType *d1st = data + ( ln - 1 ) * B + l;
+    const RealType *d2nd = d1st - B;
+    const RealType *d3rd = d2nd - B;
+    const RealType  outV2 = *d1st;
+    RealType *      s1st = scratch + ( ln - 1 ) * B + l;
+    RealType *      s2nd = s1st - B;
+    RealType *      s3rd = s2nd - B;
+    RealType *      s4th = s3rd - B;
+
+    *s1st = RealType(outV2 * m1 + outV2 * m2 + outV2 * m3 + outV2 * m4);
+    *s2nd = RealType(*d1st * m1 + outV2 * m2 + outV2 * m3 + outV2 * m4);
+    *s3rd = RealType(*d2nd * m1 + *d1st * m2 + outV2 * m3 + outV2 * m4);
+    *s4th = RealType(*d3rd * m1 + *d2nd * m2 + *d1st * m3 + outV2 * m4);
+
+    *s1st -= RealType(outV2 * m_BM1 + outV2 * m_BM2 + outV2 * m_BM3 + outV2 * m_BM4);
+    *s2nd -= RealType(*s1st * d1    + outV2 * m_BM2 + outV2 * m_BM3 + outV2 * m_BM4);
+    *s3rd -= RealType(*s2nd * d1    + *s1st * d2    + outV2 * m_BM3 + outV2 * m_BM4);
+    *s4th -= RealType(*s3rd * d1    + *s2nd * d2    + *s1st * d3    + outV2 * m_BM4);
+    }
+
+  for ( unsigned int i = ln - 4; i > 0; i-- )
+    {
+    const RealType *data0 = data + i * B;
+    const RealType *data1 = data0 + B;
+    const RealType *data2 = data1 + B;
+    const RealType *data3 = data2 + B;
+    RealType *      scratch0 = scratch + ( i - 1 ) * B;
+    const RealType *scratch1 = scratch0 + B;
+    const RealType *scratch2 = scratch1 + B;
+    const RealType *scratch3 = scratch2 + B;
+    const RealType *scratch4 = scratch3 + B;
+    for ( unsigned int l = 0; l < B; l++ )
+      {
+      scratch0[l]  = RealType(data0[l] * m1 + data1[l] * m2 + data2[l] * m3 + data3[l] * m4);
+      scratch0[l] -= RealType(scratch1[l] * d1 + scratch2[l] * d2 + scratch3[l] * d3 + scratch4[l] * d4);
+      }
+    }
+
+  for ( unsigned int i = 0; i < ln * B; i++ )
+    {
+    outs[i] += scratch[i];
+    }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -285,6 +410,12 @@ void
 RecursiveSeparableImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId)
 {
+  if ( TInputImage::ImageDimension > 1 )
+    {
+    this->ThreadedGenerateDataByBlocks(outputRegionForThread, threadId);
+    return;
+    }
+
   typedef typename TOutputImage::PixelType OutputPixelType;
 
   typedef ImageLinearConstIteratorWithIndex< TInputImage > InputConstIteratorType;
@@ -397,6 +528,158 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
   delete[] scratch;
 }
 
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateDataByBlocks(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId)
+{
+  typedef typename TOutputImage::PixelType          OutputPixelType;
+  typedef typename OutputImageRegionType::IndexType IndexType;
+  typedef typename OutputImageRegionType::SizeType  SizeType;
+  typedef typename IndexType::IndexValueType        IndexValueType;
+
+  const unsigned int ImageDimension = TInputImage::ImageDimension;
+  const unsigned int B = NumberOfLinesPerBlock;
+
+  const TInputImage *inputImage = this->GetInputImage();
+  TOutputImage *     outputImage = this->GetOutput();
+
+  // the lines of a block are neighbors along blockDirection
+  const unsigned int direction = this->m_Direction;
+  const unsigned int blockDirection = ( direction == 0 && ImageDimension > 1 ) ? 1 : 0;
+
+  const IndexType    regionIndex = outputRegionForThread.GetIndex();
+  const SizeType     regionSize = outputRegionForThread.GetSize();
+  const unsigned int ln = regionSize[direction];
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  std::vector< RealType > inps(ln * B);
+  std::vector< RealType > outs(ln * B);
+  std::vector< RealType > scratch(ln * B);
+
+  const SizeValueType numberOfLines = outputRegionForThread.GetNumberOfPixels() / ln;
+  ProgressReporter    progress(this, threadId, numberOfLines, 10);
+
+  // the first line of each block runs through the region with the size of
+  // the blocks along blockDirection and 1 along direction
+  IndexType blockIndex = regionIndex;
+  SizeType  blockSize;
+  blockSize.Fill(1);
+  blockSize[direction] = ln;
+
+  try  // this try is intended to catch an eventual AbortException.
+    {
+    bool done = false;
+    while ( !done )
+      {
+      const unsigned int numberOfLinesInBlock =
+        vnl_math_min( B, static_cast< unsigned int >( regionIndex[blockDirection] + regionSize[blockDirection]
+                                                      - blockIndex[blockDirection] ) );
+      blockSize[blockDirection] = numberOfLinesInBlock;
+      const OutputImageRegionType blockRegion(blockIndex, blockSize);
+
+      // Copy the block to the interleaved array. The region iterators go
+      // along the lowest dimension first, which is blockDirection when
+      // the block is made of rows of the image.
+      ImageRegionConstIterator< TInputImage > inputIterator(inputImage, blockRegion);
+      if ( blockDirection < direction )
+        {
+        for ( unsigned int i = 0; i < ln; i++ )
+          {
+          for ( unsigned int l = 0; l < numberOfLinesInBlock; l++ )
+            {
+            inps[i * B + l] = inputIterator.Get();
+            ++inputIterator;
+            }
+          }
+        }
+      else
+        {
+        for ( unsigned int l = 0; l < numberOfLinesInBlock; l++ )
+          {
+          for ( unsigned int i = 0; i < ln; i++ )
+            {
+            inps[i * B + l] = inputIterator.Get();
+            ++inputIterator;
+            }
+          }
+        }
+      // the missing lines of the last block are filtered, but not stored
+      for ( unsigned int i = 0; i < ln; i++ )
+        {
+        for ( unsigned int l = numberOfLinesInBlock; l < B; l++ )
+          {
+          inps[i * B + l] = inps[i * B];
+          }
+        }
+
+      this->FilterDataArrays(&outs[0], &inps[0], &scratch[0], ln);
+
+      ImageRegionIterator< TOutputImage > outputIterator(outputImage, blockRegion);
+      if ( blockDirection < direction )
+        {
+        for ( unsigned int i = 0; i < ln; i++ )
+          {
+          for ( unsigned int l = 0; l < numberOfLinesInBlock; l++ )
+            {
+            outputIterator.Set( static_cast< OutputPixelType >( outs[i * B + l] ) );
+            ++outputIterator;
+            }
+          }
+        }
+      else
+        {
+        for ( unsigned int l = 0; l < numberOfLinesInBlock; l++ )
+          {
+          for ( unsigned int i = 0; i < ln; i++ )
+            {
+            outputIterator.Set( static_cast< OutputPixelType >( outs[i * B + l] ) );
+            ++outputIterator;
+            }
+          }
+        }
+
+      for ( unsigned int l = 0; l < numberOfLinesInBlock; l++ )
+        {
+        progress.CompletedPixel();
+        }
+
+      // Move to the next block: along blockDirection first, then along the
+      // other dimensions but direction.
+      blockIndex[blockDirection] += numberOfLinesInBlock;
+      unsigned int d = blockDirection;
+      while ( blockIndex[d] >= regionIndex[d] + static_cast< IndexValueType >( regionSize[d] ) )
+        {
+        blockIndex[d] = regionIndex[d];
+        do
+          {
+          ++d;
+          }
+        while ( d == direction );
+        if ( d >= ImageDimension )
+          {
+          done = true;
+          break;
+          }
+        ++blockIndex[d];
+        }
+      }
+    }
+  catch ( ProcessAborted  & )
+    {
+    // User aborted filter excecution Here we catch an exception thrown by the
+    // progress reporter and rethrow it with the correct line number and file
+    // name.
+    ProcessAborted e(__FILE__, __LINE__);
+    e.SetDescription("Process aborted.");
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+    }
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 RecursiveSeparableImageFilter< TInputImage, TOutputImage >
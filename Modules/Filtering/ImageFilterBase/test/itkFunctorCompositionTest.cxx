@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFunctorComposition.h"
+#include "itkCastImageFilter.h"
+#include "itkBinaryFunctorImageFilter.h"
+#include "itkRescaleIntensityImageFilter.h"
+#include "itkMaskImageFilter.h"
+#include "itkImageRegionIterator.h"
+
+namespace
+{
+/** Thresholds its input: 255 when it is at least the threshold, 0
+ * otherwise. */
+class Threshold
+{
+public:
+  Threshold():m_Threshold(0) {}
+  void SetThreshold(float threshold) { m_Threshold = threshold; }
+  bool operator!=(const Threshold & other) const
+  {
+    return m_Threshold != other.m_Threshold;
+  }
+
+  bool operator==(const Threshold & other) const
+  {
+    return !( *this != other );
+  }
+
+  inline unsigned char operator()(const float & x) const
+  {
+    return x >= m_Threshold ? 255 : 0;
+  }
+
+private:
+  float m_Threshold;
+};
+}
+
+int itkFunctorCompositionTest(int, char *[])
+{
+  typedef itk::Image< short, 2 >         ShortImageType;
+  typedef itk::Image< float, 2 >         FloatImageType;
+  typedef itk::Image< unsigned char, 2 > UCharImageType;
+
+  typedef itk::Functor::Cast< short, float >                         CastType;
+  typedef itk::Functor::IntensityLinearTransform< float, float >     ShiftScaleType;
+  typedef itk::Functor::MaskInput< unsigned char, unsigned char >    MaskType;
+  typedef itk::Functor::Composition< CastType, ShiftScaleType, float >       CastShiftScaleType;
+  typedef itk::Functor::Composition< CastShiftScaleType, Threshold, unsigned char >
+                                                                             ChainType;
+  typedef itk::Functor::FirstInputComposition< ChainType, MaskType, unsigned char >
+                                                                             FusedType;
+
+  ShortImageType::RegionType region;
+  ShortImageType::SizeType   size = { { 67, 43 } };
+  region.SetSize(size);
+
+  ShortImageType::Pointer input = ShortImageType::New();
+  input->SetRegions(region);
+  input->Allocate();
+  UCharImageType::Pointer mask = UCharImageType::New();
+  mask->SetRegions(region);
+  mask->Allocate();
+
+  itk::ImageRegionIterator< ShortImageType > inputIt(input, region);
+  itk::ImageRegionIterator< UCharImageType > maskIt(mask, region);
+  short value = -1000;
+  for ( inputIt.GoToBegin(), maskIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt, ++maskIt )
+    {
+    inputIt.Set(value);
+    maskIt.Set(value % 3 != 0);
+    value = static_cast< short >( ( value * 37 + 11 ) % 2000 );
+    }
+
+  // The chain of filters
+  typedef itk::UnaryFunctorImageFilter< ShortImageType, FloatImageType, CastType >       CastFilterType;
+  typedef itk::UnaryFunctorImageFilter< FloatImageType, FloatImageType, ShiftScaleType > ShiftScaleFilterType;
+  typedef itk::UnaryFunctorImageFilter< FloatImageType, UCharImageType, Threshold >      ThresholdFilterType;
+  typedef itk::BinaryFunctorImageFilter< UCharImageType, UCharImageType, UCharImageType, MaskType >
+                                                                                         MaskFilterType;
+
+  CastFilterType::Pointer cast = CastFilterType::New();
+  cast->SetInput(input);
+  ShiftScaleFilterType::Pointer shiftScale = ShiftScaleFilterType::New();
+  shiftScale->SetInput( cast->GetOutput() );
+  shiftScale->GetFunctor().SetFactor(0.5);
+  shiftScale->GetFunctor().SetOffset(20.0);
+  ThresholdFilterType::Pointer threshold = ThresholdFilterType::New();
+  threshold->SetInput( shiftScale->GetOutput() );
+  threshold->GetFunctor().SetThreshold(100.0f);
+  MaskFilterType::Pointer masker = MaskFilterType::New();
+  masker->SetInput1( threshold->GetOutput() );
+  masker->SetInput2(mask);
+  masker->GetFunctor().SetOutsideValue(7);
+  masker->Update();
+
+  // The same chain, fused in a single filter
+  typedef itk::UnaryFunctorImageFilter< ShortImageType, UCharImageType, ChainType > ChainFilterType;
+  typedef itk::BinaryFunctorImageFilter< ShortImageType, UCharImageType, UCharImageType, FusedType >
+                                                                                    FusedFilterType;
+
+  ChainFilterType::Pointer chain = ChainFilterType::New();
+  chain->SetInput(input);
+  chain->GetFunctor().GetFirst().GetSecond().SetFactor(0.5);
+  chain->GetFunctor().GetFirst().GetSecond().SetOffset(20.0);
+  chain->GetFunctor().GetSecond().SetThreshold(100.0f);
+  chain->Update();
+
+  FusedType fusedFunctor;
+  fusedFunctor.SetFirst( chain->GetFunctor() );
+  fusedFunctor.GetBinary().SetOutsideValue(7);
+  if ( fusedFunctor.GetFirst() != chain->GetFunctor() || fusedFunctor == FusedType() )
+    {
+    std::cerr << "Wrong comparison of the compositions" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  FusedFilterType::Pointer fused = FusedFilterType::New();
+  fused->SetInput1(input);
+  fused->SetInput2(mask);
+  fused->SetFunctor(fusedFunctor);
+  fused->Update();
+
+  itk::ImageRegionConstIterator< UCharImageType > expectedIt(masker->GetOutput(), region);
+  itk::ImageRegionConstIterator< UCharImageType > thresholdIt(threshold->GetOutput(), region);
+  itk::ImageRegionConstIterator< UCharImageType > chainIt(chain->GetOutput(), region);
+  itk::ImageRegionConstIterator< UCharImageType > fusedIt(fused->GetOutput(), region);
+  unsigned int numberOfOutsideValues = 0;
+  for ( ; !expectedIt.IsAtEnd(); ++expectedIt, ++thresholdIt, ++chainIt, ++fusedIt )
+    {
+    if ( chainIt.Get() != thresholdIt.Get() || fusedIt.Get() != expectedIt.Get() )
+      {
+      std::cerr << "The fused filter differs from the chain of filters at "
+                << expectedIt.GetIndex() << ": "
+                << static_cast< int >( fusedIt.Get() ) << " instead of "
+                << static_cast< int >( expectedIt.Get() ) << std::endl;
+      return EXIT_FAILURE;
+      }
+    numberOfOutsideValues += ( expectedIt.Get() == 7 );
+    }
+  if ( numberOfOutsideValues == 0 )
+    {
+    std::cerr << "The mask was not applied" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
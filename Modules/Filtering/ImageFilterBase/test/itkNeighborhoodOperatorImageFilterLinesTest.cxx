@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMaskNeighborhoodOperatorImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+/**
+ * The one dimensional operators are applied one line of pixels at a time.
+ * This test compares their output with the output of the same operators
+ * padded by a row of zeros in another dimension, which are applied pixel
+ * by pixel.
+ */
+namespace
+{
+typedef itk::Image< short, 3 >                           InputImageType;
+typedef itk::Image< float, 3 >                           OutputImageType;
+typedef itk::Image< unsigned char, 3 >                   MaskImageType;
+typedef itk::Neighborhood< float, 3 >                    OperatorType;
+typedef itk::ConstantBoundaryCondition< InputImageType > ConstantBoundaryConditionType;
+
+bool
+CompareOutputs(const OutputImageType *lines, const OutputImageType *pixels,
+               const OutputImageType::RegionType & region, const char *name)
+{
+  itk::ImageRegionConstIteratorWithIndex< OutputImageType > linesIt(lines, region);
+  itk::ImageRegionConstIterator< OutputImageType >          pixelsIt(pixels, region);
+  for ( ; !linesIt.IsAtEnd(); ++linesIt, ++pixelsIt )
+    {
+    if ( linesIt.Get() != pixelsIt.Get() )
+      {
+      std::cerr << name << ": the value at " << linesIt.GetIndex() << " is " << linesIt.Get()
+                << " instead of " << pixelsIt.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template< class TFilter >
+typename OutputImageType::Pointer
+ApplyOperator(TFilter *filter, const InputImageType *image, const OperatorType & op,
+              const OutputImageType::RegionType & requestedRegion,
+              itk::ImageBoundaryCondition< InputImageType > *boundaryCondition)
+{
+  filter->SetInput(image);
+  filter->SetOperator(op);
+  if ( boundaryCondition )
+    {
+    filter->OverrideBoundaryCondition(boundaryCondition);
+    }
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+bool
+CompareWithPixels(const InputImageType *image, const MaskImageType *mask, bool useDefaultValue,
+                  unsigned int direction, unsigned int radius, const OutputImageType::RegionType & requestedRegion,
+                  bool constantBoundary, const char *name)
+{
+  typedef itk::NeighborhoodOperatorImageFilter< InputImageType, OutputImageType, float > FilterType;
+  typedef itk::MaskNeighborhoodOperatorImageFilter< InputImageType, MaskImageType, OutputImageType, float >
+  MaskFilterType;
+
+  // Asymmetric coefficients, to check their order
+  OperatorType           op;
+  OperatorType::SizeType opRadius;
+  opRadius.Fill(0);
+  opRadius[direction] = radius;
+  op.SetRadius(opRadius);
+  for ( unsigned int c = 0; c < op.Size(); c++ )
+    {
+    op[c] = 0.1f * ( c + 1 ) - 0.03f * c * c;
+    }
+
+  // The same coefficients in the middle row of an operator which extends
+  // along another dimension
+  OperatorType           paddedOp;
+  OperatorType::SizeType paddedRadius = opRadius;
+  paddedRadius[( direction + 1 ) % 3] = 1;
+  paddedOp.SetRadius(paddedRadius);
+  for ( unsigned int i = 0; i < paddedOp.Size(); i++ )
+    {
+    paddedOp[i] = 0.0f;
+    }
+  for ( unsigned int c = 0; c < op.Size(); c++ )
+    {
+    OperatorType::OffsetType offset;
+    offset.Fill(0);
+    offset[direction] = static_cast< itk::OffsetValueType >( c ) - static_cast< itk::OffsetValueType >( radius );
+    paddedOp[offset] = op[c];
+    }
+
+  ConstantBoundaryConditionType constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(-7);
+  ConstantBoundaryConditionType *boundaryCondition = constantBoundary ? &constantBoundaryCondition : 0;
+
+  OutputImageType::Pointer lines;
+  OutputImageType::Pointer pixels;
+  if ( mask )
+    {
+    MaskFilterType::Pointer linesFilter = MaskFilterType::New();
+    linesFilter->SetMaskImage(mask);
+    linesFilter->SetDefaultValue(-1.0f);
+    linesFilter->SetUseDefaultValue(useDefaultValue);
+    lines = ApplyOperator(linesFilter.GetPointer(), image, op, requestedRegion, boundaryCondition);
+    MaskFilterType::Pointer pixelsFilter = MaskFilterType::New();
+    pixelsFilter->SetMaskImage(mask);
+    pixelsFilter->SetDefaultValue(-1.0f);
+    pixelsFilter->SetUseDefaultValue(useDefaultValue);
+    pixels = ApplyOperator(pixelsFilter.GetPointer(), image, paddedOp, requestedRegion, boundaryCondition);
+    }
+  else
+    {
+    FilterType::Pointer linesFilter = FilterType::New();
+    lines = ApplyOperator(linesFilter.GetPointer(), image, op, requestedRegion, boundaryCondition);
+    FilterType::Pointer pixelsFilter = FilterType::New();
+    pixels = ApplyOperator(pixelsFilter.GetPointer(), image, paddedOp, requestedRegion, boundaryCondition);
+    }
+
+  if ( !CompareOutputs(lines, pixels, requestedRegion, name) )
+    {
+    std::cerr << "  in direction " << direction << " with a radius of " << radius << std::endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int itkNeighborhoodOperatorImageFilterLinesTest(int, char *[])
+{
+  InputImageType::Pointer    image = InputImageType::New();
+  InputImageType::RegionType region;
+  InputImageType::IndexType  regionIndex = { { -3, 2, 1 } };
+  InputImageType::SizeType   regionSize = { { 23, 17, 12 } };
+  region.SetIndex(regionIndex);
+  region.SetSize(regionSize);
+  image->SetRegions(region);
+  image->Allocate();
+
+  MaskImageType::Pointer mask = MaskImageType::New();
+  mask->SetRegions(region);
+  mask->Allocate();
+
+  unsigned int                                        seed = 1;
+  itk::ImageRegionIteratorWithIndex< InputImageType > it(image, region);
+  itk::ImageRegionIterator< MaskImageType >           mit(mask, region);
+  for ( ; !it.IsAtEnd(); ++it, ++mit )
+    {
+    seed = seed * 1103515245 + 12345;
+    it.Set( static_cast< short >( ( seed / 65536 ) % 1000 ) - 300 + 20 * it.GetIndex()[1] );
+    mit.Set( ( seed / 65536 ) % 3 != 0 ? 1 : 0 );
+    }
+
+  OutputImageType::RegionType subRegion;
+  OutputImageType::IndexType  subRegionIndex = { { 0, 5, 3 } };
+  OutputImageType::SizeType   subRegionSize = { { 11, 9, 6 } };
+  subRegion.SetIndex(subRegionIndex);
+  subRegion.SetSize(subRegionSize);
+
+  bool passed = true;
+  for ( unsigned int direction = 0; direction < 3; direction++ )
+    {
+    passed &= CompareWithPixels(image, 0, false, direction, 2, region, false, "zero flux");
+    passed &= CompareWithPixels(image, 0, false, direction, 4, region, true, "constant");
+    passed &= CompareWithPixels(image, 0, false, direction, 3, subRegion, false, "sub region");
+    passed &= CompareWithPixels(image, 0, false, direction, 3, subRegion, true, "constant sub region");
+    // a radius larger than half of the image
+    passed &= CompareWithPixels(image, 0, false, direction, 8, region, false, "large radius");
+    passed &= CompareWithPixels(image, mask, true, direction, 3, region, false, "mask");
+    passed &= CompareWithPixels(image, mask, false, direction, 2, subRegion, true, "mask of a sub region");
+    }
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,8 @@
 #include "itkImageToImageFilter.h"
 #include "itkCovariantVector.h"
 
+#include <vector>
+
 namespace itk
 {
 /** \class GradientImageFilter
@@ -164,6 +166,48 @@ private:
   // flag to take or not the image direction into account
   // when computing the derivatives.
   bool m_UseImageDirection;
+
+  /** Computes the gradient at the center of a neighborhood, as the inner
+   * products of the derivative operators with the slices of the
+   * neighborhood along each dimension, like NeighborhoodInnerProduct. */
+  struct GradientKernel
+  {
+    typedef typename NumericTraits< InputPixelType >::RealType      InputRealType;
+    typedef typename NumericTraits< InputRealType >::AccumulateType AccumulateRealType;
+    typedef typename NumericTraits< OutputValueType >::ValueType    CoefficientType;
+
+    template< class TNeighborhood >
+    OutputPixelType operator()(const TNeighborhood & neighborhood) const
+    {
+      const unsigned int center = neighborhood.Size() / 2;
+      OutputPixelType    gradient;
+      for ( unsigned int i = 0; i < InputImageDimension; ++i )
+        {
+        const unsigned int stride = neighborhood.GetStride(i);
+        const unsigned int size = m_Coefficients[i].size();
+        unsigned int       n = center - stride * ( size / 2 );
+        AccumulateRealType sum = NumericTraits< AccumulateRealType >::Zero;
+        for ( unsigned int k = 0; k < size; ++k, n += stride )
+          {
+          sum += static_cast< AccumulateRealType >(
+            m_Coefficients[i][k] * static_cast< InputRealType >( neighborhood.GetPixel(n) ) );
+          }
+        gradient[i] = static_cast< OutputValueType >( sum );
+        }
+
+      if ( m_UseImageDirection )
+        {
+        OutputPixelType physicalGradient;
+        m_InputImage->TransformLocalVectorToPhysicalVector(gradient, physicalGradient);
+        return physicalGradient;
+        }
+      return gradient;
+    }
+
+    std::vector< CoefficientType > m_Coefficients[InputImageDimension];
+    const InputImageType *         m_InputImage;
+    bool                           m_UseImageDirection;
+  };
 };
 } // end namespace itk
 
@@ -38,6 +38,8 @@ GradientImageFilter< TInputImage, TOperatorValueType, TOutputValueType >
 {
   this->m_UseImageSpacing   = true;
   this->m_UseImageDirection = true;
+  // The kernel is applied to every output pixel, boundary faces included
+  this->AllocateOutputsUninitializedOn();
 }
 
 //
@@ -111,17 +113,10 @@ GradientImageFilter< TInputImage, TOperatorValueType, TOutputValueType >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  unsigned int    i;
-  OutputPixelType gradient;
+  unsigned int i;
 
   ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
 
-  ConstNeighborhoodIterator< InputImageType > nit;
-  ImageRegionIterator< OutputImageType >      it;
-
-  NeighborhoodInnerProduct< InputImageType, OperatorValueType,
-                            OutputValueType > SIP;
-
   // Get the input and output
   OutputImageType *     outputImage = this->GetOutput();
   const InputImageType *inputImage  = this->GetInput();
@@ -160,58 +155,25 @@ GradientImageFilter< TInputImage, TOperatorValueType, TOutputValueType >
     radius[i]  = op[0].GetRadius()[0];
     }
 
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  faceList = bC(inputImage, outputRegionForThread, radius);
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator fit;
-  fit = faceList.begin();
-
-  // support progress methods/callbacks
-  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
-
-  // Initialize the x_slice array
-  nit = ConstNeighborhoodIterator< InputImageType >(radius, inputImage, *fit);
-
-  std::slice          x_slice[InputImageDimension];
-  const SizeValueType center = nit.Size() / 2;
+  GradientKernel kernel;
+  kernel.m_InputImage = inputImage;
+  kernel.m_UseImageDirection = m_UseImageDirection;
   for ( i = 0; i < InputImageDimension; ++i )
     {
-    x_slice[i] = std::slice( center - nit.GetStride(i) * radius[i],
-                             op[i].GetSize()[0], nit.GetStride(i) );
-    }
-
-  // Process non-boundary face and then each of the boundary faces.
-  // These are N-d regions which border the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
-    {
-    nit = ConstNeighborhoodIterator< InputImageType >(radius,
-                                                      inputImage, *fit);
-    it = ImageRegionIterator< OutputImageType >(outputImage, *fit);
-    nit.OverrideBoundaryCondition(&nbc);
-    nit.GoToBegin();
-
-    while ( !nit.IsAtEnd() )
+    kernel.m_Coefficients[i].resize( op[i].GetSize()[0] );
+    for ( unsigned int k = 0; k < op[i].GetSize()[0]; ++k )
       {
-      for ( i = 0; i < InputImageDimension; ++i )
-        {
-        gradient[i] = SIP(x_slice[i], nit, op[i]);
-        }
-
-      if ( this->m_UseImageDirection )
-        {
-        inputImage->TransformLocalVectorToPhysicalVector( gradient, it.Value() );
-        }
-      else
-        {
-        it.Value() = gradient;
-        }
-      ++nit;
-      ++it;
-      progress.CompletedPixel();
+      kernel.m_Coefficients[i][k] = static_cast< typename GradientKernel::CoefficientType >( op[i][k] );
       }
     }
+
+  // support progress methods/callbacks
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+
+  // The neighborhoods of the non-boundary region are read without bounds
+  // checking, and the boundary faces use the boundary condition.
+  NeighborhoodAlgorithm::ApplyNeighborhoodKernel(inputImage, outputImage, outputRegionForThread,
+                                                 radius, &nbc, kernel, progress);
 }
 
 /**
@@ -209,8 +209,7 @@ GradientMagnitudeRecursiveGaussianImageFilter< TInputImage, TOutputImage >
 
   typename CumulativeImageType::Pointer cumulativeImage = CumulativeImageType::New();
   cumulativeImage->SetRegions( inputImage->GetBufferedRegion() );
-  cumulativeImage->Allocate();
-  cumulativeImage->FillBuffer(NumericTraits< InternalRealType >::Zero);
+  cumulativeImage->AllocateAndFill(NumericTraits< InternalRealType >::Zero);
   // The output's information must match the input's information
   cumulativeImage->CopyInformation( this->GetInput() );
 
@@ -565,8 +565,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
     }
   RealImagePointer neighborhoodWeightImage = RealImageType::New();
   neighborhoodWeightImage->SetRegions( size );
-  neighborhoodWeightImage->Allocate();
-  neighborhoodWeightImage->FillBuffer( 0.0 );
+  neighborhoodWeightImage->AllocateAndFill( 0.0 );
 
   ImageRegionIteratorWithIndex<RealImageType> ItW(
     neighborhoodWeightImage, neighborhoodWeightImage->GetRequestedRegion() );
@@ -840,8 +839,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
       }
     this->m_PhiLattice = PointDataImageType::New();
     this->m_PhiLattice->SetRegions( size );
-    this->m_PhiLattice->Allocate();
-    this->m_PhiLattice->FillBuffer( 0.0 );
+    this->m_PhiLattice->AllocateAndFill( 0.0 );
 
     ImageRegionIterator<PointDataImageType> ItP(
       this->m_PhiLattice, this->m_PhiLattice->GetLargestPossibleRegion() );
@@ -315,6 +315,13 @@ protected:
                                   outputRegionForThread,
                                   ThreadIdType threadId);
 
+  /** Compute the continuous index in the input image of the output pixel
+   * at the given index. */
+  void MapIndexToInputContinuousIndex(const OutputImageType *outputPtr,
+                                      const InputImageType *inputPtr,
+                                      const IndexType & index,
+                                      ContinuousInputIndexType & inputIndex) const;
+
 private:
   ResampleImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);      //purposely not implemented
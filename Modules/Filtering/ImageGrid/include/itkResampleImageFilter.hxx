@@ -25,6 +25,8 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageLinearIteratorWithIndex.h"
 #include "itkSpecialCoordinatesImage.h"
+#include "itkMath.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -58,6 +60,10 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   m_Extrapolator = NULL;
 
   m_DefaultPixelValue = 0;
+
+  // Every output pixel is interpolated, extrapolated or set to the default
+  // value
+  this->AllocateOutputsUninitializedOn();
 }
 
 /**
@@ -260,14 +266,21 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   // Get ths input pointers
   InputImageConstPointer inputPtr = this->GetInput();
 
-  // Create an iterator that will walk the output region for this thread.
-  typedef ImageRegionIteratorWithIndex< TOutputImage > OutputIterator;
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  // Create an iterator that will walk the output region for this thread
+  // line by line.
+  typedef ImageLinearIteratorWithIndex< TOutputImage > OutputIterator;
   OutputIterator outIt(outputPtr, outputRegionForThread);
+  outIt.SetDirection(0);
 
-  // Define a few indices that will be used to translate from an input pixel
-  // to an output pixel
-  PointType outputPoint;         // Coordinates of current output pixel
-  PointType inputPoint;          // Coordinates of current input pixel
+  // The points of a line, which are mapped in place from the output image
+  // to the input image by a single call to the transform
+  const SizeValueType      lineLength = outputRegionForThread.GetSize(0);
+  std::vector< PointType > points(lineLength);
 
   ContinuousInputIndexType inputIndex;
 
@@ -290,51 +303,35 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
 
   while ( !outIt.IsAtEnd() )
     {
-    // Determine the index of the current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
-
-    // Compute corresponding input pixel position
-    inputPoint = this->m_Transform->TransformPoint(outputPoint);
-    inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
-
-    PixelType        pixval;
-    OutputType       value;
-    // Evaluate input at right position and copy to the output
-    if ( m_Interpolator->IsInsideBuffer(inputIndex) )
+    // Determine the positions of the output pixels of the line
+    IndexType index = outIt.GetIndex();
+    for ( SizeValueType i = 0; i < lineLength; i++ )
       {
-      if ( m_InterpolatorIsBSpline )
-        {
-        value = m_BSplineInterpolator
-                 ->EvaluateAtContinuousIndex(inputIndex, threadId);
-        }
-      else
-        {
-        value = m_Interpolator ->EvaluateAtContinuousIndex(inputIndex);
-        }
-      // Check boundaries and assign
-      if ( value < minOutputValue )
-        {
-        pixval = minValue;
-        }
-      else if ( value > maxOutputValue )
-        {
-        pixval = maxValue;
-        }
-      else
-        {
-        pixval = static_cast< PixelType >( value );
-        }
-      outIt.Set(pixval);
+      outputPtr->TransformIndexToPhysicalPoint(index, points[i]);
+      ++index[0];
       }
-    else
+
+    // Compute corresponding input pixel positions
+    this->m_Transform->TransformPoints(&points[0], &points[0], lineLength);
+
+    for ( SizeValueType i = 0; i < lineLength; i++ )
       {
-      if( m_Extrapolator.IsNull() )
-        {
-        outIt.Set( m_DefaultPixelValue ); // default background value
-        }
-      else
+      inputPtr->TransformPhysicalPointToContinuousIndex(points[i], inputIndex);
+
+      PixelType        pixval;
+      OutputType       value;
+      // Evaluate input at right position and copy to the output
+      if ( m_Interpolator->IsInsideBuffer(inputIndex) )
         {
-        value = m_Extrapolator->EvaluateAtContinuousIndex( inputIndex );
+        if ( m_InterpolatorIsBSpline )
+          {
+          value = m_BSplineInterpolator
+                   ->EvaluateAtContinuousIndex(inputIndex, threadId);
+          }
+        else
+          {
+          value = m_Interpolator ->EvaluateAtContinuousIndex(inputIndex);
+          }
         // Check boundaries and assign
         if ( value < minOutputValue )
           {
@@ -350,10 +347,36 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
           }
         outIt.Set(pixval);
         }
-      }
+      else
+        {
+        if( m_Extrapolator.IsNull() )
+          {
+          outIt.Set( m_DefaultPixelValue ); // default background value
+          }
+        else
+          {
+          value = m_Extrapolator->EvaluateAtContinuousIndex( inputIndex );
+          // Check boundaries and assign
+          if ( value < minOutputValue )
+            {
+            pixval = minValue;
+            }
+          else if ( value > maxOutputValue )
+            {
+            pixval = maxValue;
+            }
+          else
+            {
+            pixval = static_cast< PixelType >( value );
+            }
+          outIt.Set(pixval);
+          }
+        }
 
-    progress.CompletedPixel();
-    ++outIt;
+      progress.CompletedPixel();
+      ++outIt;
+      }
+    outIt.NextLine();
     }
 
   return;
@@ -374,30 +397,20 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   // Get the output pointers
   OutputImagePointer outputPtr = this->GetOutput();
 
-  // Get ths input pointers
+  // Get the input pointers
   InputImageConstPointer inputPtr = this->GetInput();
 
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
   // Create an iterator that will walk the output region for this thread.
   typedef ImageLinearIteratorWithIndex< TOutputImage > OutputIterator;
 
   OutputIterator outIt(outputPtr, outputRegionForThread);
   outIt.SetDirection(0);
 
-  // Define a few indices that will be used to translate from an input pixel
-  // to an output pixel
-  PointType outputPoint;         // Coordinates of current output pixel
-  PointType inputPoint;          // Coordinates of current input pixel
-  PointType tmpOutputPoint;
-  PointType tmpInputPoint;
-
-  ContinuousInputIndexType inputIndex;
-  ContinuousInputIndexType tmpInputIndex;
-
-  typedef typename PointType::VectorType VectorType;
-  VectorType delta;          // delta in input continuous index coordinate frame
-
-  IndexType  index;
-
   // Support for progress methods/callbacks
   ProgressReporter progress( this,
                              threadId,
@@ -416,113 +429,111 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   const OutputType minOutputValue = static_cast< OutputType >( minValue );
   const OutputType maxOutputValue = static_cast< OutputType >( maxValue );
 
-  // Determine the position of the first pixel in the scanline
-  index = outIt.GetIndex();
-  outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+  // With a linear transform, the continuous index in the input image is an
+  // affine function of the index of the output pixel, which takes into
+  // account the transform and the geometries of both images. Find it once
+  // for the region, by mapping its first pixel and the pixels next to it
+  // along each dimension. As we walk across a scan line in the output
+  // image, we then trace a line in the input image by adding the delta
+  // along the first dimension.
+  typedef typename ContinuousInputIndexType::VectorType VectorType;
+  const IndexType          firstIndex = outputRegionForThread.GetIndex();
+  ContinuousInputIndexType firstInputIndex;
+  this->MapIndexToInputContinuousIndex(outputPtr.GetPointer(), inputPtr.GetPointer(), firstIndex, firstInputIndex);
+
+  VectorType steps[ImageDimension];
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    IndexType nextIndex = firstIndex;
+    ++nextIndex[d];
+    ContinuousInputIndexType nextInputIndex;
+    this->MapIndexToInputContinuousIndex(outputPtr.GetPointer(), inputPtr.GetPointer(), nextIndex, nextInputIndex);
+    steps[d] = nextInputIndex - firstInputIndex;
+    }
+  const VectorType &  delta = steps[0];
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
 
-  // Compute corresponding input pixel position
-  inputPoint = this->m_Transform->TransformPoint(outputPoint);
-  inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+  ContinuousInputIndexType lineStart;
+  ContinuousInputIndexType inputIndex;
 
-  // As we walk across a scan line in the output image, we trace
-  // an oriented/scaled/translated line in the input image.  Cache
-  // the delta along this line in continuous index space of the input
-  // image. This allows us to use vector addition to model the
-  // transformation.
-  //
-  // To find delta, we take two pixels adjacent in a scanline
-  // and determine the continuous indices of these pixels when
-  // mapped to the input coordinate frame. We use the difference
-  // between these two continuous indices as the delta to apply
-  // to an index to trace line in the input image as we move
-  // across the scanline of the output image.
-  //
-  // We determine delta in this manner so that Images
-  // are both handled properly (taking into account the direction cosines).
-  //
-  ++index[0];
-  outputPtr->TransformIndexToPhysicalPoint(index, tmpOutputPoint);
-  tmpInputPoint = this->m_Transform->TransformPoint(tmpOutputPoint);
-  inputPtr->TransformPhysicalPointToContinuousIndex(tmpInputPoint,
-                                                    tmpInputIndex);
-  delta = tmpInputIndex - inputIndex;
+  // The part of each line inside the input buffer is interpolated in one
+  // call
+  std::vector< ContinuousInputIndexType > insideInputIndices(lineLength);
+  std::vector< OutputType >               insideValues(lineLength);
 
   while ( !outIt.IsAtEnd() )
     {
     // Determine the continuous index of the first pixel of output
     // scanline when mapped to the input coordinate frame.
-    //
-
-    // First get the position of the pixel in the output coordinate frame
-    index = outIt.GetIndex();
-    outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+    const IndexType index = outIt.GetIndex();
+    lineStart = firstInputIndex;
+    for ( unsigned int d = 1; d < ImageDimension; d++ )
+      {
+      lineStart += steps[d] * static_cast< TInterpolatorPrecisionType >( index[d] - firstIndex[d] );
+      }
 
-    // Compute corresponding input pixel continuous index, this index
-    // will incremented in the scanline loop
-    inputPoint = this->m_Transform->TransformPoint(outputPoint);
-    inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+    // Only the part of the line inside the input buffer, as found by the
+    // interpolator, is interpolated, without checking each pixel. A line
+    // which misses the buffer is filled with the default value.
+    SizeValueType insideBegin;
+    SizeValueType insideEnd;
+    m_Interpolator->ComputeLinePartInsideBuffer(lineStart, delta, lineLength, insideBegin, insideEnd);
 
-    while ( !outIt.IsAtEndOfLine() )
+    if ( insideBegin < insideEnd )
       {
-      PixelType  pixval;
-      OutputType value;
-      // Evaluate input at right position and copy to the output
-      if ( m_Interpolator->IsInsideBuffer(inputIndex) )
+      for ( SizeValueType i = insideBegin; i < insideEnd; ++i )
         {
-        if ( m_InterpolatorIsBSpline )
-          {
-          value = m_BSplineInterpolator->EvaluateAtContinuousIndex(
-            inputIndex,
-            threadId);
-          }
-        else
-          {
-          value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-          }
-        //Check for value min/max
-        if ( value <  minOutputValue )
-          {
-          pixval = minValue;
-          }
-        else if ( value > maxOutputValue )
-          {
-          pixval = maxValue;
-          }
-        else
+        ContinuousInputIndexType & insideInputIndex = insideInputIndices[i - insideBegin];
+        for ( unsigned int d = 0; d < ImageDimension; d++ )
           {
-          pixval = static_cast< PixelType >( value );
+          insideInputIndex[d] = lineStart[d] + static_cast< TInterpolatorPrecisionType >( i ) * delta[d];
           }
-        outIt.Set(pixval);
+        }
+      m_Interpolator->EvaluateAtContinuousIndices(&insideInputIndices[0],
+                                                  &insideValues[0],
+                                                  insideEnd - insideBegin);
+      }
+
+    for ( SizeValueType i = 0; i < lineLength; ++i, ++outIt )
+      {
+      progress.CompletedPixel();
+
+      const bool inside = ( i >= insideBegin && i < insideEnd );
+      if ( !inside && m_Extrapolator.IsNull() )
+        {
+        outIt.Set(defaultValue); // default background value
+        continue;
+        }
+
+      OutputType value;
+      if ( inside )
+        {
+        value = insideValues[i - insideBegin];
         }
       else
         {
-        if( m_Extrapolator.IsNull() )
+        for ( unsigned int d = 0; d < ImageDimension; d++ )
           {
-          outIt.Set(defaultValue); // default background value
-          }
-        else
-          {
-          value = m_Extrapolator->EvaluateAtContinuousIndex( inputIndex );
-          // Check boundaries and assign
-          if ( value < minOutputValue )
-            {
-            pixval = minValue;
-            }
-          else if ( value > maxOutputValue )
-            {
-            pixval = maxValue;
-            }
-          else
-            {
-            pixval = static_cast< PixelType >( value );
-            }
-          outIt.Set(pixval);
+          inputIndex[d] = lineStart[d] + static_cast< TInterpolatorPrecisionType >( i ) * delta[d];
           }
+        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
         }
 
-      progress.CompletedPixel();
-      ++outIt;
-      inputIndex += delta;
+      // Check for value min/max
+      PixelType pixval;
+      if ( value < minOutputValue )
+        {
+        pixval = minValue;
+        }
+      else if ( value > maxOutputValue )
+        {
+        pixval = maxValue;
+        }
+      else
+        {
+        pixval = static_cast< PixelType >( value );
+        }
+      outIt.Set(pixval);
       }
     outIt.NextLine();
     } //while( !outIt.IsAtEnd() )
@@ -530,6 +541,26 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   return;
 }
 
+/**
+ * Map the index of an output pixel to a continuous index of the input
+ */
+template< class TInputImage,
+          class TOutputImage,
+          class TInterpolatorPrecisionType >
+void
+ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
+::MapIndexToInputContinuousIndex(const OutputImageType *outputPtr,
+                                 const InputImageType *inputPtr,
+                                 const IndexType & index,
+                                 ContinuousInputIndexType & inputIndex) const
+{
+  PointType outputPoint;
+
+  outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+  const PointType inputPoint = m_Transform->TransformPoint(outputPoint);
+  inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+}
+
 /**
  * Inform pipeline of necessary input image region
  *
@@ -50,6 +50,9 @@ WarpImageFilter< TInputImage, TOutputImage, TDisplacementField >
 
   m_Interpolator =
     static_cast< InterpolatorType * >( interp.GetPointer() );
+
+  // Every output pixel is interpolated or set to the edge padding value
+  this->AllocateOutputsUninitializedOn();
 }
 
 /**
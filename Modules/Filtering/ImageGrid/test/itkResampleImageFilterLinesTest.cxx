@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkResampleImageFilter.h"
+#include "itkAffineTransform.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkNearestNeighborExtrapolateImageFunction.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+/**
+ * With a linear transform, the output lines are resampled by stepping the
+ * continuous index of the input image, and only their part inside the
+ * input buffer is interpolated. This test compares the output with the
+ * output of the same transform when it doesn't claim to be linear, where
+ * each pixel is transformed and checked on its own.
+ */
+namespace
+{
+typedef itk::Image< short, 3 > InputImageType;
+typedef itk::Image< float, 3 > OutputImageType;
+
+/** An affine transform which uses the path of the non linear transforms */
+class NonlinearAffineTransform : public itk::AffineTransform< double, 3 >
+{
+public:
+  typedef NonlinearAffineTransform        Self;
+  typedef itk::AffineTransform< double, 3 > Superclass;
+  typedef itk::SmartPointer< Self >       Pointer;
+  typedef itk::SmartPointer< const Self > ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(NonlinearAffineTransform, AffineTransform);
+
+  virtual bool IsLinear() const
+  {
+    return false;
+  }
+
+protected:
+  NonlinearAffineTransform() {}
+  ~NonlinearAffineTransform() {}
+};
+
+typedef itk::ResampleImageFilter< InputImageType, OutputImageType > FilterType;
+
+OutputImageType::Pointer
+Resample(const InputImageType *image, FilterType::TransformType *transform,
+         const OutputImageType::RegionType & region, const OutputImageType::DirectionType & direction,
+         bool nearestNeighbor, bool extrapolate)
+{
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetTransform(transform);
+  filter->SetDefaultPixelValue(-1000.0f);
+  if ( nearestNeighbor )
+    {
+    filter->SetInterpolator( itk::NearestNeighborInterpolateImageFunction< InputImageType, double >::New() );
+    }
+  if ( extrapolate )
+    {
+    filter->SetExtrapolator( itk::NearestNeighborExtrapolateImageFunction< InputImageType, double >::New() );
+    }
+  FilterType::SpacingType spacing;
+  spacing[0] = 0.8;
+  spacing[1] = 1.1;
+  spacing[2] = 1.3;
+  filter->SetOutputSpacing(spacing);
+  FilterType::OriginPointType origin;
+  origin[0] = -7.0;
+  origin[1] = 3.5;
+  origin[2] = -2.25;
+  filter->SetOutputOrigin(origin);
+  filter->SetOutputDirection(direction);
+  filter->SetSize( region.GetSize() );
+  filter->SetOutputStartIndex( region.GetIndex() );
+  filter->SetNumberOfThreads(3);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+bool
+CompareWithPixels(const InputImageType *image, double angle, const OutputImageType::RegionType & region,
+                  const OutputImageType::DirectionType & direction, bool nearestNeighbor, bool extrapolate,
+                  const char *name)
+{
+  typedef itk::AffineTransform< double, 3 > TransformType;
+  TransformType::Pointer linear = TransformType::New();
+  TransformType::OutputVectorType axis;
+  axis[0] = 1.0;
+  axis[1] = 2.0;
+  axis[2] = -0.5;
+  linear->Rotate3D(axis, angle);
+  linear->Scale(1.1);
+  TransformType::OutputVectorType translation;
+  translation[0] = 3.3;
+  translation[1] = -4.1;
+  translation[2] = 1.7;
+  linear->Translate(translation);
+
+  NonlinearAffineTransform::Pointer nonlinear = NonlinearAffineTransform::New();
+  nonlinear->SetParameters( linear->GetParameters() );
+
+  OutputImageType::Pointer lines = Resample(image, linear, region, direction, nearestNeighbor, extrapolate);
+  OutputImageType::Pointer pixels = Resample(image, nonlinear, region, direction, nearestNeighbor, extrapolate);
+
+  unsigned int                                              insidePixels = 0;
+  itk::ImageRegionConstIteratorWithIndex< OutputImageType > linesIt(lines, region);
+  itk::ImageRegionConstIterator< OutputImageType >          pixelsIt(pixels, region);
+  for ( ; !linesIt.IsAtEnd(); ++linesIt, ++pixelsIt )
+    {
+    if ( vcl_abs( linesIt.Get() - pixelsIt.Get() ) > 1e-3 )
+      {
+      std::cerr << name << ": the value at " << linesIt.GetIndex() << " is " << linesIt.Get()
+                << " instead of " << pixelsIt.Get() << std::endl;
+      return false;
+      }
+    if ( pixelsIt.Get() != -1000.0f )
+      {
+      ++insidePixels;
+      }
+    }
+
+  // Some of the output must be inside the input, and some outside, unless
+  // it is extrapolated
+  if ( insidePixels == 0 || ( !extrapolate && insidePixels == region.GetNumberOfPixels() ) )
+    {
+    std::cerr << name << ": " << insidePixels << " pixels inside the input" << std::endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int itkResampleImageFilterLinesTest(int, char *[])
+{
+  InputImageType::Pointer    image = InputImageType::New();
+  InputImageType::RegionType imageRegion;
+  InputImageType::IndexType  imageIndex = { { -2, 3, 0 } };
+  InputImageType::SizeType   imageSize = { { 25, 19, 14 } };
+  imageRegion.SetIndex(imageIndex);
+  imageRegion.SetSize(imageSize);
+  image->SetRegions(imageRegion);
+  InputImageType::SpacingType imageSpacing;
+  imageSpacing[0] = 1.0;
+  imageSpacing[1] = 0.9;
+  imageSpacing[2] = 1.5;
+  image->SetSpacing(imageSpacing);
+  image->Allocate();
+
+  unsigned int                                        seed = 1;
+  itk::ImageRegionIteratorWithIndex< InputImageType > it(image, imageRegion);
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245 + 12345;
+    it.Set( static_cast< short >( ( seed / 65536 ) % 500 ) + 30 * it.GetIndex()[0] );
+    }
+
+  OutputImageType::RegionType region;
+  OutputImageType::IndexType  regionIndex = { { -5, 2, -3 } };
+  OutputImageType::SizeType   regionSize = { { 37, 26, 17 } };
+  region.SetIndex(regionIndex);
+  region.SetSize(regionSize);
+
+  OutputImageType::DirectionType identity;
+  identity.SetIdentity();
+  OutputImageType::DirectionType oblique;
+  const double                   c = vcl_cos(0.4);
+  const double                   s = vcl_sin(0.4);
+  oblique.SetIdentity();
+  oblique[0][0] = c;
+  oblique[0][2] = -s;
+  oblique[2][0] = s;
+  oblique[2][2] = c;
+
+  bool passed = true;
+  passed &= CompareWithPixels(image, 0.3, region, identity, false, false, "linear");
+  passed &= CompareWithPixels(image, -0.7, region, oblique, false, false, "linear oblique");
+  passed &= CompareWithPixels(image, 0.3, region, oblique, true, false, "nearest neighbor");
+  passed &= CompareWithPixels(image, 1.1, region, identity, false, true, "extrapolated");
+  // lines parallel to the sides of the input buffer
+  passed &= CompareWithPixels(image, 0.0, region, identity, false, false, "no rotation");
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
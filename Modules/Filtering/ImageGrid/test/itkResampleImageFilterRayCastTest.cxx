@@ -0,0 +1,155 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkResampleImageFilter.h"
+#include "itkCenteredEuler3DTransform.h"
+#include "itkRayCastInterpolateImageFunction.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+/**
+ * RayCastInterpolateImageFunction projects the input image along the ray
+ * from its focal point, so that an output plane far outside of the input
+ * buffer still gets a digitally reconstructed radiograph. This test
+ * resamples a volume on such a plane, with a linear transform, where the
+ * output lines are resampled by stepping the continuous index of the input
+ * image, and compares the projection with the one obtained when the
+ * transform doesn't claim to be linear and each pixel is resampled on its
+ * own.
+ */
+namespace
+{
+typedef itk::Image< short, 3 > InputImageType;
+typedef itk::Image< float, 3 > OutputImageType;
+
+typedef itk::CenteredEuler3DTransform< double > TransformType;
+
+/** A centered Euler transform which uses the path of the non linear
+ * transforms */
+class NonlinearCenteredEuler3DTransform : public itk::CenteredEuler3DTransform< double >
+{
+public:
+  typedef NonlinearCenteredEuler3DTransform       Self;
+  typedef itk::CenteredEuler3DTransform< double > Superclass;
+  typedef itk::SmartPointer< Self >               Pointer;
+  typedef itk::SmartPointer< const Self >         ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(NonlinearCenteredEuler3DTransform, CenteredEuler3DTransform);
+
+  virtual bool IsLinear() const
+  {
+    return false;
+  }
+
+protected:
+  NonlinearCenteredEuler3DTransform() {}
+  ~NonlinearCenteredEuler3DTransform() {}
+};
+
+typedef itk::ResampleImageFilter< InputImageType, OutputImageType > FilterType;
+
+OutputImageType::Pointer
+Project(const InputImageType *image, TransformType *transform)
+{
+  typedef itk::RayCastInterpolateImageFunction< InputImageType, double > InterpolatorType;
+  InterpolatorType::Pointer interpolator = InterpolatorType::New();
+  interpolator->SetTransform(transform);
+  interpolator->SetThreshold(0.0);
+  InterpolatorType::InputPointType focalPoint;
+  focalPoint[0] = 0.0;
+  focalPoint[1] = 0.0;
+  focalPoint[2] = -100.0;
+  interpolator->SetFocalPoint(focalPoint);
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetTransform(transform);
+  filter->SetInterpolator(interpolator);
+  filter->SetDefaultPixelValue(-1.0f);
+  FilterType::SizeType size;
+  size[0] = 40;
+  size[1] = 40;
+  size[2] = 1;
+  filter->SetSize(size);
+  FilterType::OriginPointType origin;
+  origin[0] = -19.5;
+  origin[1] = -19.5;
+  origin[2] = 100.0;
+  filter->SetOutputOrigin(origin);
+  filter->SetNumberOfThreads(3);
+  filter->Update();
+  return filter->GetOutput();
+}
+}
+
+int itkResampleImageFilterRayCastTest(int, char *[])
+{
+  // A 32x32x32 volume centered on the origin, with a cube of 100 in its
+  // middle
+  InputImageType::Pointer   image = InputImageType::New();
+  InputImageType::SizeType  imageSize = { { 32, 32, 32 } };
+  InputImageType::PointType imageOrigin;
+  imageOrigin.Fill(-15.5);
+  image->SetRegions(imageSize);
+  image->SetOrigin(imageOrigin);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< InputImageType > it( image, image->GetBufferedRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    const InputImageType::IndexType index = it.GetIndex();
+    bool                            inCube = true;
+    for ( unsigned int d = 0; d < 3; d++ )
+      {
+      inCube &= ( index[d] >= 8 && index[d] < 24 );
+      }
+    it.Set(inCube ? 100 : 0);
+    }
+
+  TransformType::Pointer linear = TransformType::New();
+  linear->SetIdentity();
+  NonlinearCenteredEuler3DTransform::Pointer nonlinear = NonlinearCenteredEuler3DTransform::New();
+  nonlinear->SetIdentity();
+
+  OutputImageType::Pointer lines = Project(image, linear);
+  OutputImageType::Pointer pixels = Project(image, nonlinear);
+
+  // The output plane is outside of the input buffer, but every ray goes
+  // through the volume, and some go through the cube
+  double                                           sum = 0.0;
+  itk::ImageRegionConstIterator< OutputImageType > linesIt( lines, lines->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< OutputImageType > pixelsIt( pixels, pixels->GetBufferedRegion() );
+  for ( ; !linesIt.IsAtEnd(); ++linesIt, ++pixelsIt )
+    {
+    if ( linesIt.Get() < 0.0f || vcl_abs( linesIt.Get() - pixelsIt.Get() ) > 1e-3 )
+      {
+      std::cerr << "The projection is " << linesIt.Get() << " instead of " << pixelsIt.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    sum += linesIt.Get();
+    }
+  if ( sum <= 0.0 )
+    {
+    std::cerr << "The projection is empty" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Sum of the projection: " << sum << std::endl;
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -219,8 +219,7 @@ void PolylineMaskImageFilter< TInputImage, TPolyline, TVector, TOutputImage >
   outputImagePtr->SetRequestedRegion( inputImagePtr->GetRequestedRegion() );
   outputImagePtr->SetBufferedRegion( inputImagePtr->GetBufferedRegion() );
   outputImagePtr->SetLargestPossibleRegion( inputImagePtr->GetLargestPossibleRegion() );
-  outputImagePtr->Allocate();
-  outputImagePtr->FillBuffer(0);
+  outputImagePtr->AllocateAndFill(0);
 
   InputImageConstIteratorType inputIt( inputImagePtr, inputImagePtr->GetLargestPossibleRegion() );
   OutputImageIteratorType     outputIt( outputImagePtr, outputImagePtr->GetLargestPossibleRegion() );
@@ -395,8 +394,7 @@ void PolylineMaskImageFilter< TInputImage, TPolyline, TVector, TOutputImage >
   projectionImagePtr->SetRequestedRegion(projectionRegion);
   projectionImagePtr->SetBufferedRegion(projectionRegion);
   projectionImagePtr->SetLargestPossibleRegion(projectionRegion);
-  projectionImagePtr->Allocate();
-  projectionImagePtr->FillBuffer(0);
+  projectionImagePtr->AllocateAndFill(0);
 
   typedef ImageRegionIterator< ProjectionImageType > ProjectionImageIteratorType;
   ProjectionImageIteratorType projectionIt( projectionImagePtr, projectionImagePtr->GetLargestPossibleRegion() );
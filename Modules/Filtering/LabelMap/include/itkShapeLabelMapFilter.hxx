@@ -485,8 +485,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   // std::cout << boundingBox << "  " << lRegion << "  " << elRegion << std::endl;
   // now initialize the image
   lineImage->SetRegions( elRegion );
-  lineImage->Allocate();
-  lineImage->FillBuffer( VectorLineType() );
+  lineImage->AllocateAndFill( VectorLineType() );
 
   // std::cout << "lineContainer.size(): " << lineContainer.size() << std::endl;
 
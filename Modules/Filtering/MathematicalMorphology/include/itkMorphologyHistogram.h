@@ -104,6 +104,14 @@ public:
     return false;
   }
 
+  /** The map based histogram doesn't need the range of the input. */
+  static bool UseInputRange()
+  {
+    return false;
+  }
+
+  void SetRange(const TInputPixel &, const TInputPixel &) {}
+
   MapType     m_Map;
   TInputPixel m_Boundary;
 
@@ -182,6 +190,14 @@ public:
     return true;
   }
 
+  /** The vector covers the whole range of the pixel type. */
+  static bool UseInputRange()
+  {
+    return false;
+  }
+
+  void SetRange(const TInputPixel &, const TInputPixel &) {}
+
   std::vector< IdentifierType >   m_Vector;
   TInputPixel                     m_InitValue;
   TInputPixel                     m_CurrentValue;
@@ -190,8 +206,216 @@ public:
   TInputPixel                     m_Boundary;
 };
 
+/** \class BoundedRangeMorphologyHistogram
+ * \brief Histogram of the values in a bounded range, with a hierarchy
+ * of bit sets to find the extreme value quickly.
+ *
+ * The counts are stored in a vector which covers the range given to
+ * SetRange(), which the filter sets to the range of the input image, so
+ * a 12 bit image stored in 16 bit pixels only needs 4096 counts. A bit
+ * set marks the non empty counts; each upper level marks the non zero
+ * words of the level below, up to a single word. Adding or removing a
+ * pixel updates at most one bit per level when a count changes between 0
+ * and 1, and GetValue() goes down the hierarchy looking for the lowest or
+ * highest bit of one word per level, instead of walking the counts one by
+ * one like VectorMorphologyHistogram does. The boundary is counted apart
+ * since its value is usually outside of the range of the image.
+ *
+ * \ingroup ITKMathematicalMorphology
+ */
+template< class TInputPixel, class TCompare >
+class BoundedRangeMorphologyHistogram
+{
+public:
+  typedef uint32_t WordType;
+
+  BoundedRangeMorphologyHistogram()
+  {
+    // the extreme value is the highest one when TCompare sorts the values
+    // in decreasing order
+    m_UseHighest = m_Compare( NumericTraits< TInputPixel >::max(), NumericTraits< TInputPixel >::NonpositiveMin() );
+    m_Boundary = 0;
+    m_BoundaryCount = 0;
+    this->SetRange( NumericTraits< TInputPixel >::NonpositiveMin(), NumericTraits< TInputPixel >::max() );
+  }
+
+  /** Sets the range of the values, and empties the histogram. */
+  void SetRange(const TInputPixel & minimum, const TInputPixel & maximum)
+  {
+    m_Minimum = minimum;
+    SizeValueType size = static_cast< SizeValueType >( static_cast< int >( maximum ) - static_cast< int >( minimum ) ) + 1;
+    m_Counts.assign(size, 0);
+    m_Levels.clear();
+    do
+      {
+      size = ( size + WordBits - 1 ) / WordBits;
+      m_Levels.push_back( std::vector< WordType >(size, 0) );
+      }
+    while ( size > 1 );
+  }
+
+  inline void AddBoundary()
+  {
+    ++m_BoundaryCount;
+  }
+
+  inline void RemoveBoundary()
+  {
+    --m_BoundaryCount;
+  }
+
+  inline void AddPixel(const TInputPixel & p)
+  {
+    const SizeValueType bin = static_cast< SizeValueType >( static_cast< int >( p ) - static_cast< int >( m_Minimum ) );
+    if ( m_Counts[bin]++ == 0 )
+      {
+      SizeValueType position = bin;
+      for ( unsigned int l = 0; l < m_Levels.size(); l++ )
+        {
+        WordType &     word = m_Levels[l][position / WordBits];
+        const WordType previous = word;
+        word |= static_cast< WordType >( 1 ) << ( position % WordBits );
+        if ( previous != 0 )
+          {
+          break;
+          }
+        position /= WordBits;
+        }
+      }
+  }
+
+  inline void RemovePixel(const TInputPixel & p)
+  {
+    const SizeValueType bin = static_cast< SizeValueType >( static_cast< int >( p ) - static_cast< int >( m_Minimum ) );
+    if ( --m_Counts[bin] == 0 )
+      {
+      SizeValueType position = bin;
+      for ( unsigned int l = 0; l < m_Levels.size(); l++ )
+        {
+        WordType & word = m_Levels[l][position / WordBits];
+        word &= ~( static_cast< WordType >( 1 ) << ( position % WordBits ) );
+        if ( word != 0 )
+          {
+          break;
+          }
+        position /= WordBits;
+        }
+      }
+  }
+
+  inline TInputPixel GetValue()
+  {
+    if ( m_Levels.back()[0] == 0 )
+      {
+      // only the boundary is in the histogram
+      itkAssertInDebugAndIgnoreInReleaseMacro(m_BoundaryCount > 0);
+      return m_Boundary;
+      }
+
+    SizeValueType position = 0;
+    for ( int l = static_cast< int >( m_Levels.size() ) - 1; l >= 0; l-- )
+      {
+      const WordType word = m_Levels[l][position];
+      position = position * WordBits + ( m_UseHighest ? GetHighestBit(word) : GetLowestBit(word) );
+      }
+    const TInputPixel value =
+      static_cast< TInputPixel >( static_cast< int >( position ) + static_cast< int >( m_Minimum ) );
+    if ( m_BoundaryCount > 0 && m_Compare(m_Boundary, value) )
+      {
+      return m_Boundary;
+      }
+    return value;
+  }
+
+  inline TInputPixel GetValue(const TInputPixel &)
+  {
+    return GetValue();
+  }
+
+  void SetBoundary(const TInputPixel & val)
+  {
+    m_Boundary = val;
+  }
+
+  static bool UseVectorBasedAlgorithm()
+  {
+    return true;
+  }
+
+  /** The filter must call SetRange() with the range of its input. */
+  static bool UseInputRange()
+  {
+    return true;
+  }
+
+private:
+  itkStaticConstMacro(WordBits, unsigned int, 32);
+
+  /** Position of the lowest bit set in a non zero word. */
+  static unsigned int GetLowestBit(WordType word)
+  {
+    static const unsigned int deBruijnPositions[32] =
+      { 0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+        31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9 };
+    return deBruijnPositions[static_cast< WordType >( ( word & ( ~word + 1 ) ) * 0x077CB531U ) >> 27];
+  }
+
+  /** Position of the highest bit set in a non zero word. */
+  static unsigned int GetHighestBit(WordType word)
+  {
+    unsigned int position = 0;
+    for ( unsigned int shift = 16; shift > 0; shift /= 2 )
+      {
+      if ( word >> shift )
+        {
+        word >>= shift;
+        position += shift;
+        }
+      }
+    return position;
+  }
+
+  std::vector< IdentifierType >           m_Counts;
+  std::vector< std::vector< WordType > >  m_Levels;
+  TInputPixel                             m_Minimum;
+  TCompare                                m_Compare;
+  bool                                    m_UseHighest;
+  TInputPixel                             m_Boundary;
+  IdentifierType                          m_BoundaryCount;
+};
+
+/** \class MovingMorphologyHistogram
+ * \brief Histogram used by MovingHistogramDilateImageFilter and
+ * MovingHistogramErodeImageFilter.
+ *
+ * It is MorphologyHistogram, except for the 16 bit integer types which
+ * use BoundedRangeMorphologyHistogram instead of a map. The anchor
+ * filters, which create a new histogram for each line, keep using
+ * MorphologyHistogram.
+ *
+ * \ingroup ITKMathematicalMorphology
+ */
+template< class TInputPixel, class TCompare >
+class MovingMorphologyHistogram:
+  public MorphologyHistogram< TInputPixel, TCompare >
+{
+};
+
 /** \cond HIDE_SPECIALIZATION_DOCUMENTATION */
 
+template< class TCompare >
+class MovingMorphologyHistogram<unsigned short, TCompare>:
+  public BoundedRangeMorphologyHistogram<unsigned short, TCompare>
+{
+};
+
+template< class TCompare >
+class MovingMorphologyHistogram<short, TCompare>:
+  public BoundedRangeMorphologyHistogram<short, TCompare>
+{
+};
+
+
 // now create MorphologyHistogram partial specilizations using the VectorMorphologyHistogram
 // as base class
 
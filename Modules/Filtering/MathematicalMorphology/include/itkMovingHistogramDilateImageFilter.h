@@ -41,19 +41,19 @@ namespace itk
 template< class TInputImage, class TOutputImage, class TKernel >
 class ITK_EXPORT MovingHistogramDilateImageFilter:
   public MovingHistogramMorphologyImageFilter< TInputImage, TOutputImage, TKernel,
-                                               typename Function::MorphologyHistogram< typename TInputImage::PixelType,
-                                                                                       typename std::greater< typename
-                                                                                                              TInputImage
-                                                                                                              ::PixelType > > >
+                                               typename Function::MovingMorphologyHistogram< typename TInputImage::PixelType,
+                                                                                             typename std::greater< typename
+                                                                                                                    TInputImage
+                                                                                                                    ::PixelType > > >
 {
 public:
   /** Standard class typedefs. */
   typedef MovingHistogramDilateImageFilter Self;
   typedef MovingHistogramMorphologyImageFilter< TInputImage, TOutputImage, TKernel,
-                                                typename Function::MorphologyHistogram< typename TInputImage::PixelType,
-                                                                                        typename std::greater< typename
-                                                                                                               TInputImage
-                                                                                                               ::PixelType > > >  Superclass;
+                                                typename Function::MovingMorphologyHistogram< typename TInputImage::PixelType,
+                                                                                              typename std::greater< typename
+                                                                                                                     TInputImage
+                                                                                                                     ::PixelType > > >  Superclass;
   typedef SmartPointer< Self >       Pointer;
   typedef SmartPointer< const Self > ConstPointer;
 
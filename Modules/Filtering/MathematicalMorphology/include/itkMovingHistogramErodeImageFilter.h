@@ -41,19 +41,19 @@ namespace itk
 template< class TInputImage, class TOutputImage, class TKernel >
 class ITK_EXPORT MovingHistogramErodeImageFilter:
   public MovingHistogramMorphologyImageFilter< TInputImage, TOutputImage, TKernel,
-                                               typename Function::MorphologyHistogram< typename TInputImage::PixelType,
-                                                                                       typename std::less< typename
-                                                                                                           TInputImage
-                                                                                                           ::PixelType > > >
+                                               typename Function::MovingMorphologyHistogram< typename TInputImage::PixelType,
+                                                                                             typename std::less< typename
+                                                                                                                 TInputImage
+                                                                                                                 ::PixelType > > >
 {
 public:
   /** Standard class typedefs. */
   typedef MovingHistogramErodeImageFilter Self;
   typedef MovingHistogramMorphologyImageFilter< TInputImage, TOutputImage, TKernel,
-                                                typename Function::MorphologyHistogram< typename TInputImage::PixelType,
-                                                                                        typename std::less< typename
-                                                                                                            TInputImage
-                                                                                                            ::PixelType > > >  Superclass;
+                                                typename Function::MovingMorphologyHistogram< typename TInputImage::PixelType,
+                                                                                              typename std::less< typename
+                                                                                                                  TInputImage
+                                                                                                                  ::PixelType > > >  Superclass;
   typedef SmartPointer< Self >       Pointer;
   typedef SmartPointer< const Self > ConstPointer;
 
@@ -32,6 +32,9 @@ namespace itk
  *
  * This class is similar to MovingHistogramImageFilter but add support
  * for boundaries and don't fully update the histogram to enhance performances.
+ * When the histogram needs it, the range of the values of the input is
+ * computed before the threads start, so that each histogram only covers
+ * that range.
  *
  * \sa MovingHistogramImageFilter, MovingHistogramDilateImageFilter, MovingHistogramErodeImageFilter
  * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
@@ -103,10 +106,18 @@ protected:
 //                               outputRegionForThread,
 //                               ThreadIdType threadId);
 
-  /** needed to pass the boundary value to the histogram object */
+  /** Computes the range of the input values when the histogram needs
+   * it (see BoundedRangeMorphologyHistogram). */
+  void BeforeThreadedGenerateData();
+
+  /** needed to pass the boundary value and the range of the input values
+   * to the histogram object */
   virtual void ConfigureHistogram(THistogram & histogram);
 
   PixelType m_Boundary;
+
+  PixelType m_InputMinimum;
+  PixelType m_InputMaximum;
 private:
   MovingHistogramMorphologyImageFilter(const Self &); //purposely not
                                                       // implemented
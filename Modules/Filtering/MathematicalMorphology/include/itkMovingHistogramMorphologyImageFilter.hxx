@@ -20,6 +20,7 @@
 
 #include "itkMovingHistogramMorphologyImageFilter.h"
 #include "itkNumericTraits.h"
+#include "itkImageRegionConstIterator.h"
 
 namespace itk
 {
@@ -30,6 +31,46 @@ MovingHistogramMorphologyImageFilter< TInputImage, TOutputImage, TKernel, THisto
   // default m_boundary should be set by subclasses. Just provide a default
   // value to always get the same behavior if it is not done
   m_Boundary = NumericTraits< PixelType >::Zero;
+  m_InputMinimum = NumericTraits< PixelType >::Zero;
+  m_InputMaximum = NumericTraits< PixelType >::Zero;
+}
+
+template< class TInputImage, class TOutputImage, class TKernel, class THistogram >
+void
+MovingHistogramMorphologyImageFilter< TInputImage, TOutputImage, TKernel, THistogram >
+::BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+
+  if ( !THistogram::UseInputRange() )
+    {
+    return;
+    }
+
+  // the histograms only have to hold the values of the input requested
+  // region, which the threads read
+  const InputImageType *input = this->GetInput();
+  m_InputMinimum = NumericTraits< PixelType >::Zero;
+  m_InputMaximum = NumericTraits< PixelType >::Zero;
+  ImageRegionConstIterator< InputImageType > it( input, input->GetRequestedRegion() );
+  it.GoToBegin();
+  if ( !it.IsAtEnd() )
+    {
+    m_InputMinimum = it.Get();
+    m_InputMaximum = it.Get();
+    }
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    const PixelType & value = it.Get();
+    if ( value < m_InputMinimum )
+      {
+      m_InputMinimum = value;
+      }
+    else if ( m_InputMaximum < value )
+      {
+      m_InputMaximum = value;
+      }
+    }
 }
 
 template< class TInputImage, class TOutputImage, class TKernel, class THistogram >
@@ -38,6 +79,10 @@ MovingHistogramMorphologyImageFilter< TInputImage, TOutputImage, TKernel, THisto
 ::ConfigureHistogram(THistogram & histogram)
 {
   histogram.SetBoundary(m_Boundary);
+  if ( THistogram::UseInputRange() )
+    {
+    histogram.SetRange(m_InputMinimum, m_InputMaximum);
+    }
 }
 
 template< class TInputImage, class TOutputImage, class TKernel, class THistogram >
@@ -48,6 +93,10 @@ MovingHistogramMorphologyImageFilter< TInputImage, TOutputImage, TKernel, THisto
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Boundary: " << m_Boundary << std::endl;
+  os << indent << "InputMinimum: "
+     << static_cast< typename NumericTraits< PixelType >::PrintType >( m_InputMinimum ) << std::endl;
+  os << indent << "InputMaximum: "
+     << static_cast< typename NumericTraits< PixelType >::PrintType >( m_InputMaximum ) << std::endl;
 }
 } // end namespace itk
 #endif
@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBasicDilateImageFilter.h"
+#include "itkBasicErodeImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMovingHistogramDilateImageFilter.h"
+#include "itkMovingHistogramErodeImageFilter.h"
+
+namespace
+{
+template< class TImage >
+typename TImage::Pointer
+CreateRangeTestImage(const typename TImage::SizeType & size, int minimum, int maximum, unsigned int seed)
+{
+  typename TImage::Pointer image = TImage::New();
+  typename TImage::RegionType region;
+  region.SetSize(size);
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIterator< TImage > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245 + 12345;
+    it.Set( static_cast< typename TImage::PixelType >( minimum + static_cast< int >( ( seed / 65536 ) % ( maximum - minimum + 1 ) ) ) );
+    }
+  return image;
+}
+
+template< class TImage, class TBasicFilter, class THistogramFilter >
+bool
+CompareWithBasicFilter(const TImage *image, const typename TBasicFilter::KernelType & kernel,
+                       const typename TImage::RegionType & requestedRegion, const char *name)
+{
+  typename TBasicFilter::Pointer basic = TBasicFilter::New();
+  basic->SetInput(image);
+  basic->SetKernel(kernel);
+  basic->Update();
+
+  typename THistogramFilter::Pointer histogram = THistogramFilter::New();
+  histogram->SetInput(image);
+  histogram->SetKernel(kernel);
+  if ( requestedRegion.GetNumberOfPixels() > 0 )
+    {
+    histogram->GetOutput()->SetRequestedRegion(requestedRegion);
+    }
+  histogram->Update();
+
+  if ( !histogram->GetUseVectorBasedAlgorithm() )
+    {
+    std::cerr << name << ": the 16 bit histogram should be vector based" << std::endl;
+    return false;
+    }
+
+  const typename TImage::RegionType region = histogram->GetOutput()->GetRequestedRegion();
+  itk::ImageRegionConstIterator< TImage > basicIt( basic->GetOutput(), region );
+  itk::ImageRegionConstIterator< TImage > histogramIt( histogram->GetOutput(), region );
+  for ( ; !basicIt.IsAtEnd(); ++basicIt, ++histogramIt )
+    {
+    if ( basicIt.Get() != histogramIt.Get() )
+      {
+      std::cerr << name << ": the histogram filter differs from the basic filter at "
+                << basicIt.GetIndex() << ": " << histogramIt.Get() << " instead of "
+                << basicIt.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template< class TImage >
+bool
+CompareDilateAndErode(const typename TImage::SizeType & size, const typename TImage::SizeType & radius,
+                      int minimum, int maximum, unsigned int seed)
+{
+  typedef itk::FlatStructuringElement< TImage::ImageDimension > KernelType;
+  typedef itk::BasicDilateImageFilter< TImage, TImage, KernelType >         BasicDilateType;
+  typedef itk::BasicErodeImageFilter< TImage, TImage, KernelType >          BasicErodeType;
+  typedef itk::MovingHistogramDilateImageFilter< TImage, TImage, KernelType > HistogramDilateType;
+  typedef itk::MovingHistogramErodeImageFilter< TImage, TImage, KernelType >  HistogramErodeType;
+
+  const KernelType kernel = KernelType::Ball(radius);
+  typename TImage::Pointer image = CreateRangeTestImage< TImage >(size, minimum, maximum, seed);
+
+  // a requested region away from the borders of the image, whose input
+  // requested region doesn't hold all the values of the image
+  typename TImage::RegionType subRegion;
+  typename TImage::IndexType  subRegionIndex;
+  typename TImage::SizeType   subRegionSize;
+  for ( unsigned int d = 0; d < TImage::ImageDimension; d++ )
+    {
+    subRegionIndex[d] = size[d] / 3;
+    subRegionSize[d] = size[d] / 3;
+    }
+  subRegion.SetIndex(subRegionIndex);
+  subRegion.SetSize(subRegionSize);
+
+  bool passed = true;
+  passed &= CompareWithBasicFilter< TImage, BasicDilateType, HistogramDilateType >(
+    image, kernel, typename TImage::RegionType(), "dilate");
+  passed &= CompareWithBasicFilter< TImage, BasicErodeType, HistogramErodeType >(
+    image, kernel, typename TImage::RegionType(), "erode");
+  passed &= CompareWithBasicFilter< TImage, BasicDilateType, HistogramDilateType >(
+    image, kernel, subRegion, "dilate of a sub region");
+  passed &= CompareWithBasicFilter< TImage, BasicErodeType, HistogramErodeType >(
+    image, kernel, subRegion, "erode of a sub region");
+
+  // a constant image has a range of a single value
+  typename TImage::Pointer constantImage = CreateRangeTestImage< TImage >(size, minimum, minimum, seed);
+  passed &= CompareWithBasicFilter< TImage, BasicDilateType, HistogramDilateType >(
+    constantImage, kernel, typename TImage::RegionType(), "dilate of a constant image");
+  passed &= CompareWithBasicFilter< TImage, BasicErodeType, HistogramErodeType >(
+    constantImage, kernel, typename TImage::RegionType(), "erode of a constant image");
+  return passed;
+}
+}
+
+int itkMovingHistogramMorphologyRangeTest(int, char *[])
+{
+  typedef itk::Image< unsigned short, 2 > UShortImageType;
+  typedef itk::Image< unsigned short, 3 > UShort3DImageType;
+  typedef itk::Image< short, 2 >          ShortImageType;
+  typedef itk::Image< short, 3 >          Short3DImageType;
+
+  bool passed = true;
+
+  // 12 bit values
+  UShortImageType::SizeType size2D = { { 47, 38 } };
+  UShortImageType::SizeType radius2D = { { 4, 3 } };
+  passed &= CompareDilateAndErode< UShortImageType >(size2D, radius2D, 0, 4095, 1);
+
+  // the whole range of the type, where the hierarchy has three levels
+  passed &= CompareDilateAndErode< UShortImageType >(size2D, radius2D, 0, 65535, 2);
+  passed &= CompareDilateAndErode< ShortImageType >(size2D, radius2D, -32768, 32767, 3);
+
+  // negative values, and a few distinct values only
+  passed &= CompareDilateAndErode< ShortImageType >(size2D, radius2D, -1200, 800, 4);
+  passed &= CompareDilateAndErode< ShortImageType >(size2D, radius2D, -3, 4, 5);
+
+  UShort3DImageType::SizeType size3D = { { 21, 17, 15 } };
+  UShort3DImageType::SizeType radius3D = { { 3, 2, 2 } };
+  passed &= CompareDilateAndErode< UShort3DImageType >(size3D, radius3D, 100, 3000, 6);
+  passed &= CompareDilateAndErode< Short3DImageType >(size3D, radius3D, -2048, 2047, 7);
+
+  // the histogram algorithm is always selected for non decomposable
+  // kernels of 16 bit images
+  typedef itk::FlatStructuringElement< 2 >                                          KernelType;
+  typedef itk::GrayscaleDilateImageFilter< UShortImageType, UShortImageType, KernelType > DilateFilterType;
+  DilateFilterType::Pointer dilate = DilateFilterType::New();
+  dilate->SetKernel( KernelType::Ball(radius2D) );
+  if ( dilate->GetAlgorithm() != DilateFilterType::HISTO )
+    {
+    std::cerr << "GrayscaleDilateImageFilter should use the histogram algorithm" << std::endl;
+    passed = false;
+    }
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
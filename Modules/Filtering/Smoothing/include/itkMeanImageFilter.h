@@ -107,6 +107,22 @@ protected:
 private:
   MeanImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);  //purposely not implemented
+
+  /** Computes the mean of a neighborhood. */
+  struct MeanKernel
+  {
+    template< class TNeighborhood >
+    OutputPixelType operator()(const TNeighborhood & neighborhood) const
+    {
+      const unsigned int neighborhoodSize = neighborhood.Size();
+      InputRealType      sum = NumericTraits< InputRealType >::Zero;
+      for ( unsigned int i = 0; i < neighborhoodSize; ++i )
+        {
+        sum += static_cast< InputRealType >( neighborhood.GetPixel(i) );
+        }
+      return static_cast< OutputPixelType >( sum / double(neighborhoodSize) );
+    }
+  };
 };
 } // end namespace itk
 
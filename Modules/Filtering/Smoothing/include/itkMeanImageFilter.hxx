@@ -39,56 +39,16 @@ MeanImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  unsigned int i;
-
   ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
 
-  ConstNeighborhoodIterator< InputImageType > bit;
-  ImageRegionIterator< OutputImageType >      it;
-
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename  InputImageType::ConstPointer input  = this->GetInput();
-
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  faceList = bC( input, outputRegionForThread, this->GetRadius() );
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator fit;
-
   // support progress methods/callbacks
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  InputRealType sum;
-
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
-    {
-    bit = ConstNeighborhoodIterator< InputImageType >(this->GetRadius(),
-                                                      input, *fit);
-    unsigned int neighborhoodSize = bit.Size();
-    it = ImageRegionIterator< OutputImageType >(output, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
-
-    while ( !bit.IsAtEnd() )
-      {
-      sum = NumericTraits< InputRealType >::Zero;
-      for ( i = 0; i < neighborhoodSize; ++i )
-        {
-        sum += static_cast< InputRealType >( bit.GetPixel(i) );
-        }
-
-      // get the mean value
-      it.Set( static_cast< OutputPixelType >( sum / double(neighborhoodSize) ) );
-
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
-      }
-    }
+  // The neighborhoods of the non-boundary region are read without bounds
+  // checking, and the boundary faces use the boundary condition.
+  MeanKernel kernel;
+  NeighborhoodAlgorithm::ApplyNeighborhoodKernel(this->GetInput(), this->GetOutput(), outputRegionForThread,
+                                                 this->GetRadius(), &nbc, kernel, progress);
 }
 } // end namespace itk
 
@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkMedianHistogram_h
+#define __itkMedianHistogram_h
+
+#include "itkIntTypes.h"
+#include "itkNumericTraits.h"
+
+#include <vector>
+
+namespace itk
+{
+namespace Function
+{
+/** \class MedianHistogram
+ * \brief Histogram of the values of a moving window, used by
+ * MedianImageFilter to find the median of the window.
+ *
+ * The generic version is not usable: UseHistogramAlgorithm() returns false
+ * and MedianImageFilter sorts the neighborhood of each pixel instead. The
+ * 8 and 16 bit integer types are specialized to TieredMedianHistogram.
+ *
+ * \ingroup ITKSmoothing
+ */
+template< class TInputPixel >
+class MedianHistogram
+{
+public:
+  static bool UseHistogramAlgorithm() { return false; }
+
+  void AddPixel(const TInputPixel &) {}
+  void RemovePixel(const TInputPixel &) {}
+  TInputPixel GetMedian() { return TInputPixel(); }
+};
+
+/** \class TieredMedianHistogram
+ * \brief Histogram of all the values of an 8 or 16 bit integer type, with
+ * a coarse and a fine level.
+ *
+ * Each coarse bin counts the values of 2^(b/2) consecutive fine bins,
+ * where b is the number of bits of the type. The coarse bin holding the
+ * median is tracked while pixels are added and removed, so GetMedian()
+ * usually moves by a few coarse bins and then scans at most 2^(b/2) fine
+ * bins, whatever the number of pixels in the window.
+ *
+ * \ingroup ITKSmoothing
+ */
+template< class TInputPixel >
+class TieredMedianHistogram
+{
+public:
+  TieredMedianHistogram():
+    m_Fine(static_cast< SizeValueType >( 1 ) << ( 8 * sizeof( TInputPixel ) ), 0),
+    m_Coarse(static_cast< SizeValueType >( 1 ) << ( 8 * sizeof( TInputPixel ) - FineBits ), 0),
+    m_Entries(0),
+    m_CoarseBin(0),
+    m_BelowCoarseBin(0)
+  {}
+
+  static bool UseHistogramAlgorithm() { return true; }
+
+  void AddPixel(const TInputPixel & p)
+  {
+    const unsigned int bin = GetBin(p);
+    ++m_Fine[bin];
+    ++m_Coarse[bin >> FineBits];
+    if ( ( bin >> FineBits ) < m_CoarseBin )
+      {
+      ++m_BelowCoarseBin;
+      }
+    ++m_Entries;
+  }
+
+  void RemovePixel(const TInputPixel & p)
+  {
+    const unsigned int bin = GetBin(p);
+    --m_Fine[bin];
+    --m_Coarse[bin >> FineBits];
+    if ( ( bin >> FineBits ) < m_CoarseBin )
+      {
+      --m_BelowCoarseBin;
+      }
+    --m_Entries;
+  }
+
+  /** Returns the value of rank m_Entries / 2 of the sorted values, which is
+   * the median for an odd number of entries. The histogram must not be
+   * empty. */
+  TInputPixel GetMedian()
+  {
+    const SizeValueType rank = m_Entries / 2;
+
+    // Move to the coarse bin which holds the median.
+    while ( m_BelowCoarseBin > rank )
+      {
+      --m_CoarseBin;
+      m_BelowCoarseBin -= m_Coarse[m_CoarseBin];
+      }
+    while ( m_BelowCoarseBin + m_Coarse[m_CoarseBin] <= rank )
+      {
+      m_BelowCoarseBin += m_Coarse[m_CoarseBin];
+      ++m_CoarseBin;
+      }
+
+    // Then search its fine bins.
+    SizeValueType below = m_BelowCoarseBin;
+    unsigned int  bin = m_CoarseBin << FineBits;
+    while ( below + m_Fine[bin] <= rank )
+      {
+      below += m_Fine[bin];
+      ++bin;
+      }
+    return static_cast< TInputPixel >( static_cast< int >( bin )
+                                       + static_cast< int >( NumericTraits< TInputPixel >::NonpositiveMin() ) );
+  }
+
+private:
+  itkStaticConstMacro(FineBits, unsigned int, 4 * sizeof( TInputPixel ));
+
+  static unsigned int GetBin(const TInputPixel & p)
+  {
+    return static_cast< unsigned int >( static_cast< int >( p )
+                                        - static_cast< int >( NumericTraits< TInputPixel >::NonpositiveMin() ) );
+  }
+
+  std::vector< SizeValueType > m_Fine;
+  std::vector< SizeValueType > m_Coarse;
+  SizeValueType                m_Entries;
+  unsigned int                 m_CoarseBin;
+  SizeValueType                m_BelowCoarseBin;
+};
+
+template<>
+class MedianHistogram< unsigned char >:
+  public TieredMedianHistogram< unsigned char >
+{};
+
+template<>
+class MedianHistogram< signed char >:
+  public TieredMedianHistogram< signed char >
+{};
+
+template<>
+class MedianHistogram< char >:
+  public TieredMedianHistogram< char >
+{};
+
+template<>
+class MedianHistogram< unsigned short >:
+  public TieredMedianHistogram< unsigned short >
+{};
+
+template<>
+class MedianHistogram< short >:
+  public TieredMedianHistogram< short >
+{};
+} // end namespace Function
+} // end namespace itk
+
+#endif
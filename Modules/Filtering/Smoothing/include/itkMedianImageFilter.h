@@ -20,6 +20,10 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include "itkMedianHistogram.h"
+
+#include <vector>
+#include <algorithm>
 
 namespace itk
 {
@@ -35,6 +39,14 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * For 8 and 16 bit integer input pixel types, the filter slides a
+ * histogram of the neighborhood values along the lines of the image,
+ * updating it with the pixels which enter and leave the neighborhood, and
+ * reads the median from the histogram (see Function::MedianHistogram).
+ * The cost per pixel is then proportional to the size of a section of
+ * the neighborhood instead of its volume. Other pixel types sort the
+ * neighborhood of each pixel. Both give the same output.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -111,8 +123,38 @@ protected:
                             ThreadIdType threadId);
 
 private:
+  typedef Function::MedianHistogram< InputPixelType > HistogramType;
+
+  /** Computes the output region with a moving histogram. Only used when
+   * HistogramType::UseHistogramAlgorithm() is true. */
+  void ThreadedGenerateDataWithHistogram(const OutputImageRegionType & outputRegionForThread,
+                                         ThreadIdType threadId);
+
   MedianImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);    //purposely not implemented
+
+  /** Computes the median of a neighborhood by a partial sort. All of our
+   * neighborhoods have an odd number of pixels, so there is always a
+   * median index. */
+  struct MedianKernel
+  {
+    template< class TNeighborhood >
+    OutputPixelType operator()(const TNeighborhood & neighborhood)
+    {
+      const unsigned int neighborhoodSize = neighborhood.Size();
+      m_Pixels.resize(neighborhoodSize);
+      for ( unsigned int i = 0; i < neighborhoodSize; ++i )
+        {
+        m_Pixels[i] = neighborhood.GetPixel(i);
+        }
+      const typename std::vector< InputPixelType >::iterator medianIterator =
+        m_Pixels.begin() + neighborhoodSize / 2;
+      std::nth_element( m_Pixels.begin(), medianIterator, m_Pixels.end() );
+      return static_cast< OutputPixelType >( *medianIterator );
+    }
+
+    std::vector< InputPixelType > m_Pixels;
+  };
 };
 } // end namespace itk
 
@@ -22,6 +22,7 @@
 #include "itkConstNeighborhoodIterator.h"
 #include "itkNeighborhoodInnerProduct.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageLinearIteratorWithIndex.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
@@ -42,55 +43,120 @@ MedianImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename  InputImageType::ConstPointer input  = this->GetInput();
+  if ( HistogramType::UseHistogramAlgorithm() )
+    {
+    this->ThreadedGenerateDataWithHistogram(outputRegionForThread, threadId);
+    return;
+    }
 
-  // Find the data-set boundary "faces"
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType
-  faceList = bC( input, outputRegionForThread, this->GetRadius() );
+  ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
 
   // support progress methods/callbacks
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  // All of our neighborhoods have an odd number of pixels, so there is
-  // always a median index (if there where an even number of pixels
-  // in the neighborhood we have to average the middle two values).
+  // The neighborhoods of the non-boundary region are read without bounds
+  // checking, and the boundary faces use the boundary condition.
+  MedianKernel kernel;
+  NeighborhoodAlgorithm::ApplyNeighborhoodKernel(this->GetInput(), this->GetOutput(), outputRegionForThread,
+                                                 this->GetRadius(), &nbc, kernel, progress);
+}
 
-  ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
-  std::vector< InputPixelType >                      pixels;
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for ( typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator
-        fit = faceList.begin(); fit != faceList.end(); ++fit )
+template< class TInputImage, class TOutputImage >
+void
+MedianImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateDataWithHistogram(const OutputImageRegionType & outputRegionForThread,
+                                    ThreadIdType threadId)
+{
+  OutputImageType *     output = this->GetOutput();
+  const InputImageType *input = this->GetInput();
+
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+
+  // The neighborhood is made of rows along the dimension 0. The indices
+  // outside of the buffered region are clamped to its border, which is
+  // what the ZeroFluxNeumannBoundaryCondition does.
+  const InputSizeType                      radius = this->GetRadius();
+  const InputImageRegionType               bufferedRegion = input->GetBufferedRegion();
+  const typename InputImageType::IndexType bufferStart = bufferedRegion.GetIndex();
+  const InputSizeType                      bufferSize = bufferedRegion.GetSize();
+  const OffsetValueType *                  offsetTable = input->GetOffsetTable();
+  const InputPixelType *                   buffer = input->GetBufferPointer();
+  const OffsetValueType                    firstX = bufferStart[0];
+  const OffsetValueType                    lastX = firstX + static_cast< OffsetValueType >( bufferSize[0] ) - 1;
+
+  SizeValueType numberOfRows = 1;
+  for ( unsigned int d = 1; d < InputImageDimension; d++ )
     {
-    ImageRegionIterator< OutputImageType > it = ImageRegionIterator< OutputImageType >(output, *fit);
-
-    ConstNeighborhoodIterator< InputImageType > bit =
-      ConstNeighborhoodIterator< InputImageType >(this->GetRadius(), input, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
-    const unsigned int neighborhoodSize = bit.Size();
-    const unsigned int medianPosition = neighborhoodSize / 2;
-    while ( !bit.IsAtEnd() )
+    numberOfRows *= 2 * radius[d] + 1;
+    }
+  std::vector< const InputPixelType * > rows(numberOfRows);
+
+  HistogramType histogram;
+
+  ImageLinearIteratorWithIndex< OutputImageType > it(output, outputRegionForThread);
+  it.SetDirection(0);
+  for ( it.GoToBegin(); !it.IsAtEnd(); it.NextLine() )
+    {
+    const typename OutputImageType::IndexType index = it.GetIndex();
+    for ( SizeValueType r = 0; r < numberOfRows; r++ )
       {
-      // collect all the pixels in the neighborhood, note that we use
-      // GetPixel on the NeighborhoodIterator to honor the boundary conditions
-      pixels.resize(neighborhoodSize);
-      for ( unsigned int i = 0; i < neighborhoodSize; ++i )
+      OffsetValueType offset = 0;
+      SizeValueType   position = r;
+      for ( unsigned int d = 1; d < InputImageDimension; d++ )
         {
-        pixels[i] = ( bit.GetPixel(i) );
+        const SizeValueType   width = 2 * radius[d] + 1;
+        const OffsetValueType lastIndex = static_cast< OffsetValueType >( bufferSize[d] ) - 1;
+        OffsetValueType       i = index[d] - bufferStart[d] + static_cast< OffsetValueType >( position % width )
+                                  - static_cast< OffsetValueType >( radius[d] );
+        i = std::min( std::max( i, OffsetValueType( 0 ) ), lastIndex );
+        offset += i * offsetTable[d];
+        position /= width;
         }
+      rows[r] = buffer + offset - firstX;
+      }
 
-      // get the median value
-      const typename std::vector< InputPixelType >::iterator medianIterator = pixels.begin() + medianPosition;
-      std::nth_element( pixels.begin(), medianIterator, pixels.end() );
-      it.Set( static_cast< typename OutputImageType::PixelType >( *medianIterator ) );
-
-      ++bit;
-      ++it;
+    // Fill the histogram with the neighborhood of the first pixel of the
+    // line, then move it one pixel at a time.
+    const OffsetValueType radiusX = radius[0];
+    OffsetValueType       x = index[0];
+    for ( OffsetValueType j = x - radiusX; j <= x + radiusX; j++ )
+      {
+      const OffsetValueType clampedJ = std::min( std::max( j, firstX ), lastX );
+      for ( SizeValueType r = 0; r < numberOfRows; r++ )
+        {
+        histogram.AddPixel(rows[r][clampedJ]);
+        }
+      }
+    while ( true )
+      {
+      it.Set( static_cast< OutputPixelType >( histogram.GetMedian() ) );
       progress.CompletedPixel();
+      ++it;
+      if ( it.IsAtEndOfLine() )
+        {
+        break;
+        }
+      const OffsetValueType leaving = std::min( std::max( x - radiusX, firstX ), lastX );
+      const OffsetValueType entering = std::min( std::max( x + radiusX + 1, firstX ), lastX );
+      ++x;
+      if ( leaving != entering )
+        {
+        for ( SizeValueType r = 0; r < numberOfRows; r++ )
+          {
+          histogram.RemovePixel(rows[r][leaving]);
+          histogram.AddPixel(rows[r][entering]);
+          }
+        }
+      }
+
+    // Empty the histogram for the next line.
+    for ( OffsetValueType j = x - radiusX; j <= x + radiusX; j++ )
+      {
+      const OffsetValueType clampedJ = std::min( std::max( j, firstX ), lastX );
+      for ( SizeValueType r = 0; r < numberOfRows; r++ )
+        {
+        histogram.RemovePixel(rows[r][clampedJ]);
+        }
       }
     }
 }
@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMedianImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+namespace
+{
+/** Compare the median computed with the moving histogram for the integer
+ * pixel type TPixel with the median computed by sorting the neighborhoods
+ * of the same image converted to float, over the given output requested
+ * region, or the largest possible region when it is empty. */
+template< class TPixel, unsigned int VDimension >
+bool
+CompareMedianAlgorithms(const typename itk::Image< TPixel, VDimension >::SizeType & size,
+                        const typename itk::Image< TPixel, VDimension >::SizeType & radius,
+                        const typename itk::Image< TPixel, VDimension >::RegionType & requestedRegion,
+                        int minimum, int range, unsigned int numberOfThreads)
+{
+  typedef itk::Image< TPixel, VDimension > ImageType;
+  typedef itk::Image< float, VDimension >  FloatImageType;
+
+  typename ImageType::RegionType region;
+  region.SetSize(size);
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  typename FloatImageType::Pointer floatImage = FloatImageType::New();
+  floatImage->SetRegions(region);
+  floatImage->Allocate();
+
+  itk::ImageRegionIterator< ImageType >      it(image, region);
+  itk::ImageRegionIterator< FloatImageType > fit(floatImage, region);
+  unsigned int                               seed = 17;
+  for ( ; !it.IsAtEnd(); ++it, ++fit )
+    {
+    seed = seed * 1103515245 + 12345;
+    const int value = minimum + static_cast< int >( ( seed / 65536 ) % range );
+    it.Set( static_cast< TPixel >( value ) );
+    fit.Set( static_cast< float >( value ) );
+    }
+
+  typedef itk::MedianImageFilter< ImageType, ImageType >           FilterType;
+  typedef itk::MedianImageFilter< FloatImageType, FloatImageType > FloatFilterType;
+  typename FilterType::Pointer      filter = FilterType::New();
+  typename FloatFilterType::Pointer floatFilter = FloatFilterType::New();
+  filter->SetInput(image);
+  filter->SetRadius(radius);
+  filter->SetNumberOfThreads(numberOfThreads);
+  floatFilter->SetInput(floatImage);
+  floatFilter->SetRadius(radius);
+  if ( requestedRegion.GetNumberOfPixels() > 0 )
+    {
+    filter->GetOutput()->SetRequestedRegion(requestedRegion);
+    floatFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+    }
+  filter->Update();
+  floatFilter->Update();
+
+  itk::ImageRegionConstIteratorWithIndex< ImageType > oit( filter->GetOutput(),
+                                                           filter->GetOutput()->GetRequestedRegion() );
+  itk::ImageRegionConstIterator< FloatImageType >     foit( floatFilter->GetOutput(),
+                                                            filter->GetOutput()->GetRequestedRegion() );
+  for ( ; !oit.IsAtEnd(); ++oit, ++foit )
+    {
+    if ( static_cast< float >( oit.Get() ) != foit.Get() )
+      {
+      std::cerr << "Wrong median at " << oit.GetIndex() << ": " << static_cast< int >( oit.Get() )
+                << " instead of " << foit.Get() << " (size " << size << ", radius " << radius << ")"
+                << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkMedianImageFilterHistogramTest(int, char* [] )
+{
+  typedef itk::Image< unsigned char, 2 >  UCharImageType;
+  typedef itk::Image< short, 2 >          ShortImageType;
+  typedef itk::Image< unsigned short, 3 > UShort3DImageType;
+  typedef itk::Image< signed char, 3 >    SChar3DImageType;
+
+  bool passed = true;
+
+  UCharImageType::SizeType   size2D = { { 37, 23 } };
+  UCharImageType::SizeType   radii2D[3] = { { { 1, 1 } }, { { 4, 2 } }, { { 0, 7 } } };
+  UCharImageType::RegionType subRegion;
+  UCharImageType::IndexType  subRegionIndex = { { 5, 3 } };
+  UCharImageType::SizeType   subRegionSize = { { 20, 11 } };
+  subRegion.SetIndex(subRegionIndex);
+  subRegion.SetSize(subRegionSize);
+  for ( unsigned int r = 0; r < 3; r++ )
+    {
+    passed &= CompareMedianAlgorithms< unsigned char, 2 >(size2D, radii2D[r], UCharImageType::RegionType(),
+                                                          0, 256, 3);
+    passed &= CompareMedianAlgorithms< unsigned char, 2 >(size2D, radii2D[r], subRegion, 0, 256, 2);
+    passed &= CompareMedianAlgorithms< short, 2 >(size2D, radii2D[r], ShortImageType::RegionType(),
+                                                  -32768, 65536, 4);
+    // values grouped in a few coarse bins
+    passed &= CompareMedianAlgorithms< short, 2 >(size2D, radii2D[r], ShortImageType::RegionType(),
+                                                  -300, 600, 1);
+    }
+
+  // a neighborhood as large as the image
+  UCharImageType::SizeType smallSize = { { 12, 9 } };
+  UCharImageType::SizeType largeRadius = { { 5, 4 } };
+  passed &= CompareMedianAlgorithms< unsigned char, 2 >(smallSize, largeRadius, UCharImageType::RegionType(),
+                                                        0, 256, 1);
+
+  UShort3DImageType::SizeType size3D = { { 19, 13, 11 } };
+  UShort3DImageType::SizeType radius3D = { { 3, 2, 2 } };
+  passed &= CompareMedianAlgorithms< unsigned short, 3 >(size3D, radius3D, UShort3DImageType::RegionType(),
+                                                         0, 4096, 3);
+  passed &= CompareMedianAlgorithms< signed char, 3 >(size3D, radius3D, SChar3DImageType::RegionType(),
+                                                      -128, 256, 2);
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
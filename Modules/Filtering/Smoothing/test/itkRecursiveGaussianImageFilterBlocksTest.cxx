@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+/**
+ * The images of more than one dimension are filtered by blocks of lines
+ * filtered together. This test compares every line of their output with
+ * the output of the same line filtered alone as a 1D image.
+ */
+namespace
+{
+typedef itk::Image< float, 3 > ImageType;
+typedef itk::Image< float, 1 > LineImageType;
+
+bool
+CompareWithLines(const ImageType *image, unsigned int direction, unsigned int order,
+                 const ImageType::RegionType & requestedRegion)
+{
+  typedef itk::RecursiveGaussianImageFilter< ImageType, ImageType >         FilterType;
+  typedef itk::RecursiveGaussianImageFilter< LineImageType, LineImageType > LineFilterType;
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetDirection(direction);
+  filter->SetSigma(2.5);
+  filter->SetOrder( static_cast< FilterType::OrderEnumType >( order ) );
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+
+  const ImageType::RegionType outputRegion = filter->GetOutput()->GetBufferedRegion();
+  const unsigned int          ln = outputRegion.GetSize(direction);
+
+  LineImageType::Pointer    line = LineImageType::New();
+  LineImageType::RegionType lineRegion;
+  lineRegion.SetSize(0, ln);
+  line->SetRegions(lineRegion);
+  LineImageType::SpacingType lineSpacing;
+  lineSpacing[0] = image->GetSpacing()[direction];
+  line->SetSpacing(lineSpacing);
+  line->Allocate();
+
+  LineFilterType::Pointer lineFilter = LineFilterType::New();
+  lineFilter->SetInput(line);
+  lineFilter->SetSigma(2.5);
+  lineFilter->SetOrder( static_cast< LineFilterType::OrderEnumType >( order ) );
+
+  // Go through the first pixel of each line
+  ImageType::RegionType startRegion = outputRegion;
+  startRegion.SetSize(direction, 1);
+  itk::ImageRegionConstIteratorWithIndex< ImageType > startIt(image, startRegion);
+  for ( ; !startIt.IsAtEnd(); ++startIt )
+    {
+    ImageType::IndexType index = startIt.GetIndex();
+    for ( unsigned int i = 0; i < ln; i++ )
+      {
+      LineImageType::IndexType lineIndex = { { i } };
+      line->SetPixel( lineIndex, image->GetPixel(index) );
+      ++index[direction];
+      }
+    line->Modified();
+    lineFilter->Update();
+
+    index = startIt.GetIndex();
+    for ( unsigned int i = 0; i < ln; i++ )
+      {
+      LineImageType::IndexType lineIndex = { { i } };
+      const float              expected = lineFilter->GetOutput()->GetPixel(lineIndex);
+      const float              value = filter->GetOutput()->GetPixel(index);
+      if ( vcl_abs(expected - value) > 1e-5 * ( 1.0 + vcl_abs(expected) ) )
+        {
+        std::cerr << "Direction " << direction << ", order " << order << ": the value at "
+                  << index << " is " << value << " instead of " << expected << std::endl;
+        return false;
+        }
+      ++index[direction];
+      }
+    }
+  return true;
+}
+}
+
+int itkRecursiveGaussianImageFilterBlocksTest(int, char *[])
+{
+  // sizes which aren't multiples of the number of lines in a block
+  ImageType::Pointer    image = ImageType::New();
+  ImageType::SizeType   size = { { 19, 13, 11 } };
+  ImageType::RegionType region;
+  region.SetSize(size);
+  image->SetRegions(region);
+  ImageType::SpacingType spacing;
+  spacing[0] = 1.0;
+  spacing[1] = 0.5;
+  spacing[2] = 2.0;
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  unsigned int                                   seed = 1;
+  itk::ImageRegionIteratorWithIndex< ImageType > it(image, region);
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245 + 12345;
+    it.Set( static_cast< float >( ( seed / 65536 ) % 100 ) + 10.0f * it.GetIndex()[0] );
+    }
+
+  ImageType::RegionType subRegion;
+  ImageType::IndexType  subRegionIndex = { { 3, 2, 5 } };
+  ImageType::SizeType   subRegionSize = { { 9, 10, 4 } };
+  subRegion.SetIndex(subRegionIndex);
+  subRegion.SetSize(subRegionSize);
+
+  bool passed = true;
+  for ( unsigned int direction = 0; direction < 3; direction++ )
+    {
+    for ( unsigned int order = 0; order < 3; order++ )
+      {
+      passed &= CompareWithLines(image, direction, order, region);
+      }
+    passed &= CompareWithLines(image, direction, 0, subRegion);
+    }
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
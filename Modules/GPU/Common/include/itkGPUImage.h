@@ -67,6 +67,10 @@ namespace itk
     //
     void Allocate();
 
+    void AllocateUninitialized();
+
+    void AllocateAndFill(const TPixel & value);
+
     virtual void Initialize();
 
     void FillBuffer(const TPixel & value);
@@ -157,6 +161,9 @@ namespace itk
     GPUImage();
     virtual ~GPUImage();
 
+    /** Allocate the GPU memory matching the CPU buffer. */
+    void AllocateGPU();
+
   private:
 
     // functions that are purposely not implemented
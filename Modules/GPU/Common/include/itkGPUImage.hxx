@@ -27,6 +27,29 @@ namespace itk
     // allocate CPU memory - calling Allocate() in superclass
     Superclass::Allocate();
 
+    this->AllocateGPU();
+  }
+
+  template <class TPixel, unsigned int VImageDimension>
+  void GPUImage< TPixel, VImageDimension >::AllocateUninitialized()
+  {
+    Superclass::AllocateUninitialized();
+
+    this->AllocateGPU();
+  }
+
+  template <class TPixel, unsigned int VImageDimension>
+  void GPUImage< TPixel, VImageDimension >::AllocateAndFill(const TPixel & value)
+  {
+    Superclass::AllocateAndFill(value);
+
+    this->AllocateGPU();
+    m_GPUManager->SetGPUBufferDirty();
+  }
+
+  template <class TPixel, unsigned int VImageDimension>
+  void GPUImage< TPixel, VImageDimension >::AllocateGPU()
+  {
     // allocate GPU memory
     this->ComputeOffsetTable();
     unsigned long numPixel = this->GetOffsetTable()[VImageDimension];
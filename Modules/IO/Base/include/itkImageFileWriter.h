@@ -66,6 +66,10 @@ public:
  * with a suitable suffix (".png", ".jpg", etc) and setting the input
  * to the writer is enough to get the writer to work properly.
  *
+ * When the ImageIO supports streamed writing, the writer can update its
+ * input in pieces, either a given NumberOfStreamDivisions or as many as
+ * needed for the upstream pipeline to fit in a MemoryBudget.
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -154,6 +158,14 @@ public:
   itkSetMacro(NumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the maximum number of bytes of image data that the upstream
+   * pipeline may use to produce one piece. When it is not 0, the number of
+   * stream divisions is the smallest one whose pieces fit in the budget,
+   * according to the requested regions propagated by the pipeline, and
+   * NumberOfStreamDivisions is ignored. It is 0 by default. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
   /** Aliased to the Write() method to be consistent with the rest of the
    * pipeline. */
   virtual void Update()
@@ -195,6 +207,10 @@ protected:
   /** Does the real work. */
   void GenerateData(void);
 
+  /** Estimate the memory used upstream by the pieces given by the ImageIO
+   * when the image is written in numberOfDivisions. */
+  virtual SizeValueType EstimateStreamedPieceMemorySize(unsigned int numberOfDivisions);
+
 private:
   ImageFileWriter(const Self &); //purposely not implemented
   void operator=(const Self &);  //purposely not implemented
@@ -207,6 +223,7 @@ private:
 
   ImageIORegion m_PasteIORegion;
   unsigned int  m_NumberOfStreamDivisions;
+  SizeValueType m_MemoryBudget;
   bool          m_UserSpecifiedIORegion;    // track whether the region
                                             // is user specified
   bool m_FactorySpecifiedImageIO;           //track whether the factory
@@ -32,6 +32,7 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
+#include <algorithm>
 #include <complex>
 
 namespace itk
@@ -48,6 +49,7 @@ ImageFileWriter< TInputImage >
   m_UserSpecifiedIORegion = false;
   m_UserSpecifiedImageIO = false;
   m_NumberOfStreamDivisions = 1;
+  m_MemoryBudget = 0;
 }
 
 //---------------------------------------------------------
@@ -261,11 +263,6 @@ ImageFileWriter< TInputImage >
   // Notify start event observers
   this->InvokeEvent( StartEvent() );
 
-  if ( m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion )
-    {
-    m_ImageIO->SetUseStreamedWriting(true);
-    }
-
   ImageIORegion largestIORegion(TInputImage::ImageDimension);
   ImageIORegionAdaptor< TInputImage::ImageDimension >::
   Convert( largestRegion, largestIORegion, largestRegion.GetIndex() );
@@ -291,12 +288,31 @@ ImageFileWriter< TInputImage >
       << "Largest possible region: " << largestRegion);
     }
 
+  // Determin the number of divisions requested, from the memory budget
+  // when there is one
+  unsigned int numberOfStreamDivisions = m_NumberOfStreamDivisions;
+  if ( m_MemoryBudget > 0 )
+    {
+    const unsigned int maximumNumberOfDivisions =
+      m_ImageIO->GetActualNumberOfSplitsForWriting(static_cast< unsigned int >( NumericTraits< int >::max() ),
+                                                   pasteIORegion,
+                                                   largestIORegion);
+    numberOfStreamDivisions = this->PlanNumberOfStreamDivisions(m_MemoryBudget, maximumNumberOfDivisions);
+    itkDebugMacro(<< "Streaming in " << numberOfStreamDivisions << " pieces for a memory budget of "
+                  << m_MemoryBudget << " bytes");
+    }
+
+  if ( numberOfStreamDivisions > 1 || m_UserSpecifiedIORegion )
+    {
+    m_ImageIO->SetUseStreamedWriting(true);
+    }
+
   // Determin the actual number of divisions of the input. This is determined
   // by what the ImageIO can do
   unsigned int numDivisions;
 
   // this may fail and throw an exception if the configuration is not supported
-  numDivisions = m_ImageIO->GetActualNumberOfSplitsForWriting(m_NumberOfStreamDivisions,
+  numDivisions = m_ImageIO->GetActualNumberOfSplitsForWriting(numberOfStreamDivisions,
                                                               pasteIORegion,
                                                               largestIORegion);
 
@@ -390,7 +406,7 @@ ImageFileWriter< TInputImage >
   // before this test, bad stuff would happend when they don't match
   if ( bufferedRegion != ioRegion )
     {
-    if ( m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion )
+    if ( m_NumberOfStreamDivisions > 1 || m_MemoryBudget > 0 || m_UserSpecifiedIORegion )
       {
       itkDebugMacro("Requested stream region does not match generated output");
       itkDebugMacro("input filter may not support streaming well");
@@ -422,6 +438,43 @@ ImageFileWriter< TInputImage >
   m_ImageIO->Write(dataPtr);
 }
 
+//---------------------------------------------------------
+template< class TInputImage >
+SizeValueType
+ImageFileWriter< TInputImage >
+::EstimateStreamedPieceMemorySize(unsigned int numberOfDivisions)
+{
+  InputImageType *           input = const_cast< InputImageType * >( this->GetInput() );
+  const InputImageRegionType largestRegion = input->GetLargestPossibleRegion();
+
+  ImageIORegion largestIORegion(TInputImage::ImageDimension);
+  ImageIORegionAdaptor< TInputImage::ImageDimension >::
+  Convert( largestRegion, largestIORegion, largestRegion.GetIndex() );
+  const ImageIORegion pasteIORegion = m_UserSpecifiedIORegion ? m_PasteIORegion : largestIORegion;
+
+  numberOfDivisions = m_ImageIO->GetActualNumberOfSplitsForWriting(numberOfDivisions,
+                                                                   pasteIORegion,
+                                                                   largestIORegion);
+
+  // the first piece is on the boundary of the image and the middle one
+  // inside, where the requested regions are enlarged the most
+  SizeValueType      size = 0;
+  const unsigned int pieces[2] = { 0, numberOfDivisions / 2 };
+  for ( unsigned int i = 0; i < 2; i++ )
+    {
+    const ImageIORegion streamIORegion = m_ImageIO->GetSplitRegionForWriting(pieces[i], numberOfDivisions,
+                                                                             pasteIORegion,
+                                                                             largestIORegion);
+    InputImageRegionType streamRegion;
+    ImageIORegionAdaptor< TInputImage::ImageDimension >::
+    Convert( streamIORegion, streamRegion, largestRegion.GetIndex() );
+    input->SetRequestedRegion(streamRegion);
+    input->PropagateRequestedRegion();
+    size = std::max( size, this->EstimateUpstreamMemorySize() );
+    }
+  return size;
+}
+
 //---------------------------------------------------------
 template< class TInputImage >
 void
@@ -445,6 +498,7 @@ ImageFileWriter< TInputImage >
 
   os << indent << "IO Region: " << m_PasteIORegion << "\n";
   os << indent << "Number of Stream Divisions: " << m_NumberOfStreamDivisions << "\n";
+  os << indent << "Memory Budget: " << m_MemoryBudget << "\n";
 
   if ( m_UseCompression )
     {
@@ -0,0 +1,25 @@
+set(DOCUMENTATION "This module contains a benchmark driver that measures the
+throughput of frequently used filters, metrics and image readers of the toolkit
+on synthetic images. Its machine-readable output lets performance regressions be
+tracked between versions. It is not built unless it is explicitly requested.")
+
+itk_module(ITKBenchmarks
+  DEPENDS
+    ITKCommon
+    ITKConnectedComponents
+    ITKDistanceMap
+    ITKImageFunction
+    ITKImageGrid
+    ITKIOBase
+    ITKIOMeta
+    ITKIONIFTI
+    ITKIONRRD
+    ITKKWSys
+    ITKRegistrationCommon
+    ITKSmoothing
+    ITKTestKernel
+    ITKTransform
+  EXCLUDE_FROM_ALL
+  DESCRIPTION
+    "${DOCUMENTATION}"
+)
@@ -0,0 +1,588 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Measures the throughput, in megavoxels per second, of frequently used
+// filters, metrics and image readers on random 3D images of several sizes
+// and for several numbers of threads.
+//
+// Usage: itkBenchmarks [--sizes 64,128] [--threads 1,2,4] [--repetitions 3]
+//                      [--benchmark Name]... [--format text|csv|json]
+//                      [--output file] [--temporary-directory dir] [--list]
+//
+// Every measurement is repeated and the fastest run is reported, together
+// with the mean time. The CSV and JSON formats are meant to be archived and
+// compared between versions of the toolkit.
+
+#include "itkRandomImageSource.h"
+#include "itkRealTimeClock.h"
+#include "itkMultiThreader.h"
+#include "itkVersion.h"
+
+#include "itkAffineTransform.h"
+#include "itkConnectedComponentImageFilter.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkMattesMutualInformationImageToImageMetric.h"
+#include "itkMedianImageFilter.h"
+#include "itkMetaImageIOFactory.h"
+#include "itkNiftiImageIOFactory.h"
+#include "itkNrrdImageIOFactory.h"
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkResampleImageFilter.h"
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkTranslationTransform.h"
+
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+const unsigned int Dimension = 3;
+
+/** Parameters of one measurement. */
+struct BenchmarkSettings {
+  unsigned int Size;
+  itk::ThreadIdType NumberOfThreads;
+  unsigned int Repetitions;
+  std::string TemporaryDirectory;
+};
+
+/** Fastest and mean time of the repetitions of a measurement, in
+ * seconds. */
+struct Timing {
+  double Minimum;
+  double Mean;
+
+  Timing():Minimum( std::numeric_limits< double >::max() ), Mean(0) {}
+
+  void Add(double time, unsigned int repetitions)
+  {
+    Minimum = std::min(Minimum, time);
+    Mean += time / repetitions;
+  }
+};
+
+/** A benchmark: a function measuring one filter for one pixel type.
+ * Argument is passed to the function unchanged. */
+struct BenchmarkType {
+  const char *Name;
+  const char *PixelType;
+  bool Threaded;
+  const char *Argument;
+  Timing (*Run)(const BenchmarkSettings & settings, const char *argument);
+};
+
+/** Result of one measurement. */
+struct ResultType {
+  std::string Name;
+  std::string PixelType;
+  unsigned int Size;
+  itk::ThreadIdType NumberOfThreads;
+  unsigned int Repetitions;
+  Timing Time;
+
+  double GetMegavoxelsPerSecond() const
+  {
+    const double numberOfPixels = static_cast< double >( Size ) * Size * Size;
+    return Time.Minimum > 0 ? numberOfPixels / Time.Minimum / 1e6 : 0;
+  }
+};
+
+double GetTime()
+{
+  static itk::RealTimeClock::Pointer clock = itk::RealTimeClock::New();
+  return clock->GetTimeInSeconds();
+}
+
+template< class TImage >
+typename TImage::Pointer
+CreateRandomImage(unsigned int size, typename TImage::PixelType minimum,
+                  typename TImage::PixelType maximum)
+{
+  typedef itk::RandomImageSource< TImage > SourceType;
+
+  typename TImage::SizeType imageSize;
+  imageSize.Fill(size);
+
+  typename SourceType::Pointer source = SourceType::New();
+  source->SetSize(imageSize);
+  source->SetMin(minimum);
+  source->SetMax(maximum);
+  source->Update();
+
+  typename TImage::Pointer image = source->GetOutput();
+  image->DisconnectPipeline();
+  return image;
+}
+
+/** Time the re-execution of the pipeline from first to last. */
+Timing TimeUpdates(itk::ProcessObject *first, itk::ProcessObject *last,
+                   unsigned int repetitions)
+{
+  Timing timing;
+
+  for ( unsigned int r = 0; r < repetitions; r++ )
+    {
+    first->Modified();
+    const double start = GetTime();
+    last->Update();
+    timing.Add(GetTime() - start, repetitions);
+    }
+  return timing;
+}
+
+template< class TPixel >
+Timing BenchmarkResample(const BenchmarkSettings & settings, const char *)
+{
+  typedef itk::Image< TPixel, Dimension >                      ImageType;
+  typedef itk::ResampleImageFilter< ImageType, ImageType >     FilterType;
+  typedef itk::AffineTransform< double, Dimension >            TransformType;
+
+  typename ImageType::Pointer image = CreateRandomImage< ImageType >(settings.Size, 0, 100);
+
+  // a small rotation around the center of the image
+  typename TransformType::Pointer           transform = TransformType::New();
+  typename TransformType::InputPointType    center;
+  for ( unsigned int d = 0; d < Dimension; d++ )
+    {
+    center[d] = 0.5 * settings.Size;
+    }
+  transform->SetCenter(center);
+  transform->Rotate(0, 1, 0.1);
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetTransform(transform);
+  filter->SetOutputParametersFromImage(image);
+  filter->SetNumberOfThreads(settings.NumberOfThreads);
+  return TimeUpdates(filter, filter, settings.Repetitions);
+}
+
+template< class TPixel >
+Timing BenchmarkDiscreteGaussian(const BenchmarkSettings & settings, const char *)
+{
+  typedef itk::Image< TPixel, Dimension >                              InputImageType;
+  typedef itk::Image< float, Dimension >                               OutputImageType;
+  typedef itk::DiscreteGaussianImageFilter< InputImageType, OutputImageType > FilterType;
+
+  typename InputImageType::Pointer image = CreateRandomImage< InputImageType >(settings.Size, 0, 100);
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetVariance(4.0);
+  filter->SetMaximumKernelWidth(32);
+  filter->SetNumberOfThreads(settings.NumberOfThreads);
+  return TimeUpdates(filter, filter, settings.Repetitions);
+}
+
+template< class TPixel >
+Timing BenchmarkRecursiveGaussian(const BenchmarkSettings & settings, const char *)
+{
+  typedef itk::Image< TPixel, Dimension >                                     ImageType;
+  typedef itk::RecursiveGaussianImageFilter< ImageType, ImageType >          FilterType;
+
+  typename ImageType::Pointer image = CreateRandomImage< ImageType >(settings.Size, 0, 100);
+
+  // smooth along every direction, as SmoothingRecursiveGaussianImageFilter
+  typename FilterType::Pointer filters[Dimension];
+  for ( unsigned int d = 0; d < Dimension; d++ )
+    {
+    filters[d] = FilterType::New();
+    filters[d]->SetInput( d == 0 ? image.GetPointer() : filters[d - 1]->GetOutput() );
+    filters[d]->SetDirection(d);
+    filters[d]->SetSigma(2.0);
+    filters[d]->SetNumberOfThreads(settings.NumberOfThreads);
+    }
+  return TimeUpdates(filters[0], filters[Dimension - 1], settings.Repetitions);
+}
+
+template< class TPixel >
+Timing BenchmarkMedian(const BenchmarkSettings & settings, const char *)
+{
+  typedef itk::Image< TPixel, Dimension >                  ImageType;
+  typedef itk::MedianImageFilter< ImageType, ImageType >   FilterType;
+
+  typename ImageType::Pointer image = CreateRandomImage< ImageType >(settings.Size, 0, 100);
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetRadius(1);
+  filter->SetNumberOfThreads(settings.NumberOfThreads);
+  return TimeUpdates(filter, filter, settings.Repetitions);
+}
+
+template< class TPixel >
+Timing BenchmarkConnectedComponent(const BenchmarkSettings & settings, const char *)
+{
+  typedef itk::Image< TPixel, Dimension >                                    InputImageType;
+  typedef itk::Image< unsigned int, Dimension >                              OutputImageType;
+  typedef itk::ConnectedComponentImageFilter< InputImageType, OutputImageType > FilterType;
+
+  // half of the pixels are foreground
+  typename InputImageType::Pointer image = CreateRandomImage< InputImageType >(settings.Size, 0, 2);
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetNumberOfThreads(settings.NumberOfThreads);
+  return TimeUpdates(filter, filter, settings.Repetitions);
+}
+
+template< class TPixel >
+Timing BenchmarkSignedMaurerDistanceMap(const BenchmarkSettings & settings, const char *)
+{
+  typedef itk::Image< TPixel, Dimension >                                           InputImageType;
+  typedef itk::Image< float, Dimension >                                            OutputImageType;
+  typedef itk::SignedMaurerDistanceMapImageFilter< InputImageType, OutputImageType > FilterType;
+
+  typename InputImageType::Pointer image = CreateRandomImage< InputImageType >(settings.Size, 0, 2);
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetNumberOfThreads(settings.NumberOfThreads);
+  return TimeUpdates(filter, filter, settings.Repetitions);
+}
+
+template< class TPixel >
+Timing BenchmarkMattesMutualInformation(const BenchmarkSettings & settings, const char *)
+{
+  typedef itk::Image< TPixel, Dimension >                                          ImageType;
+  typedef itk::MattesMutualInformationImageToImageMetric< ImageType, ImageType >   MetricType;
+  typedef itk::TranslationTransform< double, Dimension >                           TransformType;
+  typedef itk::LinearInterpolateImageFunction< ImageType, double >                 InterpolatorType;
+
+  typename ImageType::Pointer fixedImage = CreateRandomImage< ImageType >(settings.Size, 0, 100);
+  typename ImageType::Pointer movingImage = CreateRandomImage< ImageType >(settings.Size, 0, 100);
+
+  typename TransformType::Pointer transform = TransformType::New();
+  transform->SetIdentity();
+
+  typename MetricType::Pointer metric = MetricType::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetFixedImageRegion( fixedImage->GetBufferedRegion() );
+  metric->SetTransform(transform);
+  metric->SetInterpolator( InterpolatorType::New() );
+  metric->SetNumberOfHistogramBins(50);
+  metric->UseAllPixelsOn();
+  metric->SetNumberOfThreads(settings.NumberOfThreads);
+  metric->Initialize();
+
+  typename MetricType::ParametersType parameters = transform->GetParameters();
+  typename MetricType::MeasureType    value;
+  typename MetricType::DerivativeType derivative;
+
+  // the metric and its derivative, as evaluated by gradient descent
+  Timing timing;
+  for ( unsigned int r = 0; r < settings.Repetitions; r++ )
+    {
+    const double start = GetTime();
+    metric->GetValueAndDerivative(parameters, value, derivative);
+    timing.Add(GetTime() - start, settings.Repetitions);
+    }
+  return timing;
+}
+
+template< class TPixel >
+Timing BenchmarkImageFileReader(const BenchmarkSettings & settings, const char *extension)
+{
+  typedef itk::Image< TPixel, Dimension >      ImageType;
+  typedef itk::ImageFileWriter< ImageType >    WriterType;
+  typedef itk::ImageFileReader< ImageType >    ReaderType;
+
+  const std::string fileName = settings.TemporaryDirectory + "/itkBenchmarkImage" + extension;
+
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( CreateRandomImage< ImageType >(settings.Size, 0, 100) );
+  writer->SetFileName(fileName);
+  writer->Update();
+
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  const Timing timing = TimeUpdates(reader, reader, settings.Repetitions);
+
+  itksys::SystemTools::RemoveFile( fileName.c_str() );
+  return timing;
+}
+
+const BenchmarkType Benchmarks[] = {
+  { "ResampleImageFilter", "float", true, 0, &BenchmarkResample< float > },
+  { "ResampleImageFilter", "short", true, 0, &BenchmarkResample< short > },
+  { "DiscreteGaussianImageFilter", "float", true, 0, &BenchmarkDiscreteGaussian< float > },
+  { "DiscreteGaussianImageFilter", "unsigned char", true, 0, &BenchmarkDiscreteGaussian< unsigned char > },
+  { "RecursiveGaussianImageFilter", "float", true, 0, &BenchmarkRecursiveGaussian< float > },
+  { "MedianImageFilter", "unsigned char", true, 0, &BenchmarkMedian< unsigned char > },
+  { "MedianImageFilter", "short", true, 0, &BenchmarkMedian< short > },
+  { "MedianImageFilter", "float", true, 0, &BenchmarkMedian< float > },
+  { "ConnectedComponentImageFilter", "unsigned char", true, 0, &BenchmarkConnectedComponent< unsigned char > },
+  { "SignedMaurerDistanceMapImageFilter", "unsigned char", true, 0,
+    &BenchmarkSignedMaurerDistanceMap< unsigned char > },
+  { "MattesMutualInformationImageToImageMetric", "float", true, 0,
+    &BenchmarkMattesMutualInformation< float > },
+  { "MetaImageIO", "short", false, ".mha", &BenchmarkImageFileReader< short > },
+  { "NrrdImageIO", "short", false, ".nrrd", &BenchmarkImageFileReader< short > },
+  { "NiftiImageIO", "short", false, ".nii", &BenchmarkImageFileReader< short > },
+  { "MetaImageIO", "float", false, ".mha", &BenchmarkImageFileReader< float > }
+};
+
+const unsigned int NumberOfBenchmarks = sizeof( Benchmarks ) / sizeof( Benchmarks[0] );
+
+/** Parse a comma separated list of positive integers. */
+bool ParseList(const char *text, std::vector< unsigned int > & values)
+{
+  values.clear();
+  std::istringstream stream(text);
+  std::string        item;
+  while ( std::getline(stream, item, ',') )
+    {
+    const int value = atoi( item.c_str() );
+    if ( value <= 0 )
+      {
+      return false;
+      }
+    values.push_back(value);
+    }
+  return !values.empty();
+}
+
+void PrintText(std::ostream & os, const std::vector< ResultType > & results)
+{
+  os << std::left << std::setw(44) << "Benchmark" << std::setw(15) << "Pixel" << std::right
+     << std::setw(6) << "Size" << std::setw(9) << "Threads"
+     << std::setw(13) << "Min (s)" << std::setw(13) << "Mean (s)"
+     << std::setw(12) << "MVoxels/s" << std::endl;
+  for ( size_t i = 0; i < results.size(); i++ )
+    {
+    const ResultType & r = results[i];
+    os << std::left << std::setw(44) << r.Name << std::setw(15) << r.PixelType << std::right
+       << std::setw(6) << r.Size << std::setw(9) << r.NumberOfThreads
+       << std::fixed << std::setprecision(6)
+       << std::setw(13) << r.Time.Minimum << std::setw(13) << r.Time.Mean
+       << std::setprecision(2) << std::setw(12) << r.GetMegavoxelsPerSecond()
+       << std::endl;
+    }
+}
+
+void PrintCSV(std::ostream & os, const std::vector< ResultType > & results)
+{
+  os << "Benchmark,PixelType,Size,Threads,Repetitions,MinimumTime,MeanTime,MegavoxelsPerSecond"
+     << std::endl;
+  for ( size_t i = 0; i < results.size(); i++ )
+    {
+    const ResultType & r = results[i];
+    os << r.Name << "," << r.PixelType << "," << r.Size << "," << r.NumberOfThreads << ","
+       << r.Repetitions << "," << r.Time.Minimum << "," << r.Time.Mean << ","
+       << r.GetMegavoxelsPerSecond() << std::endl;
+    }
+}
+
+void PrintJSON(std::ostream & os, const std::vector< ResultType > & results)
+{
+  os << "{" << std::endl
+     << "  \"ITKVersion\": \"" << itk::Version::GetITKVersion() << "\"," << std::endl
+     << "  \"NumberOfCPUs\": " << itk::MultiThreader::GetGlobalDefaultNumberOfThreads()
+     << "," << std::endl
+     << "  \"Results\": [";
+  for ( size_t i = 0; i < results.size(); i++ )
+    {
+    const ResultType & r = results[i];
+    os << ( i > 0 ? "," : "" ) << std::endl
+       << "    { \"Benchmark\": \"" << r.Name << "\", \"PixelType\": \"" << r.PixelType
+       << "\", \"Size\": " << r.Size << ", \"Threads\": " << r.NumberOfThreads
+       << ", \"Repetitions\": " << r.Repetitions
+       << ", \"MinimumTime\": " << r.Time.Minimum << ", \"MeanTime\": " << r.Time.Mean
+       << ", \"MegavoxelsPerSecond\": " << r.GetMegavoxelsPerSecond() << " }";
+    }
+  os << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+void Usage(const char *program)
+{
+  std::cerr << "Usage: " << program << " [--sizes 64,128] [--threads 1,2,4] [--repetitions 3]"
+            << std::endl
+            << "         [--benchmark Name]... [--format text|csv|json] [--output file]"
+            << std::endl
+            << "         [--temporary-directory dir] [--list]" << std::endl;
+}
+}
+
+int main(int argc, char *argv[])
+{
+  std::vector< unsigned int > sizes;
+  sizes.push_back(64);
+  sizes.push_back(128);
+
+  // 1, 2, 4, ... up to the number of processors
+  std::vector< unsigned int > threads;
+  const unsigned int          numberOfCPUs = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+  for ( unsigned int t = 1; t < numberOfCPUs; t *= 2 )
+    {
+    threads.push_back(t);
+    }
+  threads.push_back(numberOfCPUs);
+
+  unsigned int               repetitions = 3;
+  std::vector< std::string > selected;
+  std::string                format = "text";
+  std::string                outputFileName;
+  std::string                temporaryDirectory = ".";
+
+  for ( int i = 1; i < argc; i++ )
+    {
+    const std::string option = argv[i];
+    if ( option == "--list" )
+      {
+      for ( unsigned int b = 0; b < NumberOfBenchmarks; b++ )
+        {
+        std::cout << Benchmarks[b].Name << " (" << Benchmarks[b].PixelType << ")" << std::endl;
+        }
+      return EXIT_SUCCESS;
+      }
+    if ( i + 1 >= argc )
+      {
+      Usage(argv[0]);
+      return EXIT_FAILURE;
+      }
+    const char *value = argv[++i];
+    if ( ( option == "--sizes" && ParseList(value, sizes) )
+         || ( option == "--threads" && ParseList(value, threads) ) )
+      {
+      continue;
+      }
+    else if ( option == "--repetitions" && atoi(value) > 0 )
+      {
+      repetitions = atoi(value);
+      }
+    else if ( option == "--benchmark" )
+      {
+      selected.push_back(value);
+      }
+    else if ( option == "--format"
+              && ( !strcmp(value, "text") || !strcmp(value, "csv") || !strcmp(value, "json") ) )
+      {
+      format = value;
+      }
+    else if ( option == "--output" )
+      {
+      outputFileName = value;
+      }
+    else if ( option == "--temporary-directory" )
+      {
+      temporaryDirectory = value;
+      }
+    else
+      {
+      Usage(argv[0]);
+      return EXIT_FAILURE;
+      }
+    }
+
+  itk::ObjectFactoryBase::RegisterFactory( itk::MetaImageIOFactory::New() );
+  itk::ObjectFactoryBase::RegisterFactory( itk::NrrdImageIOFactory::New() );
+  itk::ObjectFactoryBase::RegisterFactory( itk::NiftiImageIOFactory::New() );
+
+  std::vector< ResultType > results;
+  for ( unsigned int b = 0; b < NumberOfBenchmarks; b++ )
+    {
+    const BenchmarkType & benchmark = Benchmarks[b];
+
+    bool run = selected.empty();
+    for ( size_t s = 0; s < selected.size(); s++ )
+      {
+      run = run || selected[s] == benchmark.Name;
+      }
+    if ( !run )
+      {
+      continue;
+      }
+
+    for ( size_t s = 0; s < sizes.size(); s++ )
+      {
+      // the readers do not use threads
+      const size_t numberOfThreadCounts = benchmark.Threaded ? threads.size() : 1;
+      for ( size_t t = 0; t < numberOfThreadCounts; t++ )
+        {
+        BenchmarkSettings settings;
+        settings.Size = sizes[s];
+        settings.NumberOfThreads = benchmark.Threaded ? threads[t] : 1;
+        settings.Repetitions = repetitions;
+        settings.TemporaryDirectory = temporaryDirectory;
+
+        ResultType result;
+        result.Name = benchmark.Name;
+        result.PixelType = benchmark.PixelType;
+        result.Size = settings.Size;
+        result.NumberOfThreads = settings.NumberOfThreads;
+        result.Repetitions = repetitions;
+        try
+          {
+          result.Time = benchmark.Run(settings, benchmark.Argument);
+          }
+        catch ( itk::ExceptionObject & excp )
+          {
+          std::cerr << benchmark.Name << " (" << benchmark.PixelType << ") failed:" << std::endl
+                    << excp << std::endl;
+          return EXIT_FAILURE;
+          }
+        results.push_back(result);
+
+        // progress on the console when the report goes to a file
+        if ( !outputFileName.empty() )
+          {
+          std::cout << result.Name << " (" << result.PixelType << ") size " << result.Size
+                    << ", " << result.NumberOfThreads << " threads: "
+                    << result.GetMegavoxelsPerSecond() << " MVoxels/s" << std::endl;
+          }
+        }
+      }
+    }
+
+  std::ofstream outputFile;
+  if ( !outputFileName.empty() )
+    {
+    outputFile.open( outputFileName.c_str() );
+    if ( !outputFile )
+      {
+      std::cerr << "Cannot write " << outputFileName << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  std::ostream & os = outputFileName.empty() ? std::cout : outputFile;
+
+  if ( format == "csv" )
+    {
+    PrintCSV(os, results);
+    }
+  else if ( format == "json" )
+    {
+    PrintJSON(os, results);
+    }
+  else
+    {
+    PrintText(os, results);
+    }
+  return EXIT_SUCCESS;
+}
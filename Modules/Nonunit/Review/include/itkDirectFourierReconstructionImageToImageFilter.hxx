@@ -209,8 +209,7 @@ void DirectFourierReconstructionImageToImageFilter< TInputImage, TOutputImage >:
   pRegion.SetSize(pSize);
   pRegion.SetIndex(pStart);
   projectionLine->SetRegions(pRegion);
-  projectionLine->Allocate();
-  projectionLine->FillBuffer(0);
+  projectionLine->AllocateAndFill(0);
 
   ProjectionLineType::IndexType pIdx;
   const unsigned int            pLineHalfShift = pSize[0] - inputROISize[m_RDirection] / 2;
@@ -239,8 +238,7 @@ void DirectFourierReconstructionImageToImageFilter< TInputImage, TOutputImage >:
 
   FFTSliceType::Pointer FFTSlice = FFTSliceType::New();
   FFTSlice->SetRegions(FFTSliceRegion);
-  FFTSlice->Allocate();
-  FFTSlice->FillBuffer(0);
+  FFTSlice->AllocateAndFill(0);
 
   FFTSliceIteratorType    FFTSliceIt (FFTSlice, FFTSliceRegion);
   FFTSliceType::IndexType sIdx;
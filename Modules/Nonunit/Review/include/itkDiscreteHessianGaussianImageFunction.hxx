@@ -133,8 +133,7 @@ DiscreteHessianGaussianImageFunction< TInputImage, TOutput >
   region.SetSize(size);
 
   kernelImage->SetRegions(region);
-  kernelImage->Allocate();
-  kernelImage->FillBuffer(itk::NumericTraits< TOutput >::Zero);
+  kernelImage->AllocateAndFill(itk::NumericTraits< TOutput >::Zero);
 
   // Initially the kernel image will be an impulse at the center
   typename KernelImageType::IndexType centerIndex;
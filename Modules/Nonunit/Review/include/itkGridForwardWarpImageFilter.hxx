@@ -75,8 +75,7 @@ GridForwardWarpImageFilter< TDisplacementField, TOutputImage >
   outputPtr->SetRegions( fieldPtr->GetRequestedRegion() );
   outputPtr->SetOrigin( fieldPtr->GetOrigin() );
   outputPtr->SetSpacing(spacing);
-  outputPtr->Allocate();
-  outputPtr->FillBuffer(m_BackgroundValue);
+  outputPtr->AllocateAndFill(m_BackgroundValue);
 
   IndexType FirstIndex = fieldPtr->GetRequestedRegion().GetIndex();
   IndexType LastIndex = fieldPtr->GetRequestedRegion().GetIndex()
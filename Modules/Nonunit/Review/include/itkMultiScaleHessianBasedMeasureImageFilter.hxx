@@ -158,8 +158,7 @@ MultiScaleHessianBasedMeasureImageFilter
       dynamic_cast< ScalesImageType * >( this->ProcessObject::GetOutput(1) );
 
     scalesImage->SetBufferedRegion( scalesImage->GetRequestedRegion() );
-    scalesImage->Allocate();
-    scalesImage->FillBuffer(0);
+    scalesImage->AllocateAndFill(0);
     }
 
   if ( m_GenerateHessianOutput )
@@ -1030,8 +1030,7 @@ MultiphaseSparseFiniteDifferenceImageFilter< TInputImage, TFeatureImage, TOutput
     sparsePtr->m_StatusImage->SetRegions (
       this->m_LevelSet[fId]->GetRequestedRegion() );
     sparsePtr->m_StatusImage->CopyInformation(this->m_LevelSet[fId]);
-    sparsePtr->m_StatusImage->Allocate();
-    sparsePtr->m_StatusImage->FillBuffer(m_StatusNull);  //NonpositiveMin
+    sparsePtr->m_StatusImage->AllocateAndFill(m_StatusNull);  //NonpositiveMin
 
     // Initialize the boundary pixels in the status image to
     // m_StatusBoundaryPixel values.  Uses the face calculator to find all of
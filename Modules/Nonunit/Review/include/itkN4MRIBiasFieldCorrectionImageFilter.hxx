@@ -118,8 +118,7 @@ N4MRIBiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
   RealImagePointer logBiasField = RealImageType::New();
   logBiasField->CopyInformation( inputImage );
   logBiasField->SetRegions( inputImage->GetLargestPossibleRegion() );
-  logBiasField->Allocate();
-  logBiasField->FillBuffer( 0.0 );
+  logBiasField->AllocateAndFill( 0.0 );
 
 
   // Iterate until convergence or iterative exhaustion.
@@ -425,8 +424,7 @@ N4MRIBiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
   RealImagePointer sharpenedImage = RealImageType::New();
   sharpenedImage->CopyInformation( inputImage );
   sharpenedImage->SetRegions( inputImage->GetLargestPossibleRegion() );
-  sharpenedImage->Allocate();
-  sharpenedImage->FillBuffer( 0.0 );
+  sharpenedImage->AllocateAndFill( 0.0 );
 
   ImageRegionIterator<RealImageType> ItC(
     sharpenedImage, sharpenedImage->GetLargestPossibleRegion() );
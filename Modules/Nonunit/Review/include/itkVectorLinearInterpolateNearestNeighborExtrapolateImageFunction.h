@@ -114,6 +114,18 @@ public:
     return true;
   }
 
+  /** Every point of a line is inside the buffer, since IsInsideBuffer()
+   * always answers true. */
+  virtual void ComputeLinePartInsideBuffer(const ContinuousIndexType &,
+                                           const typename ContinuousIndexType::VectorType &,
+                                           SizeValueType numberOfPoints,
+                                           SizeValueType & begin,
+                                           SizeValueType & end) const
+  {
+    begin = 0;
+    end = numberOfPoints;
+  }
+
   /** Evaluate the function at a ContinuousIndex position
    *
    * Returns the linearly interpolated image intensity at a
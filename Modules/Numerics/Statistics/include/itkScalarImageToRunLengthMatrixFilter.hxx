@@ -168,8 +168,7 @@ ScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
     typename BoolImageType::Pointer alreadyVisitedImage = BoolImageType::New();
     alreadyVisitedImage->CopyInformation( this->GetInput() );
     alreadyVisitedImage->SetRegions( this->GetInput()->GetRequestedRegion() );
-    alreadyVisitedImage->Allocate();
-    alreadyVisitedImage->FillBuffer( false );
+    alreadyVisitedImage->AllocateAndFill( false );
 
     neighborIt.GoToBegin();
     OffsetType offset = offsets.Value();
@@ -91,6 +91,7 @@ throw ( ExceptionObject )
   m_TransformMovingImageFilter->SetOutputOrigin( this->m_FixedImage->GetOrigin() );
   m_TransformMovingImageFilter->SetOutputSpacing( this->m_FixedImage->GetSpacing() );
   m_TransformMovingImageFilter->SetOutputDirection( this->m_FixedImage->GetDirection() );
+  m_TransformMovingImageFilter->SetNumberOfThreads( this->GetNumberOfThreads() );
 
   // Compute the image gradients
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -99,6 +100,7 @@ throw ( ExceptionObject )
 
   m_CastFixedImageFilter = CastFixedImageFilterType::New();
   m_CastFixedImageFilter->SetInput(this->m_FixedImage);
+  m_CastFixedImageFilter->SetNumberOfThreads( this->GetNumberOfThreads() );
 
   for ( iFilter = 0; iFilter < FixedImageDimension; iFilter++ )
     {
@@ -111,6 +113,7 @@ throw ( ExceptionObject )
     m_FixedSobelFilters[iFilter]->SetOperator(m_FixedSobelOperators[iFilter]);
 
     m_FixedSobelFilters[iFilter]->SetInput( m_CastFixedImageFilter->GetOutput() );
+    m_FixedSobelFilters[iFilter]->SetNumberOfThreads( this->GetNumberOfThreads() );
 
     m_FixedSobelFilters[iFilter]->UpdateLargestPossibleRegion();
     }
@@ -121,6 +124,7 @@ throw ( ExceptionObject )
 
   m_CastMovedImageFilter = CastMovedImageFilterType::New();
   m_CastMovedImageFilter->SetInput( m_TransformMovingImageFilter->GetOutput() );
+  m_CastMovedImageFilter->SetNumberOfThreads( this->GetNumberOfThreads() );
 
   for ( iFilter = 0; iFilter < MovedImageDimension; iFilter++ )
     {
@@ -133,6 +137,7 @@ throw ( ExceptionObject )
     m_MovedSobelFilters[iFilter]->SetOperator(m_MovedSobelOperators[iFilter]);
 
     m_MovedSobelFilters[iFilter]->SetInput( m_CastMovedImageFilter->GetOutput() );
+    m_MovedSobelFilters[iFilter]->SetNumberOfThreads( this->GetNumberOfThreads() );
 
     m_MovedSobelFilters[iFilter]->UpdateLargestPossibleRegion();
     }
@@ -282,6 +287,14 @@ GradientDifferenceImageToImageMetric< TFixedImage, TMovingImage >
 
   this->SetTransformParameters(parameters);
   m_TransformMovingImageFilter->UpdateLargestPossibleRegion();
+
+  // Update the gradient images before iterating over them
+  for ( iDimension = 0; iDimension < FixedImageDimension; iDimension++ )
+    {
+    m_FixedSobelFilters[iDimension]->UpdateLargestPossibleRegion();
+    m_MovedSobelFilters[iDimension]->UpdateLargestPossibleRegion();
+    }
+
   MeasureType measure = NumericTraits< MeasureType >::Zero;
 
   for ( iDimension = 0; iDimension < FixedImageDimension; iDimension++ )
@@ -310,9 +323,6 @@ GradientDifferenceImageToImageMetric< TFixedImage, TMovingImage >
     MovedIteratorType movedIterator( m_MovedSobelFilters[iDimension]->GetOutput(),
                                      this->GetFixedImageRegion() );
 
-    m_FixedSobelFilters[iDimension]->UpdateLargestPossibleRegion();
-    m_MovedSobelFilters[iDimension]->UpdateLargestPossibleRegion();
-
     this->m_NumberOfPixelsCounted = 0;
 
     while ( !fixedIterator.IsAtEnd() )
@@ -344,20 +354,25 @@ typename GradientDifferenceImageToImageMetric< TFixedImage, TMovingImage >::Meas
 GradientDifferenceImageToImageMetric< TFixedImage, TMovingImage >
 ::GetValue(const TransformParametersType & parameters) const
 {
-  unsigned int iFilter;                        // Index of Sobel filters for
-                                               // each dimension
   unsigned int iDimension;
 
-  this->SetTransformParameters(parameters);
-  m_TransformMovingImageFilter->UpdateLargestPossibleRegion();
+  // Compute the similarity measure
 
-  // Update the gradient images
+  MovedGradientPixelType subtractionFactor[FixedImageDimension];
+  MeasureType            currentMeasure;
 
-  for ( iFilter = 0; iFilter < MovedImageDimension; iFilter++ )
+  for ( iDimension = 0; iDimension < FixedImageDimension; iDimension++ )
     {
-    m_MovedSobelFilters[iFilter]->UpdateLargestPossibleRegion();
+    subtractionFactor[iDimension] = 1.0;
     }
 
+  // Compute the new value of the measure for this subtraction factor.
+  // ComputeMeasure() sets the parameters and updates the moved image
+  // gradients, so that the moving image is resampled once per call: the
+  // transforms are modified by every SetParameters(), even with the same
+  // parameters.
+  currentMeasure = this->ComputeMeasure(parameters, subtractionFactor);
+
   // Compute the range of the moved image gradients
   // NB: Ideally this should be a filter as the computation is only
   //     required if the moved gradient image has been updated.
@@ -366,19 +381,6 @@ GradientDifferenceImageToImageMetric< TFixedImage, TMovingImage >
 
   this->ComputeMovedGradientRange();
 
-  // Compute the similarity measure
-
-  MovedGradientPixelType subtractionFactor[FixedImageDimension];
-  MeasureType            currentMeasure;
-
-  for ( iDimension = 0; iDimension < FixedImageDimension; iDimension++ )
-    {
-    subtractionFactor[iDimension] = 1.0;
-    }
-
-  // Compute the new value of the measure for this subtraction factor
-  currentMeasure = this->ComputeMeasure(parameters, subtractionFactor);
-
   return currentMeasure;
 }
 
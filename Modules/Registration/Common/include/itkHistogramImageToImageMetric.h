@@ -68,6 +68,7 @@ public:
   FixedImageConstPointerType;
   typedef typename Superclass::MovingImageConstPointer
   MovingImageConstPointerType;
+  typedef typename Superclass::MovingImagePointType       MovingImagePointType;
 
   /** Typedefs for histogram. This should have been defined as
       Histogram<RealType,2> but a bug in VC++7 produced an internal compiler
@@ -156,7 +157,7 @@ protected:
   /** Constructor is protected to ensure that \c New() function is used to
       create instances. */
   HistogramImageToImageMetric();
-  virtual ~HistogramImageToImageMetric() {}
+  virtual ~HistogramImageToImageMetric();
 
   /** The histogram size. */
   HistogramSizeType m_HistogramSize;
@@ -201,6 +202,16 @@ private:
   HistogramImageToImageMetric(const Self &); //purposely not implemented
   void operator=(const Self &);              //purposely not implemented
 
+  /** Resets the histogram of the thread before its samples are added. */
+  inline void GetValueThreadPreProcess(ThreadIdType threadID,
+                                       bool withinSampleThread) const;
+
+  /** Adds the sample to the histogram of the thread. */
+  inline bool GetValueThreadProcessSample(ThreadIdType threadID,
+                                          SizeValueType fixedImageSample,
+                                          const MovingImagePointType & mappedPoint,
+                                          double movingImageValue) const;
+
   /** The padding value. */
   FixedImagePixelType m_PaddingValue;
 
@@ -218,6 +229,10 @@ private:
   /** Pointer to the joint histogram. This is updated during every call to
    * GetValue() */
   HistogramPointer m_Histogram;
+
+  /** Joint histograms of the samples of each thread, which are summed by
+   * ComputeHistogram(). */
+  HistogramPointer *m_ThreaderHistograms;
 };
 } // end namespace itk
 
@@ -22,7 +22,6 @@
 #include "itkHistogramImageToImageMetric.h"
 #include "itkNumericTraits.h"
 #include "itkImageRegionConstIterator.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
 
 namespace itk
 {
@@ -42,6 +41,25 @@ HistogramImageToImageMetric< TFixedImage, TMovingImage >
   m_Histogram->SetMeasurementVectorSize(2);
   m_LowerBoundSetByUser = false;
   m_UpperBoundSetByUser = false;
+
+  m_ThreaderHistograms = NULL;
+  this->m_WithinThreadPreProcess = true;
+  this->m_WithinThreadPostProcess = false;
+
+  //  For backward compatibility, the default behavior is to use all the pixels
+  //  in the fixed image.
+  this->SetUseAllPixels(true);
+}
+
+template< class TFixedImage, class TMovingImage >
+HistogramImageToImageMetric< TFixedImage, TMovingImage >
+::~HistogramImageToImageMetric()
+{
+  if ( m_ThreaderHistograms != NULL )
+    {
+    delete[] m_ThreaderHistograms;
+    }
+  m_ThreaderHistograms = NULL;
 }
 
 template< class TFixedImage, class TMovingImage >
@@ -146,6 +164,56 @@ throw ( ExceptionObject )
         maxMoving + ( maxMoving - minMoving ) * m_UpperBoundIncreaseFactor;
       }
     }
+
+  this->Superclass::MultiThreadingInitialize();
+
+  if ( m_ThreaderHistograms != NULL )
+    {
+    delete[] m_ThreaderHistograms;
+    }
+  m_ThreaderHistograms = new HistogramPointer[this->m_NumberOfThreads];
+  for ( ThreadIdType threadID = 0; threadID < this->m_NumberOfThreads; threadID++ )
+    {
+    m_ThreaderHistograms[threadID] = HistogramType::New();
+    m_ThreaderHistograms[threadID]->SetMeasurementVectorSize(2);
+    }
+}
+
+template< class TFixedImage, class TMovingImage >
+inline void
+HistogramImageToImageMetric< TFixedImage, TMovingImage >
+::GetValueThreadPreProcess(ThreadIdType threadID,
+                           bool itkNotUsed(withinSampleThread) ) const
+{
+  m_ThreaderHistograms[threadID]->Initialize(m_HistogramSize, m_LowerBound, m_UpperBound);
+}
+
+template< class TFixedImage, class TMovingImage >
+inline bool
+HistogramImageToImageMetric< TFixedImage, TMovingImage >
+::GetValueThreadProcessSample(ThreadIdType threadID,
+                              SizeValueType fixedImageSample,
+                              const MovingImagePointType & itkNotUsed(mappedPoint),
+                              double movingImageValue) const
+{
+  const double fixedValue = this->m_FixedImageSamples[fixedImageSample].value;
+
+  if ( m_UsePaddingValue && !( fixedValue > m_PaddingValue ) )
+    {
+    return false;
+    }
+
+  // Wrap stack buffers, so that no memory is allocated per sample
+  double                                  measurement[2] = { fixedValue, movingImageValue };
+  typename HistogramType::IndexValueType  indexBuffer[2];
+  const MeasurementVectorType             sample(measurement, 2, false);
+  typename HistogramType::IndexType       index(indexBuffer, 2, false);
+
+  HistogramType *histogram = m_ThreaderHistograms[threadID];
+  histogram->GetIndex(sample, index);
+  histogram->IncreaseFrequencyOfIndex(index, 1);
+
+  return true;
 }
 
 template< class TFixedImage, class TMovingImage >
@@ -249,72 +317,32 @@ HistogramImageToImageMetric< TFixedImage, TMovingImage >
 ::ComputeHistogram(TransformParametersType const & parameters,
                    HistogramType & histogram) const
 {
-  FixedImageConstPointerType fixedImage = this->m_FixedImage;
-
-  if ( !fixedImage )
+  if ( !this->m_FixedImage )
     {
     itkExceptionMacro(<< "Fixed image has not been assigned");
     }
 
-  typedef itk::ImageRegionConstIteratorWithIndex< FixedImageType >
-  FixedIteratorType;
-
-  typename FixedImageType::IndexType index;
-  typename FixedImageType::RegionType fixedRegion;
-
-  fixedRegion = this->GetFixedImageRegion();
-  FixedIteratorType ti(fixedImage, fixedRegion);
-
-  this->m_NumberOfPixelsCounted = 0;
   this->SetTransformParameters(parameters);
 
+  // MUST BE CALLED TO INITIATE PROCESSING
+  this->GetValueMultiThreadedInitiate();
+
+  // Sum the histograms of the threads, which all have the bins of the
+  // joint histogram
   histogram.Initialize(m_HistogramSize, m_LowerBound, m_UpperBound);
 
-  ti.GoToBegin();
-  while ( !ti.IsAtEnd() )
+  const typename HistogramType::InstanceIdentifier numberOfBins = histogram.Size();
+  for ( ThreadIdType threadID = 0; threadID < this->m_NumberOfThreads; threadID++ )
     {
-    index = ti.GetIndex();
-
-    if ( fixedRegion.IsInside(index)
-         && ( !m_UsePaddingValue
-              || ( m_UsePaddingValue && ti.Get() > m_PaddingValue ) ) )
+    const HistogramType *threadHistogram = m_ThreaderHistograms[threadID];
+    for ( typename HistogramType::InstanceIdentifier bin = 0; bin < numberOfBins; bin++ )
       {
-      InputPointType inputPoint;
-      fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
-
-      if ( this->m_FixedImageMask
-           && !this->m_FixedImageMask->IsInside(inputPoint) )
+      const typename HistogramType::AbsoluteFrequencyType freq = threadHistogram->GetFrequency(bin);
+      if ( freq > 0 )
         {
-        ++ti;
-        continue;
-        }
-
-      OutputPointType transformedPoint =
-        this->m_Transform->TransformPoint(inputPoint);
-
-      if ( this->m_MovingImageMask
-           && !this->m_MovingImageMask->IsInside(transformedPoint) )
-        {
-        ++ti;
-        continue;
-        }
-
-      if ( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
-        {
-        const RealType movingValue =
-          this->m_Interpolator->Evaluate(transformedPoint);
-        const RealType fixedValue = ti.Get();
-        this->m_NumberOfPixelsCounted++;
-
-        typename HistogramType::MeasurementVectorType sample;
-        sample.SetSize(2);
-        sample[0] = fixedValue;
-        sample[1] = movingValue;
-        histogram.IncreaseFrequencyOfMeasurement(sample, 1);
+        histogram.IncreaseFrequency(bin, freq);
         }
       }
-
-    ++ti;
     }
 
   itkDebugMacro("NumberOfPixelsCounted = " << this->m_NumberOfPixelsCounted);
@@ -486,6 +486,30 @@ public:
                                              ImageDerivativesType & gradient,
                                              ThreadIdType threadID) const;
 
+  /** Number of fixed image samples mapped together by the threaded loops. */
+  itkStaticConstMacro(SampleBlockSize, unsigned int, 64);
+
+  /** Map consecutive fixed image samples to the MovingImage domain with
+   * the batched TransformPoints of the transform. The B-spline transform
+   * caching paths of TransformPoint aren't used. */
+  void TransformSamplePoints(unsigned int firstSampleNumber,
+                             unsigned int numberOfSamples,
+                             MovingImagePointType *mappedPoints,
+                             ThreadIdType threadID) const;
+
+  /** Check whether a mapped point is within the moving image mask and
+   * buffer, and evaluate the moving image there if it is. */
+  void EvaluateMovingImageValue(const MovingImagePointType & mappedPoint,
+                                bool & sampleOk,
+                                double & movingImageValue,
+                                ThreadIdType threadID) const;
+
+  void EvaluateMovingImageValueAndDerivatives(const MovingImagePointType & mappedPoint,
+                                              bool & sampleOk,
+                                              double & movingImageValue,
+                                              ImageDerivativesType & gradient,
+                                              ThreadIdType threadID) const;
+
   /** Boolean to indicate if the interpolator BSpline. */
   bool m_InterpolatorIsBSpline;
   /** Pointer to BSplineInterpolator. */
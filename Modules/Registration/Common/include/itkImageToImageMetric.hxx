@@ -1005,31 +1005,86 @@ ImageToImageMetric< TFixedImage, TMovingImage >
 
   if ( sampleOk )
     {
-    // If user provided a mask over the Moving image
-    if ( m_MovingImageMask )
+    this->EvaluateMovingImageValue(mappedPoint, sampleOk, movingImageValue, threadID);
+    }
+}
+
+/**
+ * Map a block of fixed image samples to the MovingImage domain.
+ */
+template< class TFixedImage, class TMovingImage >
+void
+ImageToImageMetric< TFixedImage, TMovingImage >
+::TransformSamplePoints(unsigned int firstSampleNumber,
+                        unsigned int numberOfSamples,
+                        MovingImagePointType *mappedPoints,
+                        ThreadIdType threadID) const
+{
+  TransformType *transform;
+
+  if ( threadID > 0 )
+    {
+    transform = this->m_ThreaderTransform[threadID - 1];
+    }
+  else
+    {
+    transform = this->m_Transform;
+    }
+
+  // The sample points are gathered into a contiguous array for the
+  // transform
+  FixedImagePointType fixedPoints[SampleBlockSize];
+  for ( unsigned int start = 0; start < numberOfSamples; start += SampleBlockSize )
+    {
+    const unsigned int count =
+      vnl_math_min(static_cast< unsigned int >( SampleBlockSize ), numberOfSamples - start);
+    for ( unsigned int k = 0; k < count; k++ )
       {
-      // Check if mapped point is within the support region of the moving image
-      // mask
-      sampleOk = sampleOk && m_MovingImageMask->IsInside(mappedPoint);
+      fixedPoints[k] = m_FixedImageSamples[firstSampleNumber + start + k].point;
       }
+    transform->TransformPoints(fixedPoints, mappedPoints + start, count);
+    }
+}
+
+/**
+ * Evaluate the moving image at a mapped point.
+ */
+template< class TFixedImage, class TMovingImage >
+void
+ImageToImageMetric< TFixedImage, TMovingImage >
+::EvaluateMovingImageValue(const MovingImagePointType & mappedPoint,
+                           bool & sampleOk,
+                           double & movingImageValue,
+                           ThreadIdType threadID) const
+{
+  // If user provided a mask over the Moving image
+  if ( m_MovingImageMask )
+    {
+    // Check if mapped point is within the support region of the moving image
+    // mask
+    sampleOk = m_MovingImageMask->IsInside(mappedPoint);
+    }
+  else
+    {
+    sampleOk = true;
+    }
 
-    if ( m_InterpolatorIsBSpline )
+  if ( m_InterpolatorIsBSpline )
+    {
+    // Check if mapped point inside image buffer
+    sampleOk = sampleOk && m_BSplineInterpolator->IsInsideBuffer(mappedPoint);
+    if ( sampleOk )
       {
-      // Check if mapped point inside image buffer
-      sampleOk = sampleOk && m_BSplineInterpolator->IsInsideBuffer(mappedPoint);
-      if ( sampleOk )
-        {
-        movingImageValue = m_BSplineInterpolator->Evaluate(mappedPoint, threadID);
-        }
+      movingImageValue = m_BSplineInterpolator->Evaluate(mappedPoint, threadID);
       }
-    else
+    }
+  else
+    {
+    // Check if mapped point inside image buffer
+    sampleOk = sampleOk && m_Interpolator->IsInsideBuffer(mappedPoint);
+    if ( sampleOk )
       {
-      // Check if mapped point inside image buffer
-      sampleOk = sampleOk && m_Interpolator->IsInsideBuffer(mappedPoint);
-      if ( sampleOk )
-        {
-        movingImageValue = m_Interpolator->Evaluate(mappedPoint);
-        }
+      movingImageValue = m_Interpolator->Evaluate(mappedPoint);
       }
     }
 }
@@ -1123,35 +1178,55 @@ ImageToImageMetric< TFixedImage, TMovingImage >
 
   if ( sampleOk )
     {
-    // If user provided a mask over the Moving image
-    if ( m_MovingImageMask )
-      {
-      // Check if mapped point is within the support region of the moving image
-      // mask
-      sampleOk = sampleOk && m_MovingImageMask->IsInside(mappedPoint);
-      }
+    this->EvaluateMovingImageValueAndDerivatives(mappedPoint, sampleOk, movingImageValue,
+                                                 movingImageGradient, threadID);
+    }
+}
 
-    if ( m_InterpolatorIsBSpline )
+/**
+ * Evaluate the moving image and its derivatives at a mapped point.
+ */
+template< class TFixedImage, class TMovingImage >
+void
+ImageToImageMetric< TFixedImage, TMovingImage >
+::EvaluateMovingImageValueAndDerivatives(const MovingImagePointType & mappedPoint,
+                                         bool & sampleOk,
+                                         double & movingImageValue,
+                                         ImageDerivativesType & movingImageGradient,
+                                         ThreadIdType threadID) const
+{
+  // If user provided a mask over the Moving image
+  if ( m_MovingImageMask )
+    {
+    // Check if mapped point is within the support region of the moving image
+    // mask
+    sampleOk = m_MovingImageMask->IsInside(mappedPoint);
+    }
+  else
+    {
+    sampleOk = true;
+    }
+
+  if ( m_InterpolatorIsBSpline )
+    {
+    // Check if mapped point inside image buffer
+    sampleOk = sampleOk && m_BSplineInterpolator->IsInsideBuffer(mappedPoint);
+    if ( sampleOk )
       {
-      // Check if mapped point inside image buffer
-      sampleOk = sampleOk && m_BSplineInterpolator->IsInsideBuffer(mappedPoint);
-      if ( sampleOk )
-        {
-        this->m_BSplineInterpolator->EvaluateValueAndDerivative(mappedPoint,
-                                                                movingImageValue,
-                                                                movingImageGradient,
-                                                                threadID);
-        }
+      this->m_BSplineInterpolator->EvaluateValueAndDerivative(mappedPoint,
+                                                              movingImageValue,
+                                                              movingImageGradient,
+                                                              threadID);
       }
-    else
+    }
+  else
+    {
+    // Check if mapped point inside image buffer
+    sampleOk = sampleOk && m_Interpolator->IsInsideBuffer(mappedPoint);
+    if ( sampleOk )
       {
-      // Check if mapped point inside image buffer
-      sampleOk = sampleOk && m_Interpolator->IsInsideBuffer(mappedPoint);
-      if ( sampleOk )
-        {
-        this->ComputeImageDerivatives(mappedPoint, movingImageGradient, threadID);
-        movingImageValue = this->m_Interpolator->Evaluate(mappedPoint);
-        }
+      this->ComputeImageDerivatives(mappedPoint, movingImageGradient, threadID);
+      movingImageValue = this->m_Interpolator->Evaluate(mappedPoint);
       }
     }
 }
@@ -1319,24 +1394,41 @@ ImageToImageMetric< TFixedImage, TMovingImage >
     this->GetValueThreadPreProcess(threadID, true);
     }
 
-  // Process the samples
-  int numSamples = 0;
-  for ( int count = 0; count < chunkSize; ++count, ++fixedImageSample )
+  // Process the samples by blocks. Unless the transform is a B-spline
+  // one, the points of a block are mapped by a single call to the transform.
+  int                  numSamples = 0;
+  MovingImagePointType mappedPoints[SampleBlockSize];
+  for ( int blockStart = 0; blockStart < chunkSize; blockStart += SampleBlockSize )
     {
-    MovingImagePointType mappedPoint;
-    bool                 sampleOk;
-    double               movingImageValue;
-    // Get moving image value
-    this->TransformPoint(fixedImageSample, mappedPoint, sampleOk, movingImageValue,
-                         threadID);
-
-    if ( sampleOk )
+    const int blockSize = vnl_math_min(static_cast< int >( SampleBlockSize ), chunkSize - blockStart);
+    if ( !m_TransformIsBSpline )
       {
-      // CALL USER FUNCTION
-      if ( GetValueThreadProcessSample(threadID, fixedImageSample,
-                                       mappedPoint, movingImageValue) )
+      this->TransformSamplePoints(fixedImageSample, blockSize, mappedPoints, threadID);
+      }
+    for ( int count = 0; count < blockSize; ++count, ++fixedImageSample )
+      {
+      MovingImagePointType & mappedPoint = mappedPoints[count];
+      bool                   sampleOk;
+      double                 movingImageValue;
+      // Get moving image value
+      if ( m_TransformIsBSpline )
+        {
+        this->TransformPoint(fixedImageSample, mappedPoint, sampleOk, movingImageValue,
+                             threadID);
+        }
+      else
         {
-        ++numSamples;
+        this->EvaluateMovingImageValue(mappedPoint, sampleOk, movingImageValue, threadID);
+        }
+
+      if ( sampleOk )
+        {
+        // CALL USER FUNCTION
+        if ( GetValueThreadProcessSample(threadID, fixedImageSample,
+                                         mappedPoint, movingImageValue) )
+          {
+          ++numSamples;
+          }
         }
       }
     }
@@ -1483,28 +1575,46 @@ ImageToImageMetric< TFixedImage, TMovingImage >
     this->GetValueAndDerivativeThreadPreProcess(threadID, true);
     }
 
-  // Process the samples
-  MovingImagePointType mappedPoint;
+  // Process the samples by blocks. Unless the transform is a B-spline
+  // one, the points of a block are mapped by a single call to the transform.
+  MovingImagePointType mappedPoints[SampleBlockSize];
   bool                 sampleOk;
   double               movingImageValue;
   ImageDerivativesType movingImageGradientValue;
-  for ( int count = 0; count < chunkSize; ++count, ++fixedImageSample )
+  for ( int blockStart = 0; blockStart < chunkSize; blockStart += SampleBlockSize )
     {
-    // Get moving image value
-    TransformPointWithDerivatives(fixedImageSample, mappedPoint, sampleOk,
-                                  movingImageValue, movingImageGradientValue,
-                                  threadID);
-
-    if ( sampleOk )
+    const int blockSize = vnl_math_min(static_cast< int >( SampleBlockSize ), chunkSize - blockStart);
+    if ( !m_TransformIsBSpline )
+      {
+      this->TransformSamplePoints(fixedImageSample, blockSize, mappedPoints, threadID);
+      }
+    for ( int count = 0; count < blockSize; ++count, ++fixedImageSample )
       {
-      // CALL USER FUNCTION
-      if ( this->GetValueAndDerivativeThreadProcessSample(threadID,
-                                                          fixedImageSample,
-                                                          mappedPoint,
-                                                          movingImageValue,
-                                                          movingImageGradientValue) )
+      MovingImagePointType & mappedPoint = mappedPoints[count];
+      // Get moving image value
+      if ( m_TransformIsBSpline )
+        {
+        TransformPointWithDerivatives(fixedImageSample, mappedPoint, sampleOk,
+                                      movingImageValue, movingImageGradientValue,
+                                      threadID);
+        }
+      else
         {
-        ++numSamples;
+        this->EvaluateMovingImageValueAndDerivatives(mappedPoint, sampleOk, movingImageValue,
+                                                     movingImageGradientValue, threadID);
+        }
+
+      if ( sampleOk )
+        {
+        // CALL USER FUNCTION
+        if ( this->GetValueAndDerivativeThreadProcessSample(threadID,
+                                                            fixedImageSample,
+                                                            mappedPoint,
+                                                            movingImageValue,
+                                                            movingImageGradientValue) )
+          {
+          ++numSamples;
+          }
         }
       }
     }
@@ -86,6 +86,19 @@ public:
   typedef typename Superclass::FixedImageConstPointer  FixedImageConstPointer;
   typedef typename Superclass::MovingImageConstPointer MovingImageConstPointer;
   typedef typename Superclass::FixedImageRegionType    FixedImageRegionType;
+  typedef typename Superclass::MovingImagePointType    MovingImagePointType;
+  typedef typename Superclass::FixedImagePointType     FixedImagePointType;
+  typedef typename Superclass::ImageDerivativesType    ImageDerivativesType;
+
+  /** The moving image dimension. */
+  itkStaticConstMacro(MovingImageDimension, unsigned int,
+                      MovingImageType::ImageDimension);
+
+  /** Initialize the Metric by making sure that all the components
+   *  are present and plugged together correctly, and by sampling the
+   *  fixed image region for the threads. */
+  virtual void Initialize(void)
+  throw ( ExceptionObject );
 
   /** Computes the gradient image and assigns it to m_GradientImage */
   void ComputeGradient();
@@ -108,7 +121,7 @@ public:
 
   /** This method allows the user to set the foreground value.  The default
    *  value is 255. */
-  itkSetMacro(ForegroundValue, RealType);
+  void SetForegroundValue(RealType value);
   itkGetConstMacro(ForegroundValue, RealType);
 
   /** Set/Get whether this metric returns 2*|A&B|/(|A|+|B|)
@@ -120,15 +133,49 @@ public:
   itkGetConstMacro(Complement, bool);
 protected:
   KappaStatisticImageToImageMetric();
-  virtual ~KappaStatisticImageToImageMetric() {}
+  virtual ~KappaStatisticImageToImageMetric();
   void PrintSelf(std::ostream & os, Indent indent) const;
 
 private:
   KappaStatisticImageToImageMetric(const Self &); //purposely not implemented
   void operator=(const Self &);                   //purposely not implemented
 
+  /** Areas and derivative sums accumulated by a thread over its samples */
+  struct ThreaderSumsType {
+    SizeValueType  m_MovingForegroundArea;
+    SizeValueType  m_Intersection;
+    DerivativeType m_Sum1;
+    DerivativeType m_Sum2;
+  };
+
+  inline bool GetValueThreadProcessSample(ThreadIdType threadID,
+                                          SizeValueType fixedImageSample,
+                                          const MovingImagePointType & mappedPoint,
+                                          double movingImageValue) const;
+
+  inline bool GetValueAndDerivativeThreadProcessSample(ThreadIdType threadID,
+                                                       SizeValueType fixedImageSample,
+                                                       const MovingImagePointType & mappedPoint,
+                                                       double movingImageValue,
+                                                       const ImageDerivativesType &
+                                                       movingImageGradientValue) const;
+
+  /** Counts the fixed image samples in the foreground. The fixed
+   * foreground area doesn't depend on the transform, so it is only
+   * computed when the samples or the foreground value change. */
+  void ComputeFixedForegroundArea();
+
+  /** Resets the sums of the threads. */
+  void ResetThreaderSums(bool withDerivatives) const;
+
+  /** Adds up the sums of the threads into the first one. */
+  void MergeThreaderSums(bool withDerivatives) const;
+
   RealType m_ForegroundValue;
   bool     m_Complement;
+
+  SizeValueType     m_FixedForegroundArea;
+  ThreaderSumsType *m_ThreaderSums;
 };
 } // end namespace itk
 
@@ -35,269 +35,308 @@ KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
   this->SetComputeGradient(true);
   m_ForegroundValue = 255;
   m_Complement = false;
+
+  m_FixedForegroundArea = 0;
+  m_ThreaderSums = NULL;
+  this->m_WithinThreadPreProcess = false;
+  this->m_WithinThreadPostProcess = false;
+
+  //  For backward compatibility, the default behavior is to use all the pixels
+  //  in the fixed image.
+  this->SetUseAllPixels(true);
 }
 
-/**
- * Get the match Measure
- */
 template <class TFixedImage, class TMovingImage>
-typename KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>::MeasureType
 KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
-::GetValue(const TransformParametersType & parameters) const
+::~KappaStatisticImageToImageMetric()
 {
-  itkDebugMacro("GetValue( " << parameters << " ) ");
-
-  this->SetTransformParameters(parameters);
-
-  // Get the fixed image
-  //
-  //
-  FixedImageConstPointer fixedImage = this->m_FixedImage;
-  if( !fixedImage )
+  if( m_ThreaderSums != NULL )
     {
-    itkExceptionMacro(<< "Fixed image has not been assigned");
+    delete[] m_ThreaderSums;
     }
+  m_ThreaderSums = NULL;
+}
 
-  // Get an iterator over the fixed image
-  //
-  //
-  typedef  ImageRegionConstIteratorWithIndex<FixedImageType> FixedIteratorType;
-  typename FixedImageType::IndexType fixedIndex;
-  FixedIteratorType fi( fixedImage, fixedImage->GetBufferedRegion() );
-
-  // Get the moving image
-  //
-  //
-  MovingImageConstPointer movingImage = this->m_MovingImage;
-  if( !movingImage )
+template <class TFixedImage, class TMovingImage>
+void
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::SetForegroundValue(RealType value)
+{
+  if( value != m_ForegroundValue )
     {
-    itkExceptionMacro(<< "Moving image has not been assigned");
+    m_ForegroundValue = value;
+    this->ComputeFixedForegroundArea();
+    this->Modified();
     }
+}
 
-  // Following are used in the metric computation.  'measure' is the
-  // value of the metric.  'fixedForegroundArea' is the total area
-  // of the foreground region in the fixed image.
-  // 'movingForegroundArea' is the foreground area in the moving image
-  // in the area of overlap under the current transformation.
-  // 'intersection' is the area of foreground intersection between the
-  // fixed and moving image.
-  //
-  //
-  MeasureType measure;
-  MeasureType intersection         = NumericTraits<MeasureType>::Zero;
-  MeasureType movingForegroundArea = NumericTraits<MeasureType>::Zero;
-  MeasureType fixedForegroundArea  = NumericTraits<MeasureType>::Zero;
-
-  // Compute fixedForegroundArea, movingForegroundArea, and
-  // intersection.  Loop over the fixed image.
-  //
-  //
-  while( !fi.IsAtEnd() )
-    {
-    fixedIndex = fi.GetIndex();
+/**
+ * Initialize
+ */
+template <class TFixedImage, class TMovingImage>
+void
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::Initialize(void)
+throw ( ExceptionObject )
+{
+  this->Superclass::Initialize();
+  this->Superclass::MultiThreadingInitialize();
 
-    InputPointType fixedInputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(fixedIndex, fixedInputPoint);
+  if( m_ThreaderSums != NULL )
+    {
+    delete[] m_ThreaderSums;
+    }
+  m_ThreaderSums = new ThreaderSumsType[this->m_NumberOfThreads];
+  for( ThreadIdType threadID = 0; threadID < this->m_NumberOfThreads; threadID++ )
+    {
+    m_ThreaderSums[threadID].m_Sum1.SetSize(this->m_NumberOfParameters);
+    m_ThreaderSums[threadID].m_Sum2.SetSize(this->m_NumberOfParameters);
+    }
 
-    if( this->m_FixedImageMask && !this->m_FixedImageMask->IsInside(fixedInputPoint) )
-      {
-      ++fi;
-      continue;
-      }
+  this->ComputeFixedForegroundArea();
+}
 
-    const RealType fixedValue = fi.Get();
+template <class TFixedImage, class TMovingImage>
+void
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::ComputeFixedForegroundArea()
+{
+  m_FixedForegroundArea = 0;
 
-    // Increment 'fixedForegroundArea'
-    //
-    //
-    if( fixedValue == m_ForegroundValue )
+  typename Superclass::FixedImageSampleContainer::const_iterator it;
+  for( it = this->m_FixedImageSamples.begin(); it != this->m_FixedImageSamples.end(); ++it )
+    {
+    if( it->value == m_ForegroundValue )
       {
-      fixedForegroundArea++;
+      m_FixedForegroundArea++;
       }
+    }
+}
 
-    // Get the point in the transformed moving image corresponding to
-    // the point in the fixed image (physical coordinates)
-    //
-    //
-    OutputPointType
-      transformedPoint = this->m_Transform->TransformPoint(fixedInputPoint);
-
-    if( this->m_MovingImageMask && !this->m_MovingImageMask->IsInside(transformedPoint) )
+template <class TFixedImage, class TMovingImage>
+void
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::ResetThreaderSums(bool withDerivatives) const
+{
+  for( ThreadIdType threadID = 0; threadID < this->m_NumberOfThreads; threadID++ )
+    {
+    ThreaderSumsType & sums = m_ThreaderSums[threadID];
+    sums.m_MovingForegroundArea = 0;
+    sums.m_Intersection = 0;
+    if( withDerivatives )
       {
-      ++fi;
-      continue;
+      sums.m_Sum1.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
+      sums.m_Sum2.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
       }
+    }
+}
 
-    // Compute movingForegroundArea and intersection
-    //
-    //
-    if( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
+template <class TFixedImage, class TMovingImage>
+void
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::MergeThreaderSums(bool withDerivatives) const
+{
+  ThreaderSumsType & total = m_ThreaderSums[0];
+  for( ThreadIdType threadID = 1; threadID < this->m_NumberOfThreads; threadID++ )
+    {
+    const ThreaderSumsType & sums = m_ThreaderSums[threadID];
+    total.m_MovingForegroundArea += sums.m_MovingForegroundArea;
+    total.m_Intersection += sums.m_Intersection;
+    if( withDerivatives )
       {
-      const RealType movingValue = this->m_Interpolator->Evaluate(transformedPoint);
-      if( movingValue == m_ForegroundValue )
-        {
-        movingForegroundArea++;
-        }
-      if( ( movingValue == m_ForegroundValue ) && ( fixedValue == m_ForegroundValue ) )
-        {
-        intersection++;
-        }
+      total.m_Sum1 += sums.m_Sum1;
+      total.m_Sum2 += sums.m_Sum2;
       }
-    ++fi;
     }
+}
 
-  // Compute the final metric value
-  //
-  //
-  if( !m_Complement )
-    {
-    measure = 2.0 * ( intersection ) / ( fixedForegroundArea + movingForegroundArea );
-    }
-  else
+template <class TFixedImage, class TMovingImage>
+inline bool
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::GetValueThreadProcessSample(ThreadIdType threadID,
+                              SizeValueType fixedImageSample,
+                              const MovingImagePointType & itkNotUsed(mappedPoint),
+                              double movingImageValue) const
+{
+  const RealType fixedValue = this->m_FixedImageSamples[fixedImageSample].value;
+
+  if( movingImageValue == m_ForegroundValue )
     {
-    measure = 1.0 - 2.0 * ( intersection ) / ( fixedForegroundArea + movingForegroundArea );
+    m_ThreaderSums[threadID].m_MovingForegroundArea++;
+    if( fixedValue == m_ForegroundValue )
+      {
+      m_ThreaderSums[threadID].m_Intersection++;
+      }
     }
 
-  return measure;
+  return true;
 }
 
 /**
- * Get the Derivative Measure
+ * Get the match Measure
  */
 template <class TFixedImage, class TMovingImage>
-void
+typename KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>::MeasureType
 KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
-::GetDerivative(const TransformParametersType & parameters,
-                DerivativeType & derivative) const
+::GetValue(const TransformParametersType & parameters) const
 {
-  itkDebugMacro("GetDerivative( " << parameters << " ) ");
+  itkDebugMacro("GetValue( " << parameters << " ) ");
 
-  if( !this->GetGradientImage() )
+  if( !this->m_FixedImage )
     {
-    itkExceptionMacro(<< "The gradient image is null, maybe you forgot to call Initialize()");
+    itkExceptionMacro(<< "Fixed image has not been assigned");
     }
 
-  FixedImageConstPointer fixedImage = this->m_FixedImage;
-  if( !fixedImage )
+  if( !this->m_MovingImage )
     {
-    itkExceptionMacro(<< "Fixed image has not been assigned");
+    itkExceptionMacro(<< "Moving image has not been assigned");
     }
 
-  const unsigned int ImageDimension = FixedImageType::ImageDimension;
-
-  typedef  ImageRegionConstIteratorWithIndex<FixedImageType> FixedIteratorType;
-
-  FixedIteratorType ti( fixedImage, this->GetFixedImageRegion() );
-
-  typename FixedImageType::IndexType index;
-
-  this->m_NumberOfPixelsCounted = 0;
-
   this->SetTransformParameters(parameters);
+  this->ResetThreaderSums(false);
 
-  const unsigned int ParametersDimension = this->GetNumberOfParameters();
-  derivative = DerivativeType(ParametersDimension);
-  derivative.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
-
-  typedef Array<double> ArrayType;
+  // MUST BE CALLED TO INITIATE PROCESSING
+  this->GetValueMultiThreadedInitiate();
 
-  ArrayType sum1 = ArrayType(ParametersDimension);
-  sum1.Fill(NumericTraits<ITK_TYPENAME ArrayType::ValueType>::Zero);
+  this->MergeThreaderSums(false);
 
-  ArrayType sum2 = ArrayType(ParametersDimension);
-  sum2.Fill(NumericTraits<ITK_TYPENAME ArrayType::ValueType>::Zero);
+  // The metric value is computed from 'intersection', the area of
+  // foreground intersection between the fixed and moving image,
+  // 'fixedForegroundArea', the total area of the foreground region in
+  // the fixed image, and 'movingForegroundArea', the foreground area
+  // in the moving image in the area of overlap under the current
+  // transformation.
+  const MeasureType intersection = m_ThreaderSums[0].m_Intersection;
+  const MeasureType movingForegroundArea = m_ThreaderSums[0].m_MovingForegroundArea;
+  const MeasureType fixedForegroundArea = m_FixedForegroundArea;
 
-  int fixedArea = 0;
-  int movingArea = 0;
-  int intersection = 0;
-
-  ti.GoToBegin();
-  while( !ti.IsAtEnd() )
+  MeasureType measure;
+  if( !m_Complement )
     {
-    index = ti.GetIndex();
+    measure = 2.0 * ( intersection ) / ( fixedForegroundArea + movingForegroundArea );
+    }
+  else
+    {
+    measure = 1.0 - 2.0 * ( intersection ) / ( fixedForegroundArea + movingForegroundArea );
+    }
 
-    InputPointType inputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
+  return measure;
+}
 
-    if( this->m_FixedImageMask && !this->m_FixedImageMask->IsInside(inputPoint) )
-      {
-      ++ti;
-      continue;
-      }
+template <class TFixedImage, class TMovingImage>
+inline bool
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::GetValueAndDerivativeThreadProcessSample(ThreadIdType threadID,
+                                           SizeValueType fixedImageSample,
+                                           const MovingImagePointType & mappedPoint,
+                                           double movingImageValue,
+                                           const ImageDerivativesType &
+                                           movingImageGradientValue) const
+{
+  this->GetValueThreadProcessSample(threadID, fixedImageSample, mappedPoint, movingImageValue);
 
-    const RealType fixedValue = ti.Value();
-    if( fixedValue == m_ForegroundValue )
-      {
-      fixedArea++;
-      }
+  const RealType             fixedValue = this->m_FixedImageSamples[fixedImageSample].value;
+  const FixedImagePointType &fixedImagePoint = this->m_FixedImageSamples[fixedImageSample].point;
+  ThreaderSumsType &         sums = m_ThreaderSums[threadID];
 
-    OutputPointType transformedPoint = this->m_Transform->TransformPoint(inputPoint);
+  // Use a raw pointer here to avoid the overhead of smart pointers.
+  TransformType *transform;
 
-    if( this->m_MovingImageMask && !this->m_MovingImageMask->IsInside(transformedPoint) )
-      {
-      ++ti;
-      continue;
-      }
+  if( threadID > 0 )
+    {
+    transform = this->m_ThreaderTransform[threadID - 1];
+    }
+  else
+    {
+    transform = this->m_Transform;
+    }
 
-    if( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
+  TransformJacobianType jacobian;
+  transform->ComputeJacobianWithRespectToParameters(fixedImagePoint, jacobian);
+  for( unsigned int par = 0; par < this->m_NumberOfParameters; par++ )
+    {
+    for( unsigned int dim = 0; dim < MovingImageDimension; dim++ )
       {
-      const RealType movingValue  = this->m_Interpolator->Evaluate(transformedPoint);
-
-      if( movingValue == m_ForegroundValue )
+      sums.m_Sum2[par] += jacobian(dim, par) * movingImageGradientValue[dim];
+      if( fixedValue == m_ForegroundValue )
         {
-        movingArea++;
+        sums.m_Sum1[par] += 2.0 * jacobian(dim, par) * movingImageGradientValue[dim];
         }
+      }
+    }
 
-      if( ( movingValue == m_ForegroundValue ) && ( fixedValue == m_ForegroundValue ) )
-        {
-        intersection++;
-        }
+  return true;
+}
 
-      TransformJacobianType jacobian;
-      this->m_Transform->ComputeJacobianWithRespectToParameters(
-        inputPoint, jacobian);
+/**
+ * Get the Derivative Measure
+ */
+template <class TFixedImage, class TMovingImage>
+void
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::GetDerivative(const TransformParametersType & parameters,
+                DerivativeType & derivative) const
+{
+  itkDebugMacro("GetDerivative( " << parameters << " ) ");
 
-      this->m_NumberOfPixelsCounted++;
+  MeasureType value;
+  // call the combined version
+  this->GetValueAndDerivative(parameters, value, derivative);
+}
 
-      // Get the gradient by NearestNeighboorInterpolation:
-      // which is equivalent to round up the point components.
-      typedef typename OutputPointType::CoordRepType CoordRepType;
-      typedef ContinuousIndex<CoordRepType, MovingImageType::ImageDimension>
-      MovingImageContinuousIndexType;
+/**
+ * Get both the match Measure and theDerivative Measure
+ */
+template <class TFixedImage, class TMovingImage>
+void
+KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
+::GetValueAndDerivative(const TransformParametersType & parameters,
+                        MeasureType & value, DerivativeType  & derivative) const
+{
+  if( !this->GetGradientImage() )
+    {
+    itkExceptionMacro(<< "The gradient image is null, maybe you forgot to call Initialize()");
+    }
 
-      MovingImageContinuousIndexType tempIndex;
-      this->m_MovingImage->TransformPhysicalPointToContinuousIndex(transformedPoint, tempIndex);
+  if( !this->m_FixedImage )
+    {
+    itkExceptionMacro(<< "Fixed image has not been assigned");
+    }
 
-      typename MovingImageType::IndexType mappedIndex;
-      mappedIndex.CopyWithRound(tempIndex);
+  this->SetTransformParameters(parameters);
+  this->ResetThreaderSums(true);
 
-      const GradientPixelType gradient = this->m_GradientImage->GetPixel(mappedIndex);
-      for( unsigned int par = 0; par < ParametersDimension; par++ )
-        {
-        for( unsigned int dim = 0; dim < ImageDimension; dim++ )
-          {
-          sum2[par] += jacobian(dim, par) * gradient[dim];
-          if( fixedValue == m_ForegroundValue )
-            {
-            sum1[par] += 2.0 * jacobian(dim, par) * gradient[dim];
-            }
-          }
-        }
-      }
-    ++ti;
-    }
+  // MUST BE CALLED TO INITIATE PROCESSING
+  this->GetValueAndDerivativeMultiThreadedInitiate();
+
+  this->MergeThreaderSums(true);
 
   if( !this->m_NumberOfPixelsCounted )
     {
     itkExceptionMacro(<< "All the points mapped to outside of the moving image");
     }
+
+  const double intersection = m_ThreaderSums[0].m_Intersection;
+  const double areaSum = double(m_FixedForegroundArea)
+                         + double(m_ThreaderSums[0].m_MovingForegroundArea);
+
+  if( !m_Complement )
+    {
+    value = 2.0 * intersection / areaSum;
+    }
   else
     {
-    double areaSum = double(fixedArea) + double(movingArea);
-    for( unsigned int par = 0; par < ParametersDimension; par++ )
-      {
-      derivative[par] = -( areaSum * sum1[par] - 2.0 * intersection * sum2[par] ) / ( areaSum * areaSum );
-      }
+    value = 1.0 - 2.0 * intersection / areaSum;
+    }
+
+  const unsigned int ParametersDimension = this->GetNumberOfParameters();
+  derivative = DerivativeType(ParametersDimension);
+
+  const DerivativeType & sum1 = m_ThreaderSums[0].m_Sum1;
+  const DerivativeType & sum2 = m_ThreaderSums[0].m_Sum2;
+  for( unsigned int par = 0; par < ParametersDimension; par++ )
+    {
+    derivative[par] = -( areaSum * sum1[par] - 2.0 * intersection * sum2[par] ) / ( areaSum * areaSum );
     }
 }
 
@@ -372,19 +411,6 @@ KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
   this->m_GradientImage = tempGradientImage;
 }
 
-/**
- * Get both the match Measure and theDerivative Measure
- */
-template <class TFixedImage, class TMovingImage>
-void
-KappaStatisticImageToImageMetric<TFixedImage, TMovingImage>
-::GetValueAndDerivative(const TransformParametersType & parameters,
-                        MeasureType & Value, DerivativeType  & Derivative) const
-{
-  Value      = this->GetValue(parameters);
-  this->GetDerivative(parameters, Derivative);
-}
-
 /**
  * PrintSelf
  */
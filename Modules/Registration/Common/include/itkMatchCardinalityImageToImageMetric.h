@@ -18,11 +18,6 @@
 #ifndef __itkMatchCardinalityImageToImageMetric_h
 #define __itkMatchCardinalityImageToImageMetric_h
 
-/**
- *  TODO: This class needs to be more tightly integrated with the new
- *  multi-threaded ImageToImageMetric.
- */
-
 #include "itkImageToImageMetric.h"
 #include "itkPoint.h"
 #include <vector>
@@ -60,6 +55,13 @@ namespace itk
  * number of pixels in the overlap of the fixed and moving image
  * buffers conditional on any assigned masks.
  *
+ * The fixed image is sampled in Initialize(), and the matches of the
+ * samples are counted by the threads of ImageToImageMetric in
+ * GetValueThreadProcessSample(). The metric no longer has its own
+ * region splitter and thread callbacks: GetNonconstValue(),
+ * ThreadedGetValue(), SplitFixedRegion(), ThreaderCallback() and
+ * ThreadStruct were removed.
+ *
  * \ingroup RegistrationMetrics
  * \ingroup ITKRegistrationCommon
  */
@@ -96,6 +98,13 @@ public:
   typedef typename Superclass::FixedImageConstPointer  FixedImageConstPointer;
   typedef typename Superclass::MovingImageConstPointer MovingImageConstPointer;
   typedef typename Superclass::FixedImageRegionType    FixedImageRegionType;
+  typedef typename Superclass::MovingImagePointType    MovingImagePointType;
+
+  /** Initialize the Metric by making sure that all the components
+   *  are present and plugged together correctly, and by sampling the
+   *  fixed image region for the threads. */
+  virtual void Initialize(void)
+  throw ( ExceptionObject );
 
   /** Get the derivatives of the match measure. */
   void GetDerivative(const TransformParametersType &,
@@ -125,56 +134,24 @@ public:
 
   /** Return the multithreader used by this class. */
   MultiThreader * GetMultiThreader()
-  { return m_Threader; }
+  { return this->m_Threader; }
 protected:
   MatchCardinalityImageToImageMetric();
-  virtual ~MatchCardinalityImageToImageMetric() {}
+  virtual ~MatchCardinalityImageToImageMetric();
   void PrintSelf(std::ostream & os, Indent indent) const;
 
-  /**
-   * Non-const version of GetValue().  This is a hack around various
-   * const issues with trying to spawn threads from the const version
-   * of GetValue().
-   */
-  MeasureType GetNonconstValue(const TransformParametersType & parameters);
-
-  /**
-   * Thread worker routine to calculate the contribution of the a
-   * subregion to the overall metric.  Can only be called from
-   * GetValue(). */
-  virtual
-  void ThreadedGetValue(const FixedImageRegionType & outputRegionForThread,
-                        ThreadIdType threadId);
-
-  /** Split the FixedImageRegion into "num" pieces, returning
-   * region "i" as "splitRegion". This method is called "num" times. The
-   * regions must not overlap. The method returns the number of pieces that
-   * the routine is capable of splitting the FixedImageRegion,
-   * i.e. return value is less than or equal to "num". */
-  virtual
-  ThreadIdType SplitFixedRegion(ThreadIdType i, int num, FixedImageRegionType & splitRegion);
-
-  /** Static function used as a "callback" by the MultiThreader.  The threading
-   * library will call this routine for each thread, which will delegate the
-   * control to ThreadedGetValue(). */
-  static ITK_THREAD_RETURN_TYPE ThreaderCallback(void *arg);
-
-  /** Internal structure used for passing image data into the threading library
-    */
-  struct ThreadStruct {
-    Pointer Metric;
-  };
 private:
   MatchCardinalityImageToImageMetric(const Self &); //purposely not implemented
   void operator=(const Self &);                     //purposely not implemented
 
-  bool                         m_MeasureMatches;
-  std::vector< MeasureType >   m_ThreadMatches;
-  std::vector< SizeValueType > m_ThreadCounts;
+  inline bool GetValueThreadProcessSample(ThreadIdType threadID,
+                                          SizeValueType fixedImageSample,
+                                          const MovingImagePointType & mappedPoint,
+                                          double movingImageValue) const;
+
+  bool m_MeasureMatches;
 
-  /** Support processing data in multiple threads. Used by subclasses
-   * (e.g., ImageSource). */
-  MultiThreader::Pointer m_Threader;
+  MeasureType *m_ThreaderMatches;
 };
 } // end namespace itk
 
@@ -19,7 +19,6 @@
 #define __itkMatchCardinalityImageToImageMetric_hxx
 
 #include "itkMatchCardinalityImageToImageMetric.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
 
 namespace itk
 {
@@ -36,254 +35,110 @@ MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >
   m_MeasureMatches = true;         // default to measure percentage of pixel
                                    // matches
 
-  m_Threader = MultiThreader::New();
+  m_ThreaderMatches = NULL;
+  this->m_WithinThreadPreProcess = false;
+  this->m_WithinThreadPostProcess = false;
+
+  //  For backward compatibility, the default behavior is to use all the pixels
+  //  in the fixed image.
+  this->SetUseAllPixels(true);
 }
 
-/*
- * Get the match Measure
- */
 template< class TFixedImage, class TMovingImage >
-typename MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >::MeasureType
 MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >
-::GetValue(const TransformParametersType & parameters) const
+::~MatchCardinalityImageToImageMetric()
 {
-  return const_cast< Self * >( this )->GetNonconstValue(parameters);
+  if ( m_ThreaderMatches != NULL )
+    {
+    delete[] m_ThreaderMatches;
+    }
+  m_ThreaderMatches = NULL;
 }
 
 /**
- * Get the match Measure (non const version. spawns threads).
+ * Initialize
  */
 template< class TFixedImage, class TMovingImage >
-typename MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >::MeasureType
+void
 MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >
-::GetNonconstValue(const TransformParametersType & parameters)
+::Initialize(void)
+throw ( ExceptionObject )
 {
-  itkDebugMacro("GetValue( " << parameters << " ) ");
-
-  FixedImageConstPointer fixedImage = this->m_FixedImage;
-  if ( !fixedImage )
-    {
-    itkExceptionMacro(<< "Fixed image has not been assigned");
-    }
+  this->Superclass::Initialize();
+  this->Superclass::MultiThreadingInitialize();
 
-  // Initialize some variables before spawning threads
-  //
-  //
-  MeasureType measure = NumericTraits< MeasureType >::Zero;
-  this->m_NumberOfPixelsCounted = 0;
-
-  m_ThreadMatches.clear();
-  m_ThreadCounts.clear();
-  m_ThreadMatches.resize( this->GetNumberOfThreads() );
-  m_ThreadCounts.resize( this->GetNumberOfThreads() );
-
-  typename std::vector< MeasureType >::iterator mIt;
-  std::vector< SizeValueType >::iterator cIt;
-  for ( mIt = m_ThreadMatches.begin(), cIt = m_ThreadCounts.begin();
-        mIt != m_ThreadMatches.end(); ++mIt, ++cIt )
+  if ( m_ThreaderMatches != NULL )
     {
-    *mIt = NumericTraits< MeasureType >::Zero;
-    *cIt = 0;
+    delete[] m_ThreaderMatches;
     }
+  m_ThreaderMatches = new MeasureType[this->m_NumberOfThreads];
+}
 
-  // store the parameters in the transform so all threads can access them
-  this->SetTransformParameters(parameters);
-
-  // Set up the multithreaded processing
-  //
-  //
-  ThreadStruct str;
-  str.Metric = this;
-
-  this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
-  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
-
-  // multithread the execution
-  //
-  //
-  this->GetMultiThreader()->SingleMethodExecute();
-
-  // Collect the contribution to the metric for each thread
-  //
-  //
-  for ( mIt = m_ThreadMatches.begin(), cIt = m_ThreadCounts.begin();
-        mIt != m_ThreadMatches.end(); ++mIt, ++cIt )
-    {
-    measure += *mIt;
-    this->m_NumberOfPixelsCounted += *cIt;
-    }
+template< class TFixedImage, class TMovingImage >
+inline bool
+MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >
+::GetValueThreadProcessSample(ThreadIdType threadID,
+                              SizeValueType fixedImageSample,
+                              const MovingImagePointType & itkNotUsed(mappedPoint),
+                              double movingImageValue) const
+{
+  const double fixedValue = this->m_FixedImageSamples[fixedImageSample].value;
 
-  if ( !this->m_NumberOfPixelsCounted )
+  if ( m_MeasureMatches )
     {
-    itkExceptionMacro(<< "All the points mapped to outside of the moving image");
+    m_ThreaderMatches[threadID] += ( movingImageValue == fixedValue ); // count matches
     }
   else
     {
-    measure /= this->m_NumberOfPixelsCounted;
+    m_ThreaderMatches[threadID] += ( movingImageValue != fixedValue ); // count mismatches
     }
 
-  return measure;
+  return true;
 }
 
+/*
+ * Get the match Measure
+ */
 template< class TFixedImage, class TMovingImage >
-void
+typename MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >::MeasureType
 MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >
-::ThreadedGetValue(const FixedImageRegionType & regionForThread,
-                   ThreadIdType threadId)
+::GetValue(const TransformParametersType & parameters) const
 {
-  FixedImageConstPointer fixedImage = this->GetFixedImage();
+  itkDebugMacro("GetValue( " << parameters << " ) ");
 
-  if ( !fixedImage )
+  if ( !this->m_FixedImage )
     {
     itkExceptionMacro(<< "Fixed image has not been assigned");
     }
 
-  typedef  ImageRegionConstIteratorWithIndex< FixedImageType > FixedIteratorType;
-  typename FixedImageType::IndexType index;
-  FixedIteratorType ti(fixedImage, regionForThread);
-
-  MeasureType   threadMeasure = NumericTraits< MeasureType >::Zero;
-  SizeValueType threadNumberOfPixelsCounted = 0;
-
-  while ( !ti.IsAtEnd() )
+  for ( ThreadIdType threadID = 0; threadID < this->m_NumberOfThreads; threadID++ )
     {
-    index = ti.GetIndex();
-
-    typename Superclass::InputPointType inputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
-
-    if ( this->GetFixedImageMask() && !this->GetFixedImageMask()->IsInside(inputPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    typename Superclass::OutputPointType
-    transformedPoint = this->GetTransform()->TransformPoint(inputPoint);
-
-    if ( this->GetMovingImageMask() && !this->GetMovingImageMask()->IsInside(transformedPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    if ( this->GetInterpolator()->IsInsideBuffer(transformedPoint) )
-      {
-      const RealType movingValue = this->GetInterpolator()->Evaluate(transformedPoint);
-      const RealType fixedValue = ti.Get();
-      RealType       diff;
-
-      threadNumberOfPixelsCounted++;
-
-      if ( m_MeasureMatches )
-        {
-        diff = ( movingValue == fixedValue ); // count matches
-        }
-      else
-        {
-        diff = ( movingValue != fixedValue ); // count mismatches
-        }
-      threadMeasure += diff;
-      }
-
-    ++ti;
+    m_ThreaderMatches[threadID] = NumericTraits< MeasureType >::Zero;
     }
 
-  m_ThreadMatches[threadId] = threadMeasure;
-  m_ThreadCounts[threadId] = threadNumberOfPixelsCounted;
-}
-
-//----------------------------------------------------------------------------
-template< class TFixedImage, class TMovingImage >
-ThreadIdType
-MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >
-::SplitFixedRegion(ThreadIdType i, int num, FixedImageRegionType & splitRegion)
-{
-  // Get the output pointer
-  const typename FixedImageRegionType::SizeType & fixedRegionSize =
-    this->GetFixedImageRegion().GetSize();
-
-  int splitAxis;
-  typename FixedImageRegionType::IndexType splitIndex;
-  typename FixedImageRegionType::SizeType splitSize;
+  // store the parameters in the transform so all threads can access them
+  this->SetTransformParameters(parameters);
 
-  // Initialize the splitRegion to the output requested region
-  splitRegion = this->GetFixedImageRegion();
-  splitIndex = splitRegion.GetIndex();
-  splitSize = splitRegion.GetSize();
+  // MUST BE CALLED TO INITIATE PROCESSING
+  this->GetValueMultiThreadedInitiate();
 
-  // split on the outermost dimension available
-  splitAxis = this->GetFixedImage()->GetImageDimension() - 1;
-  while ( fixedRegionSize[splitAxis] == 1 )
+  // Collect the contribution to the metric for each thread
+  MeasureType measure = m_ThreaderMatches[0];
+  for ( ThreadIdType threadID = 1; threadID < this->m_NumberOfThreads; threadID++ )
     {
-    --splitAxis;
-    if ( splitAxis < 0 )
-      { // cannot split
-      itkDebugMacro("  Cannot Split");
-      return 1;
-      }
+    measure += m_ThreaderMatches[threadID];
     }
 
-  // determine the actual number of pieces that will be generated
-  typename FixedImageRegionType::SizeType::SizeValueType range = fixedRegionSize[splitAxis];
-  int valuesPerThread = Math::Ceil< int >(range / (double)num);
-  ThreadIdType maxThreadIdUsed = Math::Ceil< int >(range / (double)valuesPerThread) - 1;
-
-  // Split the region
-  if ( i < maxThreadIdUsed )
-    {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    splitSize[splitAxis] = valuesPerThread;
-    }
-  if ( i == maxThreadIdUsed )
+  if ( !this->m_NumberOfPixelsCounted )
     {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    // last thread needs to process the "rest" dimension being split
-    splitSize[splitAxis] = splitSize[splitAxis] - i * valuesPerThread;
+    itkExceptionMacro(<< "All the points mapped to outside of the moving image");
     }
-
-  // set the split region ivars
-  splitRegion.SetIndex(splitIndex);
-  splitRegion.SetSize(splitSize);
-
-  itkDebugMacro("  Split Piece: " << splitRegion);
-
-  return maxThreadIdUsed + 1;
-}
-
-// Callback routine used by the threading library. This routine just calls
-// the ThreadedGenerateData method after setting the correct region for this
-// thread.
-template< class TFixedImage, class TMovingImage >
-ITK_THREAD_RETURN_TYPE
-MatchCardinalityImageToImageMetric< TFixedImage, TMovingImage >
-::ThreaderCallback(void *arg)
-{
-  ThreadStruct *str;
-  ThreadIdType  total, threadId, threadCount;
-
-  threadId = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->ThreadID;
-  threadCount = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->NumberOfThreads;
-
-  str = (ThreadStruct *)( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
-
-  // execute the actual method with appropriate computation region
-  // first find out how many pieces extent can be split into.
-  FixedImageRegionType splitRegion;
-  total = str->Metric->SplitFixedRegion(threadId, threadCount, splitRegion);
-
-  if ( threadId < total )
+  else
     {
-    str->Metric->ThreadedGetValue(splitRegion, threadId);
+    measure /= this->m_NumberOfPixelsCounted;
     }
-  // else
-  //   {
-  //   otherwise don't use this thread. Sometimes the threads dont
-  //   break up very well and it is just as efficient to leave a
-  //   few threads idle.
-  //   }
 
-  return ITK_THREAD_RETURN_VALUE;
+  return measure;
 }
 
 /**
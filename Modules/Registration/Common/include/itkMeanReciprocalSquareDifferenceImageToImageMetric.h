@@ -74,6 +74,13 @@ public:
   typedef typename Superclass::MovingImageType         MovingImageType;
   typedef typename Superclass::FixedImageConstPointer  FixedImageConstPointer;
   typedef typename Superclass::MovingImageConstPointer MovingImageConstPointer;
+  typedef typename Superclass::MovingImagePointType    MovingImagePointType;
+
+  /** Initialize the Metric by making sure that all the components
+   *  are present and plugged together correctly, and by sampling the
+   *  fixed image region for the threads. */
+  virtual void Initialize(void)
+  throw ( ExceptionObject );
 
   /** Get the derivatives of the match measure. */
   void GetDerivative(const TransformParametersType & parameters,
@@ -97,7 +104,7 @@ public:
   itkSetMacro(Delta, double);
 protected:
   MeanReciprocalSquareDifferenceImageToImageMetric();
-  virtual ~MeanReciprocalSquareDifferenceImageToImageMetric() {}
+  virtual ~MeanReciprocalSquareDifferenceImageToImageMetric();
   void PrintSelf(std::ostream & os, Indent indent) const;
 
 private:
@@ -108,8 +115,15 @@ private:
                                                                   // not
                                                                   // implemented
 
+  inline bool GetValueThreadProcessSample(ThreadIdType threadID,
+                                          SizeValueType fixedImageSample,
+                                          const MovingImagePointType & mappedPoint,
+                                          double movingImageValue) const;
+
   double m_Lambda;
   double m_Delta;
+
+  MeasureType *m_ThreaderMeasure;
 };
 } // end namespace itk
 
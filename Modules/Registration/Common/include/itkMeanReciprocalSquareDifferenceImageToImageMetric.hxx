@@ -19,7 +19,6 @@
 #define __itkMeanReciprocalSquareDifferenceImageToImageMetric_hxx
 
 #include "itkMeanReciprocalSquareDifferenceImageToImageMetric.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
 
 namespace itk
 {
@@ -32,6 +31,25 @@ MeanReciprocalSquareDifferenceImageToImageMetric< TFixedImage, TMovingImage >
 {
   m_Lambda = 1.0;
   m_Delta  = 0.00011;
+
+  m_ThreaderMeasure = NULL;
+  this->m_WithinThreadPreProcess = false;
+  this->m_WithinThreadPostProcess = false;
+
+  //  For backward compatibility, the default behavior is to use all the pixels
+  //  in the fixed image.
+  this->SetUseAllPixels(true);
+}
+
+template< class TFixedImage, class TMovingImage >
+MeanReciprocalSquareDifferenceImageToImageMetric< TFixedImage, TMovingImage >
+::~MeanReciprocalSquareDifferenceImageToImageMetric()
+{
+  if ( m_ThreaderMeasure != NULL )
+    {
+    delete[] m_ThreaderMeasure;
+    }
+  m_ThreaderMeasure = NULL;
 }
 
 /**
@@ -47,71 +65,67 @@ MeanReciprocalSquareDifferenceImageToImageMetric< TFixedImage, TMovingImage >
   os << "Delta  value  = " << m_Delta  << std::endl;
 }
 
-/*
- * Get the match Measure
+/**
+ * Initialize
  */
 template< class TFixedImage, class TMovingImage >
-typename MeanReciprocalSquareDifferenceImageToImageMetric< TFixedImage, TMovingImage >::MeasureType
+void
 MeanReciprocalSquareDifferenceImageToImageMetric< TFixedImage, TMovingImage >
-::GetValue(const TransformParametersType & parameters) const
+::Initialize(void)
+throw ( ExceptionObject )
 {
-  FixedImageConstPointer fixedImage = this->m_FixedImage;
+  this->Superclass::Initialize();
+  this->Superclass::MultiThreadingInitialize();
 
-  if ( !fixedImage )
+  if ( m_ThreaderMeasure != NULL )
     {
-    itkExceptionMacro(<< "Fixed image has not been assigned");
+    delete[] m_ThreaderMeasure;
     }
+  m_ThreaderMeasure = new MeasureType[this->m_NumberOfThreads];
+}
 
-  const unsigned int              dimension = FixedImageType::ImageDimension;
-  itk::Point< double, dimension > Point;
-
-  double MovingValue;
-  double FixedValue;
-
-  typedef  itk::ImageRegionConstIteratorWithIndex< FixedImageType > FixedIteratorType;
+template< class TFixedImage, class TMovingImage >
+inline bool
+MeanReciprocalSquareDifferenceImageToImageMetric< TFixedImage, TMovingImage >
+::GetValueThreadProcessSample(ThreadIdType threadID,
+                              SizeValueType fixedImageSample,
+                              const MovingImagePointType & itkNotUsed(mappedPoint),
+                              double movingImageValue) const
+{
+  const double diff = movingImageValue - this->m_FixedImageSamples[fixedImageSample].value;
 
-  FixedIteratorType ti( fixedImage, this->GetFixedImageRegion() );
+  m_ThreaderMeasure[threadID] += 1.0f / ( 1.0f + m_Lambda * ( diff * diff ) );
 
-  typename FixedImageType::IndexType index;
+  return true;
+}
 
-  MeasureType measure = NumericTraits< MeasureType >::Zero;
+/*
+ * Get the match Measure
+ */
+template< class TFixedImage, class TMovingImage >
+typename MeanReciprocalSquareDifferenceImageToImageMetric< TFixedImage, TMovingImage >::MeasureType
+MeanReciprocalSquareDifferenceImageToImageMetric< TFixedImage, TMovingImage >
+::GetValue(const TransformParametersType & parameters) const
+{
+  if ( !this->m_FixedImage )
+    {
+    itkExceptionMacro(<< "Fixed image has not been assigned");
+    }
 
-  this->m_NumberOfPixelsCounted = 0;
+  for ( ThreadIdType threadID = 0; threadID < this->m_NumberOfThreads; threadID++ )
+    {
+    m_ThreaderMeasure[threadID] = NumericTraits< MeasureType >::Zero;
+    }
 
   this->SetTransformParameters(parameters);
 
-  while ( !ti.IsAtEnd() )
+  // MUST BE CALLED TO INITIATE PROCESSING
+  this->GetValueMultiThreadedInitiate();
+
+  MeasureType measure = m_ThreaderMeasure[0];
+  for ( ThreadIdType threadID = 1; threadID < this->m_NumberOfThreads; threadID++ )
     {
-    index = ti.GetIndex();
-
-    InputPointType inputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
-
-    if ( this->m_FixedImageMask && !this->m_FixedImageMask->IsInside(inputPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    TransformType const *transform = this->m_Transform;
-    OutputPointType      transformedPoint = transform->TransformPoint(inputPoint);
-
-    if ( this->m_MovingImageMask && !this->m_MovingImageMask->IsInside(transformedPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    if ( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
-      {
-      MovingValue  = this->m_Interpolator->Evaluate(transformedPoint);
-      FixedValue     = ti.Get();
-      this->m_NumberOfPixelsCounted++;
-      const double diff = MovingValue - FixedValue;
-      measure += 1.0f / ( 1.0f + m_Lambda * ( diff * diff ) );
-      }
-
-    ++ti;
+    measure += m_ThreaderMeasure[threadID];
     }
 
   return measure;
@@ -72,6 +72,19 @@ public:
   typedef typename Superclass::MovingImageType         MovingImageType;
   typedef typename Superclass::FixedImageConstPointer  FixedImageConstPointer;
   typedef typename Superclass::MovingImageConstPointer MovingImageConstPointer;
+  typedef typename Superclass::MovingImagePointType    MovingImagePointType;
+  typedef typename Superclass::FixedImagePointType     FixedImagePointType;
+  typedef typename Superclass::ImageDerivativesType    ImageDerivativesType;
+
+  /** The moving image dimension. */
+  itkStaticConstMacro(MovingImageDimension, unsigned int,
+                      MovingImageType::ImageDimension);
+
+  /** Initialize the Metric by making sure that all the components
+   *  are present and plugged together correctly, and by sampling the
+   *  fixed image region for the threads. */
+  virtual void Initialize(void)
+  throw ( ExceptionObject );
 
   /** Get the derivatives of the match measure. */
   void GetDerivative(const TransformParametersType & parameters,
@@ -93,7 +106,7 @@ public:
   itkBooleanMacro(SubtractMean);
 protected:
   NormalizedCorrelationImageToImageMetric();
-  virtual ~NormalizedCorrelationImageToImageMetric() {}
+  virtual ~NormalizedCorrelationImageToImageMetric();
   void PrintSelf(std::ostream & os, Indent indent) const;
 
 private:
@@ -102,7 +115,45 @@ private:
   void operator=(const Self &);                          //purposely not
                                                          // implemented
 
+  typedef typename NumericTraits< MeasureType >::AccumulateType AccumulateType;
+
+  /** Sums accumulated by a thread over its samples. The means are only
+   * known once all the samples have been processed, so m_DerivativeF and
+   * m_DerivativeM sum the fixed and moving values times the derivatives
+   * of the moving value with respect to the parameters, and m_Differential
+   * sums these derivatives alone. */
+  struct ThreaderSumsType {
+    AccumulateType m_SFF;
+    AccumulateType m_SMM;
+    AccumulateType m_SFM;
+    AccumulateType m_SF;
+    AccumulateType m_SM;
+    DerivativeType m_DerivativeF;
+    DerivativeType m_DerivativeM;
+    DerivativeType m_Differential;
+  };
+
+  inline bool GetValueThreadProcessSample(ThreadIdType threadID,
+                                          SizeValueType fixedImageSample,
+                                          const MovingImagePointType & mappedPoint,
+                                          double movingImageValue) const;
+
+  inline bool GetValueAndDerivativeThreadProcessSample(ThreadIdType threadID,
+                                                       SizeValueType fixedImageSample,
+                                                       const MovingImagePointType & mappedPoint,
+                                                       double movingImageValue,
+                                                       const ImageDerivativesType &
+                                                       movingImageGradientValue) const;
+
+  /** Resets the sums of the threads. */
+  void ResetThreaderSums(bool withDerivatives) const;
+
+  /** Adds up the sums of the threads into the first one. */
+  void MergeThreaderSums(bool withDerivatives) const;
+
   bool m_SubtractMean;
+
+  ThreaderSumsType *m_ThreaderSums;
 };
 } // end namespace itk
 
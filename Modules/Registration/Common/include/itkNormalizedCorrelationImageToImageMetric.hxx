@@ -19,7 +19,6 @@
 #define __itkNormalizedCorrelationImageToImageMetric_hxx
 
 #include "itkNormalizedCorrelationImageToImageMetric.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
 
 namespace itk
 {
@@ -31,82 +30,148 @@ NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
 ::NormalizedCorrelationImageToImageMetric()
 {
   m_SubtractMean = false;
+
+  m_ThreaderSums = NULL;
+  this->m_WithinThreadPreProcess = false;
+  this->m_WithinThreadPostProcess = false;
+
+  //  For backward compatibility, the default behavior is to use all the pixels
+  //  in the fixed image.
+  this->SetUseAllPixels(true);
+}
+
+template <class TFixedImage, class TMovingImage>
+NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
+::~NormalizedCorrelationImageToImageMetric()
+{
+  if( m_ThreaderSums != NULL )
+    {
+    delete[] m_ThreaderSums;
+    }
+  m_ThreaderSums = NULL;
 }
 
 /**
- * Get the match Measure
+ * Initialize
  */
 template <class TFixedImage, class TMovingImage>
-typename NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>::MeasureType
+void
 NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
-::GetValue(const TransformParametersType & parameters) const
+::Initialize(void)
+throw ( ExceptionObject )
 {
-  FixedImageConstPointer fixedImage = this->m_FixedImage;
+  this->Superclass::Initialize();
+  this->Superclass::MultiThreadingInitialize();
 
-  if( !fixedImage )
+  if( m_ThreaderSums != NULL )
     {
-    itkExceptionMacro(<< "Fixed image has not been assigned");
+    delete[] m_ThreaderSums;
     }
-
-  typedef  itk::ImageRegionConstIteratorWithIndex<FixedImageType> FixedIteratorType;
-
-  FixedIteratorType ti( fixedImage, this->GetFixedImageRegion() );
-
-  typename FixedImageType::IndexType index;
-
-  MeasureType measure;
-
-  this->m_NumberOfPixelsCounted = 0;
-
-  this->SetTransformParameters(parameters);
-
-  typedef  typename NumericTraits<MeasureType>::AccumulateType AccumulateType;
-
-  AccumulateType sff = NumericTraits<AccumulateType>::Zero;
-  AccumulateType smm = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sfm = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sf  = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sm  = NumericTraits<AccumulateType>::Zero;
-
-  while( !ti.IsAtEnd() )
+  m_ThreaderSums = new ThreaderSumsType[this->m_NumberOfThreads];
+  for( ThreadIdType threadID = 0; threadID < this->m_NumberOfThreads; threadID++ )
     {
-    index = ti.GetIndex();
-
-    InputPointType inputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
+    m_ThreaderSums[threadID].m_DerivativeF.SetSize(this->m_NumberOfParameters);
+    m_ThreaderSums[threadID].m_DerivativeM.SetSize(this->m_NumberOfParameters);
+    m_ThreaderSums[threadID].m_Differential.SetSize(this->m_NumberOfParameters);
+    }
+}
 
-    if( this->m_FixedImageMask && !this->m_FixedImageMask->IsInside(inputPoint) )
+template <class TFixedImage, class TMovingImage>
+void
+NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
+::ResetThreaderSums(bool withDerivatives) const
+{
+  for( ThreadIdType threadID = 0; threadID < this->m_NumberOfThreads; threadID++ )
+    {
+    ThreaderSumsType & sums = m_ThreaderSums[threadID];
+    sums.m_SFF = NumericTraits<AccumulateType>::Zero;
+    sums.m_SMM = NumericTraits<AccumulateType>::Zero;
+    sums.m_SFM = NumericTraits<AccumulateType>::Zero;
+    sums.m_SF = NumericTraits<AccumulateType>::Zero;
+    sums.m_SM = NumericTraits<AccumulateType>::Zero;
+    if( withDerivatives )
       {
-      ++ti;
-      continue;
+      sums.m_DerivativeF.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
+      sums.m_DerivativeM.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
+      sums.m_Differential.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
       }
+    }
+}
 
-    OutputPointType transformedPoint = this->m_Transform->TransformPoint(inputPoint);
-
-    if( this->m_MovingImageMask && !this->m_MovingImageMask->IsInside(transformedPoint) )
+template <class TFixedImage, class TMovingImage>
+void
+NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
+::MergeThreaderSums(bool withDerivatives) const
+{
+  ThreaderSumsType & total = m_ThreaderSums[0];
+  for( ThreadIdType threadID = 1; threadID < this->m_NumberOfThreads; threadID++ )
+    {
+    const ThreaderSumsType & sums = m_ThreaderSums[threadID];
+    total.m_SFF += sums.m_SFF;
+    total.m_SMM += sums.m_SMM;
+    total.m_SFM += sums.m_SFM;
+    total.m_SF += sums.m_SF;
+    total.m_SM += sums.m_SM;
+    if( withDerivatives )
       {
-      ++ti;
-      continue;
+      total.m_DerivativeF += sums.m_DerivativeF;
+      total.m_DerivativeM += sums.m_DerivativeM;
+      total.m_Differential += sums.m_Differential;
       }
+    }
+}
 
-    if( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
-      {
-      const RealType movingValue  = this->m_Interpolator->Evaluate(transformedPoint);
-      const RealType fixedValue   = ti.Get();
-      sff += fixedValue  * fixedValue;
-      smm += movingValue * movingValue;
-      sfm += fixedValue  * movingValue;
-      if( this->m_SubtractMean )
-        {
-        sf += fixedValue;
-        sm += movingValue;
-        }
-      this->m_NumberOfPixelsCounted++;
-      }
+template <class TFixedImage, class TMovingImage>
+inline bool
+NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
+::GetValueThreadProcessSample(ThreadIdType threadID,
+                              SizeValueType fixedImageSample,
+                              const MovingImagePointType & itkNotUsed(mappedPoint),
+                              double movingImageValue) const
+{
+  const RealType     fixedValue = this->m_FixedImageSamples[fixedImageSample].value;
+  const RealType     movingValue = movingImageValue;
+  ThreaderSumsType & sums = m_ThreaderSums[threadID];
+
+  sums.m_SFF += fixedValue  * fixedValue;
+  sums.m_SMM += movingValue * movingValue;
+  sums.m_SFM += fixedValue  * movingValue;
+  if( this->m_SubtractMean )
+    {
+    sums.m_SF += fixedValue;
+    sums.m_SM += movingValue;
+    }
 
-    ++ti;
+  return true;
+}
+
+/**
+ * Get the match Measure
+ */
+template <class TFixedImage, class TMovingImage>
+typename NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>::MeasureType
+NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
+::GetValue(const TransformParametersType & parameters) const
+{
+  if( !this->m_FixedImage )
+    {
+    itkExceptionMacro(<< "Fixed image has not been assigned");
     }
 
+  this->SetTransformParameters(parameters);
+  this->ResetThreaderSums(false);
+
+  // MUST BE CALLED TO INITIATE PROCESSING
+  this->GetValueMultiThreadedInitiate();
+
+  this->MergeThreaderSums(false);
+
+  AccumulateType sff = m_ThreaderSums[0].m_SFF;
+  AccumulateType smm = m_ThreaderSums[0].m_SMM;
+  AccumulateType sfm = m_ThreaderSums[0].m_SFM;
+  const AccumulateType sf = m_ThreaderSums[0].m_SF;
+  const AccumulateType sm = m_ThreaderSums[0].m_SM;
+
   if( this->m_SubtractMean && this->m_NumberOfPixelsCounted > 0 )
     {
     sff -= ( sf * sf / this->m_NumberOfPixelsCounted );
@@ -116,6 +181,7 @@ NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
 
   const RealType denom = -1.0 * vcl_sqrt(sff * smm);
 
+  MeasureType measure;
   if( this->m_NumberOfPixelsCounted > 0 && denom != 0.0 )
     {
     measure = sfm / denom;
@@ -128,189 +194,66 @@ NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
   return measure;
 }
 
-/**
- * Get the Derivative Measure
- */
 template <class TFixedImage, class TMovingImage>
-void
+inline bool
 NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
-::GetDerivative(const TransformParametersType & parameters,
-                DerivativeType & derivative) const
+::GetValueAndDerivativeThreadProcessSample(ThreadIdType threadID,
+                                           SizeValueType fixedImageSample,
+                                           const MovingImagePointType & mappedPoint,
+                                           double movingImageValue,
+                                           const ImageDerivativesType &
+                                           movingImageGradientValue) const
 {
-  if( !this->GetGradientImage() )
-    {
-    itkExceptionMacro(<< "The gradient image is null, maybe you forgot to call Initialize()");
-    }
+  this->GetValueThreadProcessSample(threadID, fixedImageSample, mappedPoint, movingImageValue);
 
-  FixedImageConstPointer fixedImage = this->m_FixedImage;
+  const RealType             fixedValue = this->m_FixedImageSamples[fixedImageSample].value;
+  const RealType             movingValue = movingImageValue;
+  const FixedImagePointType &fixedImagePoint = this->m_FixedImageSamples[fixedImageSample].point;
+  ThreaderSumsType &         sums = m_ThreaderSums[threadID];
 
-  if( !fixedImage )
+  // Use a raw pointer here to avoid the overhead of smart pointers.
+  TransformType *transform;
+
+  if( threadID > 0 )
     {
-    itkExceptionMacro(<< "Fixed image has not been assigned");
+    transform = this->m_ThreaderTransform[threadID - 1];
     }
-
-  const unsigned int dimension = FixedImageType::ImageDimension;
-
-  typedef  itk::ImageRegionConstIteratorWithIndex<FixedImageType> FixedIteratorType;
-
-  FixedIteratorType ti( fixedImage, this->GetFixedImageRegion() );
-
-  typename FixedImageType::IndexType index;
-
-  this->m_NumberOfPixelsCounted = 0;
-
-  this->SetTransformParameters(parameters);
-
-  typedef  typename NumericTraits<MeasureType>::AccumulateType AccumulateType;
-
-  AccumulateType sff  = NumericTraits<AccumulateType>::Zero;
-  AccumulateType smm  = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sfm = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sf  = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sm  = NumericTraits<AccumulateType>::Zero;
-
-  const unsigned int ParametersDimension = this->GetNumberOfParameters();
-  derivative = DerivativeType(ParametersDimension);
-  derivative.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
-
-  DerivativeType derivativeF = DerivativeType(ParametersDimension);
-  derivativeF.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
-
-  DerivativeType derivativeM = DerivativeType(ParametersDimension);
-  derivativeM.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
-
-  ti.GoToBegin();
-  // First compute the sums
-  while( !ti.IsAtEnd() )
+  else
     {
-    index = ti.GetIndex();
-
-    InputPointType inputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
-
-    if( this->m_FixedImageMask && !this->m_FixedImageMask->IsInside(inputPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    OutputPointType transformedPoint = this->m_Transform->TransformPoint(inputPoint);
-
-    if( this->m_MovingImageMask && !this->m_MovingImageMask->IsInside(transformedPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    if( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
-      {
-      const RealType movingValue  = this->m_Interpolator->Evaluate(transformedPoint);
-      const RealType fixedValue   = ti.Get();
-      sff += fixedValue  * fixedValue;
-      smm += movingValue * movingValue;
-      sfm += fixedValue  * movingValue;
-      if( this->m_SubtractMean )
-        {
-        sf += fixedValue;
-        sm += movingValue;
-        }
-      this->m_NumberOfPixelsCounted++;
-      }
-
-    ++ti;
+    transform = this->m_Transform;
     }
 
-  // Compute contributions to derivatives
-  ti.GoToBegin();
-  while( !ti.IsAtEnd() )
+  // Jacobian should be evaluated at the unmapped (fixed image) point.
+  TransformJacobianType jacobian;
+  transform->ComputeJacobianWithRespectToParameters(fixedImagePoint, jacobian);
+  for( unsigned int par = 0; par < this->m_NumberOfParameters; par++ )
     {
-    index = ti.GetIndex();
-
-    InputPointType inputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
-
-    if( this->m_FixedImageMask && !this->m_FixedImageMask->IsInside(inputPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    OutputPointType transformedPoint = this->m_Transform->TransformPoint(inputPoint);
-
-    if( this->m_MovingImageMask && !this->m_MovingImageMask->IsInside(transformedPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    if( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
+    RealType differential = NumericTraits<RealType>::Zero;
+    for( unsigned int dim = 0; dim < MovingImageDimension; dim++ )
       {
-      const RealType movingValue  = this->m_Interpolator->Evaluate(transformedPoint);
-      const RealType fixedValue     = ti.Get();
-
-      TransformJacobianType jacobian;
-      this->m_Transform->ComputeJacobianWithRespectToParameters(inputPoint, jacobian);
-
-      // Get the gradient by NearestNeighboorInterpolation:
-      // which is equivalent to round up the point components.
-      typedef typename OutputPointType::CoordRepType CoordRepType;
-      typedef ContinuousIndex<CoordRepType, MovingImageType::ImageDimension>
-      MovingImageContinuousIndexType;
-
-      MovingImageContinuousIndexType tempIndex;
-      this->m_MovingImage->TransformPhysicalPointToContinuousIndex(transformedPoint, tempIndex);
-
-      typename MovingImageType::IndexType mappedIndex;
-      mappedIndex.CopyWithRound(tempIndex);
-
-      const GradientPixelType gradient =
-        this->GetGradientImage()->GetPixel(mappedIndex);
-      for( unsigned int par = 0; par < ParametersDimension; par++ )
-        {
-        RealType sumF = NumericTraits<RealType>::Zero;
-        RealType sumM = NumericTraits<RealType>::Zero;
-        for( unsigned int dim = 0; dim < dimension; dim++ )
-          {
-          const RealType differential = jacobian(dim, par) * gradient[dim];
-          sumF += fixedValue  * differential;
-          sumM += movingValue * differential;
-          if( this->m_SubtractMean && this->m_NumberOfPixelsCounted > 0 )
-            {
-            sumF -= differential * sf / this->m_NumberOfPixelsCounted;
-            sumM -= differential * sm / this->m_NumberOfPixelsCounted;
-            }
-          }
-        derivativeF[par] += sumF;
-        derivativeM[par] += sumM;
-        }
+      differential += jacobian(dim, par) * movingImageGradientValue[dim];
       }
-
-    ++ti;
+    sums.m_DerivativeF[par] += fixedValue  * differential;
+    sums.m_DerivativeM[par] += movingValue * differential;
+    sums.m_Differential[par] += differential;
     }
 
-  if( this->m_SubtractMean && this->m_NumberOfPixelsCounted > 0 )
-    {
-    sff -= ( sf * sf / this->m_NumberOfPixelsCounted );
-    smm -= ( sm * sm / this->m_NumberOfPixelsCounted );
-    sfm -= ( sf * sm / this->m_NumberOfPixelsCounted );
-    }
+  return true;
+}
 
-  const RealType denom = -1.0 * vcl_sqrt(sff * smm);
+/**
+ * Get the Derivative Measure
+ */
+template <class TFixedImage, class TMovingImage>
+void
+NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
+::GetDerivative(const TransformParametersType & parameters,
+                DerivativeType & derivative) const
+{
+  MeasureType value;
 
-  if( this->m_NumberOfPixelsCounted > 0 && denom != 0.0 )
-    {
-    for( unsigned int i = 0; i < ParametersDimension; i++ )
-      {
-      derivative[i] = ( derivativeF[i] - ( sfm / smm ) * derivativeM[i] ) / denom;
-      }
-    }
-  else
-    {
-    for( unsigned int i = 0; i < ParametersDimension; i++ )
-      {
-      derivative[i] = NumericTraits<MeasureType>::Zero;
-      }
-    }
+  // call the combined version
+  this->GetValueAndDerivative(parameters, value, derivative);
 }
 
 /*
@@ -322,161 +265,40 @@ NormalizedCorrelationImageToImageMetric<TFixedImage, TMovingImage>
 ::GetValueAndDerivative(const TransformParametersType & parameters,
                         MeasureType & value, DerivativeType  & derivative) const
 {
-  if( !this->GetGradientImage() )
-    {
-    itkExceptionMacro(<< "The gradient image is null, maybe you forgot to call Initialize()");
-    }
-
-  FixedImageConstPointer fixedImage = this->m_FixedImage;
-
-  if( !fixedImage )
+  if( !this->m_FixedImage )
     {
     itkExceptionMacro(<< "Fixed image has not been assigned");
     }
 
-  const unsigned int dimension = FixedImageType::ImageDimension;
-
-  typedef  itk::ImageRegionConstIteratorWithIndex<FixedImageType> FixedIteratorType;
-
-  FixedIteratorType ti( fixedImage, this->GetFixedImageRegion() );
-
-  typename FixedImageType::IndexType index;
-
-  this->m_NumberOfPixelsCounted = 0;
-
   this->SetTransformParameters(parameters);
+  this->ResetThreaderSums(true);
 
-  typedef  typename NumericTraits<MeasureType>::AccumulateType AccumulateType;
+  // MUST BE CALLED TO INITIATE PROCESSING
+  this->GetValueAndDerivativeMultiThreadedInitiate();
 
-  AccumulateType sff  = NumericTraits<AccumulateType>::Zero;
-  AccumulateType smm  = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sfm = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sf  = NumericTraits<AccumulateType>::Zero;
-  AccumulateType sm  = NumericTraits<AccumulateType>::Zero;
+  this->MergeThreaderSums(true);
 
   const unsigned int ParametersDimension = this->GetNumberOfParameters();
   derivative = DerivativeType(ParametersDimension);
-  derivative.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
-
-  DerivativeType derivativeF = DerivativeType(ParametersDimension);
-  derivativeF.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
-
-  DerivativeType derivativeM = DerivativeType(ParametersDimension);
-  derivativeM.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
-
-  DerivativeType derivativeM1 = DerivativeType(ParametersDimension);
-  derivativeM1.Fill(NumericTraits<ITK_TYPENAME DerivativeType::ValueType>::Zero);
-
-  ti.GoToBegin();
-  // First compute the sums
-  while( !ti.IsAtEnd() )
-    {
-    index = ti.GetIndex();
-
-    InputPointType inputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
-
-    if( this->m_FixedImageMask && !this->m_FixedImageMask->IsInside(inputPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    OutputPointType transformedPoint = this->m_Transform->TransformPoint(inputPoint);
-
-    if( this->m_MovingImageMask && !this->m_MovingImageMask->IsInside(transformedPoint) )
-      {
-      ++ti;
-      continue;
-      }
 
-    if( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
-      {
-      const RealType movingValue  = this->m_Interpolator->Evaluate(transformedPoint);
-      const RealType fixedValue   = ti.Get();
-      sff += fixedValue  * fixedValue;
-      smm += movingValue * movingValue;
-      sfm += fixedValue  * movingValue;
-      if( this->m_SubtractMean )
-        {
-        sf += fixedValue;
-        sm += movingValue;
-        }
-      this->m_NumberOfPixelsCounted++;
-      }
+  AccumulateType sff = m_ThreaderSums[0].m_SFF;
+  AccumulateType smm = m_ThreaderSums[0].m_SMM;
+  AccumulateType sfm = m_ThreaderSums[0].m_SFM;
+  const AccumulateType sf = m_ThreaderSums[0].m_SF;
+  const AccumulateType sm = m_ThreaderSums[0].m_SM;
 
-    ++ti;
-    }
+  DerivativeType & derivativeF = m_ThreaderSums[0].m_DerivativeF;
+  DerivativeType & derivativeM = m_ThreaderSums[0].m_DerivativeM;
 
-  // Compute contributions to derivatives
-  ti.GoToBegin();
-  while( !ti.IsAtEnd() )
+  if( this->m_SubtractMean && this->m_NumberOfPixelsCounted > 0 )
     {
-    index = ti.GetIndex();
-
-    InputPointType inputPoint;
-    fixedImage->TransformIndexToPhysicalPoint(index, inputPoint);
-
-    if( this->m_FixedImageMask && !this->m_FixedImageMask->IsInside(inputPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    OutputPointType transformedPoint = this->m_Transform->TransformPoint(inputPoint);
-
-    if( this->m_MovingImageMask && !this->m_MovingImageMask->IsInside(transformedPoint) )
-      {
-      ++ti;
-      continue;
-      }
-
-    if( this->m_Interpolator->IsInsideBuffer(transformedPoint) )
+    const DerivativeType & differential = m_ThreaderSums[0].m_Differential;
+    for( unsigned int i = 0; i < ParametersDimension; i++ )
       {
-      const RealType movingValue  = this->m_Interpolator->Evaluate(transformedPoint);
-      const RealType fixedValue     = ti.Get();
-
-      TransformJacobianType jacobian;
-      this->m_Transform->ComputeJacobianWithRespectToParameters(inputPoint, jacobian);
-
-      // Get the gradient by NearestNeighboorInterpolation:
-      // which is equivalent to round up the point components.
-      typedef typename OutputPointType::CoordRepType CoordRepType;
-      typedef ContinuousIndex<CoordRepType, MovingImageType::ImageDimension>
-      MovingImageContinuousIndexType;
-
-      MovingImageContinuousIndexType tempIndex;
-      this->m_MovingImage->TransformPhysicalPointToContinuousIndex(transformedPoint, tempIndex);
-
-      typename MovingImageType::IndexType mappedIndex;
-      mappedIndex.CopyWithRound(tempIndex);
-
-      const GradientPixelType gradient =
-        this->GetGradientImage()->GetPixel(mappedIndex);
-      for( unsigned int par = 0; par < ParametersDimension; par++ )
-        {
-        RealType sumF = NumericTraits<RealType>::Zero;
-        RealType sumM = NumericTraits<RealType>::Zero;
-        for( unsigned int dim = 0; dim < dimension; dim++ )
-          {
-          const RealType differential = jacobian(dim, par) * gradient[dim];
-          sumF += fixedValue  * differential;
-          sumM += movingValue * differential;
-          if( this->m_SubtractMean && this->m_NumberOfPixelsCounted > 0 )
-            {
-            sumF -= differential * sf / this->m_NumberOfPixelsCounted;
-            sumM -= differential * sm / this->m_NumberOfPixelsCounted;
-            }
-          }
-        derivativeF[par] += sumF;
-        derivativeM[par] += sumM;
-        }
+      derivativeF[i] -= differential[i] * sf / this->m_NumberOfPixelsCounted;
+      derivativeM[i] -= differential[i] * sm / this->m_NumberOfPixelsCounted;
       }
-    ++ti;
-    }
 
-  if( this->m_SubtractMean && this->m_NumberOfPixelsCounted > 0 )
-    {
     sff -= ( sf * sf / this->m_NumberOfPixelsCounted );
     smm -= ( sm * sm / this->m_NumberOfPixelsCounted );
     sfm -= ( sf * sm / this->m_NumberOfPixelsCounted );
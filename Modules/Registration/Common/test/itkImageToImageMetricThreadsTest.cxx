@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNormalizedCorrelationImageToImageMetric.h"
+#include "itkMeanReciprocalSquareDifferenceImageToImageMetric.h"
+#include "itkKappaStatisticImageToImageMetric.h"
+#include "itkMatchCardinalityImageToImageMetric.h"
+#include "itkMutualInformationHistogramImageToImageMetric.h"
+#include "itkNormalizedMutualInformationHistogramImageToImageMetric.h"
+#include "itkMeanSquaresHistogramImageToImageMetric.h"
+#include "itkCorrelationCoefficientHistogramImageToImageMetric.h"
+#include "itkTranslationTransform.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+/**
+ * The metrics below evaluate the samples of the fixed image in the
+ * threads of ImageToImageMetric, each thread accumulating into its own
+ * sums or histogram. This test checks that the values and the
+ * derivatives computed with several threads match the ones computed with
+ * a single thread.
+ */
+namespace
+{
+typedef itk::Image< unsigned char, 2 >         ImageType;
+typedef itk::TranslationTransform< double, 2 > TransformType;
+
+const unsigned int NumberOfThreads = 3;
+
+/** A disk of 200 over a textured background, shifted by offset */
+ImageType::Pointer
+MakeImage(int offset)
+{
+  ImageType::Pointer  image = ImageType::New();
+  ImageType::SizeType size = { { 64, 48 } };
+  image->SetRegions(size);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    const int                  x = index[0] - offset - 30;
+    const int                  y = index[1] - 24;
+    it.Set( x * x + y * y < 200 ? 200 : ( index[0] * 7 + index[1] * 3 ) % 50 );
+    }
+  return image;
+}
+
+bool
+IsClose(double a, double b)
+{
+  return vcl_abs(a - b) <= 1e-6 * ( vcl_abs(a) + vcl_abs(b) ) + 1e-9;
+}
+
+void
+SetForegroundValue(itk::KappaStatisticImageToImageMetric< ImageType, ImageType > *metric)
+{
+  metric->SetForegroundValue(200);
+}
+
+template< class TMetric >
+void
+SetHistogramSize(TMetric *metric)
+{
+  typename TMetric::HistogramSizeType size;
+  size.SetSize(2);
+  size.Fill(32);
+  metric->SetHistogramSize(size);
+}
+
+template< class TMetric, class TInterpolator >
+bool
+CompareThreads(const char *name, bool hasDerivative, void ( *configure )(TMetric *) = NULL)
+{
+  ImageType::Pointer fixedImage = MakeImage(0);
+  ImageType::Pointer movingImage = MakeImage(3);
+
+  typename TMetric::MeasureType    values[2][4];
+  typename TMetric::DerivativeType derivatives[2][4];
+  for ( unsigned int run = 0; run < 2; run++ )
+    {
+    typename TMetric::Pointer metric = TMetric::New();
+    metric->SetFixedImage(fixedImage);
+    metric->SetMovingImage(movingImage);
+    metric->SetTransform( TransformType::New() );
+    metric->SetInterpolator( TInterpolator::New() );
+    metric->SetFixedImageRegion( fixedImage->GetBufferedRegion() );
+    if ( configure )
+      {
+      configure( metric.GetPointer() );
+      }
+    metric->SetNumberOfThreads(run == 0 ? 1 : NumberOfThreads);
+    metric->Initialize();
+
+    TransformType::ParametersType parameters(2);
+    for ( unsigned int k = 0; k < 4; k++ )
+      {
+      parameters[0] = 1.3 * k;
+      parameters[1] = -0.4 * k;
+      values[run][k] = metric->GetValue(parameters);
+      if ( hasDerivative )
+        {
+        typename TMetric::MeasureType value;
+        metric->GetValueAndDerivative(parameters, value, derivatives[run][k]);
+        if ( !IsClose(value, values[run][k]) )
+          {
+          std::cerr << name << ": GetValueAndDerivative() gives " << value
+                    << " instead of " << values[run][k] << std::endl;
+          return false;
+          }
+        }
+      }
+    }
+
+  for ( unsigned int k = 0; k < 4; k++ )
+    {
+    if ( !IsClose(values[0][k], values[1][k]) )
+      {
+      std::cerr << name << ": the value is " << values[1][k] << " with " << NumberOfThreads
+                << " threads instead of " << values[0][k] << std::endl;
+      return false;
+      }
+    if ( !hasDerivative )
+      {
+      continue;
+      }
+    for ( unsigned int i = 0; i < derivatives[0][k].Size(); i++ )
+      {
+      if ( !IsClose(derivatives[0][k][i], derivatives[1][k][i]) )
+        {
+        std::cerr << name << ": the derivative is " << derivatives[1][k] << " with " << NumberOfThreads
+                  << " threads instead of " << derivatives[0][k] << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int itkImageToImageMetricThreadsTest(int, char *[])
+{
+  typedef itk::LinearInterpolateImageFunction< ImageType, double >          LinearType;
+  typedef itk::NearestNeighborInterpolateImageFunction< ImageType, double > NearestType;
+
+  typedef itk::NormalizedCorrelationImageToImageMetric< ImageType, ImageType >          NCType;
+  typedef itk::MeanReciprocalSquareDifferenceImageToImageMetric< ImageType, ImageType > MRSDType;
+  typedef itk::KappaStatisticImageToImageMetric< ImageType, ImageType >                 KappaType;
+  typedef itk::MatchCardinalityImageToImageMetric< ImageType, ImageType >               MatchType;
+
+  typedef itk::MutualInformationHistogramImageToImageMetric< ImageType, ImageType >           MIType;
+  typedef itk::NormalizedMutualInformationHistogramImageToImageMetric< ImageType, ImageType > NMIType;
+  typedef itk::MeanSquaresHistogramImageToImageMetric< ImageType, ImageType >                 MSType;
+  typedef itk::CorrelationCoefficientHistogramImageToImageMetric< ImageType, ImageType >      CCType;
+
+  bool passed = true;
+  passed &= CompareThreads< NCType, LinearType >("NormalizedCorrelation", true);
+  passed &= CompareThreads< MRSDType, LinearType >("MeanReciprocalSquareDifference", true);
+  passed &= CompareThreads< KappaType, NearestType >("KappaStatistic", true, SetForegroundValue);
+  // MatchCardinality provides no derivative
+  passed &= CompareThreads< MatchType, NearestType >("MatchCardinality", false);
+  passed &= CompareThreads< MIType, LinearType >("MutualInformationHistogram", true,
+                                                 SetHistogramSize< MIType >);
+  passed &= CompareThreads< NMIType, LinearType >("NormalizedMutualInformationHistogram", true,
+                                                  SetHistogramSize< NMIType >);
+  passed &= CompareThreads< MSType, LinearType >("MeanSquaresHistogram", true,
+                                                 SetHistogramSize< MSType >);
+  passed &= CompareThreads< CCType, LinearType >("CorrelationCoefficientHistogram", true,
+                                                 SetHistogramSize< CCType >);
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test PASSED !" << std::endl;
+  return EXIT_SUCCESS;
+}
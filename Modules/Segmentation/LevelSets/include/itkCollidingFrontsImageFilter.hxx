@@ -109,8 +109,7 @@ CollidingFrontsImageFilter< TInputImage, TOutputImage >
 
     OutputImageRegionType region =  outputImage->GetRequestedRegion();
     outputImage->SetBufferedRegion(region);
-    outputImage->Allocate();
-    outputImage->FillBuffer (NumericTraits< OutputPixelType >::Zero);
+    outputImage->AllocateAndFill(NumericTraits< OutputPixelType >::Zero);
 
     typedef BinaryThresholdImageFunction< OutputImageType >                                   FunctionType;
     typedef FloodFilledImageFunctionConditionalConstIterator< OutputImageType, FunctionType > IteratorType;
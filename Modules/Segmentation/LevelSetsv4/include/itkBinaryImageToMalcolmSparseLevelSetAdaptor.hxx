@@ -52,8 +52,7 @@ void BinaryImageToMalcolmSparseLevelSetAdaptor< TInputImage >
   this->m_InternalImage = InternalImageType::New();
   this->m_InternalImage->CopyInformation( this->m_InputImage );
   this->m_InternalImage->SetRegions( this->m_InputImage->GetBufferedRegion() );
-  this->m_InternalImage->Allocate();
-  this->m_InternalImage->FillBuffer( LevelSetType::PlusOneLayer() );
+  this->m_InternalImage->AllocateAndFill( LevelSetType::PlusOneLayer() );
 
   LevelSetLabelObjectPointer innerPart = LevelSetLabelObjectType::New();
   innerPart->SetLabel( LevelSetType::MinusOneLayer() );
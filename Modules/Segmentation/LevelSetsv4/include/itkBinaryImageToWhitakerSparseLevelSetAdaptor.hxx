@@ -53,8 +53,7 @@ void BinaryImageToWhitakerSparseLevelSetAdaptor< TInputImage, TLevelSetValueType
   this->m_InternalImage = InternalImageType::New();
   this->m_InternalImage->CopyInformation( this->m_InputImage );
   this->m_InternalImage->SetRegions( this->m_InputImage->GetBufferedRegion() );
-  this->m_InternalImage->Allocate();
-  this->m_InternalImage->FillBuffer( LevelSetType::PlusThreeLayer() );
+  this->m_InternalImage->AllocateAndFill( LevelSetType::PlusThreeLayer() );
 
   LevelSetLabelObjectPointer innerPart = LevelSetLabelObjectType::New();
   innerPart->SetLabel( LevelSetType::MinusThreeLayer() );
@@ -151,8 +151,7 @@ ConfidenceConnectedImageFilter< TInputImage, TOutputImage >
   // Zero the output
   OutputImageRegionType region = outputImage->GetRequestedRegion();
   outputImage->SetBufferedRegion(region);
-  outputImage->Allocate();
-  outputImage->FillBuffer (NumericTraits< OutputImagePixelType >::Zero);
+  outputImage->AllocateAndFill(NumericTraits< OutputImagePixelType >::Zero);
 
   // Compute the statistics of the seed point
   typedef MeanImageFunction< InputImageType,
@@ -282,8 +282,7 @@ ConnectedThresholdImageFilter< TInputImage, TOutputImage >
   // Zero the output
   OutputImageRegionType region =  outputImage->GetRequestedRegion();
   outputImage->SetBufferedRegion(region);
-  outputImage->Allocate();
-  outputImage->FillBuffer (NumericTraits< OutputImagePixelType >::Zero);
+  outputImage->AllocateAndFill(NumericTraits< OutputImagePixelType >::Zero);
 
   typedef BinaryThresholdImageFunction< InputImageType, double > FunctionType;
 
@@ -206,8 +206,7 @@ IsolatedConnectedImageFilter< TInputImage, TOutputImage >
   // Zero the output
   OutputImageRegionType region = outputImage->GetRequestedRegion();
   outputImage->SetBufferedRegion(region);
-  outputImage->Allocate();
-  outputImage->FillBuffer (NumericTraits< OutputImagePixelType >::Zero);
+  outputImage->AllocateAndFill(NumericTraits< OutputImagePixelType >::Zero);
 
   typedef BinaryThresholdImageFunction< InputImageType >                               FunctionType;
   typedef FloodFilledImageFunctionConditionalIterator< OutputImageType, FunctionType > IteratorType;
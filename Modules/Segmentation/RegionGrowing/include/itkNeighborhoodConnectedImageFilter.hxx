@@ -122,8 +122,7 @@ NeighborhoodConnectedImageFilter< TInputImage, TOutputImage >
 
   // Zero the output
   outputImage->SetBufferedRegion( outputImage->GetRequestedRegion() );
-  outputImage->Allocate();
-  outputImage->FillBuffer (NumericTraits< OutputImagePixelType >::Zero);
+  outputImage->AllocateAndFill(NumericTraits< OutputImagePixelType >::Zero);
 
   typedef NeighborhoodBinaryThresholdImageFunction< InputImageType >                   FunctionType;
   typedef FloodFilledImageFunctionConditionalIterator< OutputImageType, FunctionType > IteratorType;
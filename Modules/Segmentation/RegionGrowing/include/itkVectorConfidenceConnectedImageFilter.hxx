@@ -109,8 +109,7 @@ VectorConfidenceConnectedImageFilter< TInputImage, TOutputImage >
   // Zero the output
   OutputImageRegionType region = outputImage->GetRequestedRegion();
   outputImage->SetBufferedRegion(region);
-  outputImage->Allocate();
-  outputImage->FillBuffer (NumericTraits< OutputImagePixelType >::Zero);
+  outputImage->AllocateAndFill(NumericTraits< OutputImagePixelType >::Zero);
 
   // Compute the statistics of the seed point
   typedef VectorMeanImageFunction< InputImageType > VectorMeanImageFunctionType;
@@ -74,8 +74,7 @@ TobogganImageFilter< TInputImage >
 
   // Zero the output
   outputImage->SetBufferedRegion( outputImage->GetRequestedRegion() );
-  outputImage->Allocate();
-  outputImage->FillBuffer (z);
+  outputImage->AllocateAndFill(z);
 
   typedef ImageRegionConstIterator< InputImageType >  InputIterator;
   typedef ImageRegionConstIterator< OutputImageType > OutputIterator;